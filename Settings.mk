@@ -14,7 +14,7 @@ NNFORGE_PATH=../..
 NNFORGE_INPUT_DATA_PATH=/home/max/nnforge/input_data
 NNFORGE_WORKING_DATA_PATH=/home/max/nnforge/working_data
 
-BOOST_LIBS=-lboost_thread-mt -lboost_regex-mt -lboost_chrono-mt -lboost_filesystem-mt -lboost_program_options-mt -lboost_random-mt -lboost_system-mt -lboost_date_time-mt
+BOOST_LIBS=-lboost_thread-mt -lboost_regex-mt -lboost_chrono-mt -lboost_filesystem-mt -lboost_program_options-mt -lboost_random-mt -lboost_system-mt -lboost_date_time-mt -lrt
 OPENCV_LIBS=-lopencv_highgui -lopencv_imgproc -lopencv_core
 NETCDF_LIBS=-lnetcdf
 MATIO_LIBS=-lmatio
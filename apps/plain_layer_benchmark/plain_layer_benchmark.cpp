@@ -0,0 +1,454 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+#include <boost/program_options.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/chrono.hpp>
+#include <boost/format.hpp>
+#include <boost/uuid/uuid_io.hpp>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <nnforge/nnforge.h>
+#include <nnforge/layer_factory.h>
+#include <nnforge/plain/plain.h>
+#include <nnforge/plain/layer_tester_plain_factory.h>
+#include <nnforge/plain/layer_updater_plain_factory.h>
+#include <nnforge/plain/layer_hessian_plain_factory.h>
+#include <nnforge/plain/sparsity_util.h>
+
+using namespace nnforge;
+using namespace nnforge::plain;
+
+// Runs the body once untimed to warm up caches and then repeats it until min_seconds elapse
+class phase_timer
+{
+public:
+	phase_timer(float min_seconds)
+		: min_seconds(min_seconds)
+		, iteration_count(0)
+		, elapsed_seconds(0.0F)
+		, warmed_up(false)
+		, started(false)
+		, paused_seconds(0.0F)
+	{
+	}
+
+	bool next()
+	{
+		if (!warmed_up)
+		{
+			warmed_up = true;
+			return true;
+		}
+
+		if (!started)
+		{
+			started = true;
+			start = boost::chrono::high_resolution_clock::now();
+			return true;
+		}
+
+		++iteration_count;
+		boost::chrono::duration<float> sec = boost::chrono::high_resolution_clock::now() - start;
+		elapsed_seconds = sec.count() - paused_seconds;
+		return (elapsed_seconds < min_seconds);
+	}
+
+	// The time between pause and resume is not counted, it is used to restore inputs the iteration overwrites
+	void pause()
+	{
+		pause_start = boost::chrono::high_resolution_clock::now();
+	}
+
+	void resume()
+	{
+		boost::chrono::duration<float> sec = boost::chrono::high_resolution_clock::now() - pause_start;
+		if (started)
+			paused_seconds += sec.count();
+	}
+
+	unsigned int get_iteration_count() const
+	{
+		return iteration_count;
+	}
+
+	float get_seconds_per_iteration() const
+	{
+		return elapsed_seconds / static_cast<float>(iteration_count);
+	}
+
+private:
+	float min_seconds;
+	unsigned int iteration_count;
+	float elapsed_seconds;
+	bool warmed_up;
+	bool started;
+	boost::chrono::steady_clock::time_point start;
+	float paused_seconds;
+	boost::chrono::steady_clock::time_point pause_start;
+};
+
+struct grid_point
+{
+	std::string layer_name;
+	unsigned int input_size;
+	unsigned int feature_map_count;
+	unsigned int entry_count;
+	int thread_count;
+};
+
+std::vector<unsigned int> parse_list(const std::string& str)
+{
+	std::vector<unsigned int> res;
+	std::istringstream in(str);
+	unsigned int val;
+	while (in >> val)
+	{
+		res.push_back(val);
+		if (in.peek() == ',')
+			in.ignore();
+	}
+
+	return res;
+}
+
+void print_result(
+	std::ostream& out,
+	const grid_point& point,
+	const char * phase,
+	const phase_timer& timer,
+	float flops)
+{
+	float seconds = timer.get_seconds_per_iteration();
+	float gflops = (seconds > 0.0F) ? flops / seconds * 1.0e-9F : 0.0F;
+	out << (boost::format("%1%,%2%,%3%,%4%,%5%,%6%,%7%,%|8$.6f|,%|9$.3f|")
+		% point.layer_name % phase % point.input_size % point.feature_map_count % point.entry_count % point.thread_count
+		% timer.get_iteration_count() % (seconds * 1000.0F) % gflops) << std::endl;
+}
+
+// Layers from the factory carry degenerate parameters, parameterized ones are rebuilt for the feature map count of the grid point
+layer_smart_ptr get_layer(
+	const boost::uuids::uuid& layer_guid,
+	unsigned int feature_map_count)
+{
+	if (layer_guid == convolution_layer::layer_guid)
+		return layer_smart_ptr(new convolution_layer(std::vector<unsigned int>(2, 3), feature_map_count, feature_map_count));
+	if (layer_guid == average_subsampling_layer::layer_guid)
+		return layer_smart_ptr(new average_subsampling_layer(std::vector<unsigned int>(2, 2)));
+	if (layer_guid == max_subsampling_layer::layer_guid)
+		return layer_smart_ptr(new max_subsampling_layer(std::vector<unsigned int>(2, 2)));
+	if (layer_guid == local_contrast_subtractive_layer::layer_guid)
+		return layer_smart_ptr(new local_contrast_subtractive_layer(std::vector<unsigned int>(2, 9), std::vector<unsigned int>(1, 0), feature_map_count));
+	if (layer_guid == maxout_layer::layer_guid)
+		return layer_smart_ptr(new maxout_layer(2));
+
+	return single_layer_factory::get_const_instance().create_layer(layer_guid);
+}
+
+std::string get_layer_name(const boost::uuids::uuid& layer_guid)
+{
+	std::map<boost::uuids::uuid, std::string> name_map;
+	name_map[convolution_layer::layer_guid] = "convolution";
+	name_map[hyperbolic_tangent_layer::layer_guid] = "hyperbolic_tangent";
+	name_map[average_subsampling_layer::layer_guid] = "average_subsampling";
+	name_map[max_subsampling_layer::layer_guid] = "max_subsampling";
+	name_map[absolute_layer::layer_guid] = "absolute";
+	name_map[local_contrast_subtractive_layer::layer_guid] = "local_contrast_subtractive";
+	name_map[rgb_to_yuv_convert_layer::layer_guid] = "rgb_to_yuv_convert";
+	name_map[rectified_linear_layer::layer_guid] = "rectified_linear";
+	name_map[soft_rectified_linear_layer::layer_guid] = "soft_rectified_linear";
+	name_map[softmax_layer::layer_guid] = "softmax";
+	name_map[maxout_layer::layer_guid] = "maxout";
+	name_map[sigmoid_layer::layer_guid] = "sigmoid";
+
+	std::map<boost::uuids::uuid, std::string>::const_iterator it = name_map.find(layer_guid);
+	if (it != name_map.end())
+		return it->second;
+
+	return boost::uuids::to_string(layer_guid);
+}
+
+additional_buffer_smart_ptr get_random_buffer(
+	size_t elem_count,
+	random_generator& gen)
+{
+	additional_buffer_smart_ptr res(new additional_buffer(elem_count));
+	nnforge_uniform_real_distribution<float> dist(-1.0F, 1.0F);
+	for(additional_buffer::iterator it = res->begin(); it != res->end(); ++it)
+		*it = dist(gen);
+
+	return res;
+}
+
+void benchmark_layer(
+	std::ostream& out,
+	const grid_point& point,
+	const boost::uuids::uuid& layer_guid,
+	float min_seconds,
+	random_generator& gen)
+{
+	plain_running_configuration_const_smart_ptr plain_config(new plain_running_configuration(point.thread_count, 1.0F));
+
+	const_layer_smart_ptr layer_schema = get_layer(layer_guid, point.feature_map_count);
+	layer_configuration_specific input_configuration(point.feature_map_count);
+	input_configuration.dimension_sizes.push_back(point.input_size);
+	input_configuration.dimension_sizes.push_back(point.input_size);
+	layer_configuration_specific output_configuration = layer_schema->get_output_layer_configuration_specific(input_configuration);
+	const unsigned int entry_count = point.entry_count;
+
+	layer_data_smart_ptr data = layer_schema->create_layer_data();
+	layer_schema->randomize_data(*data, gen);
+	layer_data_smart_ptr learning_rate = layer_schema->create_layer_data();
+	for(layer_data::iterator it = learning_rate->begin(); it != learning_rate->end(); ++it)
+		std::fill(it->begin(), it->end(), 1.0e-6F);
+	layer_data_smart_ptr hessian_data = layer_schema->create_layer_data();
+
+	additional_buffer_smart_ptr input_neurons = get_random_buffer(entry_count * input_configuration.get_neuron_count(), gen);
+	// In-place backprop overwrites output errors with input ones, they are restored from the original before each iteration
+	const additional_buffer_smart_ptr original_output_errors = get_random_buffer(entry_count * output_configuration.get_neuron_count(), gen);
+	additional_buffer_smart_ptr output_errors(new additional_buffer(*original_output_errors));
+	const unsigned int output_errors_zero_count = sparsity_util::get_zero_count(&(*original_output_errors->begin()), entry_count * output_configuration.get_neuron_count(), plain_config);
+
+	{
+		const_layer_tester_plain_smart_ptr tester = single_layer_tester_plain_factory::get_const_instance().get_tester_plain_layer(layer_guid);
+		additional_buffer_smart_ptr input_buffer = get_random_buffer(input_neurons->size(), gen);
+		additional_buffer_set additional_buffers = tester->allocate_additional_buffers(entry_count, layer_schema, input_configuration, output_configuration, plain_config);
+
+		phase_timer timer(min_seconds);
+		while (timer.next())
+			tester->test(input_buffer, additional_buffers, plain_config, layer_schema, data, input_configuration, output_configuration, entry_count);
+		print_result(out, point, "tester_test", timer, static_cast<float>(entry_count) * layer_schema->get_forward_flops(input_configuration));
+	}
+
+	{
+		const_layer_updater_plain_smart_ptr updater = single_layer_updater_plain_factory::get_const_instance().get_updater_plain_layer(layer_guid);
+		updater_additional_buffer_set additional_buffers = updater->allocate_additional_buffers(entry_count, layer_schema, input_configuration, output_configuration, plain_config, true);
+		additional_buffer_smart_ptr input_errors = additional_buffers.input_errors_buffer ? additional_buffers.input_errors_buffer : output_errors;
+		layer_data_list data_list(entry_count, data);
+
+		{
+			phase_timer timer(min_seconds);
+			while (timer.next())
+				updater->test(input_neurons, additional_buffers.output_neurons_buffer, additional_buffers.additional_buffers, plain_config, layer_schema, data_list, input_configuration, output_configuration, entry_count, -1);
+			print_result(out, point, "updater_test", timer, static_cast<float>(entry_count) * layer_schema->get_forward_flops(input_configuration));
+		}
+
+		{
+			phase_timer timer(min_seconds);
+			while (timer.next())
+			{
+				if (input_errors == output_errors)
+				{
+					timer.pause();
+					std::copy(original_output_errors->begin(), original_output_errors->end(), output_errors->begin());
+					timer.resume();
+				}
+				updater->backprop(input_errors, input_neurons, output_errors, additional_buffers.output_neurons_buffer, additional_buffers.additional_buffers, plain_config, layer_schema, data_list, input_configuration, output_configuration, entry_count, output_errors_zero_count);
+			}
+			print_result(out, point, "updater_backprop", timer, static_cast<float>(entry_count) * layer_schema->get_backward_flops(input_configuration));
+		}
+
+		std::copy(original_output_errors->begin(), original_output_errors->end(), output_errors->begin());
+
+		if (!layer_schema->is_empty_data())
+		{
+			layer_data_list single_data_list(1, data);
+			layer_data_list learning_rate_list(1, learning_rate);
+			phase_timer timer(min_seconds);
+			while (timer.next())
+				updater->update_weights(input_neurons, output_errors, additional_buffers.additional_buffers, single_data_list, learning_rate_list, plain_config, layer_schema, input_configuration, output_configuration, 1, entry_count, -1, 0.0F, output_errors_zero_count);
+			print_result(out, point, "updater_update_weights", timer, static_cast<float>(entry_count) * layer_schema->get_weights_update_flops(input_configuration));
+		}
+	}
+
+	{
+		const_layer_hessian_plain_smart_ptr hessian = single_layer_hessian_plain_factory::get_const_instance().get_hessian_plain_layer(layer_guid);
+		hessian_additional_buffer_set additional_buffers = hessian->allocate_additional_buffers(entry_count, layer_schema, input_configuration, output_configuration, plain_config, true);
+		additional_buffer_smart_ptr input_errors = additional_buffers.input_errors_buffer ? additional_buffers.input_errors_buffer : output_errors;
+
+		{
+			phase_timer timer(min_seconds);
+			while (timer.next())
+				hessian->test(input_neurons, additional_buffers.output_neurons_buffer, additional_buffers.additional_buffers, plain_config, layer_schema, data, input_configuration, output_configuration, entry_count);
+			print_result(out, point, "hessian_test", timer, static_cast<float>(entry_count) * layer_schema->get_forward_flops(input_configuration));
+		}
+
+		{
+			phase_timer timer(min_seconds);
+			while (timer.next())
+			{
+				if (input_errors == output_errors)
+				{
+					timer.pause();
+					std::copy(original_output_errors->begin(), original_output_errors->end(), output_errors->begin());
+					timer.resume();
+				}
+				hessian->backprop(input_errors, output_errors, additional_buffers.output_neurons_buffer, additional_buffers.additional_buffers, plain_config, layer_schema, data, input_configuration, output_configuration, entry_count);
+			}
+			print_result(out, point, "hessian_backprop", timer, static_cast<float>(entry_count) * layer_schema->get_backward_flops_2nd(input_configuration));
+		}
+
+		std::copy(original_output_errors->begin(), original_output_errors->end(), output_errors->begin());
+
+		if (!layer_schema->is_empty_data())
+		{
+			phase_timer timer(min_seconds);
+			while (timer.next())
+				hessian->update_hessian(input_neurons, output_errors, additional_buffers.additional_buffers, hessian_data, plain_config, layer_schema, input_configuration, output_configuration, entry_count);
+			print_result(out, point, "hessian_update_hessian", timer, static_cast<float>(entry_count) * layer_schema->get_weights_update_flops_2nd(input_configuration));
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		nnforge::plain::plain::init();
+
+		boost::filesystem::path config_file;
+		std::string layers;
+		std::string input_sizes;
+		std::string feature_map_counts;
+		std::string entry_counts;
+		std::string thread_counts;
+		float min_seconds;
+		boost::filesystem::path output_file;
+
+		std::string default_config_path = argv[0];
+		default_config_path += ".cfg";
+
+		boost::program_options::options_description gener("Generic options");
+		gener.add_options()
+			("help", "produce help message")
+			("config,C", boost::program_options::value<boost::filesystem::path>(&config_file)->default_value(default_config_path), "path to the configuration file.")
+			;
+
+		boost::program_options::options_description config("Configuration");
+		config.add_options()
+			("layers", boost::program_options::value<std::string>(&layers)->default_value(""), "comma separated names of layers to benchmark (empty means all the registered layers).")
+			("input_sizes", boost::program_options::value<std::string>(&input_sizes)->default_value("16,64"), "comma separated widths (and heights) of 2D input.")
+			("feature_map_counts", boost::program_options::value<std::string>(&feature_map_counts)->default_value("4,32"), "comma separated input feature map counts.")
+			("entry_counts", boost::program_options::value<std::string>(&entry_counts)->default_value("1,32"), "comma separated entry counts processed at once.")
+			("thread_counts", boost::program_options::value<std::string>(&thread_counts)->default_value("1,0"), "comma separated OpenMP thread counts (0 means all the hardware threads).")
+			("min_time", boost::program_options::value<float>(&min_seconds)->default_value(0.2F), "minimum time in seconds to repeat each measurement for.")
+			("output,O", boost::program_options::value<boost::filesystem::path>(&output_file)->default_value(""), "CSV file to write results to (empty means standard output).")
+			;
+
+		boost::program_options::options_description cmdline_options;
+		cmdline_options.add(gener).add(config);
+
+		boost::program_options::variables_map vm;
+		boost::program_options::store(boost::program_options::parse_command_line(argc, argv, cmdline_options), vm);
+		boost::program_options::notify(vm);
+
+		if (vm.count("help"))
+		{
+			std::cout << cmdline_options << std::endl;
+			return 0;
+		}
+
+		{
+			boost::filesystem::ifstream in(config_file);
+			if (in)
+			{
+				// The config file generated by the build contains data folders not used by the benchmark
+				boost::program_options::store(boost::program_options::parse_config_file(in, config, true), vm);
+				boost::program_options::notify(vm);
+			}
+		}
+
+		std::vector<boost::uuids::uuid> layer_guid_list = single_layer_factory::get_const_instance().get_layer_guid_list();
+		if (!layers.empty())
+		{
+			std::vector<boost::uuids::uuid> filtered_layer_guid_list;
+			std::string separated_layers = "," + layers + ",";
+			for(std::vector<boost::uuids::uuid>::const_iterator it = layer_guid_list.begin(); it != layer_guid_list.end(); ++it)
+				if (separated_layers.find("," + get_layer_name(*it) + ",") != std::string::npos)
+					filtered_layer_guid_list.push_back(*it);
+			layer_guid_list = filtered_layer_guid_list;
+		}
+
+		std::ofstream out_file;
+		if (!output_file.empty())
+			out_file.open(output_file.string().c_str());
+		std::ostream& out = output_file.empty() ? std::cout : out_file;
+
+		out << "layer,phase,input_size,feature_map_count,entry_count,thread_count,iteration_count,ms_per_iteration,gflops" << std::endl;
+
+		std::vector<unsigned int> input_size_list = parse_list(input_sizes);
+		std::vector<unsigned int> feature_map_count_list = parse_list(feature_map_counts);
+		std::vector<unsigned int> entry_count_list = parse_list(entry_counts);
+		std::vector<unsigned int> thread_count_list = parse_list(thread_counts);
+
+		random_generator gen = rnd::get_random_generator(48576);
+		for(std::vector<boost::uuids::uuid>::const_iterator layer_it = layer_guid_list.begin(); layer_it != layer_guid_list.end(); ++layer_it)
+		{
+			for(std::vector<unsigned int>::const_iterator thread_it = thread_count_list.begin(); thread_it != thread_count_list.end(); ++thread_it)
+			{
+				for(std::vector<unsigned int>::const_iterator size_it = input_size_list.begin(); size_it != input_size_list.end(); ++size_it)
+				{
+					for(std::vector<unsigned int>::const_iterator feature_map_it = feature_map_count_list.begin(); feature_map_it != feature_map_count_list.end(); ++feature_map_it)
+					{
+						for(std::vector<unsigned int>::const_iterator entry_it = entry_count_list.begin(); entry_it != entry_count_list.end(); ++entry_it)
+						{
+							grid_point point;
+							point.layer_name = get_layer_name(*layer_it);
+							point.input_size = *size_it;
+							point.feature_map_count = *feature_map_it;
+							point.entry_count = *entry_it;
+							point.thread_count = static_cast<int>(*thread_it);
+							#ifdef _OPENMP
+							if (point.thread_count == 0)
+								point.thread_count = omp_get_max_threads();
+							#endif
+							if (point.thread_count == 0)
+								point.thread_count = 1;
+
+							try
+							{
+								benchmark_layer(out, point, *layer_it, min_seconds, gen);
+							}
+							catch (const std::exception& e)
+							{
+								// Some layers don't accept the configuration, rgb_to_yuv_convert requires 3 feature maps for example
+								std::cerr << (boost::format("Skipping %1% for input size %2%, %3% feature maps: %4%") % point.layer_name % point.input_size % point.feature_map_count % e.what()) << std::endl;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << "Exception caught: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,133 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "async_job_queue.h"
+
+#include "neural_network_exception.h"
+
+#include <boost/thread.hpp>
+#include <boost/format.hpp>
+#include <deque>
+#include <iostream>
+#include <stdexcept>
+
+namespace nnforge
+{
+	struct async_job_queue_thread_struct
+	{
+		async_job_queue_thread_struct()
+			: stop(false)
+		{
+		}
+
+		boost::mutex m;
+		boost::condition_variable job_cv;
+		boost::condition_variable pop_cv;
+		std::deque<async_job_queue::job_function> jobs;
+		bool stop;
+		boost::thread_group threads;
+	};
+
+	async_job_queue::async_job_queue(
+		unsigned int max_pending_count,
+		const std::string& error_prefix)
+		: max_pending_count(max_pending_count)
+		, error_prefix(error_prefix)
+		, impl(0)
+	{
+		if (max_pending_count == 0)
+			throw neural_network_exception((boost::format("%1%: max pending count should be positive") % error_prefix).str());
+
+		async_job_queue_thread_struct * tst = new async_job_queue_thread_struct();
+		impl = tst;
+		tst->threads.add_thread(new boost::thread(&async_job_queue::run_worker, this));
+	}
+
+	async_job_queue::~async_job_queue()
+	{
+		async_job_queue_thread_struct * tst = static_cast<async_job_queue_thread_struct *>(impl);
+		{
+			boost::lock_guard<boost::mutex> lock(tst->m);
+			tst->stop = true;
+		}
+		tst->job_cv.notify_all();
+		tst->threads.join_all();
+
+		if (!error.empty())
+			std::cerr << error_prefix << ": " << error << std::endl;
+
+		delete tst;
+	}
+
+	void async_job_queue::push(const job_function& job)
+	{
+		async_job_queue_thread_struct * tst = static_cast<async_job_queue_thread_struct *>(impl);
+
+		{
+			boost::unique_lock<boost::mutex> lock(tst->m);
+			while (error.empty() && (tst->jobs.size() >= max_pending_count))
+				tst->pop_cv.wait(lock);
+			if (!error.empty())
+			{
+				std::string err = error;
+				error.clear();
+				throw neural_network_exception((boost::format("%1%: %2%") % error_prefix % err).str());
+			}
+			tst->jobs.push_back(job);
+		}
+		tst->job_cv.notify_one();
+	}
+
+	void async_job_queue::run_worker()
+	{
+		async_job_queue_thread_struct * tst = static_cast<async_job_queue_thread_struct *>(impl);
+
+		while (true)
+		{
+			job_function job;
+			{
+				boost::unique_lock<boost::mutex> lock(tst->m);
+				while ((!tst->stop) && tst->jobs.empty())
+					tst->job_cv.wait(lock);
+				// Pending jobs are completed before stopping
+				if (tst->jobs.empty())
+					return;
+				job = tst->jobs.front();
+				tst->jobs.pop_front();
+			}
+			tst->pop_cv.notify_all();
+
+			std::string err;
+			try
+			{
+				job();
+			}
+			catch (std::exception& e)
+			{
+				err = e.what();
+			}
+
+			if (!err.empty())
+			{
+				{
+					boost::lock_guard<boost::mutex> lock(tst->m);
+					error = err;
+				}
+				tst->pop_cv.notify_all();
+			}
+		}
+	}
+}
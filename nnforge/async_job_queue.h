@@ -0,0 +1,56 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <boost/function.hpp>
+
+namespace nnforge
+{
+	// Runs jobs one by one in the order pushed on a single background thread
+	// push blocks only when max_pending_count jobs are already waiting.
+	// An error of the job is rethrown by the next push, prefixed with error_prefix
+	class async_job_queue
+	{
+	public:
+		typedef boost::function<void ()> job_function;
+
+		async_job_queue(
+			unsigned int max_pending_count,
+			const std::string& error_prefix);
+
+		// Waits for all pending jobs to complete, the error not rethrown yet is written to std::cerr
+		~async_job_queue();
+
+		void push(const job_function& job);
+
+	private:
+		void run_worker();
+
+	private:
+		unsigned int max_pending_count;
+		std::string error_prefix;
+		std::string error;
+
+		void * impl;
+
+	private:
+		async_job_queue();
+		async_job_queue(const async_job_queue&);
+		async_job_queue& operator =(const async_job_queue&);
+	};
+}
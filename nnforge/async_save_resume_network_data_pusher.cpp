@@ -0,0 +1,50 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "async_save_resume_network_data_pusher.h"
+
+#include <boost/bind/bind.hpp>
+
+namespace nnforge
+{
+	async_save_resume_network_data_pusher::async_save_resume_network_data_pusher(
+		const boost::filesystem::path& folder_path,
+		unsigned int max_pending_count,
+		unsigned int epoch_interval,
+		float time_interval)
+		: save_resume_network_data_pusher(folder_path, epoch_interval, time_interval)
+		, jobs(max_pending_count, "Error saving resume data")
+	{
+	}
+
+	async_save_resume_network_data_pusher::~async_save_resume_network_data_pusher()
+	{
+	}
+
+	void async_save_resume_network_data_pusher::push(const training_task_state& task_state)
+	{
+		if (!is_save_required(task_state))
+			return;
+
+		// The trainer keeps updating network data and hessian in place
+		training_task_state job = task_state;
+		job.data = task_state.data->clone();
+		if (task_state.hessian)
+			job.hessian = task_state.hessian->clone();
+
+		jobs.push(boost::bind(&async_save_resume_network_data_pusher::save, this, job));
+	}
+}
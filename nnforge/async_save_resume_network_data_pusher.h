@@ -0,0 +1,43 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include "save_resume_network_data_pusher.h"
+#include "async_job_queue.h"
+
+namespace nnforge
+{
+	// The pusher writes snapshots of network data on a background thread, so training doesn't wait for disk I/O
+	// push blocks only when max_pending_count snapshots are already waiting to be written
+	class async_save_resume_network_data_pusher : public save_resume_network_data_pusher
+	{
+	public:
+		async_save_resume_network_data_pusher(
+			const boost::filesystem::path& folder_path,
+			unsigned int max_pending_count,
+			unsigned int epoch_interval = 1,
+			float time_interval = 0.0F);
+
+		// Waits for all pending snapshots to be written
+		virtual ~async_save_resume_network_data_pusher();
+
+		virtual void push(const training_task_state& task_state);
+
+	private:
+		async_job_queue jobs;
+	};
+}
@@ -0,0 +1,65 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "async_validate_progress_network_data_pusher.h"
+
+#include <boost/bind/bind.hpp>
+#include <sstream>
+#include <iostream>
+
+namespace nnforge
+{
+	async_validate_progress_network_data_pusher::async_validate_progress_network_data_pusher(
+		network_tester_smart_ptr tester,
+		supervised_data_reader_smart_ptr reader,
+		testing_complete_result_set_visualizer_smart_ptr visualizer,
+		const_error_function_smart_ptr ef,
+		unsigned int sample_count,
+		unsigned int max_pending_count)
+		: validate_progress_network_data_pusher(tester, reader, visualizer, ef, sample_count)
+		, jobs(max_pending_count, "Error validating network data")
+	{
+	}
+
+	async_validate_progress_network_data_pusher::~async_validate_progress_network_data_pusher()
+	{
+	}
+
+	void async_validate_progress_network_data_pusher::push(const training_task_state& task_state)
+	{
+		// The trainer keeps updating task_state.data in place
+		jobs.push(boost::bind(
+			&async_validate_progress_network_data_pusher::validate_and_print,
+			this,
+			task_state.data->clone(),
+			task_state.index_peeked,
+			task_state.get_current_epoch()));
+	}
+
+	void async_validate_progress_network_data_pusher::validate_and_print(
+		network_data_smart_ptr data,
+		unsigned int index_peeked,
+		unsigned int epoch)
+	{
+		std::ostringstream out;
+		validate(
+			data,
+			index_peeked,
+			epoch,
+			out);
+		std::cout << out.str() << std::flush;
+	}
+}
@@ -0,0 +1,53 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include "validate_progress_network_data_pusher.h"
+#include "async_job_queue.h"
+
+namespace nnforge
+{
+	// The pusher validates snapshots of network data on a background thread, so training proceeds with the next epoch immediately
+	// Tester and reader are used by the background thread only, they should not be shared with the trainer
+	// push blocks only when max_pending_count snapshots are already waiting for validation
+	class async_validate_progress_network_data_pusher : public validate_progress_network_data_pusher
+	{
+	public:
+		async_validate_progress_network_data_pusher(
+			network_tester_smart_ptr tester,
+			supervised_data_reader_smart_ptr reader,
+			testing_complete_result_set_visualizer_smart_ptr visualizer,
+			const_error_function_smart_ptr ef,
+			unsigned int sample_count,
+			unsigned int max_pending_count);
+
+		// Waits for all pending snapshots to be validated
+		virtual ~async_validate_progress_network_data_pusher();
+
+		virtual void push(const training_task_state& task_state);
+
+	private:
+		// The results are written to std::cout at once not to interleave with the trainer output
+		void validate_and_print(
+			network_data_smart_ptr data,
+			unsigned int index_peeked,
+			unsigned int epoch);
+
+	private:
+		async_job_queue jobs;
+	};
+}
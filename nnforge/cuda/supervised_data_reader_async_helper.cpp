@@ -77,17 +77,7 @@ namespace nnforge
 				unsigned int input_neuron_count = reader->get_input_configuration().get_neuron_count();
 				unsigned int output_neuron_count = reader->get_output_configuration().get_neuron_count();
 				size_t input_neuron_elem_size = reader->get_input_neuron_elem_size();
-				while(entries_read_count < entries_to_read_count)
-				{
-					bool entry_read = reader->read(
-						input + (input_neuron_count * entries_read_count * input_neuron_elem_size),
-						output + (output_neuron_count * entries_read_count));
-
-					if (!entry_read)
-						break;
-
-					entries_read_count++;
-				}
+				entries_read_count = reader->read_batch(entries_to_read_count, input, output);
 				POP_RANGE;
 
 				cuda_safe_call(cudaMemcpyAsync(
@@ -0,0 +1,339 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "data_parallel_network_updater.h"
+
+#include "supervised_sharded_data_reader.h"
+#include "neural_network_exception.h"
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/interprocess_condition.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/format.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <exception>
+#include <algorithm>
+#include <cstring>
+
+namespace nnforge
+{
+	// Barrier residing in shared memory, generation counter distinguishes subsequent waits
+	// Once aborted the barrier makes all the waits fail, the one timing out aborts the barrier for the rest of the workers
+	struct data_parallel_barrier
+	{
+		data_parallel_barrier(unsigned int worker_count)
+			: worker_count(worker_count)
+			, waiting_count(0)
+			, generation(0)
+			, aborted(false)
+		{
+		}
+
+		void wait(unsigned int timeout_seconds)
+		{
+			boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(mutex);
+			if (aborted)
+				throw neural_network_exception("Data parallel training is aborted by another worker");
+
+			unsigned int current_generation = generation;
+			if (++waiting_count == worker_count)
+			{
+				waiting_count = 0;
+				++generation;
+				cv.notify_all();
+				return;
+			}
+
+			boost::posix_time::ptime deadline = boost::posix_time::microsec_clock::universal_time() + boost::posix_time::seconds(timeout_seconds);
+			while ((generation == current_generation) && !aborted)
+			{
+				if (!cv.timed_wait(lock, deadline) && (generation == current_generation) && !aborted)
+				{
+					aborted = true;
+					cv.notify_all();
+					throw neural_network_exception((boost::format("Data parallel workers didn't synchronize within %1% seconds") % timeout_seconds).str());
+				}
+			}
+
+			if (generation == current_generation)
+				throw neural_network_exception("Data parallel training is aborted by another worker");
+		}
+
+		void abort()
+		{
+			boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(mutex);
+			aborted = true;
+			cv.notify_all();
+		}
+
+		boost::interprocess::interprocess_mutex mutex;
+		boost::interprocess::interprocess_condition cv;
+		unsigned int worker_count;
+		unsigned int waiting_count;
+		unsigned int generation;
+		bool aborted;
+	};
+
+	struct data_parallel_segment
+	{
+		boost::interprocess::managed_shared_memory memory;
+		data_parallel_barrier * sync_barrier;
+		// worker_count buffers with weights of each worker
+		float * worker_weights;
+		float * averaged_weights;
+	};
+
+	data_parallel_network_updater::data_parallel_network_updater(
+		network_schema_smart_ptr schema,
+		const_error_function_smart_ptr ef,
+		network_updater_smart_ptr local_updater,
+		const std::string& segment_name,
+		unsigned int worker_id,
+		unsigned int worker_count,
+		unsigned int sync_entry_count,
+		unsigned int sync_timeout_seconds)
+		: network_updater(
+			schema,
+			ef,
+			std::map<unsigned int, float>(),
+			std::map<unsigned int, weight_vector_bound>(),
+			0.0F)
+		, local_updater(local_updater)
+		, segment_name(segment_name)
+		, worker_id(worker_id)
+		, worker_count(worker_count)
+		, sync_entry_count(sync_entry_count)
+		, sync_timeout_seconds(sync_timeout_seconds)
+		, segment(0)
+		, segment_weight_count(0)
+	{
+		if (worker_id >= worker_count)
+			throw neural_network_exception((boost::format("Worker ID %1% should be less than worker count %2%") % worker_id % worker_count).str());
+	}
+
+	data_parallel_network_updater::~data_parallel_network_updater()
+	{
+		if (segment)
+		{
+			// The worker is failing, the others should not wait for it
+			if (std::uncaught_exception())
+				abort();
+
+			delete static_cast<data_parallel_segment *>(segment);
+			// All the workers have attached the segment by the time the first synchronization is complete
+			if (worker_id == 0)
+				boost::interprocess::shared_memory_object::remove(segment_name.c_str());
+		}
+	}
+
+	unsigned int data_parallel_network_updater::get_max_batch_size() const
+	{
+		return local_updater->get_max_batch_size();
+	}
+
+	void data_parallel_network_updater::layer_config_list_modified()
+	{
+		local_updater->set_input_configuration_specific(layer_config_list[0]);
+	}
+
+	std::vector<testing_result_smart_ptr> data_parallel_network_updater::actual_update(
+		supervised_data_reader& reader,
+		const std::vector<network_data_smart_ptr>& learning_rate_vector_list,
+		std::vector<network_data_smart_ptr>& data_list)
+	{
+		attach(get_weight_count(data_list));
+
+		try
+		{
+			return update_and_sync(reader, learning_rate_vector_list, data_list);
+		}
+		catch (...)
+		{
+			abort();
+			throw;
+		}
+	}
+
+	std::vector<testing_result_smart_ptr> data_parallel_network_updater::update_and_sync(
+		supervised_data_reader& reader,
+		const std::vector<network_data_smart_ptr>& learning_rate_vector_list,
+		std::vector<network_data_smart_ptr>& data_list)
+	{
+		broadcast(data_list);
+
+		// All the workers should synchronize the same number of times, thus the number of parts is defined by the largest shard
+		unsigned int shard_entry_count = supervised_sharded_data_reader::get_shard_entry_count(reader.get_entry_count(), worker_id, worker_count);
+		unsigned int max_shard_entry_count = (reader.get_entry_count() + worker_count - 1) / worker_count;
+		unsigned int part_entry_count = (sync_entry_count > 0) ? sync_entry_count : std::max(max_shard_entry_count, 1U);
+		unsigned int part_count = std::max((max_shard_entry_count + part_entry_count - 1) / part_entry_count, 1U);
+
+		std::vector<double> cumulative_error_list(data_list.size(), 0.0);
+		unsigned int entry_processed_count = 0;
+		for(unsigned int part_id = 0; part_id < part_count; ++part_id)
+		{
+			unsigned int part_start = part_id * part_entry_count;
+			unsigned int current_part_entry_count = (part_start < shard_entry_count) ? std::min(part_entry_count, shard_entry_count - part_start) : 0;
+			if (current_part_entry_count > 0)
+			{
+				supervised_sharded_data_reader shard_reader(reader, worker_id, worker_count, part_start, current_part_entry_count);
+				std::vector<testing_result_smart_ptr> part_res = local_updater->update(shard_reader, learning_rate_vector_list, data_list);
+				for(unsigned int i = 0; i < part_res.size(); ++i)
+					cumulative_error_list[i] += static_cast<double>(part_res[i]->get_error()) * part_res[i]->get_entry_count();
+				entry_processed_count += part_res.front()->get_entry_count();
+			}
+
+			average(data_list);
+		}
+
+		// Training errors are reported for the local shard only, the shard might be empty when there are fewer entries than workers
+		std::vector<testing_result_smart_ptr> res;
+		for(unsigned int i = 0; i < data_list.size(); ++i)
+		{
+			testing_result_smart_ptr new_res(new testing_result(ef));
+			new_res->init(cumulative_error_list[i], entry_processed_count);
+			res.push_back(new_res);
+		}
+
+		return res;
+	}
+
+	void data_parallel_network_updater::attach(size_t weight_count)
+	{
+		if (segment)
+		{
+			if (weight_count > segment_weight_count)
+				throw neural_network_exception((boost::format("Data parallel updater is set up for %1% weights while %2% are being trained") % segment_weight_count % weight_count).str());
+			return;
+		}
+
+		size_t segment_size = (worker_count + 1) * weight_count * sizeof(float) + 65536;
+		data_parallel_segment * new_segment = new data_parallel_segment();
+		try
+		{
+			// Workers run concurrently, construction of the named objects is atomic
+			new_segment->memory = boost::interprocess::managed_shared_memory(boost::interprocess::open_or_create, segment_name.c_str(), segment_size);
+			unsigned int * worker_count_found = new_segment->memory.find_or_construct<unsigned int>("worker_count")(worker_count);
+			size_t * weight_count_found = new_segment->memory.find_or_construct<size_t>("weight_count")(weight_count);
+			if ((*worker_count_found != worker_count) || (*weight_count_found != weight_count))
+				throw neural_network_exception((boost::format("Shared memory segment %1% is set up for %2% workers and %3% weights while %4% workers and %5% weights requested, remove the segment left by the previous run")
+					% segment_name % *worker_count_found % *weight_count_found % worker_count % weight_count).str());
+			new_segment->sync_barrier = new_segment->memory.find_or_construct<data_parallel_barrier>("sync_barrier")(worker_count);
+			new_segment->worker_weights = new_segment->memory.find_or_construct<float>("worker_weights")[worker_count * weight_count](0.0F);
+			new_segment->averaged_weights = new_segment->memory.find_or_construct<float>("averaged_weights")[weight_count](0.0F);
+		}
+		catch (const boost::interprocess::interprocess_exception& e)
+		{
+			delete new_segment;
+			throw neural_network_exception((boost::format("Unable to set up shared memory segment %1%: %2%") % segment_name % e.what()).str());
+		}
+		catch (...)
+		{
+			delete new_segment;
+			throw;
+		}
+
+		segment = new_segment;
+		segment_weight_count = weight_count;
+	}
+
+	void data_parallel_network_updater::broadcast(std::vector<network_data_smart_ptr>& data_list)
+	{
+		data_parallel_segment * s = static_cast<data_parallel_segment *>(segment);
+
+		// Other workers might still be reading averaged weights at the end of the previous update
+		sync();
+		if (worker_id == 0)
+			copy_to_buffer(data_list, s->averaged_weights);
+		sync();
+		if (worker_id != 0)
+			copy_from_buffer(data_list, s->averaged_weights);
+		// The next write to averaged weights happens after the barrier in average, each worker has read them by then
+	}
+
+	void data_parallel_network_updater::average(std::vector<network_data_smart_ptr>& data_list)
+	{
+		data_parallel_segment * s = static_cast<data_parallel_segment *>(segment);
+		size_t weight_count = get_weight_count(data_list);
+
+		copy_to_buffer(data_list, s->worker_weights + worker_id * weight_count);
+		sync();
+
+		// Each worker averages its own slice of the weights
+		size_t slice_start = weight_count * worker_id / worker_count;
+		size_t slice_end = weight_count * (worker_id + 1) / worker_count;
+		float mult = 1.0F / static_cast<float>(worker_count);
+		for(size_t i = slice_start; i < slice_end; ++i)
+		{
+			float sum = 0.0F;
+			for(unsigned int w = 0; w < worker_count; ++w)
+				sum += s->worker_weights[w * weight_count + i];
+			s->averaged_weights[i] = sum * mult;
+		}
+		sync();
+
+		copy_from_buffer(data_list, s->averaged_weights);
+	}
+
+	void data_parallel_network_updater::sync()
+	{
+		static_cast<data_parallel_segment *>(segment)->sync_barrier->wait(sync_timeout_seconds);
+	}
+
+	void data_parallel_network_updater::abort()
+	{
+		static_cast<data_parallel_segment *>(segment)->sync_barrier->abort();
+	}
+
+	size_t data_parallel_network_updater::get_weight_count(const std::vector<network_data_smart_ptr>& data_list)
+	{
+		size_t res = 0;
+		for(std::vector<network_data_smart_ptr>::const_iterator it = data_list.begin(); it != data_list.end(); ++it)
+			for(layer_data_list::const_iterator it2 = (*it)->begin(); it2 != (*it)->end(); ++it2)
+				for(layer_data::const_iterator it3 = (*it2)->begin(); it3 != (*it2)->end(); ++it3)
+					res += it3->size();
+
+		return res;
+	}
+
+	void data_parallel_network_updater::copy_to_buffer(
+		const std::vector<network_data_smart_ptr>& data_list,
+		float * buf)
+	{
+		for(std::vector<network_data_smart_ptr>::const_iterator it = data_list.begin(); it != data_list.end(); ++it)
+			for(layer_data_list::const_iterator it2 = (*it)->begin(); it2 != (*it)->end(); ++it2)
+				for(layer_data::const_iterator it3 = (*it2)->begin(); it3 != (*it2)->end(); ++it3)
+				{
+					if (!it3->empty())
+						memcpy(buf, &(*it3->begin()), it3->size() * sizeof(float));
+					buf += it3->size();
+				}
+	}
+
+	void data_parallel_network_updater::copy_from_buffer(
+		std::vector<network_data_smart_ptr>& data_list,
+		const float * buf)
+	{
+		for(std::vector<network_data_smart_ptr>::iterator it = data_list.begin(); it != data_list.end(); ++it)
+			for(layer_data_list::iterator it2 = (*it)->begin(); it2 != (*it)->end(); ++it2)
+				for(layer_data::iterator it3 = (*it2)->begin(); it3 != (*it2)->end(); ++it3)
+				{
+					if (!it3->empty())
+						memcpy(&(*it3->begin()), buf, it3->size() * sizeof(float));
+					buf += it3->size();
+				}
+	}
+}
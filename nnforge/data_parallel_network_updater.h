@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include "network_updater.h"
+#include "nn_types.h"
+
+#include <string>
+#include <vector>
+
+namespace nnforge
+{
+	// Data parallel training across worker processes running on the same machine
+	// Each worker runs this updater on the same training data, the local updater gets a shard of the data,
+	// see supervised_sharded_data_reader. Workers average their weights through the named shared memory segment
+	// every sync_entry_count entries of the shard (0 means once per epoch) and at the end of each epoch.
+	// Weights of worker 0 are copied to all the workers at the start of each epoch, so they start from the same point.
+	// All the workers should be configured identically except for worker_id.
+	// The segment is removed by worker 0 at exit, the one left by the crashed run should be removed manually
+	// The worker failing with an exception aborts the others, they fail when waiting for the rest longer than sync_timeout_seconds as well
+	// ef should be the same as the one local_updater is created with, it is used to report errors of the local shard
+	class data_parallel_network_updater : public network_updater
+	{
+	public:
+		data_parallel_network_updater(
+			network_schema_smart_ptr schema,
+			const_error_function_smart_ptr ef,
+			network_updater_smart_ptr local_updater,
+			const std::string& segment_name,
+			unsigned int worker_id,
+			unsigned int worker_count,
+			unsigned int sync_entry_count,
+			unsigned int sync_timeout_seconds);
+
+		virtual ~data_parallel_network_updater();
+
+		// set_input_configuration_specific should be called prior to this method call for this method to succeed
+		virtual unsigned int get_max_batch_size() const;
+
+	protected:
+		// schema, data and reader are guaranteed to be compatible
+		virtual std::vector<testing_result_smart_ptr> actual_update(
+			supervised_data_reader& reader,
+			const std::vector<network_data_smart_ptr>& learning_rate_vector_list,
+			std::vector<network_data_smart_ptr>& data_list);
+
+		// The method is called when client calls set_input_configuration_specific and the convolution specific configuration is modified.
+		// The layer_config_list is guaranteed to be compatible with schema
+		virtual void layer_config_list_modified();
+
+	private:
+		std::vector<testing_result_smart_ptr> update_and_sync(
+			supervised_data_reader& reader,
+			const std::vector<network_data_smart_ptr>& learning_rate_vector_list,
+			std::vector<network_data_smart_ptr>& data_list);
+
+		void attach(size_t weight_count);
+
+		// Copies weights of worker 0 to all the workers
+		void broadcast(std::vector<network_data_smart_ptr>& data_list);
+
+		void average(std::vector<network_data_smart_ptr>& data_list);
+
+		// Waits for all the workers, throws if the training is aborted or the wait times out
+		void sync();
+
+		// Makes the workers waiting and the ones to wait fail
+		void abort();
+
+		static size_t get_weight_count(const std::vector<network_data_smart_ptr>& data_list);
+
+		static void copy_to_buffer(
+			const std::vector<network_data_smart_ptr>& data_list,
+			float * buf);
+
+		static void copy_from_buffer(
+			std::vector<network_data_smart_ptr>& data_list,
+			const float * buf);
+
+	private:
+		network_updater_smart_ptr local_updater;
+		std::string segment_name;
+		unsigned int worker_id;
+		unsigned int worker_count;
+		unsigned int sync_entry_count;
+		unsigned int sync_timeout_seconds;
+
+		// Shared memory segment with the barrier, weights of each worker and averaged weights, see the .cpp
+		void * segment;
+		size_t segment_weight_count;
+	};
+}
@@ -0,0 +1,216 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "data_reader_prefetch_helper.h"
+
+#include "neural_network_exception.h"
+
+#include <boost/thread.hpp>
+#include <boost/format.hpp>
+#include <cstring>
+#include <algorithm>
+
+namespace nnforge
+{
+	struct prefetch_thread_struct
+	{
+		boost::thread t;
+	};
+
+	data_reader_prefetch_batch::data_reader_prefetch_batch()
+	{
+		clear();
+	}
+
+	void data_reader_prefetch_batch::clear()
+	{
+		entry_count = 0;
+		current_entry_id = 0;
+		end_reached = false;
+	}
+
+	data_reader_prefetch_functor::data_reader_prefetch_functor()
+	{
+	}
+
+	data_reader_prefetch_functor::data_reader_prefetch_functor(
+		unsigned int entries_to_read_count,
+		unsupervised_data_reader * reader,
+		supervised_data_reader * supervised_reader,
+		data_reader_prefetch_batch * batch)
+		: entries_to_read_count(entries_to_read_count)
+		, reader(reader)
+		, supervised_reader(supervised_reader)
+		, batch(batch)
+		, error(0)
+	{
+	}
+
+	void data_reader_prefetch_functor::operator()()
+	{
+		unsigned int entries_read_count = 0;
+		try
+		{
+			if (supervised_reader != 0)
+				entries_read_count = supervised_reader->read_batch(entries_to_read_count, &(*batch->input.begin()), &(*batch->output.begin()));
+			else
+				entries_read_count = reader->read_batch(entries_to_read_count, &(*batch->input.begin()));
+		}
+		// Exceptions cannot leave the thread, the message is rethrown by the helper on the caller's thread
+		catch (const std::exception& e)
+		{
+			*error = e.what();
+		}
+		catch (...)
+		{
+			*error = "Unknown error";
+		}
+
+		batch->entry_count = entries_read_count;
+		batch->current_entry_id = 0;
+		batch->end_reached = (entries_read_count < entries_to_read_count);
+	}
+
+	data_reader_prefetch_helper::data_reader_prefetch_helper(
+		unsupervised_data_reader * reader,
+		supervised_data_reader * supervised_reader,
+		unsigned int prefetch_entry_count)
+		: reader(reader)
+		, supervised_reader(supervised_reader)
+		, prefetch_entry_count(prefetch_entry_count)
+		, current_batch_id(0)
+		, fill_in_progress(false)
+		, impl(0)
+	{
+		if (prefetch_entry_count == 0)
+			throw neural_network_exception("Prefetch entry count should be positive");
+
+		input_entry_size = reader->get_input_configuration().get_neuron_count() * reader->get_input_neuron_elem_size();
+		output_neuron_count = (supervised_reader != 0) ? supervised_reader->get_output_configuration().get_neuron_count() : 0;
+
+		for(unsigned int i = 0; i < 2; ++i)
+		{
+			batches[i].input.resize(input_entry_size * prefetch_entry_count);
+			batches[i].output.resize(std::max(output_neuron_count * prefetch_entry_count, 1U));
+		}
+	}
+
+	data_reader_prefetch_helper::~data_reader_prefetch_helper()
+	{
+		try
+		{
+			stop();
+		}
+		catch (...)
+		{
+		}
+
+		if (impl != 0)
+			delete ((prefetch_thread_struct *)impl);
+	}
+
+	void data_reader_prefetch_helper::start()
+	{
+		error.clear();
+
+		data_reader_prefetch_functor fun(
+			prefetch_entry_count,
+			reader,
+			supervised_reader,
+			&batches[1 - current_batch_id]);
+		fun.error = &error;
+
+		if (impl != 0)
+			delete ((prefetch_thread_struct *)impl);
+
+		prefetch_thread_struct * tst = new prefetch_thread_struct();
+		impl = tst;
+		tst->t = boost::thread(fun);
+		fill_in_progress = true;
+	}
+
+	void data_reader_prefetch_helper::wait()
+	{
+		prefetch_thread_struct * tst = static_cast<prefetch_thread_struct *>(impl);
+		tst->t.join();
+		fill_in_progress = false;
+
+		if (!error.empty())
+			throw neural_network_exception((boost::format("Error prefetching data: %1%") % error).str());
+	}
+
+	bool data_reader_prefetch_helper::read(
+		void * input_elems,
+		float * output_elems)
+	{
+		return (read_batch(1, input_elems, output_elems) == 1);
+	}
+
+	unsigned int data_reader_prefetch_helper::read_batch(
+		unsigned int requested_entry_count,
+		void * input_elems,
+		float * output_elems)
+	{
+		unsigned int entries_read_count = 0;
+		while (true)
+		{
+			data_reader_prefetch_batch& current_batch = batches[current_batch_id];
+			unsigned int entries_to_copy_count = std::min(requested_entry_count - entries_read_count, current_batch.entry_count - current_batch.current_entry_id);
+			if (entries_to_copy_count > 0)
+			{
+				unsigned int entry_id = current_batch.current_entry_id;
+				if (input_elems)
+					memcpy(
+						static_cast<unsigned char *>(input_elems) + (input_entry_size * entries_read_count),
+						&(*current_batch.input.begin()) + (input_entry_size * entry_id),
+						input_entry_size * entries_to_copy_count);
+				if (output_elems)
+					memcpy(
+						output_elems + (output_neuron_count * entries_read_count),
+						&(*current_batch.output.begin()) + (output_neuron_count * entry_id),
+						output_neuron_count * entries_to_copy_count * sizeof(float));
+				current_batch.current_entry_id += entries_to_copy_count;
+				entries_read_count += entries_to_copy_count;
+			}
+
+			if ((entries_read_count == requested_entry_count) || current_batch.end_reached)
+				return entries_read_count;
+
+			if (!fill_in_progress)
+				start();
+			wait();
+
+			current_batch_id = 1 - current_batch_id;
+			if (!batches[current_batch_id].end_reached)
+				start();
+		}
+	}
+
+	void data_reader_prefetch_helper::stop()
+	{
+		if (fill_in_progress)
+		{
+			prefetch_thread_struct * tst = static_cast<prefetch_thread_struct *>(impl);
+			tst->t.join();
+			fill_in_progress = false;
+		}
+
+		batches[0].clear();
+		batches[1].clear();
+		current_batch_id = 0;
+	}
+}
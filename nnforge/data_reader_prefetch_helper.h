@@ -0,0 +1,117 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include "unsupervised_data_reader.h"
+#include "supervised_data_reader.h"
+
+#include <vector>
+#include <string>
+
+namespace nnforge
+{
+	struct data_reader_prefetch_batch
+	{
+		data_reader_prefetch_batch();
+
+		void clear();
+
+		std::vector<unsigned char> input;
+		std::vector<float> output;
+		unsigned int entry_count;
+		unsigned int current_entry_id;
+		bool end_reached;
+	};
+
+	struct data_reader_prefetch_functor
+	{
+		data_reader_prefetch_functor();
+
+		data_reader_prefetch_functor(
+			unsigned int entries_to_read_count,
+			unsupervised_data_reader * reader,
+			supervised_data_reader * supervised_reader,
+			data_reader_prefetch_batch * batch);
+
+		void operator()();
+
+		unsigned int entries_to_read_count;
+		unsupervised_data_reader * reader;
+		supervised_data_reader * supervised_reader;
+		data_reader_prefetch_batch * batch;
+
+		std::string * error;
+	};
+
+	// Reads entries from the reader in batches on a background thread:
+	// the next batch is being filled while entries from the current one are consumed
+	class data_reader_prefetch_helper
+	{
+	public:
+		// supervised_reader should point to the same object as reader for supervised data and be null otherwise
+		data_reader_prefetch_helper(
+			unsupervised_data_reader * reader,
+			supervised_data_reader * supervised_reader,
+			unsigned int prefetch_entry_count);
+
+		~data_reader_prefetch_helper();
+
+		// The method returns true in case entry is read and false if there is no more entries available
+		// If any parameter is null the method just discards corresponding data
+		bool read(
+			void * input_elems,
+			float * output_elems);
+
+		// The method reads up to requested_entry_count entries and returns the number of entries read
+		// Less than requested_entry_count entries are read only if there is no more entries available
+		unsigned int read_batch(
+			unsigned int requested_entry_count,
+			void * input_elems,
+			float * output_elems);
+
+		// Waits for the background read to complete and discards all the entries prefetched
+		// The reader is safe to use directly after the call
+		void stop();
+
+	private:
+		void start();
+
+		// Throws if the background read has failed
+		void wait();
+
+	private:
+		unsupervised_data_reader * reader;
+		supervised_data_reader * supervised_reader;
+		unsigned int prefetch_entry_count;
+		size_t input_entry_size;
+		unsigned int output_neuron_count;
+
+		data_reader_prefetch_batch batches[2];
+		unsigned int current_batch_id;
+		bool fill_in_progress;
+
+		void * impl;
+		std::string error;
+
+	private:
+		data_reader_prefetch_helper(const data_reader_prefetch_helper&);
+		data_reader_prefetch_helper& operator =(const data_reader_prefetch_helper&);
+	};
+
+	typedef nnforge_shared_ptr<data_reader_prefetch_helper> data_reader_prefetch_helper_smart_ptr;
+}
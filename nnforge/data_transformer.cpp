@@ -31,6 +31,22 @@ namespace nnforge
 		return original_config;
 	}
 
+	void data_transformer::transform(
+		const void * data,
+		void * data_transformed,
+		neuron_data_type::input_type type,
+		const layer_configuration_specific& original_config,
+		unsigned int sample_id,
+		random_generator& generator)
+	{
+		transform(data, data_transformed, type, original_config, sample_id);
+	}
+
+	bool data_transformer::is_parallel_transform_supported() const
+	{
+		return false;
+	}
+
 	bool data_transformer::is_in_place() const
 	{
 		return true;
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "layer_configuration_specific.h"
+#include "rnd.h"
 #include "neuron_data_type.h"
 #include "nn_types.h"
 
@@ -34,6 +35,19 @@ namespace nnforge
 			const layer_configuration_specific& original_config,
 			unsigned int sample_id) = 0;
 
+		// The method is called concurrently from multiple threads, each thread supplying its own random generator
+		// Override it in transformers which draw random values, the default implementation calls transform without generator
+		virtual void transform(
+			const void * data,
+			void * data_transformed,
+			neuron_data_type::input_type type,
+			const layer_configuration_specific& original_config,
+			unsigned int sample_id,
+			random_generator& generator);
+
+		// Returns true if the transformer could transform multiple entries concurrently using transform with random generator supplied
+		virtual bool is_parallel_transform_supported() const;
+
 		virtual layer_configuration_specific get_transformed_configuration(const layer_configuration_specific& original_config) const;
 
 		virtual bool is_in_place() const;
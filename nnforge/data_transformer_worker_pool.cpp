@@ -0,0 +1,182 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "data_transformer_worker_pool.h"
+
+#include "neural_network_exception.h"
+
+#include <boost/thread.hpp>
+#include <boost/format.hpp>
+#include <stdexcept>
+
+namespace nnforge
+{
+	struct worker_pool_thread_struct
+	{
+		worker_pool_thread_struct()
+			: generation(0)
+			, pending_worker_count(0)
+			, stop(false)
+		{
+		}
+
+		boost::mutex m;
+		boost::condition_variable start_cv;
+		boost::condition_variable done_cv;
+		unsigned int generation;
+		unsigned int pending_worker_count;
+		bool stop;
+		boost::thread_group threads;
+	};
+
+	data_transformer_worker_pool::data_transformer_worker_pool(
+		unsigned int worker_count,
+		random_generator& seed_generator)
+		: worker_count(worker_count)
+		, current_transformer(0)
+		, current_entry_count(0)
+		, current_data(0)
+		, current_data_entry_size(0)
+		, current_data_transformed(0)
+		, current_data_transformed_entry_size(0)
+		, current_type(neuron_data_type::type_unknown)
+		, current_original_config(0)
+		, impl(0)
+	{
+		if (worker_count == 0)
+			throw neural_network_exception("Worker count for data transformer pool should be positive");
+
+		for(unsigned int worker_id = 0; worker_id < worker_count; ++worker_id)
+			generators.push_back(rnd::get_random_generator(static_cast<unsigned long>(seed_generator())));
+		errors.resize(worker_count);
+
+		worker_pool_thread_struct * tst = new worker_pool_thread_struct();
+		impl = tst;
+		// Worker 0 is run on the calling thread
+		for(unsigned int worker_id = 1; worker_id < worker_count; ++worker_id)
+			tst->threads.add_thread(new boost::thread(&data_transformer_worker_pool::run_worker, this, worker_id));
+	}
+
+	data_transformer_worker_pool::~data_transformer_worker_pool()
+	{
+		worker_pool_thread_struct * tst = static_cast<worker_pool_thread_struct *>(impl);
+		{
+			boost::lock_guard<boost::mutex> lock(tst->m);
+			tst->stop = true;
+		}
+		tst->start_cv.notify_all();
+		tst->threads.join_all();
+
+		delete tst;
+	}
+
+	unsigned int data_transformer_worker_pool::get_worker_count() const
+	{
+		return worker_count;
+	}
+
+	void data_transformer_worker_pool::transform(
+		data_transformer& transformer,
+		unsigned int entry_count,
+		const void * data,
+		size_t data_entry_size,
+		void * data_transformed,
+		size_t data_transformed_entry_size,
+		neuron_data_type::input_type type,
+		const layer_configuration_specific& original_config)
+	{
+		worker_pool_thread_struct * tst = static_cast<worker_pool_thread_struct *>(impl);
+
+		current_transformer = &transformer;
+		current_entry_count = entry_count;
+		current_data = static_cast<const unsigned char *>(data);
+		current_data_entry_size = data_entry_size;
+		current_data_transformed = static_cast<unsigned char *>(data_transformed);
+		current_data_transformed_entry_size = data_transformed_entry_size;
+		current_type = type;
+		current_original_config = &original_config;
+		for(std::vector<std::string>::iterator it = errors.begin(); it != errors.end(); ++it)
+			it->clear();
+
+		{
+			boost::lock_guard<boost::mutex> lock(tst->m);
+			tst->pending_worker_count = worker_count - 1;
+			tst->generation++;
+		}
+		tst->start_cv.notify_all();
+
+		transform_worker_entries(0);
+
+		{
+			boost::unique_lock<boost::mutex> lock(tst->m);
+			while (tst->pending_worker_count > 0)
+				tst->done_cv.wait(lock);
+		}
+
+		for(std::vector<std::string>::const_iterator it = errors.begin(); it != errors.end(); ++it)
+			if (!it->empty())
+				throw neural_network_exception((boost::format("Error transforming data: %1%") % *it).str());
+	}
+
+	void data_transformer_worker_pool::run_worker(unsigned int worker_id)
+	{
+		worker_pool_thread_struct * tst = static_cast<worker_pool_thread_struct *>(impl);
+
+		unsigned int processed_generation = 0;
+		while (true)
+		{
+			{
+				boost::unique_lock<boost::mutex> lock(tst->m);
+				while ((!tst->stop) && (tst->generation == processed_generation))
+					tst->start_cv.wait(lock);
+				if (tst->stop)
+					return;
+				processed_generation = tst->generation;
+			}
+
+			transform_worker_entries(worker_id);
+
+			{
+				boost::lock_guard<boost::mutex> lock(tst->m);
+				tst->pending_worker_count--;
+			}
+			tst->done_cv.notify_one();
+		}
+	}
+
+	void data_transformer_worker_pool::transform_worker_entries(unsigned int worker_id)
+	{
+		try
+		{
+			random_generator& generator = generators[worker_id];
+			for(unsigned int entry_id = worker_id; entry_id < current_entry_count; entry_id += worker_count)
+			{
+				current_transformer->transform(
+					(current_data != 0) ? current_data + (current_data_entry_size * entry_id) : 0,
+					current_data_transformed + (current_data_transformed_entry_size * entry_id),
+					current_type,
+					*current_original_config,
+					0,
+					generator);
+			}
+		}
+		catch (std::exception& e)
+		{
+			errors[worker_id] = e.what();
+		}
+	}
+}
@@ -0,0 +1,84 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include "data_transformer.h"
+#include "layer_configuration_specific.h"
+#include "neuron_data_type.h"
+#include "rnd.h"
+#include "nn_types.h"
+
+#include <vector>
+#include <string>
+
+namespace nnforge
+{
+	// The pool transforms batches of entries on persistent worker threads
+	// Entry i of the batch is always processed by worker (i % worker_count) with the worker's own random generator,
+	// thus the result doesn't depend on threads scheduling
+	class data_transformer_worker_pool
+	{
+	public:
+		// Worker generators are seeded with values drawn from seed_generator
+		data_transformer_worker_pool(
+			unsigned int worker_count,
+			random_generator& seed_generator);
+
+		~data_transformer_worker_pool();
+
+		// data might be null for in-place transformers
+		void transform(
+			data_transformer& transformer,
+			unsigned int entry_count,
+			const void * data,
+			size_t data_entry_size,
+			void * data_transformed,
+			size_t data_transformed_entry_size,
+			neuron_data_type::input_type type,
+			const layer_configuration_specific& original_config);
+
+		unsigned int get_worker_count() const;
+
+	private:
+		void run_worker(unsigned int worker_id);
+
+		void transform_worker_entries(unsigned int worker_id);
+
+	private:
+		unsigned int worker_count;
+		std::vector<random_generator> generators;
+		std::vector<std::string> errors;
+
+		data_transformer * current_transformer;
+		unsigned int current_entry_count;
+		const unsigned char * current_data;
+		size_t current_data_entry_size;
+		unsigned char * current_data_transformed;
+		size_t current_data_transformed_entry_size;
+		neuron_data_type::input_type current_type;
+		const layer_configuration_specific * current_original_config;
+
+		void * impl;
+
+	private:
+		data_transformer_worker_pool(const data_transformer_worker_pool&);
+		data_transformer_worker_pool& operator =(const data_transformer_worker_pool&);
+	};
+
+	typedef nnforge_shared_ptr<data_transformer_worker_pool> data_transformer_worker_pool_smart_ptr;
+}
@@ -44,6 +44,16 @@ namespace nnforge
 			neuron_data_type::input_type type,
 			const layer_configuration_specific& original_config,
 			unsigned int sample_id);
+
+		virtual void transform(
+			const void * data,
+			void * data_transformed,
+			neuron_data_type::input_type type,
+			const layer_configuration_specific& original_config,
+			unsigned int sample_id,
+			random_generator& generator);
+
+		virtual bool is_parallel_transform_supported() const;
 			
 	protected:
 		random_generator generator;
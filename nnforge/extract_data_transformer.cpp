@@ -39,6 +39,11 @@ namespace nnforge
 	{
 	}
 
+	bool extract_data_transformer::is_parallel_transform_supported() const
+	{
+		return true;
+	}
+
 	void extract_data_transformer::transform(
 		const void * data,
 		void * data_transformed,
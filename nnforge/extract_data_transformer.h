@@ -38,6 +38,8 @@ namespace nnforge
 			const layer_configuration_specific& original_config,
 			unsigned int sample_id);
 
+		virtual bool is_parallel_transform_supported() const;
+
 		virtual layer_configuration_specific get_transformed_configuration(const layer_configuration_specific& original_config) const;
 
 		virtual bool is_in_place() const;
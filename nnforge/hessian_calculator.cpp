@@ -58,6 +58,38 @@ namespace nnforge
 			hessian_entry_to_process_count);
 	}
 
+	std::vector<network_data_smart_ptr> hessian_calculator::get_hessian(
+		unsupervised_data_reader& reader,
+		const std::vector<network_data_smart_ptr>& data_list,
+		unsigned int hessian_entry_to_process_count)
+	{
+		if (data_list.empty())
+			throw neural_network_exception("Empty network data list");
+
+		set_input_configuration_specific(reader.get_input_configuration());
+
+		// Check data-schema consistency
+		for(std::vector<network_data_smart_ptr>::const_iterator it = data_list.begin(); it != data_list.end(); ++it)
+			(*it)->check_network_data_consistency(*schema);
+
+		return actual_get_hessian(
+			reader,
+			data_list,
+			hessian_entry_to_process_count);
+	}
+
+	std::vector<network_data_smart_ptr> hessian_calculator::actual_get_hessian(
+		unsupervised_data_reader& reader,
+		const std::vector<network_data_smart_ptr>& data_list,
+		unsigned int hessian_entry_to_process_count)
+	{
+		std::vector<network_data_smart_ptr> res;
+		for(std::vector<network_data_smart_ptr>::const_iterator it = data_list.begin(); it != data_list.end(); ++it)
+			res.push_back(actual_get_hessian(reader, *it, hessian_entry_to_process_count));
+
+		return res;
+	}
+
 	void hessian_calculator::update_flops()
 	{
 		flops = 0.0F;
@@ -83,4 +115,17 @@ namespace nnforge
 	{
 		return flops;
 	}
+
+	void hessian_calculator::set_profiling(bool enabled)
+	{
+		if (enabled)
+			profiling = profiling_result_smart_ptr(new profiling_result(static_cast<unsigned int>(schema->get_layers().size())));
+		else
+			profiling.reset();
+	}
+
+	profiling_result_smart_ptr hessian_calculator::get_profiling_result() const
+	{
+		return profiling;
+	}
 }
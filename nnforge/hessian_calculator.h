@@ -20,6 +20,7 @@
 #include "network_data.h"
 #include "layer_configuration_specific.h"
 #include "supervised_data_reader.h"
+#include "profiling_result.h"
 #include "nn_types.h"
 
 namespace nnforge
@@ -37,9 +38,21 @@ namespace nnforge
 			network_data_smart_ptr data,
 			unsigned int hessian_entry_to_process_count);
 
+		// Calculates hessians for all the networks from data_list reading the data once
+		std::vector<network_data_smart_ptr> get_hessian(
+			unsupervised_data_reader& reader,
+			const std::vector<network_data_smart_ptr>& data_list,
+			unsigned int hessian_entry_to_process_count);
+
 		// set_input_configuration_specific should be called prior to this method call for this method to succeed
 		float get_flops_for_single_entry() const;
 
+		// Per-layer timings are collected on subsequent runs while enabled, backends not supporting it leave the result empty
+		void set_profiling(bool enabled);
+
+		// Returns timings accumulated since profiling was enabled, empty pointer when it is disabled
+		profiling_result_smart_ptr get_profiling_result() const;
+
 	protected:
 		hessian_calculator(network_schema_smart_ptr schema);
 
@@ -49,6 +62,13 @@ namespace nnforge
 			network_data_smart_ptr data,
 			unsigned int hessian_entry_to_process_count) = 0;
 
+		// schema, data and reader are guaranteed to be compatible
+		// The default implementation runs actual_get_hessian for each network separately
+		virtual std::vector<network_data_smart_ptr> actual_get_hessian(
+			unsupervised_data_reader& reader,
+			const std::vector<network_data_smart_ptr>& data_list,
+			unsigned int hessian_entry_to_process_count);
+
 		// The method is called when client calls set_input_configuration_specific and the convolution specific configuration is modified.
 		// The layer_config_list is guaranteed to be compatible with schema
 		virtual void layer_config_list_modified() = 0;
@@ -59,6 +79,7 @@ namespace nnforge
 		network_schema_smart_ptr schema;
 		layer_configuration_specific_list layer_config_list;
 		float flops;
+		profiling_result_smart_ptr profiling;
 
 	private:
 		hessian_calculator();
@@ -44,6 +44,22 @@ namespace nnforge
 		neuron_data_type::input_type type,
 		const layer_configuration_specific& original_config,
 		unsigned int sample_id)
+	{
+		transform(data, data_transformed, type, original_config, sample_id, generator);
+	}
+
+	bool intensity_2d_data_transformer::is_parallel_transform_supported() const
+	{
+		return true;
+	}
+
+	void intensity_2d_data_transformer::transform(
+		const void * data,
+		void * data_transformed,
+		neuron_data_type::input_type type,
+		const layer_configuration_specific& original_config,
+		unsigned int sample_id,
+		random_generator& generator)
 	{
 		if (type != neuron_data_type::type_byte)
 			throw neural_network_exception("intensity_2d_data_transformer is implemented for data stored as bytes only");
@@ -59,6 +59,20 @@ namespace nnforge
 		}
 	}
 
+	void layer::check_layer_data_consistency(const std::vector<unsigned int>& part_size_list) const
+	{
+		data_config dc = get_data_config();
+
+		if (dc.size() != part_size_list.size())
+			throw neural_network_exception((boost::format("data weight vector count %1% doesn't satisfy layer configuration %2%") % part_size_list.size() % dc.size()).str());
+
+		for(unsigned int i = 0; i < dc.size(); ++i)
+		{
+			if (dc[i] != part_size_list[i])
+				throw neural_network_exception((boost::format("data weight count %1% for vector %2% doesn't satisfy layer configuration %3%") % part_size_list[i] % i % dc[i]).str());
+		}
+	}
+
 	void layer::randomize_data(
 		layer_data& data,
 		random_generator& generator) const
@@ -75,6 +75,9 @@ namespace nnforge
 		// The method throws exception in case the data is not suitable for the layer
 		void check_layer_data_consistency(const layer_data& data) const;
 
+		// The method throws exception in case weight counts of data vectors are not suitable for the layer
+		void check_layer_data_consistency(const std::vector<unsigned int>& part_size_list) const;
+
 		// Override this member function to randomize data
 		virtual void randomize_data(
 			layer_data& data,
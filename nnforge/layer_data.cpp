@@ -24,7 +24,13 @@ namespace nnforge
 	{
 	}
 
-	void layer_data::write(std::ostream& binary_stream_to_write_to) const
+	layer_data::~layer_data()
+	{
+	}
+
+	void layer_data::write(
+		std::ostream& binary_stream_to_write_to,
+		weight_storage_type::storage_type storage) const
 	{
 		unsigned int weight_vector_count = static_cast<unsigned int>(size());
 		binary_stream_to_write_to.write(reinterpret_cast<const char*>(&weight_vector_count), sizeof(weight_vector_count));
@@ -34,11 +40,20 @@ namespace nnforge
 			unsigned int weight_count = static_cast<unsigned int>(at(i).size());
 			binary_stream_to_write_to.write(reinterpret_cast<const char*>(&weight_count), sizeof(weight_count));
 
-			binary_stream_to_write_to.write(reinterpret_cast<const char*>(&(*at(i).begin())), sizeof(float) * weight_count);
+			if (storage == weight_storage_type::type_float)
+				binary_stream_to_write_to.write(reinterpret_cast<const char*>(&(*at(i).begin())), sizeof(float) * weight_count);
+			else if (weight_count > 0)
+			{
+				std::vector<unsigned short> packed(weight_count);
+				weight_storage_type::narrow(storage, &(*at(i).begin()), &(*packed.begin()), weight_count);
+				binary_stream_to_write_to.write(reinterpret_cast<const char*>(&(*packed.begin())), sizeof(unsigned short) * weight_count);
+			}
 		}
 	}
 
-	void layer_data::read(std::istream& binary_stream_to_read_from)
+	void layer_data::read(
+		std::istream& binary_stream_to_read_from,
+		weight_storage_type::storage_type storage)
 	{
 		unsigned int weight_vector_count;
 		binary_stream_to_read_from.read(reinterpret_cast<char*>(&weight_vector_count), sizeof(weight_vector_count));
@@ -51,7 +66,14 @@ namespace nnforge
 
 			at(i).resize(weight_count);
 
-			binary_stream_to_read_from.read(reinterpret_cast<char*>(&(*at(i).begin())), sizeof(float) * weight_count);
+			if (storage == weight_storage_type::type_float)
+				binary_stream_to_read_from.read(reinterpret_cast<char*>(&(*at(i).begin())), sizeof(float) * weight_count);
+			else if (weight_count > 0)
+			{
+				std::vector<unsigned short> packed(weight_count);
+				binary_stream_to_read_from.read(reinterpret_cast<char*>(&(*packed.begin())), sizeof(unsigned short) * weight_count);
+				weight_storage_type::widen(storage, &(*packed.begin()), &(*at(i).begin()), weight_count);
+			}
 		}
 	}
 
@@ -19,6 +19,7 @@
 #include "dropout_layer_config.h"
 #include "nn_types.h"
 #include "rnd.h"
+#include "weight_storage_type.h"
 
 #include <vector>
 #include <ostream>
@@ -31,11 +32,18 @@ namespace nnforge
 	public:
 		layer_data();
 
+		virtual ~layer_data();
+
 		// The stream should be created with std::ios_base::binary flag
-		void write(std::ostream& binary_stream_to_write_to) const;
+		void write(
+			std::ostream& binary_stream_to_write_to,
+			weight_storage_type::storage_type storage = weight_storage_type::type_float) const;
 
 		// The stream should be created with std::ios_base::binary flag
-		void read(std::istream& binary_stream_to_read_from);
+		// Weights stored with reduced precision are widened to float
+		void read(
+			std::istream& binary_stream_to_read_from,
+			weight_storage_type::storage_type storage = weight_storage_type::type_float);
 
 		bool is_empty() const;
 
@@ -41,4 +41,13 @@ namespace nnforge
 
 		return i->second->clone();
 	}
+
+	std::vector<boost::uuids::uuid> layer_factory::get_layer_guid_list() const
+	{
+		std::vector<boost::uuids::uuid> res;
+		for(sample_map::const_iterator it = sample_layer_map.begin(); it != sample_layer_map.end(); ++it)
+			res.push_back(it->first);
+
+		return res;
+	}
 }
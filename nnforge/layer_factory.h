@@ -19,6 +19,7 @@
 #include "layer.h"
 
 #include <map>
+#include <vector>
 #include <boost/uuid/uuid.hpp>
 #include <boost/serialization/singleton.hpp>
 
@@ -33,6 +34,8 @@ namespace nnforge
 
 		layer_smart_ptr create_layer(const boost::uuids::uuid& layer_guid) const;
 
+		std::vector<boost::uuids::uuid> get_layer_guid_list() const;
+
 	private:
 		typedef std::map<boost::uuids::uuid, layer_smart_ptr> sample_map;
 		sample_map sample_layer_map;
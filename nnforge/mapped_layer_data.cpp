@@ -0,0 +1,50 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "mapped_layer_data.h"
+
+namespace nnforge
+{
+	mapped_layer_data::mapped_layer_data(
+		const std::vector<const float *>& part_list,
+		const std::vector<unsigned int>& part_size_list,
+		nnforge_shared_ptr<const void> mapping_holder)
+		: part_list(part_list)
+		, part_size_list(part_size_list)
+		, mapping_holder(mapping_holder)
+	{
+		resize(part_list.size());
+	}
+
+	layer_data_smart_ptr mapped_layer_data::copy() const
+	{
+		layer_data_smart_ptr res(new layer_data());
+		res->resize(part_list.size());
+		for(unsigned int part_id = 0; part_id < part_list.size(); ++part_id)
+			(*res)[part_id].assign(part_list[part_id], part_list[part_id] + part_size_list[part_id]);
+
+		return res;
+	}
+
+	size_t mapped_layer_data::get_mapped_size() const
+	{
+		size_t res = 0;
+		for(std::vector<unsigned int>::const_iterator it = part_size_list.begin(); it != part_size_list.end(); ++it)
+			res += *it * sizeof(float);
+
+		return res;
+	}
+}
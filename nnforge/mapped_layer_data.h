@@ -0,0 +1,51 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include "layer_data.h"
+#include "nn_types.h"
+
+#include <vector>
+
+namespace nnforge
+{
+	// Layer data with weights residing in memory mapped file, the float vectors are empty
+	// The mapping is kept alive as long as the data exists
+	class mapped_layer_data : public layer_data
+	{
+	public:
+		mapped_layer_data(
+			const std::vector<const float *>& part_list,
+			const std::vector<unsigned int>& part_size_list,
+			nnforge_shared_ptr<const void> mapping_holder);
+
+		// Returns regular layer data with the weights copied
+		nnforge_shared_ptr<layer_data> copy() const;
+
+		size_t get_mapped_size() const;
+
+	public:
+		std::vector<const float *> part_list;
+		std::vector<unsigned int> part_size_list;
+
+	private:
+		nnforge_shared_ptr<const void> mapping_holder;
+	};
+
+	typedef nnforge_shared_ptr<mapped_layer_data> mapped_layer_data_smart_ptr;
+	typedef nnforge_shared_ptr<const mapped_layer_data> const_mapped_layer_data_smart_ptr;
+}
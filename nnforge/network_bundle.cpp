@@ -0,0 +1,257 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "network_bundle.h"
+
+#include "mapped_layer_data.h"
+#include "neural_network_exception.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/streams/bufferstream.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/uuid/uuid_io.hpp>
+#include <boost/format.hpp>
+#include <sstream>
+#include <algorithm>
+
+namespace nnforge
+{
+	// {E2A6FF43-D1BD-4C79-9F69-C570444E95D5}
+	const boost::uuids::uuid network_bundle::bundle_guid =
+	{ 0xe2, 0xa6, 0xff, 0x43
+	, 0xd1, 0xbd
+	, 0x4c, 0x79
+	, 0x9f, 0x69
+	, 0xc5, 0x70, 0x44, 0x4e, 0x95, 0xd5 };
+
+	const size_t network_bundle::alignment = 64;
+
+	// Layout:
+	// header: guid, layer count, schema size, input normalizer size (0 if absent), reserved,
+	//         schema offset, input normalizer offset, layer table offset
+	// schema, input normalizer, layer table: for each layer part count followed by (elem count, offset) pair for each part
+	// weights
+	// Each section and each weight vector starts at alignment boundary
+	network_bundle::network_bundle(const boost::filesystem::path& file_path)
+		: file_path(file_path)
+	{
+		{
+			boost::interprocess::file_mapping mapping(file_path.string().c_str(), boost::interprocess::read_only);
+			region = nnforge_shared_ptr<const boost::interprocess::mapped_region>(new boost::interprocess::mapped_region(mapping, boost::interprocess::read_only));
+		}
+		region_begin = static_cast<const char *>(region->get_address());
+		region_size = region->get_size();
+
+		boost::interprocess::ibufferstream in_stream(region_begin, region_size, std::ios_base::in | std::ios_base::binary);
+		in_stream.exceptions(std::ostream::eofbit | std::ostream::failbit | std::ostream::badbit);
+
+		boost::uuids::uuid guid_read;
+		in_stream.read(reinterpret_cast<char*>(guid_read.data), sizeof(guid_read.data));
+		if (guid_read != bundle_guid)
+			throw neural_network_exception((boost::format("Unknown network bundle GUID encountered in %1%: %2%") % file_path.string() % guid_read).str());
+
+		unsigned int layer_count;
+		in_stream.read(reinterpret_cast<char*>(&layer_count), sizeof(layer_count));
+		in_stream.read(reinterpret_cast<char*>(&schema_size), sizeof(schema_size));
+		in_stream.read(reinterpret_cast<char*>(&input_normalizer_size), sizeof(input_normalizer_size));
+		unsigned int reserved;
+		in_stream.read(reinterpret_cast<char*>(&reserved), sizeof(reserved));
+		in_stream.read(reinterpret_cast<char*>(&schema_offset), sizeof(schema_offset));
+		in_stream.read(reinterpret_cast<char*>(&input_normalizer_offset), sizeof(input_normalizer_offset));
+		unsigned long long layer_table_offset;
+		in_stream.read(reinterpret_cast<char*>(&layer_table_offset), sizeof(layer_table_offset));
+
+		if ((schema_offset + schema_size > region_size) || (input_normalizer_offset + input_normalizer_size > region_size) || (layer_table_offset > region_size))
+			throw neural_network_exception((boost::format("Network bundle %1% is truncated") % file_path.string()).str());
+
+		in_stream.seekg(static_cast<std::streamoff>(layer_table_offset));
+		layer_part_info_list.resize(layer_count);
+		for(std::vector<std::vector<part_info> >::iterator it = layer_part_info_list.begin(); it != layer_part_info_list.end(); ++it)
+		{
+			unsigned int part_count;
+			in_stream.read(reinterpret_cast<char*>(&part_count), sizeof(part_count));
+			it->resize(part_count);
+			for(std::vector<part_info>::iterator it2 = it->begin(); it2 != it->end(); ++it2)
+			{
+				in_stream.read(reinterpret_cast<char*>(&it2->elem_count), sizeof(it2->elem_count));
+				in_stream.read(reinterpret_cast<char*>(&it2->offset), sizeof(it2->offset));
+				if (it2->offset + it2->elem_count * sizeof(float) > region_size)
+					throw neural_network_exception((boost::format("Network bundle %1% is truncated") % file_path.string()).str());
+				if (it2->offset % alignment != 0)
+					throw neural_network_exception((boost::format("Weights in network bundle %1% are not aligned to %2% bytes") % file_path.string() % alignment).str());
+			}
+		}
+	}
+
+	network_bundle::~network_bundle()
+	{
+	}
+
+	network_schema_smart_ptr network_bundle::get_schema() const
+	{
+		network_schema_smart_ptr res(new network_schema());
+		boost::interprocess::ibufferstream in_stream(region_begin + schema_offset, schema_size, std::ios_base::in | std::ios_base::binary);
+		res->read(in_stream);
+
+		return res;
+	}
+
+	normalize_data_transformer_smart_ptr network_bundle::get_input_normalizer() const
+	{
+		if (input_normalizer_size == 0)
+			return normalize_data_transformer_smart_ptr();
+
+		normalize_data_transformer_smart_ptr res(new normalize_data_transformer());
+		boost::interprocess::ibufferstream in_stream(region_begin + input_normalizer_offset, input_normalizer_size, std::ios_base::in | std::ios_base::binary);
+		res->read(in_stream);
+
+		return res;
+	}
+
+	network_data_smart_ptr network_bundle::get_data() const
+	{
+		network_data_smart_ptr res(new network_data());
+		for(std::vector<std::vector<part_info> >::const_iterator it = layer_part_info_list.begin(); it != layer_part_info_list.end(); ++it)
+		{
+			std::vector<const float *> part_list;
+			std::vector<unsigned int> part_size_list;
+			unsigned int total_elem_count = 0;
+			for(std::vector<part_info>::const_iterator it2 = it->begin(); it2 != it->end(); ++it2)
+			{
+				part_list.push_back(reinterpret_cast<const float *>(region_begin + it2->offset));
+				part_size_list.push_back(it2->elem_count);
+				total_elem_count += it2->elem_count;
+			}
+
+			if (total_elem_count > 0)
+			{
+				res->push_back(layer_data_smart_ptr(new mapped_layer_data(part_list, part_size_list, region)));
+			}
+			else
+			{
+				layer_data_smart_ptr data(new layer_data());
+				data->resize(part_list.size());
+				res->push_back(data);
+			}
+		}
+
+		return res;
+	}
+
+	void network_bundle::write(
+		const boost::filesystem::path& file_path,
+		const network_schema& schema,
+		const network_data& data,
+		normalize_data_transformer_smart_ptr input_normalizer)
+	{
+		std::ostringstream schema_stream(std::ios_base::out | std::ios_base::binary);
+		schema.write(schema_stream);
+		std::string schema_buf = schema_stream.str();
+
+		std::string input_normalizer_buf;
+		if (input_normalizer)
+		{
+			std::ostringstream input_normalizer_stream(std::ios_base::out | std::ios_base::binary);
+			input_normalizer->write(input_normalizer_stream);
+			input_normalizer_buf = input_normalizer_stream.str();
+		}
+
+		// Data mapped from another bundle is copied to access all the weights through layer_data
+		std::vector<const_layer_data_smart_ptr> source_data_list;
+		for(layer_data_list::const_iterator it = data.begin(); it != data.end(); ++it)
+		{
+			const_mapped_layer_data_smart_ptr mapped_data = nnforge_dynamic_pointer_cast<const mapped_layer_data>(*it);
+			source_data_list.push_back(mapped_data ? mapped_data->copy() : *it);
+		}
+
+		const size_t header_size = sizeof(bundle_guid.data) + 4 * sizeof(unsigned int) + 3 * sizeof(unsigned long long);
+		const unsigned long long schema_offset = get_aligned(header_size);
+		const unsigned long long input_normalizer_offset = get_aligned(schema_offset + schema_buf.size());
+		const unsigned long long layer_table_offset = get_aligned(input_normalizer_offset + input_normalizer_buf.size());
+		size_t layer_table_size = 0;
+		for(std::vector<const_layer_data_smart_ptr>::const_iterator it = source_data_list.begin(); it != source_data_list.end(); ++it)
+			layer_table_size += sizeof(unsigned int) + (*it)->size() * (sizeof(unsigned int) + sizeof(unsigned long long));
+		size_t weights_offset = get_aligned(layer_table_offset + layer_table_size);
+
+		boost::filesystem::ofstream out(file_path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+		out.exceptions(std::ostream::eofbit | std::ostream::failbit | std::ostream::badbit);
+
+		out.write(reinterpret_cast<const char*>(bundle_guid.data), sizeof(bundle_guid.data));
+		unsigned int layer_count = static_cast<unsigned int>(source_data_list.size());
+		out.write(reinterpret_cast<const char*>(&layer_count), sizeof(layer_count));
+		unsigned int schema_size = static_cast<unsigned int>(schema_buf.size());
+		out.write(reinterpret_cast<const char*>(&schema_size), sizeof(schema_size));
+		unsigned int input_normalizer_size = static_cast<unsigned int>(input_normalizer_buf.size());
+		out.write(reinterpret_cast<const char*>(&input_normalizer_size), sizeof(input_normalizer_size));
+		unsigned int reserved = 0;
+		out.write(reinterpret_cast<const char*>(&reserved), sizeof(reserved));
+		out.write(reinterpret_cast<const char*>(&schema_offset), sizeof(schema_offset));
+		out.write(reinterpret_cast<const char*>(&input_normalizer_offset), sizeof(input_normalizer_offset));
+		out.write(reinterpret_cast<const char*>(&layer_table_offset), sizeof(layer_table_offset));
+
+		write_padding(out, header_size, schema_offset);
+		out.write(schema_buf.data(), schema_buf.size());
+		write_padding(out, schema_offset + schema_buf.size(), input_normalizer_offset);
+		out.write(input_normalizer_buf.data(), input_normalizer_buf.size());
+		write_padding(out, input_normalizer_offset + input_normalizer_buf.size(), layer_table_offset);
+
+		size_t current_weights_offset = weights_offset;
+		for(std::vector<const_layer_data_smart_ptr>::const_iterator it = source_data_list.begin(); it != source_data_list.end(); ++it)
+		{
+			unsigned int part_count = static_cast<unsigned int>((*it)->size());
+			out.write(reinterpret_cast<const char*>(&part_count), sizeof(part_count));
+			for(layer_data::const_iterator it2 = (*it)->begin(); it2 != (*it)->end(); ++it2)
+			{
+				unsigned int elem_count = static_cast<unsigned int>(it2->size());
+				unsigned long long offset = current_weights_offset;
+				out.write(reinterpret_cast<const char*>(&elem_count), sizeof(elem_count));
+				out.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+				current_weights_offset = get_aligned(current_weights_offset + it2->size() * sizeof(float));
+			}
+		}
+		write_padding(out, layer_table_offset + layer_table_size, weights_offset);
+
+		current_weights_offset = weights_offset;
+		for(std::vector<const_layer_data_smart_ptr>::const_iterator it = source_data_list.begin(); it != source_data_list.end(); ++it)
+		{
+			for(layer_data::const_iterator it2 = (*it)->begin(); it2 != (*it)->end(); ++it2)
+			{
+				if (!it2->empty())
+					out.write(reinterpret_cast<const char*>(&(*it2->begin())), it2->size() * sizeof(float));
+				size_t next_weights_offset = get_aligned(current_weights_offset + it2->size() * sizeof(float));
+				write_padding(out, current_weights_offset + it2->size() * sizeof(float), next_weights_offset);
+				current_weights_offset = next_weights_offset;
+			}
+		}
+
+		out.flush();
+	}
+
+	size_t network_bundle::get_aligned(size_t offset)
+	{
+		return (offset + alignment - 1) / alignment * alignment;
+	}
+
+	void network_bundle::write_padding(
+		std::ostream& binary_stream_to_write_to,
+		size_t current_offset,
+		size_t target_offset)
+	{
+		static const char zeros[64] = {0};
+		for(size_t offset = current_offset; offset < target_offset; offset += sizeof(zeros))
+			binary_stream_to_write_to.write(zeros, std::min(sizeof(zeros), target_offset - offset));
+	}
+}
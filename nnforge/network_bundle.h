@@ -0,0 +1,93 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include "network_schema.h"
+#include "network_data.h"
+#include "normalize_data_transformer.h"
+#include "nn_types.h"
+
+#include <vector>
+#include <ostream>
+#include <boost/filesystem.hpp>
+#include <boost/uuid/uuid.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace nnforge
+{
+	// Single file containing schema, data and optional input normalizer of the trained network
+	// Each weight vector starts at 64-byte boundary, the file is mapped to memory and the weights are used in place,
+	// thus processes loading the same bundle share its pages in the page cache
+	class network_bundle
+	{
+	public:
+		// Maps the file to memory read-only and validates its layout, neither schema nor weights are copied
+		network_bundle(const boost::filesystem::path& file_path);
+
+		~network_bundle();
+
+		// input_normalizer might be empty
+		static void write(
+			const boost::filesystem::path& file_path,
+			const network_schema& schema,
+			const network_data& data,
+			normalize_data_transformer_smart_ptr input_normalizer);
+
+		network_schema_smart_ptr get_schema() const;
+
+		// Returns empty pointer if the bundle contains no input normalizer
+		normalize_data_transformer_smart_ptr get_input_normalizer() const;
+
+		// Layer data returned points to the mapped weights, the mapping is kept alive as long as the data exists
+		network_data_smart_ptr get_data() const;
+
+		static const boost::uuids::uuid bundle_guid;
+
+		static const size_t alignment;
+
+	private:
+		struct part_info
+		{
+			unsigned long long offset;
+			unsigned int elem_count;
+		};
+
+		static size_t get_aligned(size_t offset);
+
+		static void write_padding(
+			std::ostream& binary_stream_to_write_to,
+			size_t current_offset,
+			size_t target_offset);
+
+	private:
+		boost::filesystem::path file_path;
+		nnforge_shared_ptr<const boost::interprocess::mapped_region> region;
+		const char * region_begin;
+		size_t region_size;
+		unsigned long long schema_offset;
+		unsigned int schema_size;
+		unsigned long long input_normalizer_offset;
+		unsigned int input_normalizer_size;
+		std::vector<std::vector<part_info> > layer_part_info_list;
+
+	private:
+		network_bundle(const network_bundle&);
+		network_bundle& operator =(const network_bundle&);
+	};
+
+	typedef nnforge_shared_ptr<network_bundle> network_bundle_smart_ptr;
+}
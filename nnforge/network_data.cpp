@@ -17,6 +17,7 @@
 #include "network_data.h"
 
 #include "neural_network_exception.h"
+#include "mapped_layer_data.h"
 
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/format.hpp>
@@ -32,6 +33,14 @@ namespace nnforge
 	, 0x95, 0x66
 	, 0x02, 0x9d, 0x2e, 0x64, 0x90, 0x45 };
 
+	// {441A1859-66AD-4210-8D25-CA32B7EB5B7A}
+	const boost::uuids::uuid network_data::reduced_precision_data_guid =
+	{ 0x44, 0x1a, 0x18, 0x59
+	, 0x66, 0xad
+	, 0x42, 0x10
+	, 0x8d, 0x25
+	, 0xca, 0x32, 0xb7, 0xeb, 0x5b, 0x7a };
+
 	network_data::network_data()
 	{
 	}
@@ -46,6 +55,18 @@ namespace nnforge
 		}
 	}
 
+	nnforge_shared_ptr<network_data> network_data::clone() const
+	{
+		nnforge_shared_ptr<network_data> res(new network_data());
+		for(layer_data_list::const_iterator it = begin(); it != end(); ++it)
+		{
+			const_mapped_layer_data_smart_ptr mapped_data = nnforge_dynamic_pointer_cast<const mapped_layer_data>(*it);
+			res->push_back(mapped_data ? mapped_data->copy() : layer_data_smart_ptr(new layer_data(**it)));
+		}
+
+		return res;
+	}
+
 	void network_data::check_network_data_consistency(const const_layer_list& layer_list)
 	{
 		if (size() != layer_list.size())
@@ -53,7 +74,11 @@ namespace nnforge
 
 		for(unsigned int i = 0; i < size(); ++i)
 		{
-			layer_list[i]->check_layer_data_consistency(*at(i));
+			const_mapped_layer_data_smart_ptr mapped_data = nnforge_dynamic_pointer_cast<const mapped_layer_data>(at(i));
+			if (mapped_data)
+				layer_list[i]->check_layer_data_consistency(mapped_data->part_size_list);
+			else
+				layer_list[i]->check_layer_data_consistency(*at(i));
 		}
 	}
 
@@ -62,32 +87,62 @@ namespace nnforge
 		return data_guid;
 	}
 
-	void network_data::write(std::ostream& binary_stream_to_write_to) const
+	void network_data::write(
+		std::ostream& binary_stream_to_write_to,
+		weight_storage_type::storage_type storage) const
 	{
 		binary_stream_to_write_to.exceptions(std::ostream::eofbit | std::ostream::failbit | std::ostream::badbit);
 
-		const boost::uuids::uuid& guid = get_uuid();
+		// Float data is written in the original format, thus remains readable by older versions
+		const boost::uuids::uuid& guid = (storage == weight_storage_type::type_float) ? get_uuid() : reduced_precision_data_guid;
 		binary_stream_to_write_to.write(reinterpret_cast<const char*>(guid.data), sizeof(guid.data));
+		if (storage != weight_storage_type::type_float)
+		{
+			unsigned int storage_code = static_cast<unsigned int>(storage);
+			binary_stream_to_write_to.write(reinterpret_cast<const char*>(&storage_code), sizeof(storage_code));
+		}
 
 		unsigned int data_count = (unsigned int)size();
 		binary_stream_to_write_to.write(reinterpret_cast<const char*>(&data_count), sizeof(data_count));
 
 		for(layer_data_list::const_iterator it = begin(); it != end(); ++it)
 		{
-			(*it)->write(binary_stream_to_write_to);
+			const_mapped_layer_data_smart_ptr mapped_data = nnforge_dynamic_pointer_cast<const mapped_layer_data>(*it);
+			if (mapped_data)
+				mapped_data->copy()->write(binary_stream_to_write_to, storage);
+			else
+				(*it)->write(binary_stream_to_write_to, storage);
 		}
 
 		binary_stream_to_write_to.flush();
 	}
 
 	void network_data::read(std::istream& binary_stream_to_read_from)
+	{
+		read(binary_stream_to_read_from, 0);
+	}
+
+	void network_data::read(
+		std::istream& binary_stream_to_read_from,
+		weight_storage_type::storage_type * storage)
 	{
 		binary_stream_to_read_from.exceptions(std::ostream::eofbit | std::ostream::failbit | std::ostream::badbit);
 
 		boost::uuids::uuid data_guid_read;
 		binary_stream_to_read_from.read(reinterpret_cast<char*>(data_guid_read.data), sizeof(data_guid_read.data));
-		if (data_guid_read != get_uuid())
+		weight_storage_type::storage_type storage_read = weight_storage_type::type_float;
+		if (data_guid_read == reduced_precision_data_guid)
+		{
+			unsigned int storage_code;
+			binary_stream_to_read_from.read(reinterpret_cast<char*>(&storage_code), sizeof(storage_code));
+			storage_read = static_cast<weight_storage_type::storage_type>(storage_code);
+			if ((storage_read != weight_storage_type::type_fp16) && (storage_read != weight_storage_type::type_bf16))
+				throw neural_network_exception((boost::format("Unknown weight storage type encountered in input stream: %1%") % storage_code).str());
+		}
+		else if (data_guid_read != get_uuid())
 			throw neural_network_exception((boost::format("Unknown data GUID encountered in input stream: %1%") % data_guid_read).str());
+		if (storage != 0)
+			*storage = storage_read;
 
 		unsigned int data_count;
 		binary_stream_to_read_from.read(reinterpret_cast<char*>(&data_count), sizeof(data_count));
@@ -97,7 +152,7 @@ namespace nnforge
 		for(unsigned int i = 0; i < size(); ++i)
 		{
 			at(i) = layer_data_smart_ptr(new layer_data());
-			at(i)->read(binary_stream_to_read_from);
+			at(i)->read(binary_stream_to_read_from, storage_read);
 		}
 	}
 
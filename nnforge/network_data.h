@@ -21,6 +21,7 @@
 #include "dropout_layer_config.h"
 #include "nn_types.h"
 #include "rnd.h"
+#include "weight_storage_type.h"
 
 #include <vector>
 #include <ostream>
@@ -40,14 +41,25 @@ namespace nnforge
 		// All data values are initialized to 0.0F
 		network_data(const const_layer_list& layer_list, float val = 0.0F);
 
+		// Unlike copy constructor the method doesn't share layer data with the original
+		nnforge_shared_ptr<network_data> clone() const;
+
 		// The stream should be created with std::ios_base::binary flag
 		// The method modifies binary_stream_to_write_to to throw exceptions in case of failure
-		void write(std::ostream& binary_stream_to_write_to) const;
+		void write(
+			std::ostream& binary_stream_to_write_to,
+			weight_storage_type::storage_type storage = weight_storage_type::type_float) const;
 
 		// The stream should be created with std::ios_base::binary flag
 		// The method modifies binary_stream_to_read_from to throw exceptions in case of failure
+		// Data stored with reduced precision is widened to float
 		void read(std::istream& binary_stream_to_read_from);
 
+		// The same as above, storage type of the data read is returned in storage if it is not null
+		void read(
+			std::istream& binary_stream_to_read_from,
+			weight_storage_type::storage_type * storage);
+
 		// The method throws exception in case the data is not suitable for the layers
 		void check_network_data_consistency(const const_layer_list& layer_list);
 
@@ -70,6 +82,7 @@ namespace nnforge
 
 	private:
 		static const boost::uuids::uuid data_guid;
+		static const boost::uuids::uuid reduced_precision_data_guid;
 	};
 
 	typedef nnforge_shared_ptr<network_data> network_data_smart_ptr;
@@ -26,6 +26,9 @@ namespace nnforge
 		unsigned int index;
 		network_data_smart_ptr data;
 		unsigned int start_epoch;
+		// Hessian cached for the data while training, empty if not available
+		network_data_smart_ptr hessian;
+		unsigned int hessian_epoch;
 	};
 
 	class network_data_peeker
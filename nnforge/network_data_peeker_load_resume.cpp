@@ -49,6 +49,17 @@ namespace nnforge
 				new_item.data->read(in);
 			}
 
+			// The hessian cached by the trainer is resumed as well
+			boost::filesystem::path hessian_filepath = resume_ann_folder_path / (boost::format("ann_trained_%|1$03d|_epoch_%|2$05d|.hessian") % new_item.index % new_item.start_epoch).str();
+			if (boost::filesystem::exists(hessian_filepath))
+			{
+				boost::filesystem::ifstream in(hessian_filepath, std::ios_base::in | std::ios_base::binary);
+				in.exceptions(std::istream::eofbit | std::istream::failbit | std::istream::badbit);
+				in.read(reinterpret_cast<char*>(&new_item.hessian_epoch), sizeof(new_item.hessian_epoch));
+				new_item.hessian = network_data_smart_ptr(new network_data());
+				new_item.hessian->read(in);
+			}
+
 			entry_list.push_back(new_item);
 		}
 
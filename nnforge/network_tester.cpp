@@ -17,6 +17,7 @@
 #include "network_tester.h"
 
 #include "neural_network_exception.h"
+#include "mapped_layer_data.h"
 #include <boost/chrono.hpp>
 #include <boost/format.hpp>
 
@@ -36,7 +37,32 @@ namespace nnforge
 		// Check data-schema consistency
 		data->check_network_data_consistency(*schema);
 
-		actual_set_data(data);
+		actual_set_data(get_supported_data(data));
+	}
+
+	network_data_smart_ptr network_tester::get_supported_data(network_data_smart_ptr data) const
+	{
+		if (is_mapped_data_supported())
+			return data;
+
+		network_data_smart_ptr res;
+		for(unsigned int layer_id = 0; layer_id < data->size(); ++layer_id)
+		{
+			const_mapped_layer_data_smart_ptr mapped_data = nnforge_dynamic_pointer_cast<const mapped_layer_data>((*data)[layer_id]);
+			if (mapped_data)
+			{
+				if (!res)
+					res = network_data_smart_ptr(new network_data(*data));
+				(*res)[layer_id] = mapped_data->copy();
+			}
+		}
+
+		return res ? res : data;
+	}
+
+	bool network_tester::is_mapped_data_supported() const
+	{
+		return false;
 	}
 
 	void network_tester::set_input_configuration_specific(const layer_configuration_specific& input_configuration_specific)
@@ -94,6 +120,86 @@ namespace nnforge
 		return result;
 	}
 
+	void network_tester::test(
+		supervised_data_reader& reader,
+		const std::vector<network_data_smart_ptr>& data_list,
+		output_neuron_value_set::merge_type_enum merge_type,
+		testing_complete_result_set& result)
+	{
+		boost::chrono::steady_clock::time_point start = boost::chrono::high_resolution_clock::now();
+
+		if (data_list.empty())
+			throw neural_network_exception("Empty network data list");
+		std::vector<network_data_smart_ptr> supported_data_list;
+		for(std::vector<network_data_smart_ptr>::const_iterator it = data_list.begin(); it != data_list.end(); ++it)
+		{
+			(*it)->check_network_data_consistency(*schema);
+			supported_data_list.push_back(get_supported_data(*it));
+		}
+
+		set_input_configuration_specific(reader.get_input_configuration());
+
+		// Check schema-reader consistency
+		layer_config_list[layer_config_list.size() - 1].check_equality(reader.get_output_configuration());
+
+		unsigned int actual_entry_count = static_cast<unsigned int>(result.actual_output_neuron_value_set->neuron_value_list.size());
+		unsigned int original_entry_count = reader.get_entry_count();
+		unsigned int mod = original_entry_count % actual_entry_count;
+		if (mod != 0)
+			throw nnforge::neural_network_exception("Predicted entry count is not evenly divisible by actual entry count");
+		unsigned int sample_count = original_entry_count / actual_entry_count;
+
+		result.predicted_output_neuron_value_set = actual_run(reader, supported_data_list, merge_type, sample_count);
+
+		boost::chrono::duration<float> sec = boost::chrono::high_resolution_clock::now() - start;
+
+		result.recalculate_mse();
+
+		result.tr->flops = static_cast<float>(original_entry_count) * static_cast<float>(data_list.size()) * flops;
+		result.tr->time_to_complete_seconds = sec.count();
+	}
+
+	output_neuron_value_set_smart_ptr network_tester::run(
+		unsupervised_data_reader& reader,
+		const std::vector<network_data_smart_ptr>& data_list,
+		output_neuron_value_set::merge_type_enum merge_type,
+		unsigned int sample_count)
+	{
+		if (data_list.empty())
+			throw neural_network_exception("Empty network data list");
+		std::vector<network_data_smart_ptr> supported_data_list;
+		for(std::vector<network_data_smart_ptr>::const_iterator it = data_list.begin(); it != data_list.end(); ++it)
+		{
+			(*it)->check_network_data_consistency(*schema);
+			supported_data_list.push_back(get_supported_data(*it));
+		}
+
+		if (reader.get_entry_count() % sample_count != 0)
+			throw nnforge::neural_network_exception("Entry count is not evenly divisible by sample count");
+
+		set_input_configuration_specific(reader.get_input_configuration());
+
+		return actual_run(reader, supported_data_list, merge_type, sample_count);
+	}
+
+	output_neuron_value_set_smart_ptr network_tester::actual_run(
+		unsupervised_data_reader& reader,
+		const std::vector<network_data_smart_ptr>& data_list,
+		output_neuron_value_set::merge_type_enum merge_type,
+		unsigned int sample_count)
+	{
+		std::vector<output_neuron_value_set_smart_ptr> predicted_neuron_value_set_list;
+		for(std::vector<network_data_smart_ptr>::const_iterator it = data_list.begin(); it != data_list.end(); ++it)
+		{
+			actual_set_data(*it);
+			output_neuron_value_set_smart_ptr predicted_neuron_value_set = actual_run(reader);
+			predicted_neuron_value_set->compact(sample_count);
+			predicted_neuron_value_set_list.push_back(predicted_neuron_value_set);
+		}
+
+		return output_neuron_value_set_smart_ptr(new output_neuron_value_set(predicted_neuron_value_set_list, merge_type));
+	}
+
 	std::vector<layer_configuration_specific_snapshot_smart_ptr> network_tester::get_snapshot(
 		const void * input,
 		neuron_data_type::input_type type_code,
@@ -162,4 +268,26 @@ namespace nnforge
 	{
 		return flops;
 	}
+
+	void network_tester::set_profiling(bool enabled)
+	{
+		if (enabled)
+			profiling = profiling_result_smart_ptr(new profiling_result(static_cast<unsigned int>(schema->get_layers().size())));
+		else
+			profiling.reset();
+	}
+
+	profiling_result_smart_ptr network_tester::get_profiling_result() const
+	{
+		return profiling;
+	}
+
+	void network_tester::set_quantization_data(const_quantization_data_smart_ptr quantization)
+	{
+		if (quantization && ((quantization->input_range_list.size() != schema->get_layers().size())
+			|| (quantization->weight_list.size() != schema->get_layers().size()) || (quantization->weight_scale_list.size() != schema->get_layers().size())))
+			throw neural_network_exception((boost::format("Quantization data contains %1% layers while schema contains %2%") % quantization->input_range_list.size() % schema->get_layers().size()).str());
+
+		this->quantization = quantization;
+	}
 }
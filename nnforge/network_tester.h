@@ -24,6 +24,8 @@
 #include "layer_configuration_specific.h"
 #include "layer_configuration_specific_snapshot.h"
 #include "neuron_data_type.h"
+#include "profiling_result.h"
+#include "quantization_data.h"
 #include "nn_types.h"
 
 #include <vector>
@@ -49,6 +51,22 @@ namespace nnforge
 			unsupervised_data_reader& reader,
 			unsigned int sample_count);
 
+		// Runs all the networks from data_list reading the data once, predicted values are merged across networks on the fly
+		// The data set with set_data might be replaced
+		void test(
+			supervised_data_reader& reader,
+			const std::vector<network_data_smart_ptr>& data_list,
+			output_neuron_value_set::merge_type_enum merge_type,
+			testing_complete_result_set& result);
+
+		// Runs all the networks from data_list reading the data once, predicted values are merged across networks on the fly
+		// The data set with set_data might be replaced
+		output_neuron_value_set_smart_ptr run(
+			unsupervised_data_reader& reader,
+			const std::vector<network_data_smart_ptr>& data_list,
+			output_neuron_value_set::merge_type_enum merge_type,
+			unsigned int sample_count);
+
 		// You need to call set_input_configuration_specific before you call this method for the 1st time
 		std::vector<layer_configuration_specific_snapshot_smart_ptr> get_snapshot(
 			const void * input,
@@ -76,12 +94,31 @@ namespace nnforge
 		// set_input_configuration_specific should be called prior to this method call for this method to succeed
 		float get_flops_for_single_entry() const;
 
+		// Per-layer timings are collected on subsequent runs while enabled, backends not supporting it leave the result empty
+		void set_profiling(bool enabled);
+
+		// Returns timings accumulated since profiling was enabled, empty pointer when it is disabled
+		profiling_result_smart_ptr get_profiling_result() const;
+
+		// Layers supported by the backend run with int8 inputs and weights, it takes effect for the data set afterwards
+		// Pass empty pointer to get back to float computations, backends not supporting quantization ignore it
+		void set_quantization_data(const_quantization_data_smart_ptr quantization);
+
 	protected:
 		network_tester(network_schema_smart_ptr schema);
 
 		// schema, data and reader are guaranteed to be compatible
 		virtual output_neuron_value_set_smart_ptr actual_run(unsupervised_data_reader& reader) = 0;
 
+		// schema, data list and reader are guaranteed to be compatible, entry count of the reader is evenly divisible by sample_count
+		// The method returns predicted values compacted by sample_count and merged across the networks
+		// Default implementation runs networks one by one, override it to read the data once
+		virtual output_neuron_value_set_smart_ptr actual_run(
+			unsupervised_data_reader& reader,
+			const std::vector<network_data_smart_ptr>& data_list,
+			output_neuron_value_set::merge_type_enum merge_type,
+			unsigned int sample_count);
+
 		// The method is called when client calls set_data. The data is guaranteed to be compatible with schema
 		virtual void actual_set_data(network_data_smart_ptr data) = 0;
 
@@ -101,10 +138,18 @@ namespace nnforge
 
 		void update_flops();
 
+		// Backends using layer data mapped to memory in place override this method to return true
+		// Other backends receive data with mapped layers copied
+		virtual bool is_mapped_data_supported() const;
+
+		network_data_smart_ptr get_supported_data(network_data_smart_ptr data) const;
+
 	protected:
 		network_schema_smart_ptr schema;
 		layer_configuration_specific_list layer_config_list;
 		float flops;
+		profiling_result_smart_ptr profiling;
+		const_quantization_data_smart_ptr quantization;
 
 	private:
 		network_tester();
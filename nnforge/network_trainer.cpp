@@ -63,6 +63,11 @@ namespace nnforge
 				new_task.index_peeked = entry_peeked.index;
 				new_task.data = entry_peeked.data;
 				new_task.initial_epoch = entry_peeked.start_epoch;
+				if (entry_peeked.hessian)
+				{
+					new_task.hessian = entry_peeked.hessian;
+					new_task.hessian_epoch = entry_peeked.hessian_epoch;
+				}
 
 				if (is_last_epoch(new_task))
 				{
@@ -20,6 +20,7 @@
 #include <numeric>
 #include <limits>
 #include <fstream>
+#include <algorithm>
 
 #include "neural_network_exception.h"
 
@@ -38,6 +39,8 @@ namespace nnforge
 		, max_mu(1.0F)
 		, mu_increase_factor(1.0F)
 		, per_layer_mu(false)
+		, hessian_refresh_epoch_count(1)
+		, hessian_blend_factor(1.0F)
 	{
 	}
 
@@ -53,27 +56,66 @@ namespace nnforge
 
 		unsigned int hessian_entry_to_process_count = std::min<unsigned int>(std::max<unsigned int>(static_cast<unsigned int>(hessian_entry_to_process_ratio * reader.get_entry_count()), min_hessian_entry_to_process_count), reader.get_entry_count());
 
+		std::vector<network_data_smart_ptr> data_list;
+		for(std::vector<training_task_state>::iterator it = task_list.begin(); it != task_list.end(); ++it)
+			data_list.push_back(it->data);
+
 		std::vector<network_data_smart_ptr> learning_rate_vector_list;
-		for(unsigned int i = 0; i < task_list.size(); ++i)
+		std::vector<bool> hessian_calculated_list(task_list.size(), true);
+		if (is_hessian_cached())
 		{
-			network_data_smart_ptr hessian = hessian_calc->get_hessian(
+			std::vector<unsigned int> refresh_task_id_list;
+			std::vector<network_data_smart_ptr> refresh_data_list;
+			for(unsigned int i = 0; i < task_list.size(); ++i)
+			{
+				hessian_calculated_list[i] = (!task_list[i].hessian) || (task_list[i].get_current_epoch() >= task_list[i].hessian_epoch + hessian_refresh_epoch_count);
+				if (hessian_calculated_list[i])
+				{
+					refresh_task_id_list.push_back(i);
+					refresh_data_list.push_back(task_list[i].data);
+				}
+			}
+
+			if (!refresh_data_list.empty())
+			{
+				std::vector<network_data_smart_ptr> hessian_list = hessian_calc->get_hessian(
+					reader,
+					refresh_data_list,
+					hessian_entry_to_process_count);
+				for(unsigned int i = 0; i < refresh_task_id_list.size(); ++i)
+				{
+					training_task_state& task = task_list[refresh_task_id_list[i]];
+					if (task.hessian && (hessian_blend_factor < 1.0F))
+						blend_hessian(*task.hessian, *hessian_list[i]);
+					else
+						task.hessian = hessian_list[i];
+					task.hessian_epoch = task.get_current_epoch();
+				}
+			}
+
+			// The cached hessian is kept intact, learning rates are calculated from its copy
+			for(unsigned int i = 0; i < task_list.size(); ++i)
+				learning_rate_vector_list.push_back(copy_hessian(*task_list[i].hessian));
+		}
+		else
+		{
+			learning_rate_vector_list = hessian_calc->get_hessian(
 				reader,
-				task_list[i].data,
+				data_list,
 				hessian_entry_to_process_count);
+		}
 
+		for(unsigned int i = 0; i < task_list.size(); ++i)
+		{
 			std::string comment = convert_hessian_to_training_vector(
-				hessian,
+				learning_rate_vector_list[i],
 				task_list[i].get_current_epoch());
-
-			learning_rate_vector_list.push_back(hessian);
+			if (!hessian_calculated_list[i])
+				comment += (boost::format(" cached at epoch %1%") % (task_list[i].hessian_epoch + 1)).str();
 
 			task_list[i].comments.push_back(comment);
 		}
 
-		std::vector<network_data_smart_ptr> data_list;
-		for(std::vector<training_task_state>::iterator it = task_list.begin(); it != task_list.end(); ++it)
-			data_list.push_back(it->data);
-
 		std::vector<testing_result_smart_ptr> train_result = updater->update(
 			reader,
 			learning_rate_vector_list,
@@ -88,12 +130,50 @@ namespace nnforge
 		{
 			testing_result_smart_ptr res = train_result[i];
 			res->time_to_complete_seconds = sec.count();
-			res->flops = (static_cast<float>(res->get_entry_count()) * flops) + (static_cast<float>(hessian_entry_to_process_count) * flops_hessian);
+			res->flops = static_cast<float>(res->get_entry_count()) * flops;
+			if (hessian_calculated_list[i])
+				res->flops += static_cast<float>(hessian_entry_to_process_count) * flops_hessian;
 
 			task_list[i].history.push_back(res);
 		}
 	}
 
+	bool network_trainer_sdlm::is_hessian_cached() const
+	{
+		return (hessian_refresh_epoch_count > 1) || (hessian_blend_factor < 1.0F);
+	}
+
+	void network_trainer_sdlm::blend_hessian(
+		network_data& hessian,
+		const network_data& new_hessian) const
+	{
+		for(unsigned int layer_id = 0; layer_id < hessian.size(); ++layer_id)
+		{
+			layer_data& dst = *hessian[layer_id];
+			const layer_data& src = *new_hessian[layer_id];
+			for(unsigned int part_id = 0; part_id < dst.size(); ++part_id)
+			{
+				std::vector<float>::iterator dst_it = dst[part_id].begin();
+				for(std::vector<float>::const_iterator src_it = src[part_id].begin(); src_it != src[part_id].end(); ++src_it, ++dst_it)
+					*dst_it += hessian_blend_factor * (*src_it - *dst_it);
+			}
+		}
+	}
+
+	network_data_smart_ptr network_trainer_sdlm::copy_hessian(const network_data& hessian) const
+	{
+		network_data_smart_ptr res(new network_data(*schema));
+		for(unsigned int layer_id = 0; layer_id < hessian.size(); ++layer_id)
+		{
+			const layer_data& src = *hessian[layer_id];
+			layer_data& dst = *(*res)[layer_id];
+			for(unsigned int part_id = 0; part_id < src.size(); ++part_id)
+				std::copy(src[part_id].begin(), src[part_id].end(), dst[part_id].begin());
+		}
+
+		return res;
+	}
+
 #ifdef NNFORGE_DEBUG_HESSIAN
 	void network_trainer_sdlm::dump_lists(
 		network_data_smart_ptr hessian,
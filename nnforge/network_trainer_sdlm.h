@@ -42,6 +42,10 @@ namespace nnforge
 		float max_mu;
 		float mu_increase_factor;
 		bool per_layer_mu;
+		// The hessian is reused for this number of epochs before it is calculated again
+		unsigned int hessian_refresh_epoch_count;
+		// Weight of the newly calculated hessian when averaging it with the cached one, 1.0 replaces the cached one
+		float hessian_blend_factor;
 
 	protected:
 		// The method should add testing result to the training history of each element
@@ -73,6 +77,14 @@ namespace nnforge
 
 		std::vector<std::vector<float> > get_average_hessian_list(network_data_smart_ptr hessian) const;
 
+		bool is_hessian_cached() const;
+
+		void blend_hessian(
+			network_data& hessian,
+			const network_data& new_hessian) const;
+
+		network_data_smart_ptr copy_hessian(const network_data& hessian) const;
+
 		std::string convert_hessian_to_training_vector(
 			network_data_smart_ptr hessian,
 			const std::vector<std::vector<float> >& average_hessian_list,
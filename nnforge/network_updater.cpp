@@ -149,4 +149,17 @@ namespace nnforge
 	{
 		return flops;
 	}
+
+	void network_updater::set_profiling(bool enabled)
+	{
+		if (enabled)
+			profiling = profiling_result_smart_ptr(new profiling_result(static_cast<unsigned int>(schema->get_layers().size())));
+		else
+			profiling.reset();
+	}
+
+	profiling_result_smart_ptr network_updater::get_profiling_result() const
+	{
+		return profiling;
+	}
 }
@@ -24,6 +24,7 @@
 #include "dropout_layer_config.h"
 #include "weight_vector_bound.h"
 #include "error_function.h"
+#include "profiling_result.h"
 #include "nn_types.h"
 
 #include <map>
@@ -50,6 +51,12 @@ namespace nnforge
 		// set_input_configuration_specific should be called prior to this method call for this method to succeed
 		float get_flops_for_single_entry() const;
 
+		// Per-layer timings are collected on subsequent runs while enabled, backends not supporting it leave the result empty
+		void set_profiling(bool enabled);
+
+		// Returns timings accumulated since profiling was enabled, empty pointer when it is disabled
+		profiling_result_smart_ptr get_profiling_result() const;
+
 	protected:
 		network_updater(
 			network_schema_smart_ptr schema,
@@ -79,6 +86,7 @@ namespace nnforge
 		float flops;
 		std::map<unsigned int, weight_vector_bound> layer_to_weight_vector_bound_map;
 		float weight_decay;
+		profiling_result_smart_ptr profiling;
 
 	private:
 		network_updater();
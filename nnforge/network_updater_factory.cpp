@@ -16,6 +16,8 @@
 
 #include "network_updater_factory.h"
 
+#include "neural_network_exception.h"
+
 namespace nnforge
 {
 	network_updater_factory::network_updater_factory()
@@ -25,4 +27,20 @@ namespace nnforge
 	network_updater_factory::~network_updater_factory()
 	{
 	}
+
+	network_updater_smart_ptr network_updater_factory::create_asynchronous(
+		network_schema_smart_ptr schema,
+		const_error_function_smart_ptr ef,
+		const std::map<unsigned int, float>& layer_to_dropout_rate_map,
+		const std::map<unsigned int, weight_vector_bound>& layer_to_weight_vector_bound_map,
+		float weight_decay,
+		unsigned int thread_count) const
+	{
+		throw neural_network_exception("Asynchronous update is not supported by the backend");
+	}
+
+	unsigned int network_updater_factory::get_default_asynchronous_thread_count() const
+	{
+		return 0;
+	}
 }
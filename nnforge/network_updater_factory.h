@@ -35,6 +35,20 @@ namespace nnforge
 			const std::map<unsigned int, weight_vector_bound>& layer_to_weight_vector_bound_map,
 			float weight_decay) const = 0;
 
+		// Creates updater running entries in thread_count threads concurrently, each thread updating shared weights without locking
+		// thread_count == 0 means the default count for the backend
+		// The default implementation throws exception, backends supporting asynchronous update override it
+		virtual network_updater_smart_ptr create_asynchronous(
+			network_schema_smart_ptr schema,
+			const_error_function_smart_ptr ef,
+			const std::map<unsigned int, float>& layer_to_dropout_rate_map,
+			const std::map<unsigned int, weight_vector_bound>& layer_to_weight_vector_bound_map,
+			float weight_decay,
+			unsigned int thread_count) const;
+
+		// Returns 0 if asynchronous update is not supported
+		virtual unsigned int get_default_asynchronous_thread_count() const;
+
 	protected:
 		network_updater_factory();
 	};
@@ -20,17 +20,23 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/format.hpp>
 #include <boost/chrono.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
 
 #include <regex>
 #include <algorithm>
 #include <numeric>
+#include <cstdlib>
 
 #include "snapshot_visualizer.h"
 #include "output_neuron_class_set.h"
 #include "classifier_result.h"
 #include "supervised_data_stream_reader.h"
+#include "supervised_data_mapped_reader.h"
 #include "unsupervised_data_stream_reader.h"
 #include "validate_progress_network_data_pusher.h"
+#include "async_validate_progress_network_data_pusher.h"
 #include "network_data_peeker.h"
 #include "network_data_peeker_random.h"
 #include "network_data_peeker_single.h"
@@ -50,9 +56,15 @@
 #include "supervised_data_stream_writer.h"
 #include "supervised_multiple_epoch_data_reader.h"
 #include "supervised_limited_entry_count_data_reader.h"
+#include "supervised_prefetching_data_reader.h"
+#include "unsupervised_prefetching_data_reader.h"
 #include "network_trainer_sgd.h"
 #include "save_resume_network_data_pusher.h"
+#include "async_save_resume_network_data_pusher.h"
 #include "network_data_peeker_load_resume.h"
+#include "quantization_calibrator.h"
+#include "network_bundle.h"
+#include "data_parallel_network_updater.h"
 
 namespace nnforge
 {
@@ -71,6 +83,7 @@ namespace nnforge
 	const char * neural_network_toolset::ann_subfolder_name = "batch";
 	const char * neural_network_toolset::ann_resume_subfolder_name = "resume";
 	const char * neural_network_toolset::trained_ann_index_extractor_pattern = "^ann_trained_(\\d+)\\.data$";
+	const char * neural_network_toolset::trained_ann_bundle_index_extractor_pattern = "^ann_trained_(\\d+)\\.bundle$";
 	const char * neural_network_toolset::logfile_name = "log.txt";
 
 	neural_network_toolset::neural_network_toolset(factory_generator_smart_ptr factory)
@@ -124,6 +137,10 @@ namespace nnforge
 		{
 			train();
 		}
+		else if (!action.compare("train_data_parallel"))
+		{
+			train_data_parallel();
+		}
 		else if (!action.compare("profile_updater"))
 		{
 			profile_updater();
@@ -132,6 +149,10 @@ namespace nnforge
 		{
 			profile_hessian();
 		}
+		else if (!action.compare("profile_tester"))
+		{
+			profile_tester();
+		}
 		else if (!action.compare("snapshot"))
 		{
 			snapshot();
@@ -148,6 +169,18 @@ namespace nnforge
 		{
 			ann_snapshot();
 		}
+		else if (!action.compare("convert_data_storage"))
+		{
+			convert_data_storage();
+		}
+		else if (!action.compare("calibrate_quantization"))
+		{
+			calibrate_quantization();
+		}
+		else if (!action.compare("create_bundle"))
+		{
+			create_bundle();
+		}
 		else
 		{
 			throw std::runtime_error((boost::format("Unknown action: %1%") % action).str());
@@ -171,7 +204,7 @@ namespace nnforge
 		boost::program_options::options_description gener("Generic options");
 		gener.add_options()
 			("help", "produce help message")
-			("action,A", boost::program_options::value<std::string>(&action), "run action (info, create, prepare_training_data, prepare_testing_data, randomize_data, generate_input_normalizer, generate_output_normalizer, test, test_batch, validate, validate_batch, validate_infinite, train, snapshot, snapshot_invalid, ann_snapshot, profile_updater, profile_hessian)")
+			("action,A", boost::program_options::value<std::string>(&action), "run action (info, create, prepare_training_data, prepare_testing_data, randomize_data, generate_input_normalizer, generate_output_normalizer, test, test_batch, validate, validate_batch, validate_infinite, train, train_data_parallel, snapshot, snapshot_invalid, ann_snapshot, profile_updater, profile_hessian, profile_tester, convert_data_storage, calibrate_quantization, create_bundle)")
 			("config,C", boost::program_options::value<boost::filesystem::path>(&config_file)->default_value(default_config_path), "path to the configuration file.")
 			;
 
@@ -192,6 +225,8 @@ namespace nnforge
 			("mu_increase_factor", boost::program_options::value<float>(&mu_increase_factor)->default_value(1.0F), "Mu increases by this ratio each epoch.")
 			("max_mu", boost::program_options::value<float>(&max_mu)->default_value(1.0F), "Maximum Mu during training.")
 			("per_layer_mu", boost::program_options::value<bool>(&per_layer_mu)->default_value(false), "Mu is calculated for each layer separately.")
+			("hessian_refresh_epoch_count", boost::program_options::value<unsigned int>(&hessian_refresh_epoch_count)->default_value(1), "The number of epochs the hessian is reused for before it is calculated again (sdlm only).")
+			("hessian_blend_factor", boost::program_options::value<float>(&hessian_blend_factor)->default_value(1.0F), "Weight of the newly calculated hessian averaged with the previous one, 1.0 means no averaging (sdlm only).")
 			("learning_rate,L", boost::program_options::value<float>(&learning_rate)->default_value(0.02F), "Global learning rate, Eta/Mu ratio for Stochastic Diagonal Levenberg Marquardt.")
 			("learning_rate_decay_tail", boost::program_options::value<unsigned int>(&learning_rate_decay_tail_epoch_count)->default_value(0), "Number of tail iterations with gradually lowering learning rates.")
 			("learning_rate_decay_rate", boost::program_options::value<float>(&learning_rate_decay_rate)->default_value(0.5F), "Degradation of learning rate at each tail epoch.")
@@ -202,11 +237,32 @@ namespace nnforge
 			("snapshot_data_set", boost::program_options::value<std::string>(&snapshot_data_set)->default_value("training"), "Type of the dataset to use for snapshots (training, validating, testing).")
 			("profile_updater_entry_count", boost::program_options::value<unsigned int>(&profile_updater_entry_count)->default_value(1), "The number of entries to process when profiling updater.")
 			("profile_hessian_entry_count", boost::program_options::value<unsigned int>(&profile_hessian_entry_count)->default_value(0), "The number of entries to process when profiling hessian (0 means no limitation).")
-			("training_algo", boost::program_options::value<std::string>(&training_algo)->default_value("sdlm"), "Training algorithm (sdlm, sgd).")
+			("profile_tester_entry_count", boost::program_options::value<unsigned int>(&profile_tester_entry_count)->default_value(0), "The number of validating entries to process when profiling tester (0 means no limitation).")
+			("profile_tester_single_run_count", boost::program_options::value<unsigned int>(&profile_tester_single_run_count)->default_value(100), "The number of single entry runs to measure latency with when profiling tester.")
+			("training_algo", boost::program_options::value<std::string>(&training_algo)->default_value("sdlm"), "Training algorithm (sdlm, sgd, hogwild).")
+			("hogwild_thread_count", boost::program_options::value<unsigned int>(&hogwild_thread_count)->default_value(0), "The number of threads running SGD concurrently on shared weights without locking for hogwild training algorithm (0 means backend default).")
 			("dump_resume", boost::program_options::value<bool>(&dump_resume)->default_value(true), "Dump neural network data after each epoch.")
+			("dump_resume_epoch_interval", boost::program_options::value<unsigned int>(&dump_resume_epoch_interval)->default_value(1), "Dump neural network data each time this number of epochs is completed (0 means no epoch based dumping).")
+			("dump_resume_time_interval", boost::program_options::value<float>(&dump_resume_time_interval)->default_value(0.0F), "Dump neural network data if this number of seconds passed since it was last dumped (0 means no time based dumping).")
+			("dump_resume_async", boost::program_options::value<bool>(&dump_resume_async)->default_value(false), "Dump neural network data on a background thread while training proceeds.")
 			("load_resume,R", boost::program_options::value<bool>(&load_resume)->default_value(false), "Resume neural network training strating from saved.")
 			("epoch_count_in_training_set", boost::program_options::value<unsigned int>(&epoch_count_in_training_set)->default_value(1), "The whole should be split in this amount of epochs.")
 			("weight_decay", boost::program_options::value<float>(&weight_decay)->default_value(0.0F), "Weight decay.")
+			("ensemble_single_pass", boost::program_options::value<bool>(&ensemble_single_pass)->default_value(false), "Test/validate all ANNs in batch mode reading the data once, only merged result is reported.")
+			("load_bundle", boost::program_options::value<bool>(&load_bundle)->default_value(false), "Test/validate trained ANNs from bundles created by create_bundle, testers use the weights in place from the mapped files, snapshots copy them.")
+			("ensemble_merge", boost::program_options::value<std::string>(&ensemble_merge)->default_value("average"), "The way predictions of ANNs are merged in batch mode (average, median).")
+			("prefetch_entry_count", boost::program_options::value<unsigned int>(&prefetch_entry_count)->default_value(0), "The number of entries read in background while the previous ones are processed (0 means no prefetching).")
+			("mmap_training_data", boost::program_options::value<bool>(&mmap_training_data)->default_value(false), "Map training data file to memory instead of streaming it.")
+			("augmentation_worker_count", boost::program_options::value<unsigned int>(&augmentation_worker_count)->default_value(1), "The number of threads transforming input data.")
+			("async_validation", boost::program_options::value<bool>(&async_validation)->default_value(false), "Validate the network on a background thread while training proceeds with the next epoch.")
+			("data_storage", boost::program_options::value<std::string>(&data_storage)->default_value(""), "Precision trained ANNs are converted to by convert_data_storage (float, fp16, bf16), required by the action. The copies are written to <ann folder>_<data_storage>.")
+			("quantization_calibration_entry_count", boost::program_options::value<unsigned int>(&quantization_calibration_entry_count)->default_value(1000), "The number of validating entries used to calibrate activation ranges (0 means all of them).")
+			("quantized_inference", boost::program_options::value<bool>(&quantized_inference)->default_value(false), "Test/validate trained ANNs with int8 weights and activations using calibrated quantization data.")
+			("data_parallel_worker_count", boost::program_options::value<unsigned int>(&data_parallel_worker_count)->default_value(1), "The number of worker processes training the same ANNs on shards of training data (1 means no data parallel training), train_data_parallel starts them on the local machine.")
+			("data_parallel_worker_id", boost::program_options::value<unsigned int>(&data_parallel_worker_id)->default_value(0), "ID of this worker process, only worker 0 saves and validates ANNs.")
+			("data_parallel_segment_name", boost::program_options::value<std::string>(&data_parallel_segment_name)->default_value("nnforge_data_parallel"), "Name of the shared memory segment the workers exchange weights through.")
+			("data_parallel_sync_entry_count", boost::program_options::value<unsigned int>(&data_parallel_sync_entry_count)->default_value(0), "Workers average weights each time they process this number of entries (0 means once per epoch).")
+			("data_parallel_sync_timeout", boost::program_options::value<unsigned int>(&data_parallel_sync_timeout)->default_value(3600), "Workers fail if any of them doesn't reach the synchronization point within this time in seconds, it should cover the time worker 0 spends validating ANNs between epochs.")
 			;
 
 		{
@@ -290,10 +346,17 @@ namespace nnforge
 		p.add("action", -1);
 
 		boost::program_options::variables_map vm;
-		boost::program_options::store(boost::program_options::command_line_parser(argc, argv).
-				options(cmdline_options).positional(p).run(), vm);
+		boost::program_options::parsed_options parsed_command_line = boost::program_options::command_line_parser(argc, argv).
+				options(cmdline_options).positional(p).run();
+		boost::program_options::store(parsed_command_line, vm);
 		boost::program_options::notify(vm);
 
+		executable_path = argv[0];
+		worker_arg_list.clear();
+		for(std::vector<boost::program_options::option>::const_iterator it = parsed_command_line.options.begin(); it != parsed_command_line.options.end(); ++it)
+			if ((it->string_key != "action") && (it->string_key != "data_parallel_worker_id"))
+				worker_arg_list.insert(worker_arg_list.end(), it->original_tokens.begin(), it->original_tokens.end());
+
 		boost::filesystem::ifstream ifs(config_file);
 		if (!ifs)
 			throw std::runtime_error((boost::format("Can not open config file %1%") % config_file.string()).str());
@@ -307,7 +370,10 @@ namespace nnforge
 			return false;
 		}
 
+		// Data parallel workers run concurrently, each one writes its own log
 		boost::filesystem::path logfile_path = get_working_data_folder() / logfile_name;
+		if ((data_parallel_worker_count > 1) && !action.compare("train"))
+			logfile_path = get_working_data_folder() / (boost::format("%1%_worker_%|2$03d|%3%") % logfile_path.stem().string() % data_parallel_worker_id % logfile_path.extension().string()).str();
 		out_to_log_duplicator_smart_ptr = nnforge_shared_ptr<stream_duplicator>(new stream_duplicator(logfile_path));
 
 		{
@@ -349,6 +415,8 @@ namespace nnforge
 			std::cout << "mu_increase_factor" << "=" << mu_increase_factor << std::endl;
 			std::cout << "max_mu" << "=" << max_mu << std::endl;
 			std::cout << "per_layer_mu" << "=" << per_layer_mu << std::endl;
+			std::cout << "hessian_refresh_epoch_count" << "=" << hessian_refresh_epoch_count << std::endl;
+			std::cout << "hessian_blend_factor" << "=" << hessian_blend_factor << std::endl;
 			std::cout << "learning_rate" << "=" << learning_rate << std::endl;
 			std::cout << "learning_rate_decay_tail" << "=" << learning_rate_decay_tail_epoch_count << std::endl;
 			std::cout << "learning_rate_decay_rate" << "=" << learning_rate_decay_rate << std::endl;
@@ -359,11 +427,31 @@ namespace nnforge
 			std::cout << "snapshot_data_set" << "=" << snapshot_data_set << std::endl;
 			std::cout << "profile_updater_entry_count" << "=" << profile_updater_entry_count << std::endl;
 			std::cout << "profile_hessian_entry_count" << "=" << profile_hessian_entry_count << std::endl;
+			std::cout << "profile_tester_entry_count" << "=" << profile_tester_entry_count << std::endl;
+			std::cout << "profile_tester_single_run_count" << "=" << profile_tester_single_run_count << std::endl;
 			std::cout << "training_algo" << "=" << training_algo << std::endl;
+			std::cout << "hogwild_thread_count" << "=" << hogwild_thread_count << std::endl;
 			std::cout << "dump_resume" << "=" << dump_resume << std::endl;
+			std::cout << "dump_resume_epoch_interval" << "=" << dump_resume_epoch_interval << std::endl;
+			std::cout << "dump_resume_time_interval" << "=" << dump_resume_time_interval << std::endl;
+			std::cout << "dump_resume_async" << "=" << dump_resume_async << std::endl;
 			std::cout << "load_resume" << "=" << load_resume << std::endl;
 			std::cout << "epoch_count_in_training_set" << "=" << epoch_count_in_training_set << std::endl;
 			std::cout << "weight_decay" << "=" << weight_decay << std::endl;
+			std::cout << "ensemble_single_pass" << "=" << ensemble_single_pass << std::endl;
+			std::cout << "ensemble_merge" << "=" << ensemble_merge << std::endl;
+			std::cout << "prefetch_entry_count" << "=" << prefetch_entry_count << std::endl;
+			std::cout << "mmap_training_data" << "=" << mmap_training_data << std::endl;
+			std::cout << "augmentation_worker_count" << "=" << augmentation_worker_count << std::endl;
+			std::cout << "async_validation" << "=" << async_validation << std::endl;
+			std::cout << "data_storage" << "=" << data_storage << std::endl;
+			std::cout << "quantization_calibration_entry_count" << "=" << quantization_calibration_entry_count << std::endl;
+			std::cout << "quantized_inference" << "=" << quantized_inference << std::endl;
+			std::cout << "data_parallel_worker_count" << "=" << data_parallel_worker_count << std::endl;
+			std::cout << "data_parallel_worker_id" << "=" << data_parallel_worker_id << std::endl;
+			std::cout << "data_parallel_segment_name" << "=" << data_parallel_segment_name << std::endl;
+			std::cout << "data_parallel_sync_entry_count" << "=" << data_parallel_sync_entry_count << std::endl;
+			std::cout << "data_parallel_sync_timeout" << "=" << data_parallel_sync_timeout << std::endl;
 		}
 		{
 			std::vector<string_option> additional_string_options = get_string_options();
@@ -444,12 +532,33 @@ namespace nnforge
 	{
 		network_trainer_smart_ptr res;
 
-		network_updater_smart_ptr updater = updater_factory->create(
-			schema,
-			get_error_function(),
-			get_dropout_rate_map(),
-			get_weight_vector_bound_map(),
-			weight_decay);
+		network_updater_smart_ptr updater;
+		if (training_algo == "hogwild")
+			updater = updater_factory->create_asynchronous(
+				schema,
+				get_error_function(),
+				get_dropout_rate_map(),
+				get_weight_vector_bound_map(),
+				weight_decay,
+				hogwild_thread_count);
+		else
+			updater = updater_factory->create(
+				schema,
+				get_error_function(),
+				get_dropout_rate_map(),
+				get_weight_vector_bound_map(),
+				weight_decay);
+
+		if (data_parallel_worker_count > 1)
+			updater = network_updater_smart_ptr(new data_parallel_network_updater(
+				schema,
+				get_error_function(),
+				updater,
+				data_parallel_segment_name,
+				data_parallel_worker_id,
+				data_parallel_worker_count,
+				data_parallel_sync_entry_count,
+				data_parallel_sync_timeout));
 
 		if (training_algo == "sdlm")
 		{
@@ -464,10 +573,12 @@ namespace nnforge
 			typed_res->max_mu = max_mu;
 			typed_res->per_layer_mu = per_layer_mu;
 			typed_res->mu_increase_factor = mu_increase_factor;
+			typed_res->hessian_refresh_epoch_count = hessian_refresh_epoch_count;
+			typed_res->hessian_blend_factor = hessian_blend_factor;
 
 			res = typed_res;
 		}
-		else if (training_algo == "sgd")
+		else if ((training_algo == "sgd") || (training_algo == "hogwild"))
 		{
 			network_trainer_sgd_smart_ptr typed_res(
 				new network_trainer_sgd(
@@ -587,30 +698,49 @@ namespace nnforge
 		return analyzer_factory->create(schema);
 	}
 
-	network_data_smart_ptr neural_network_toolset::load_ann_data(unsigned int ann_id)
+	network_data_smart_ptr neural_network_toolset::load_ann_data(
+		unsigned int ann_id,
+		bool is_mapped_data_allowed)
+	{
+		boost::filesystem::path data_filepath = get_working_data_folder() / get_ann_subfolder_name() / (boost::format(load_bundle ? "ann_trained_%|1$03d|.bundle" : "ann_trained_%|1$03d|.data") % ann_id).str();
+		return load_ann_data(data_filepath, is_mapped_data_allowed);
+	}
+
+	network_data_smart_ptr neural_network_toolset::load_ann_data(
+		const boost::filesystem::path& file_path,
+		bool is_mapped_data_allowed) const
 	{
-		boost::filesystem::path data_filepath = get_working_data_folder() / get_ann_subfolder_name() / (boost::format("ann_trained_%|1$03d|.data") % ann_id).str();
+		if (load_bundle)
+		{
+			// The schema is checked against the data when it is passed to the tester
+			network_bundle bundle(file_path);
+			network_data_smart_ptr data = bundle.get_data();
+			return is_mapped_data_allowed ? data : data->clone();
+		}
+
 		network_data_smart_ptr data(new network_data());
 		{
-			boost::filesystem::ifstream in(data_filepath, std::ios_base::in | std::ios_base::binary);
+			boost::filesystem::ifstream in(file_path, std::ios_base::in | std::ios_base::binary);
 			data->read(in);
 		}
 		return data;
 	}
 
-	std::vector<output_neuron_value_set_smart_ptr> neural_network_toolset::run_batch(
-		supervised_data_reader& reader,
-		output_neuron_value_set_smart_ptr actual_neuron_value_set)
+	const char * neural_network_toolset::get_trained_ann_index_extractor_pattern() const
 	{
-		network_tester_smart_ptr tester = get_tester();
+		return load_bundle ? trained_ann_bundle_index_extractor_pattern : trained_ann_index_extractor_pattern;
+	}
 
+	std::vector<std::pair<unsigned int, boost::filesystem::path> > neural_network_toolset::get_trained_ann_list(
+		const char * index_extractor_pattern,
+		bool is_test_validate_ann_index_applied)
+	{
 		boost::filesystem::path batch_folder = get_working_data_folder() / get_ann_subfolder_name();
 
-		nnforge_regex expression(trained_ann_index_extractor_pattern);
+		nnforge_regex expression(index_extractor_pattern);
 		nnforge_cmatch what;
 
-		std::vector<float> invalid_ratio_list;
-		std::vector<output_neuron_value_set_smart_ptr> predicted_neuron_value_set_list;
+		std::vector<std::pair<unsigned int, boost::filesystem::path> > res;
 		for(boost::filesystem::directory_iterator it = boost::filesystem::directory_iterator(batch_folder); it != boost::filesystem::directory_iterator(); ++it)
 		{
 			boost::filesystem::path file_path = it->path();
@@ -619,25 +749,105 @@ namespace nnforge
 			if (nnforge_regex_search(file_name.c_str(), what, expression))
 			{
 				unsigned int index = static_cast<unsigned int>(atol(std::string(what[1].first, what[1].second).c_str()));
-				if ((test_validate_ann_index >= 0) && (test_validate_ann_index != index))
+				if (is_test_validate_ann_index_applied && (test_validate_ann_index >= 0) && (static_cast<unsigned int>(test_validate_ann_index) != index))
 					continue;
 
-				network_data_smart_ptr data(new network_data());
-				{
-					boost::filesystem::ifstream in(file_path, std::ios_base::in | std::ios_base::binary);
-					data->read(in);
-				}
+				res.push_back(std::make_pair(index, file_path));
+			}
+		}
+
+		std::sort(res.begin(), res.end());
+
+		return res;
+	}
+
+	boost::filesystem::path neural_network_toolset::get_quantization_data_filepath(unsigned int ann_id)
+	{
+		return get_working_data_folder() / get_ann_subfolder_name() / (boost::format("ann_trained_%|1$03d|.quant") % ann_id).str();
+	}
+
+	quantization_data_smart_ptr neural_network_toolset::load_quantization_data(unsigned int ann_id)
+	{
+		boost::filesystem::path quantization_filepath = get_quantization_data_filepath(ann_id);
+		if (!boost::filesystem::exists(quantization_filepath))
+			throw neural_network_exception((boost::format("Quantization data %1% not found, run calibrate_quantization first") % quantization_filepath.string()).str());
+
+		quantization_data_smart_ptr quantization(new quantization_data());
+		{
+			boost::filesystem::ifstream in(quantization_filepath, std::ios_base::in | std::ios_base::binary);
+			quantization->read(in);
+		}
+		return quantization;
+	}
+
+	std::vector<output_neuron_value_set_smart_ptr> neural_network_toolset::run_batch(
+		supervised_data_reader& reader,
+		output_neuron_value_set_smart_ptr actual_neuron_value_set)
+	{
+		network_tester_smart_ptr tester = get_tester();
+
+		std::vector<float> invalid_ratio_list;
+		std::vector<output_neuron_value_set_smart_ptr> predicted_neuron_value_set_list;
+
+		if (ensemble_single_pass)
+		{
+			if (quantized_inference)
+				throw neural_network_exception("Quantized inference is not supported with ensemble_single_pass");
+
+			std::vector<network_data_smart_ptr> data_list = load_batch_ann_data_list();
+
+			testing_complete_result_set testing_res(get_error_function(), actual_neuron_value_set);
+			tester->test(
+				reader,
+				data_list,
+				get_ensemble_merge_type(),
+				testing_res);
+			std::cout << "# " << data_list.size() << " ANNs run in single pass" << std::endl;
 
+			predicted_neuron_value_set_list.push_back(testing_res.predicted_output_neuron_value_set);
+
+			return predicted_neuron_value_set_list;
+		}
+
+		std::vector<std::pair<unsigned int, boost::filesystem::path> > ann_list = get_trained_ann_list(get_trained_ann_index_extractor_pattern(), true);
+
+		for(std::vector<std::pair<unsigned int, boost::filesystem::path> >::const_iterator ann_it = ann_list.begin(); ann_it != ann_list.end(); ++ann_it)
+		{
+			unsigned int index = ann_it->first;
+			const boost::filesystem::path& file_path = ann_it->second;
+
+			network_data_smart_ptr data = load_ann_data(file_path, true);
+
+			tester->set_data(data);
+
+			testing_complete_result_set testing_res(get_error_function(), actual_neuron_value_set);
+			tester->test(
+				reader,
+				testing_res);
+			std::cout << "# " << index << ", ";
+			get_validating_visualizer()->dump(std::cout, testing_res);
+			std::cout << std::endl;
+
+			if (quantized_inference)
+			{
+				// Report float and int8 results side by side so that the accuracy cost of quantization is visible
+				tester->set_quantization_data(load_quantization_data(index));
 				tester->set_data(data);
 
-				testing_complete_result_set testing_res(get_error_function(), actual_neuron_value_set);
+				testing_complete_result_set quantized_testing_res(get_error_function(), actual_neuron_value_set);
 				tester->test(
 					reader,
-					testing_res);
-				std::cout << "# " << index << ", ";
-				get_validating_visualizer()->dump(std::cout, testing_res);
+					quantized_testing_res);
+				std::cout << "# " << index << ", int8, ";
+				get_validating_visualizer()->dump(std::cout, quantized_testing_res);
 				std::cout << std::endl;
 
+				tester->set_quantization_data(const_quantization_data_smart_ptr());
+
+				predicted_neuron_value_set_list.push_back(quantized_testing_res.predicted_output_neuron_value_set);
+			}
+			else
+			{
 				predicted_neuron_value_set_list.push_back(testing_res.predicted_output_neuron_value_set);
 			}
 		}
@@ -649,45 +859,76 @@ namespace nnforge
 	{
 		network_tester_smart_ptr tester = get_tester();
 
-		boost::filesystem::path batch_folder = get_working_data_folder() / get_ann_subfolder_name();
-
-		nnforge_regex expression(trained_ann_index_extractor_pattern);
-		nnforge_cmatch what;
-
 		std::vector<float> invalid_ratio_list;
 		std::vector<output_neuron_value_set_smart_ptr> predicted_neuron_value_set_list;
-		for(boost::filesystem::directory_iterator it = boost::filesystem::directory_iterator(batch_folder); it != boost::filesystem::directory_iterator(); ++it)
+
+		if (ensemble_single_pass)
 		{
-			boost::filesystem::path file_path = it->path();
-			std::string file_name = file_path.filename().string();
+			if (quantized_inference)
+				throw neural_network_exception("Quantized inference is not supported with ensemble_single_pass");
 
-			if (nnforge_regex_search(file_name.c_str(), what, expression))
-			{
-				unsigned int index = static_cast<unsigned int>(atol(std::string(what[1].first, what[1].second).c_str()));
-				if ((test_validate_ann_index >= 0) && (test_validate_ann_index != index))
-					continue;
+			std::vector<network_data_smart_ptr> data_list = load_batch_ann_data_list();
 
-				network_data_smart_ptr data(new network_data());
-				{
-					boost::filesystem::ifstream in(file_path, std::ios_base::in | std::ios_base::binary);
-					data->read(in);
-				}
+			predicted_neuron_value_set_list.push_back(tester->run(reader, data_list, get_ensemble_merge_type(), sample_count));
+			std::cout << "# " << data_list.size() << " ANNs run in single pass" << std::endl;
 
-				tester->set_data(data);
+			return predicted_neuron_value_set_list;
+		}
 
-				boost::chrono::steady_clock::time_point start = boost::chrono::high_resolution_clock::now();
-				output_neuron_value_set_smart_ptr new_res = tester->run(reader, sample_count);
-				boost::chrono::duration<float> sec = boost::chrono::high_resolution_clock::now() - start;
-				std::cout << "# " << index;
-				std::cout << std::endl;
+		std::vector<std::pair<unsigned int, boost::filesystem::path> > ann_list = get_trained_ann_list(get_trained_ann_index_extractor_pattern(), true);
 
-				predicted_neuron_value_set_list.push_back(new_res);
-			}
+		for(std::vector<std::pair<unsigned int, boost::filesystem::path> >::const_iterator ann_it = ann_list.begin(); ann_it != ann_list.end(); ++ann_it)
+		{
+			unsigned int index = ann_it->first;
+			const boost::filesystem::path& file_path = ann_it->second;
+
+			network_data_smart_ptr data = load_ann_data(file_path, true);
+
+			tester->set_quantization_data(quantized_inference ? load_quantization_data(index) : const_quantization_data_smart_ptr());
+			tester->set_data(data);
+
+			boost::chrono::steady_clock::time_point start = boost::chrono::high_resolution_clock::now();
+			output_neuron_value_set_smart_ptr new_res = tester->run(reader, sample_count);
+			boost::chrono::duration<float> sec = boost::chrono::high_resolution_clock::now() - start;
+			std::cout << "# " << index;
+			std::cout << std::endl;
+
+			predicted_neuron_value_set_list.push_back(new_res);
 		}
 
 		return predicted_neuron_value_set_list;
 	}
 
+	std::vector<network_data_smart_ptr> neural_network_toolset::load_batch_ann_data_list()
+	{
+		boost::filesystem::path batch_folder = get_working_data_folder() / get_ann_subfolder_name();
+
+		std::vector<std::pair<unsigned int, boost::filesystem::path> > ann_list = get_trained_ann_list(get_trained_ann_index_extractor_pattern(), true);
+
+		std::vector<network_data_smart_ptr> res;
+		for(std::vector<std::pair<unsigned int, boost::filesystem::path> >::const_iterator ann_it = ann_list.begin(); ann_it != ann_list.end(); ++ann_it)
+		{
+			network_data_smart_ptr data = load_ann_data(ann_it->second, true);
+
+			res.push_back(data);
+		}
+
+		if (res.empty())
+			throw neural_network_exception((boost::format("No trained ANNs found in %1%") % batch_folder.string()).str());
+
+		return res;
+	}
+
+	output_neuron_value_set::merge_type_enum neural_network_toolset::get_ensemble_merge_type() const
+	{
+		if (ensemble_merge == "average")
+			return output_neuron_value_set::merge_average;
+		else if (ensemble_merge == "median")
+			return output_neuron_value_set::merge_median;
+		else
+			throw neural_network_exception((boost::format("Unknown ensemble merge type specified: %1%") % ensemble_merge).str());
+	}
+
 	unsigned int neural_network_toolset::get_testing_sample_count() const
 	{
 		return 1;
@@ -711,9 +952,9 @@ namespace nnforge
 
 			testing_complete_result_set complete_result_set_avg(get_error_function(), actual_neuron_value_set);
 			{
-				complete_result_set_avg.predicted_output_neuron_value_set = output_neuron_value_set_smart_ptr(new output_neuron_value_set(predicted_neuron_value_set_list, output_neuron_value_set::merge_average));
+				complete_result_set_avg.predicted_output_neuron_value_set = output_neuron_value_set_smart_ptr(new output_neuron_value_set(predicted_neuron_value_set_list, get_ensemble_merge_type()));
 				complete_result_set_avg.recalculate_mse();
-				std::cout << "Merged (average), ";
+				std::cout << "Merged (" << ensemble_merge << "), ";
 				get_validating_visualizer()->dump(std::cout, complete_result_set_avg);
 				std::cout << std::endl;
 			}
@@ -937,7 +1178,7 @@ namespace nnforge
 		boost::filesystem::path snapshot_folder = get_working_data_folder() / snapshot_subfolder_name;
 		boost::filesystem::create_directories(snapshot_folder);
 
-		network_data_smart_ptr data = load_ann_data(snapshot_ann_index);
+		network_data_smart_ptr data = load_ann_data(snapshot_ann_index, false);
 
 		std::pair<unsupervised_data_reader_smart_ptr, unsigned int> reader_and_sample_count = get_data_reader_and_sample_count_for_snapshots();
 		unsupervised_data_reader_smart_ptr reader = reader_and_sample_count.first;
@@ -1075,7 +1316,7 @@ namespace nnforge
 		}
 		std::vector<layer_data_configuration_list> layer_data_configuration_list_list = schema->get_layer_data_configuration_list_list();
 
-		network_data_smart_ptr data = load_ann_data(snapshot_ann_index);
+		network_data_smart_ptr data = load_ann_data(snapshot_ann_index, false);
 
 		std::string ann_snapshot_filename = "trained";
 		save_ann_snapshot(ann_snapshot_filename, *data, layer_data_configuration_list_list);
@@ -1098,7 +1339,7 @@ namespace nnforge
 	{
 		network_tester_smart_ptr tester = get_tester();
 
-		network_data_smart_ptr data = load_ann_data(snapshot_ann_index);
+		network_data_smart_ptr data = load_ann_data(snapshot_ann_index, true);
 
 		tester->set_data(data);
 
@@ -1152,24 +1393,12 @@ namespace nnforge
 
 	unsigned int neural_network_toolset::get_starting_index_for_batch_training()
 	{
-		nnforge_regex expression(trained_ann_index_extractor_pattern);
-		nnforge_cmatch what;
-
-		int max_index = -1;
-		boost::filesystem::path batch_folder = get_working_data_folder() / get_ann_subfolder_name();
-		for(boost::filesystem::directory_iterator it = boost::filesystem::directory_iterator(batch_folder); it != boost::filesystem::directory_iterator(); it++)
-		{
-			boost::filesystem::path file_path = it->path();
-			std::string file_name = file_path.filename().string();
+		std::vector<std::pair<unsigned int, boost::filesystem::path> > ann_list = get_trained_ann_list(trained_ann_index_extractor_pattern, false);
 
-			if (nnforge_regex_search(file_name.c_str(), what, expression))
-			{
-				int index = atol(std::string(what[1].first, what[1].second).c_str());
-				max_index = std::max<int>(max_index, index); 
-			}
-		}
+		// The list is sorted by index
+		unsigned int starting_index = ann_list.empty() ? 0 : ann_list.back().first + 1;
 
-		return static_cast<unsigned int>(max_index + 1) + batch_offset;
+		return starting_index + batch_offset;
 	}
 
 	std::vector<network_data_pusher_smart_ptr> neural_network_toolset::get_validators_for_training(network_schema_smart_ptr schema)
@@ -1179,12 +1408,21 @@ namespace nnforge
 		if (is_training_with_validation())
 		{
 			std::pair<supervised_data_reader_smart_ptr, unsigned int> validating_data_reader_and_sample_count = get_data_reader_for_validating_and_sample_count();
-			res.push_back(network_data_pusher_smart_ptr(new validate_progress_network_data_pusher(
-				tester_factory->create(schema),
-				validating_data_reader_and_sample_count.first,
-				get_validating_visualizer(),
-				get_error_function(),
-				validating_data_reader_and_sample_count.second)));
+			if (async_validation)
+				res.push_back(network_data_pusher_smart_ptr(new async_validate_progress_network_data_pusher(
+					tester_factory->create(schema),
+					validating_data_reader_and_sample_count.first,
+					get_validating_visualizer(),
+					get_error_function(),
+					validating_data_reader_and_sample_count.second,
+					1)));
+			else
+				res.push_back(network_data_pusher_smart_ptr(new validate_progress_network_data_pusher(
+					tester_factory->create(schema),
+					validating_data_reader_and_sample_count.first,
+					get_validating_visualizer(),
+					get_error_function(),
+					validating_data_reader_and_sample_count.second)));
 		}
 
 		return res;
@@ -1205,7 +1443,7 @@ namespace nnforge
 			std::vector<data_transformer_smart_ptr> data_transformer_list = get_input_data_transformer_list_for_training();
 			for(std::vector<data_transformer_smart_ptr>::iterator it = data_transformer_list.begin(); it != data_transformer_list.end(); ++it)
 			{
-				supervised_data_reader_smart_ptr new_reader(new supervised_transformed_input_data_reader(current_reader, *it));
+				supervised_data_reader_smart_ptr new_reader(new supervised_transformed_input_data_reader(current_reader, *it, augmentation_worker_count));
 				current_reader = new_reader;
 			}
 		}
@@ -1217,11 +1455,19 @@ namespace nnforge
 				current_reader = new_reader;
 			}
 		}
+		if (prefetch_entry_count > 0)
+		{
+			supervised_data_reader_smart_ptr new_reader(new supervised_prefetching_data_reader(current_reader, prefetch_entry_count));
+			current_reader = new_reader;
+		}
 		return current_reader;
 	}
 
 	supervised_data_reader_smart_ptr neural_network_toolset::get_initial_data_reader_for_training() const
 	{
+		if (mmap_training_data)
+			return supervised_data_reader_smart_ptr(new supervised_data_mapped_reader(get_working_data_folder() / training_randomized_data_filename));
+
 		nnforge_shared_ptr<std::istream> training_data_stream(new boost::filesystem::ifstream(get_working_data_folder() / training_randomized_data_filename, std::ios_base::in | std::ios_base::binary));
 		supervised_data_reader_smart_ptr current_reader(new supervised_data_stream_reader(training_data_stream));
 		return current_reader;
@@ -1236,7 +1482,7 @@ namespace nnforge
 			std::vector<data_transformer_smart_ptr> data_transformer_list = get_input_data_transformer_list_for_validating();
 			for(std::vector<data_transformer_smart_ptr>::iterator it = data_transformer_list.begin(); it != data_transformer_list.end(); ++it)
 			{
-				supervised_data_reader_smart_ptr new_reader(new supervised_transformed_input_data_reader(current_reader, *it));
+				supervised_data_reader_smart_ptr new_reader(new supervised_transformed_input_data_reader(current_reader, *it, augmentation_worker_count));
 				sample_count *= (*it)->get_sample_count();
 				current_reader = new_reader;
 			}
@@ -1250,6 +1496,11 @@ namespace nnforge
 				current_reader = new_reader;
 			}
 		}
+		if (prefetch_entry_count > 0)
+		{
+			supervised_data_reader_smart_ptr new_reader(new supervised_prefetching_data_reader(current_reader, prefetch_entry_count));
+			current_reader = new_reader;
+		}
 
 		return std::make_pair(current_reader, sample_count);
 	}
@@ -1269,7 +1520,7 @@ namespace nnforge
 			std::vector<data_transformer_smart_ptr> data_transformer_list = get_input_data_transformer_list_for_testing();
 			for(std::vector<data_transformer_smart_ptr>::iterator it = data_transformer_list.begin(); it != data_transformer_list.end(); ++it)
 			{
-				supervised_data_reader_smart_ptr new_reader(new supervised_transformed_input_data_reader(current_reader, *it));
+				supervised_data_reader_smart_ptr new_reader(new supervised_transformed_input_data_reader(current_reader, *it, augmentation_worker_count));
 				sample_count *= (*it)->get_sample_count();
 				current_reader = new_reader;
 			}
@@ -1283,6 +1534,11 @@ namespace nnforge
 				current_reader = new_reader;
 			}
 		}
+		if (prefetch_entry_count > 0)
+		{
+			supervised_data_reader_smart_ptr new_reader(new supervised_prefetching_data_reader(current_reader, prefetch_entry_count));
+			current_reader = new_reader;
+		}
 
 		return std::make_pair(current_reader, sample_count);
 	}
@@ -1302,11 +1558,16 @@ namespace nnforge
 			std::vector<data_transformer_smart_ptr> data_transformer_list = get_input_data_transformer_list_for_testing();
 			for(std::vector<data_transformer_smart_ptr>::iterator it = data_transformer_list.begin(); it != data_transformer_list.end(); ++it)
 			{
-				unsupervised_data_reader_smart_ptr new_reader(new unsupervised_transformed_input_data_reader(current_reader, *it));
+				unsupervised_data_reader_smart_ptr new_reader(new unsupervised_transformed_input_data_reader(current_reader, *it, augmentation_worker_count));
 				sample_count *= (*it)->get_sample_count();
 				current_reader = new_reader;
 			}
 		}
+		if (prefetch_entry_count > 0)
+		{
+			unsupervised_data_reader_smart_ptr new_reader(new unsupervised_prefetching_data_reader(current_reader, prefetch_entry_count));
+			current_reader = new_reader;
+		}
 
 		return std::make_pair(current_reader, sample_count);
 	}
@@ -1348,23 +1609,36 @@ namespace nnforge
 
 		complex_network_data_pusher progress;
 
-		if (dump_resume)
+		// Workers other than 0 hold the same weights, they only report their progress
+		bool is_main_worker = (data_parallel_worker_id == 0);
+
+		if (dump_resume && is_main_worker)
 		{
-			progress.push_back(network_data_pusher_smart_ptr(new save_resume_network_data_pusher(batch_resume_folder)));
+			if (dump_resume_async)
+				progress.push_back(network_data_pusher_smart_ptr(new async_save_resume_network_data_pusher(batch_resume_folder, 1, dump_resume_epoch_interval, dump_resume_time_interval)));
+			else
+				progress.push_back(network_data_pusher_smart_ptr(new save_resume_network_data_pusher(batch_resume_folder, dump_resume_epoch_interval, dump_resume_time_interval)));
 		}
 
 		progress.push_back(network_data_pusher_smart_ptr(new report_progress_network_data_pusher()));
 
-		std::vector<network_data_pusher_smart_ptr> validators_for_training = get_validators_for_training(schema);
-		progress.insert(progress.end(), validators_for_training.begin(), validators_for_training.end());
+		if (is_main_worker)
+		{
+			std::vector<network_data_pusher_smart_ptr> validators_for_training = get_validators_for_training(schema);
+			progress.insert(progress.end(), validators_for_training.begin(), validators_for_training.end());
+		}
 
-		summarize_network_data_pusher res(batch_folder);
+		network_data_pusher_smart_ptr res;
+		if (is_main_worker)
+			res = network_data_pusher_smart_ptr(new summarize_network_data_pusher(batch_folder));
+		else
+			res = network_data_pusher_smart_ptr(new complex_network_data_pusher());
 
 		trainer->train(
 			*training_data_reader,
 			*peeker,
 			progress,
-			res);
+			*res);
 	}
 
 	void neural_network_toolset::profile_updater()
@@ -1381,6 +1655,7 @@ namespace nnforge
 			get_dropout_rate_map(),
 			get_weight_vector_bound_map(),
 			weight_decay);
+		updater->set_profiling(true);
 
 		supervised_data_reader_smart_ptr training_data_reader = get_data_reader_for_training();
 		training_data_reader = supervised_data_reader_smart_ptr(new supervised_limited_entry_count_data_reader(training_data_reader, profile_updater_entry_count));
@@ -1447,8 +1722,55 @@ namespace nnforge
 			float gflops = flops / time_to_complete_seconds * 1.0e-9F;
 			std::cout << (boost::format("%|1$.1f| GFLOPs, %|2$.2f| seconds") % gflops % time_to_complete_seconds) << std::endl;
 		}
+		std::cout << *updater->get_profiling_result();
 
 		std::cout << data[data.size()-1]->get_stat() << std::endl;
+
+		// Throughput of asynchronous update versus thread count
+		if (training_algo == "hogwild")
+		{
+			unsigned int max_thread_count = (hogwild_thread_count > 0) ? hogwild_thread_count : std::max(updater_factory->get_default_asynchronous_thread_count(), 1U);
+			std::vector<unsigned int> thread_count_list;
+			for(unsigned int thread_count = 1; thread_count < max_thread_count; thread_count *= 2)
+				thread_count_list.push_back(thread_count);
+			thread_count_list.push_back(max_thread_count);
+
+			if (time_to_complete_seconds != 0.0F)
+				std::cout << (boost::format("Synchronous update: %|1$.1f| entries/s") % (static_cast<float>(training_data_reader->get_entry_count()) / time_to_complete_seconds)) << std::endl;
+
+			float single_thread_entries_per_second = 0.0F;
+			for(std::vector<unsigned int>::const_iterator it = thread_count_list.begin(); it != thread_count_list.end(); ++it)
+			{
+				network_updater_smart_ptr asynchronous_updater = updater_factory->create_asynchronous(
+					schema,
+					get_error_function(),
+					get_dropout_rate_map(),
+					get_weight_vector_bound_map(),
+					weight_decay,
+					*it);
+
+				// Each run starts from the same weights
+				std::vector<network_data_smart_ptr> asynchronous_data;
+				for(std::vector<network_data_smart_ptr>::const_iterator data_it = data.begin(); data_it != data.end(); ++data_it)
+					asynchronous_data.push_back(network_data_smart_ptr(new network_data(**data_it)));
+
+				training_data_reader->reset();
+				boost::chrono::steady_clock::time_point asynchronous_start = boost::chrono::high_resolution_clock::now();
+				asynchronous_updater->update(
+					*training_data_reader,
+					learning_rates,
+					asynchronous_data);
+				boost::chrono::duration<float> asynchronous_sec = boost::chrono::high_resolution_clock::now() - asynchronous_start;
+
+				if (asynchronous_sec.count() != 0.0F)
+				{
+					float entries_per_second = static_cast<float>(training_data_reader->get_entry_count()) / asynchronous_sec.count();
+					if (it == thread_count_list.begin())
+						single_thread_entries_per_second = entries_per_second;
+					std::cout << (boost::format("Hogwild update, %1% threads: %|2$.1f| entries/s, %|3$.2f|x of single thread") % *it % entries_per_second % (entries_per_second / single_thread_entries_per_second)) << std::endl;
+				}
+			}
+		}
 	}
 
 	void neural_network_toolset::profile_hessian()
@@ -1460,6 +1782,7 @@ namespace nnforge
 		}
 
 		hessian_calculator_smart_ptr hessian = hessian_factory->create(schema);
+		hessian->set_profiling(true);
 
 		supervised_data_reader_smart_ptr training_data_reader = get_data_reader_for_training();
 
@@ -1489,10 +1812,255 @@ namespace nnforge
 			float gflops = flops / time_to_complete_seconds * 1.0e-9F;
 			std::cout << (boost::format("%|1$.1f| GFLOPs, %|2$.2f| seconds") % gflops % time_to_complete_seconds) << std::endl;
 		}
+		std::cout << *hessian->get_profiling_result();
 
 		std::cout << hessian_data->get_stat() << std::endl;
 	}
 
+	void neural_network_toolset::profile_tester()
+	{
+		network_tester_smart_ptr tester = get_tester();
+
+		unsigned int ann_id = (test_validate_ann_index >= 0) ? static_cast<unsigned int>(test_validate_ann_index) : 0;
+		tester->set_data(load_ann_data(ann_id, true));
+
+		supervised_data_reader_smart_ptr reader = get_data_reader_for_validating_and_sample_count().first;
+		if (profile_tester_entry_count > 0)
+			reader = supervised_data_reader_smart_ptr(new supervised_limited_entry_count_data_reader(reader, profile_tester_entry_count));
+
+		if (!quantized_inference)
+		{
+			profile_tester_pass(tester, reader, std::string());
+			return;
+		}
+
+		std::pair<float, float> float_res = profile_tester_pass(tester, reader, "float");
+
+		tester->set_quantization_data(load_quantization_data(ann_id));
+		tester->set_data(load_ann_data(ann_id, true));
+		reader->reset();
+		std::pair<float, float> int8_res = profile_tester_pass(tester, reader, "int8");
+		tester->set_quantization_data(const_quantization_data_smart_ptr());
+
+		if (float_res.first > 0.0F)
+			std::cout << (boost::format("int8 vs float throughput: %|1$.2f|x") % (int8_res.first / float_res.first)) << std::endl;
+		if (int8_res.second > 0.0F)
+			std::cout << (boost::format("int8 vs float single entry latency speedup: %|1$.2f|x") % (float_res.second / int8_res.second)) << std::endl;
+	}
+
+	std::pair<float, float> neural_network_toolset::profile_tester_pass(
+		network_tester_smart_ptr tester,
+		supervised_data_reader_smart_ptr reader,
+		const std::string& name)
+	{
+		std::string prefix = name.empty() ? std::string() : name + ": ";
+		std::pair<float, float> res(0.0F, 0.0F);
+
+		// Throughput of the batched path
+		{
+			tester->set_profiling(true);
+			boost::chrono::steady_clock::time_point start = boost::chrono::high_resolution_clock::now();
+			output_neuron_value_set_smart_ptr predicted_neuron_value_set = tester->run(*reader, 1);
+			boost::chrono::duration<float> sec = boost::chrono::high_resolution_clock::now() - start;
+			float time_to_complete_seconds = sec.count();
+
+			unsigned int entry_count = static_cast<unsigned int>(predicted_neuron_value_set->neuron_value_list.size());
+			if (time_to_complete_seconds != 0.0F)
+			{
+				float flops = static_cast<float>(entry_count) * tester->get_flops_for_single_entry();
+				float gflops = flops / time_to_complete_seconds * 1.0e-9F;
+				float entries_per_second = static_cast<float>(entry_count) / time_to_complete_seconds;
+				res.first = entries_per_second;
+				std::cout << prefix << (boost::format("%1% entries, %|2$.1f| entries/s, %|3$.1f| GFLOPs, %|4$.2f| seconds") % entry_count % entries_per_second % gflops % time_to_complete_seconds) << std::endl;
+			}
+			if (!prefix.empty())
+				std::cout << prefix << "per layer" << std::endl;
+			std::cout << *tester->get_profiling_result();
+			tester->set_profiling(false);
+		}
+
+		// Latency of the single entry path
+		if (profile_tester_single_run_count > 0)
+		{
+			reader->reset();
+			const unsigned int input_neuron_count = reader->get_input_configuration().get_neuron_count();
+			const neuron_data_type::input_type type_code = reader->get_input_type();
+			std::vector<unsigned char> input(input_neuron_count * reader->get_input_neuron_elem_size());
+
+			std::vector<float> latency_list;
+			// The first run allocates buffers, it is not measured
+			for(unsigned int run_id = 0; run_id <= profile_tester_single_run_count; ++run_id)
+			{
+				if (!reader->read(&(*input.begin())))
+				{
+					reader->reset();
+					if (!reader->read(&(*input.begin())))
+						throw neural_network_exception("No entries available to profile tester with");
+				}
+
+				boost::chrono::steady_clock::time_point start = boost::chrono::high_resolution_clock::now();
+				tester->run(&(*input.begin()), type_code, input_neuron_count);
+				boost::chrono::duration<float> sec = boost::chrono::high_resolution_clock::now() - start;
+
+				if (run_id > 0)
+					latency_list.push_back(sec.count());
+			}
+
+			std::sort(latency_list.begin(), latency_list.end());
+			float p50 = latency_list[(latency_list.size() - 1) * 50 / 100];
+			float p99 = latency_list[(latency_list.size() - 1) * 99 / 100];
+			res.second = p50;
+			std::cout << prefix << (boost::format("Single entry latency over %1% runs: p50 %|2$.3f| ms, p99 %|3$.3f| ms, max %|4$.3f| ms") % latency_list.size() % (p50 * 1000.0F) % (p99 * 1000.0F) % (latency_list.back() * 1000.0F)) << std::endl;
+		}
+
+		return res;
+	}
+
+	void neural_network_toolset::convert_data_storage()
+	{
+		if (data_storage.empty())
+			throw neural_network_exception("data_storage option should be specified for convert_data_storage");
+		weight_storage_type::storage_type storage = weight_storage_type::parse(data_storage);
+
+		// The conversion may be lossy, the original ANNs are kept intact
+		boost::filesystem::path converted_batch_folder = get_working_data_folder() / (boost::format("%1%_%2%") % get_ann_subfolder_name().string() % weight_storage_type::get_name(storage)).str();
+		boost::filesystem::create_directories(converted_batch_folder);
+
+		std::vector<std::pair<unsigned int, boost::filesystem::path> > ann_list = get_trained_ann_list(trained_ann_index_extractor_pattern, true);
+
+		for(std::vector<std::pair<unsigned int, boost::filesystem::path> >::const_iterator ann_it = ann_list.begin(); ann_it != ann_list.end(); ++ann_it)
+		{
+			const boost::filesystem::path& file_path = ann_it->second;
+
+			network_data data;
+			weight_storage_type::storage_type storage_read;
+			{
+				boost::filesystem::ifstream in(file_path, std::ios_base::in | std::ios_base::binary);
+				data.read(in, &storage_read);
+			}
+
+			boost::filesystem::path converted_file_path = converted_batch_folder / file_path.filename();
+			{
+				boost::filesystem::ofstream out(converted_file_path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+				data.write(out, storage);
+			}
+
+			std::cout << file_path.filename().string() << ": " << weight_storage_type::get_name(storage_read) << " -> " << weight_storage_type::get_name(storage) << " in " << converted_batch_folder.string() << std::endl;
+		}
+	}
+
+	void neural_network_toolset::calibrate_quantization()
+	{
+		network_tester_smart_ptr tester = get_tester();
+		quantization_calibrator calibrator(tester);
+
+		std::vector<std::pair<unsigned int, boost::filesystem::path> > ann_list = get_trained_ann_list(trained_ann_index_extractor_pattern, true);
+
+		for(std::vector<std::pair<unsigned int, boost::filesystem::path> >::const_iterator ann_it = ann_list.begin(); ann_it != ann_list.end(); ++ann_it)
+		{
+			unsigned int index = ann_it->first;
+			const boost::filesystem::path& file_path = ann_it->second;
+
+			network_data_smart_ptr data(new network_data());
+			{
+				boost::filesystem::ifstream in(file_path, std::ios_base::in | std::ios_base::binary);
+				data->read(in);
+			}
+
+			tester->set_data(data);
+
+			supervised_data_reader_smart_ptr reader = get_data_reader_for_validating_and_sample_count().first;
+			quantization_data_smart_ptr quantization = calibrator.calibrate(*reader, quantization_calibration_entry_count);
+			quantization->quantize_weights(*data);
+
+			boost::filesystem::path quantization_filepath = get_quantization_data_filepath(index);
+			{
+				boost::filesystem::ofstream out(quantization_filepath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+				quantization->write(out);
+			}
+
+			std::cout << quantization_filepath.filename().string() << ":";
+			for(std::vector<float>::const_iterator range_it = quantization->input_range_list.begin(); range_it != quantization->input_range_list.end(); ++range_it)
+				std::cout << " " << *range_it;
+			std::cout << std::endl;
+		}
+	}
+
+	void neural_network_toolset::train_data_parallel()
+	{
+		if (data_parallel_worker_count < 2)
+			throw neural_network_exception("data_parallel_worker_count should be at least 2 for train_data_parallel");
+
+		// The segment left by the crashed run would make the workers fail
+		boost::interprocess::shared_memory_object::remove(data_parallel_segment_name.c_str());
+
+		std::vector<int> exit_code_list(data_parallel_worker_count, 0);
+		boost::thread_group workers;
+		for(unsigned int worker_id = 0; worker_id < data_parallel_worker_count; ++worker_id)
+		{
+			std::string command = "\"" + executable_path + "\" train";
+			for(std::vector<std::string>::const_iterator it = worker_arg_list.begin(); it != worker_arg_list.end(); ++it)
+				command += " \"" + *it + "\"";
+			command += (boost::format(" --data_parallel_worker_id=%1%") % worker_id).str();
+
+			std::cout << "Starting worker " << worker_id << ": " << command << std::endl;
+			workers.create_thread(boost::bind(&neural_network_toolset::run_worker, command, &exit_code_list[worker_id]));
+		}
+		workers.join_all();
+
+		boost::interprocess::shared_memory_object::remove(data_parallel_segment_name.c_str());
+
+		for(unsigned int worker_id = 0; worker_id < data_parallel_worker_count; ++worker_id)
+			if (exit_code_list[worker_id] != 0)
+				throw neural_network_exception((boost::format("Worker %1% exited with code %2%") % worker_id % exit_code_list[worker_id]).str());
+	}
+
+	void neural_network_toolset::run_worker(
+		const std::string& command,
+		int * exit_code)
+	{
+		*exit_code = std::system(command.c_str());
+	}
+
+	void neural_network_toolset::create_bundle()
+	{
+		network_schema_smart_ptr schema(new network_schema());
+		{
+			boost::filesystem::ifstream in(get_working_data_folder() / schema_filename, std::ios_base::in | std::ios_base::binary);
+			schema->read(in);
+		}
+
+		normalize_data_transformer_smart_ptr input_normalizer;
+		if (boost::filesystem::exists(get_working_data_folder() / normalizer_input_filename))
+			input_normalizer = get_input_data_normalize_transformer();
+
+		boost::filesystem::path batch_folder = get_working_data_folder() / get_ann_subfolder_name();
+
+		std::vector<std::pair<unsigned int, boost::filesystem::path> > ann_list = get_trained_ann_list(trained_ann_index_extractor_pattern, true);
+
+		for(std::vector<std::pair<unsigned int, boost::filesystem::path> >::const_iterator ann_it = ann_list.begin(); ann_it != ann_list.end(); ++ann_it)
+		{
+			unsigned int index = ann_it->first;
+			const boost::filesystem::path& file_path = ann_it->second;
+
+			network_data_smart_ptr data(new network_data());
+			{
+				boost::filesystem::ifstream in(file_path, std::ios_base::in | std::ios_base::binary);
+				data->read(in);
+			}
+			data->check_network_data_consistency(*schema);
+
+			// Workers might be mapping the previous version of the bundle, so it is replaced rather than overwritten
+			boost::filesystem::path bundle_file_path = batch_folder / (boost::format("ann_trained_%|1$03d|.bundle") % index).str();
+			boost::filesystem::path temp_file_path = bundle_file_path;
+			temp_file_path += ".temp";
+			network_bundle::write(temp_file_path, *schema, *data, input_normalizer);
+			boost::filesystem::rename(temp_file_path, bundle_file_path);
+
+			std::cout << bundle_file_path.filename().string() << ": " << boost::filesystem::file_size(bundle_file_path) << " bytes" << (input_normalizer ? ", with input normalizer" : "") << std::endl;
+		}
+	}
+
 	network_output_type::output_type neural_network_toolset::get_network_output_type() const
 	{
 		return network_output_type::type_classifier;
@@ -153,6 +153,7 @@ namespace nnforge
 		static const char * ann_subfolder_name;
 		static const char * ann_resume_subfolder_name;
 		static const char * trained_ann_index_extractor_pattern;
+		static const char * trained_ann_bundle_index_extractor_pattern;
 		static const char * logfile_name;
 
 		network_tester_factory_smart_ptr tester_factory;
@@ -172,6 +173,8 @@ namespace nnforge
 		float learning_rate_rise_rate;
 		float max_mu;
 		bool per_layer_mu;
+		unsigned int hessian_refresh_epoch_count;
+		float hessian_blend_factor;
 		float mu_increase_factor;
 		unsigned int batch_offset;
 		std::string snapshot_mode;
@@ -181,11 +184,36 @@ namespace nnforge
 		std::string snapshot_data_set;
 		unsigned int profile_updater_entry_count;
 		unsigned int profile_hessian_entry_count;
+		unsigned int profile_tester_entry_count;
+		unsigned int profile_tester_single_run_count;
 		std::string training_algo;
+		unsigned int hogwild_thread_count;
 		bool dump_resume;
+		unsigned int dump_resume_epoch_interval;
+		float dump_resume_time_interval;
+		bool dump_resume_async;
 		bool load_resume;
 		unsigned int epoch_count_in_training_set;
 		float weight_decay;
+		bool ensemble_single_pass;
+		bool load_bundle;
+		std::string ensemble_merge;
+		unsigned int prefetch_entry_count;
+		bool mmap_training_data;
+		unsigned int augmentation_worker_count;
+		bool async_validation;
+		std::string data_storage;
+		unsigned int quantization_calibration_entry_count;
+		bool quantized_inference;
+		unsigned int data_parallel_worker_count;
+		unsigned int data_parallel_worker_id;
+		std::string data_parallel_segment_name;
+		unsigned int data_parallel_sync_entry_count;
+		unsigned int data_parallel_sync_timeout;
+
+		std::string executable_path;
+		// Command line options except for action and worker ID, passed to the workers started by train_data_parallel
+		std::vector<std::string> worker_arg_list;
 
 	protected:
 		std::vector<output_neuron_value_set_smart_ptr> run_batch(
@@ -194,6 +222,10 @@ namespace nnforge
 
 		std::vector<output_neuron_value_set_smart_ptr> run_batch(unsupervised_data_reader& reader, unsigned int sample_count);
 
+		std::vector<network_data_smart_ptr> load_batch_ann_data_list();
+
+		output_neuron_value_set::merge_type_enum get_ensemble_merge_type() const;
+
 		void randomize_data();
 
 		void create();
@@ -219,14 +251,60 @@ namespace nnforge
 			const network_data& data,
 			const std::vector<layer_data_configuration_list>& layer_data_configuration_list_list);
 
-		network_data_smart_ptr load_ann_data(unsigned int ann_id);
+		network_data_smart_ptr load_ann_data(
+			unsigned int ann_id,
+			bool is_mapped_data_allowed);
+
+		// Reads either regular ANN data or the data from the bundle, depending on load_bundle
+		// Only testers accept mapped data with empty weight vectors, the bundle data is copied for other consumers unless is_mapped_data_allowed
+		network_data_smart_ptr load_ann_data(
+			const boost::filesystem::path& file_path,
+			bool is_mapped_data_allowed) const;
+
+		const char * get_trained_ann_index_extractor_pattern() const;
+
+		// Returns indexes and paths of files in the ANN folder matching index_extractor_pattern, sorted by index
+		// Only the ANN with test_validate_ann_index is returned if it is non-negative and is_test_validate_ann_index_applied
+		std::vector<std::pair<unsigned int, boost::filesystem::path> > get_trained_ann_list(
+			const char * index_extractor_pattern,
+			bool is_test_validate_ann_index_applied);
 
 		void train();
 
+		// Runs data_parallel_worker_count training workers as child processes on the local machine and waits for them
+		void train_data_parallel();
+
+		static void run_worker(
+			const std::string& command,
+			int * exit_code);
+
 		void profile_updater();
 
 		void profile_hessian();
 
+		// With quantized_inference float and int8 inference of the same ANN are profiled one after another and compared
+		void profile_tester();
+
+		// Profiles throughput of the batched path and latency of the single entry path,
+		// returns entries per second and median latency in seconds (0 if the latter is not measured)
+		std::pair<float, float> profile_tester_pass(
+			network_tester_smart_ptr tester,
+			supervised_data_reader_smart_ptr reader,
+			const std::string& name);
+
+		// Writes copies of trained ANNs with data_storage precision to a separate folder, reading them back widens weights to float
+		void convert_data_storage();
+
+		// Collects activation ranges of trained ANNs on validating data, quantizes their weights to int8 and stores both next to ANN data
+		void calibrate_quantization();
+
+		boost::filesystem::path get_quantization_data_filepath(unsigned int ann_id);
+
+		quantization_data_smart_ptr load_quantization_data(unsigned int ann_id);
+
+		// Packs schema, trained ANN data and input normalizer into memory mappable bundles, see network_bundle
+		void create_bundle();
+
 		normalize_data_transformer_smart_ptr get_input_data_normalize_transformer() const;
 
 		normalize_data_transformer_smart_ptr get_output_data_normalize_transformer() const;
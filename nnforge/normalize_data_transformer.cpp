@@ -86,6 +86,11 @@ namespace nnforge
 		return res;
 	}
 
+	bool normalize_data_transformer::is_parallel_transform_supported() const
+	{
+		return true;
+	}
+
 	void normalize_data_transformer::transform(
 		const void * data,
 		void * data_transformed,
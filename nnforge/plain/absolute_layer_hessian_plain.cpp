@@ -47,8 +47,8 @@ namespace nnforge
 			unsigned int entry_count) const
 		{
 			const int elem_count = static_cast<int>(entry_count * input_configuration_specific.get_neuron_count());
-			const std::vector<float>::const_iterator in_it = input_buffer->begin();
-			const std::vector<float>::iterator out_it = output_buffer->begin();
+			const additional_buffer::const_iterator in_it = input_buffer->begin();
+			const additional_buffer::iterator out_it = output_buffer->begin();
 
 			#pragma omp parallel for default(none) schedule(guided) num_threads(plain_config->openmp_thread_count)
 			for(int i = 0; i < elem_count; ++i)
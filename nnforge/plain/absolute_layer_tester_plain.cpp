@@ -46,7 +46,7 @@ namespace nnforge
 			unsigned int entry_count) const
 		{
 			const int elem_count = static_cast<int>(entry_count * input_configuration_specific.get_neuron_count());
-			const std::vector<float>::iterator in_it = input_buffer->begin();
+			const additional_buffer::iterator in_it = input_buffer->begin();
 
 			#pragma omp parallel for default(none) schedule(guided) num_threads(plain_config->openmp_thread_count)
 			for(int i = 0; i < elem_count; ++i)
@@ -23,6 +23,36 @@ namespace nnforge
 {
 	namespace plain
 	{
+		struct absolute_layer_updater_plain::test_body
+		{
+			additional_buffer::const_iterator in_it;
+			additional_buffer::iterator out_it;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				for(int i = begin; i < end; ++i)
+					*(out_it + i) = fabs(*(in_it + i));
+			}
+		};
+
+		struct absolute_layer_updater_plain::backprop_body
+		{
+			additional_buffer::const_iterator in_it;
+			additional_buffer::iterator in_err_it;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				for(int i = begin; i < end; ++i)
+				{
+					float val = *(in_it + i);
+					if (val < 0.0F)
+					{
+						*(in_err_it + i) = - *(in_err_it + i);
+					}
+				}
+			}
+		};
+
 		absolute_layer_updater_plain::absolute_layer_updater_plain()
 		{
 		}
@@ -52,12 +82,11 @@ namespace nnforge
 				throw neural_network_exception("absolute_layer_updater_plain is not able to run using the same input");
 
 			const int elem_count = static_cast<int>(updater_count * input_configuration_specific.get_neuron_count());
-			const std::vector<float>::const_iterator in_it = input_buffer->begin();
-			const std::vector<float>::iterator out_it = output_buffer->begin();
+			const additional_buffer::const_iterator in_it = input_buffer->begin();
+			const additional_buffer::iterator out_it = output_buffer->begin();
 
-			#pragma omp parallel for default(none) schedule(guided) num_threads(plain_config->openmp_thread_count)
-			for(int i = 0; i < elem_count; ++i)
-				*(out_it + i) = fabs(*(in_it + i));
+			const test_body body = { in_it, out_it };
+			plain_config->parallel_for(elem_count, body);
 		}
 
 		void absolute_layer_updater_plain::backprop(
@@ -71,21 +100,15 @@ namespace nnforge
 			const layer_data_list& data,
 			const layer_configuration_specific& input_configuration_specific,
 			const layer_configuration_specific& output_configuration_specific,
-			unsigned int updater_count) const
+			unsigned int updater_count,
+			unsigned int output_errors_zero_count) const
 		{
 			const int elem_count = static_cast<int>(updater_count * input_configuration_specific.get_neuron_count());
-			const std::vector<float>::const_iterator in_it = input_neurons->begin();
-			const std::vector<float>::iterator in_err_it = input_errors->begin();
+			const additional_buffer::const_iterator in_it = input_neurons->begin();
+			const additional_buffer::iterator in_err_it = input_errors->begin();
 
-			#pragma omp parallel for default(none) schedule(guided) num_threads(plain_config->openmp_thread_count)
-			for(int i = 0; i < elem_count; ++i)
-			{
-				float val = *(in_it + i);
-				if (val < 0.0F)
-				{
-					*(in_err_it + i) = - *(in_err_it + i);
-				}
-			}
+			const backprop_body body = { in_it, in_err_it };
+			plain_config->parallel_for(elem_count, body);
 		}
 
 		bool absolute_layer_updater_plain::is_in_place_backprop() const
@@ -0,0 +1,195 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "additional_buffer_planner.h"
+
+#include <algorithm>
+#ifdef NNFORGE_DEBUG_UNINITIALIZED_BUFFERS
+#include <limits>
+#endif
+
+namespace nnforge
+{
+	namespace plain
+	{
+		struct compare_buffer_size
+		{
+			compare_buffer_size(const std::vector<unsigned int>& elem_count_list)
+				: elem_count_list(elem_count_list)
+			{
+			}
+
+			bool operator()(unsigned int x, unsigned int y) const
+			{
+				return elem_count_list[x] > elem_count_list[y];
+			}
+
+			const std::vector<unsigned int>& elem_count_list;
+		};
+
+		additional_buffer_planner::additional_buffer_planner(
+			const const_layer_tester_plain_list& tester_list,
+			const const_layer_list& layer_list,
+			const layer_configuration_specific_list& layer_config_list,
+			plain_running_configuration_const_smart_ptr plain_config)
+			: plain_config(plain_config)
+			, storage_max_entry_count(0)
+		{
+			const unsigned int layer_count = static_cast<unsigned int>(tester_list.size());
+
+			// Lifetimes. The buffer is alive from the layer creating it till the last layer reading it;
+			// testers working in-place pass their input buffer through, extending its lifetime
+			const additional_buffer_smart_ptr external_input_buffer(new additional_buffer());
+			additional_buffer_smart_ptr current_buffer = external_input_buffer;
+			int current_buffer_id = -1;
+			for(unsigned int layer_id = 0; layer_id < layer_count; ++layer_id)
+			{
+				if (current_buffer_id >= 0)
+					buffer_list[current_buffer_id].last_layer_id = layer_id;
+
+				std::vector<std::pair<unsigned int, bool> > elem_count_list = tester_list[layer_id]->get_additional_buffer_elem_count_list(
+					layer_list[layer_id],
+					layer_config_list[layer_id],
+					layer_config_list[layer_id + 1],
+					plain_config);
+
+				// Identify the output buffer with placeholders, the testers return either the input buffer or one of the additional ones
+				additional_buffer_set placeholders;
+				std::vector<unsigned int> buffer_id_list;
+				for(std::vector<std::pair<unsigned int, bool> >::const_iterator it = elem_count_list.begin(); it != elem_count_list.end(); ++it)
+				{
+					placeholders.push_back(additional_buffer_smart_ptr(new additional_buffer()));
+					buffer_lifetime new_buffer;
+					new_buffer.elem_count = it->first;
+					new_buffer.per_entry = it->second;
+					new_buffer.first_layer_id = layer_id;
+					new_buffer.last_layer_id = layer_id;
+					new_buffer.storage_id = 0;
+					buffer_id_list.push_back(static_cast<unsigned int>(buffer_list.size()));
+					buffer_list.push_back(new_buffer);
+				}
+				layer_buffer_id_list.push_back(buffer_id_list);
+
+				additional_buffer_smart_ptr output_buffer = tester_list[layer_id]->get_output_buffer(current_buffer, placeholders);
+				if (output_buffer != current_buffer)
+				{
+					current_buffer = output_buffer;
+					current_buffer_id = buffer_id_list[std::find(placeholders.begin(), placeholders.end(), output_buffer) - placeholders.begin()];
+				}
+			}
+			// The output of the last layer is read after the run
+			if (current_buffer_id >= 0)
+				buffer_list[current_buffer_id].last_layer_id = layer_count;
+
+			// Storage assignment, largest buffers first
+			std::vector<unsigned int> buffer_id_list_sorted(buffer_list.size());
+			std::vector<unsigned int> elem_count_list(buffer_list.size());
+			for(unsigned int buffer_id = 0; buffer_id < buffer_list.size(); ++buffer_id)
+			{
+				buffer_id_list_sorted[buffer_id] = buffer_id;
+				elem_count_list[buffer_id] = buffer_list[buffer_id].elem_count;
+			}
+			std::stable_sort(buffer_id_list_sorted.begin(), buffer_id_list_sorted.end(), compare_buffer_size(elem_count_list));
+
+			for(std::vector<unsigned int>::const_iterator it = buffer_id_list_sorted.begin(); it != buffer_id_list_sorted.end(); ++it)
+			{
+				buffer_lifetime& buffer = buffer_list[*it];
+				unsigned int storage_id = 0;
+				for(; storage_id < storage_list.size(); ++storage_id)
+				{
+					const storage_info& storage = storage_list[storage_id];
+					if ((storage.per_entry == buffer.per_entry) && !is_overlapped(buffer, storage))
+						break;
+				}
+
+				if (storage_id == storage_list.size())
+				{
+					storage_info new_storage;
+					new_storage.elem_count = 0;
+					new_storage.per_entry = buffer.per_entry;
+					storage_list.push_back(new_storage);
+				}
+
+				storage_info& storage = storage_list[storage_id];
+				storage.elem_count = std::max(storage.elem_count, buffer.elem_count);
+				storage.buffer_id_list.push_back(*it);
+				buffer.storage_id = storage_id;
+			}
+		}
+
+		additional_buffer_planner::~additional_buffer_planner()
+		{
+		}
+
+		bool additional_buffer_planner::is_overlapped(
+			const buffer_lifetime& buffer,
+			const storage_info& storage) const
+		{
+			for(std::vector<unsigned int>::const_iterator it = storage.buffer_id_list.begin(); it != storage.buffer_id_list.end(); ++it)
+			{
+				const buffer_lifetime& other = buffer_list[*it];
+				if ((buffer.first_layer_id <= other.last_layer_id) && (other.first_layer_id <= buffer.last_layer_id))
+					return true;
+			}
+
+			return false;
+		}
+
+		void additional_buffer_planner::update_buffer_configuration(buffer_plain_size_configuration& buffer_configuration) const
+		{
+			for(std::vector<storage_info>::const_iterator it = storage_list.begin(); it != storage_list.end(); ++it)
+			{
+				size_t s = static_cast<size_t>(it->elem_count) * sizeof(float);
+				if (it->per_entry)
+					buffer_configuration.add_per_entry_buffer(s);
+				else
+					buffer_configuration.add_constant_buffer(s);
+			}
+		}
+
+		std::vector<additional_buffer_set> additional_buffer_planner::get_additional_buffers(unsigned int max_entry_count)
+		{
+			if (max_entry_count > storage_max_entry_count)
+			{
+				// Release the old storage before allocating the new one
+				storage_buffers.clear();
+				for(std::vector<storage_info>::const_iterator it = storage_list.begin(); it != storage_list.end(); ++it)
+					storage_buffers.push_back(plain_config->allocate_buffer(it->elem_count * (it->per_entry ? max_entry_count : 1)));
+				storage_max_entry_count = max_entry_count;
+			}
+#ifdef NNFORGE_DEBUG_UNINITIALIZED_BUFFERS
+			// The storage kept from the previous call holds valid values, reset them so that kernels reading them are caught
+			else
+			{
+				for(additional_buffer_set::const_iterator it = storage_buffers.begin(); it != storage_buffers.end(); ++it)
+					std::fill((*it)->begin(), (*it)->end(), std::numeric_limits<float>::quiet_NaN());
+			}
+#endif
+
+			std::vector<additional_buffer_set> res;
+			for(std::vector<std::vector<unsigned int> >::const_iterator it = layer_buffer_id_list.begin(); it != layer_buffer_id_list.end(); ++it)
+			{
+				additional_buffer_set additional_buffers;
+				for(std::vector<unsigned int>::const_iterator it2 = it->begin(); it2 != it->end(); ++it2)
+					additional_buffers.push_back(storage_buffers[buffer_list[*it2].storage_id]);
+				res.push_back(additional_buffers);
+			}
+
+			return res;
+		}
+	}
+}
@@ -0,0 +1,92 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include "layer_tester_plain.h"
+#include "plain_running_configuration.h"
+#include "buffer_plain_size_configuration.h"
+#include "../layer.h"
+#include "../layer_configuration_specific.h"
+#include "../nn_types.h"
+
+#include <vector>
+
+namespace nnforge
+{
+	namespace plain
+	{
+		// Computes lifetimes of the additional buffers of the testers over the layer list
+		// and lets the buffers with non-overlapping lifetimes share the same storage.
+		// The input buffer of the 1st layer is owned by the caller and is never shared
+		// The storage is shared across calls as well, thus the object owning the planner is not safe to be used from several threads at once
+		class additional_buffer_planner
+		{
+		public:
+			additional_buffer_planner(
+				const const_layer_tester_plain_list& tester_list,
+				const const_layer_list& layer_list,
+				const layer_configuration_specific_list& layer_config_list,
+				plain_running_configuration_const_smart_ptr plain_config);
+
+			~additional_buffer_planner();
+
+			// Adds shared storage only, it is less than the sum of the sizes of all the additional buffers
+			void update_buffer_configuration(buffer_plain_size_configuration& buffer_configuration) const;
+
+			// Returns the additional buffer set for each layer, the sets are to be passed to the testers as is.
+			// The storage is kept between calls and is reallocated only when max_entry_count grows,
+			// buffers returned by the previous call are overwritten by the next run
+			std::vector<additional_buffer_set> get_additional_buffers(unsigned int max_entry_count);
+
+		private:
+			struct buffer_lifetime
+			{
+				unsigned int elem_count;
+				bool per_entry;
+				unsigned int first_layer_id;
+				unsigned int last_layer_id;
+				unsigned int storage_id;
+			};
+
+			struct storage_info
+			{
+				unsigned int elem_count;
+				bool per_entry;
+				std::vector<unsigned int> buffer_id_list;
+			};
+
+			bool is_overlapped(
+				const buffer_lifetime& buffer,
+				const storage_info& storage) const;
+
+			std::vector<buffer_lifetime> buffer_list;
+			std::vector<std::vector<unsigned int> > layer_buffer_id_list;
+			std::vector<storage_info> storage_list;
+
+			plain_running_configuration_const_smart_ptr plain_config;
+			additional_buffer_set storage_buffers;
+			unsigned int storage_max_entry_count;
+
+		private:
+			additional_buffer_planner(const additional_buffer_planner&);
+			additional_buffer_planner& operator =(const additional_buffer_planner&);
+		};
+
+		typedef nnforge_shared_ptr<additional_buffer_planner> additional_buffer_planner_smart_ptr;
+	}
+}
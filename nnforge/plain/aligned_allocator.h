@@ -0,0 +1,136 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+#ifdef NNFORGE_DEBUG_UNINITIALIZED_BUFFERS
+#include <cstring>
+#endif
+
+namespace nnforge
+{
+	namespace plain
+	{
+		// Allocates memory aligned to the cache line so that SIMD kernels might use aligned loads.
+		// Elements are default-initialized on resize, that is floats are not zero-filled, when built with C++11 compiler,
+		// thus kernels should not read any part of their buffers they haven't written before.
+		// Build with NNFORGE_DEBUG_UNINITIALIZED_BUFFERS and C++11 compiler to fill new memory with NaNs,
+		// kernels reading it make the results NaN
+		template<typename T, std::size_t alignment = 64>
+		class aligned_allocator
+		{
+		public:
+			typedef T value_type;
+			typedef T * pointer;
+			typedef const T * const_pointer;
+			typedef T& reference;
+			typedef const T& const_reference;
+			typedef std::size_t size_type;
+			typedef std::ptrdiff_t difference_type;
+
+			template<typename U>
+			struct rebind
+			{
+				typedef aligned_allocator<U, alignment> other;
+			};
+
+			aligned_allocator()
+			{
+			}
+
+			template<typename U>
+			aligned_allocator(const aligned_allocator<U, alignment>&)
+			{
+			}
+
+			pointer address(reference x) const
+			{
+				return &x;
+			}
+
+			const_pointer address(const_reference x) const
+			{
+				return &x;
+			}
+
+			pointer allocate(
+				size_type n,
+				const void * hint = 0)
+			{
+				// The pointer returned by operator new is stored right before the aligned block
+				unsigned char * raw = static_cast<unsigned char *>(::operator new(n * sizeof(T) + alignment + sizeof(void *)));
+				std::size_t aligned_address = (reinterpret_cast<std::size_t>(raw + sizeof(void *)) + (alignment - 1)) & ~(alignment - 1);
+				void * res = reinterpret_cast<void *>(aligned_address);
+				*(static_cast<void **>(res) - 1) = raw;
+#ifdef NNFORGE_DEBUG_UNINITIALIZED_BUFFERS
+				// All bits set is NaN for float
+				memset(res, 0xFF, n * sizeof(T));
+#endif
+				return static_cast<pointer>(res);
+			}
+
+			void deallocate(
+				pointer p,
+				size_type n)
+			{
+				if (p)
+					::operator delete(*(reinterpret_cast<void **>(p) - 1));
+			}
+
+			size_type max_size() const
+			{
+				return (static_cast<size_type>(-1) - alignment - sizeof(void *)) / sizeof(T);
+			}
+
+			void construct(
+				pointer p,
+				const_reference val)
+			{
+				::new(static_cast<void *>(p)) T(val);
+			}
+
+			// Used by C++11 containers for default insertion
+			template<typename U>
+			void construct(U * p)
+			{
+				::new(static_cast<void *>(p)) U;
+			}
+
+			void destroy(pointer p)
+			{
+				p->~T();
+			}
+		};
+
+		template<typename T, typename U, std::size_t alignment>
+		bool operator ==(const aligned_allocator<T, alignment>&, const aligned_allocator<U, alignment>&)
+		{
+			return true;
+		}
+
+		template<typename T, typename U, std::size_t alignment>
+		bool operator !=(const aligned_allocator<T, alignment>&, const aligned_allocator<U, alignment>&)
+		{
+			return false;
+		}
+
+		typedef std::vector<float, aligned_allocator<float> > additional_buffer;
+	}
+}
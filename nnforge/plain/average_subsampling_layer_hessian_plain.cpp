@@ -51,8 +51,8 @@ namespace nnforge
 			const layer_configuration_specific& output_configuration_specific,
 			unsigned int entry_count) const
 		{
-			const std::vector<float>::const_iterator in_it_global = input_buffer->begin();
-			const std::vector<float>::iterator out_it_global = output_buffer->begin();
+			const additional_buffer::const_iterator in_it_global = input_buffer->begin();
+			const additional_buffer::iterator out_it_global = output_buffer->begin();
 			const unsigned int input_neuron_count = input_configuration_specific.get_neuron_count();
 			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
 			const unsigned int output_neuron_count = output_configuration_specific.get_neuron_count();
@@ -105,14 +105,14 @@ namespace nnforge
 					int entry_id = workload_id / feature_map_count;
 					int feature_map_id = workload_id - (entry_id * feature_map_count);
 
-					std::vector<float>::const_iterator in_it_base = in_it_global + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
-					std::vector<float>::iterator out_it_base = out_it_global + (entry_id * output_neuron_count) + (feature_map_id * output_neuron_count_per_feature_map);
+					additional_buffer::const_iterator in_it_base = in_it_global + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
+					additional_buffer::iterator out_it_base = out_it_global + (entry_id * output_neuron_count) + (feature_map_id * output_neuron_count_per_feature_map);
 
 					std::fill_n(current_output_position.begin(), dimension_count, 0);
-					for(std::vector<float>::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it)
+					for(additional_buffer::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it)
 					{
 						// Define the starting position of the first input elem
-						std::vector<float>::const_iterator in_it = in_it_base;
+						additional_buffer::const_iterator in_it = in_it_base;
 						for(unsigned int i = 0; i < dimension_count; ++i)
 							in_it += current_output_position[i] * (*(subsampling_sizes_it + i)) * (*(input_slices_it + i));
 
@@ -147,8 +147,8 @@ namespace nnforge
 			const layer_configuration_specific& output_configuration_specific,
 			unsigned int entry_count) const
 		{
-			const std::vector<float>::iterator in_err_it_global = input_errors->begin();
-			const std::vector<float>::const_iterator out_err_it_global = output_errors->begin();
+			const additional_buffer::iterator in_err_it_global = input_errors->begin();
+			const additional_buffer::const_iterator out_err_it_global = output_errors->begin();
 			const unsigned int input_neuron_count = input_configuration_specific.get_neuron_count();
 			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
 			const unsigned int output_neuron_count = output_configuration_specific.get_neuron_count();
@@ -201,14 +201,16 @@ namespace nnforge
 					int entry_id = workload_id / feature_map_count;
 					int feature_map_id = workload_id - (entry_id * feature_map_count);
 
-					std::vector<float>::iterator in_err_it_base = in_err_it_global + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
-					std::vector<float>::const_iterator out_err_it_base = out_err_it_global + (entry_id * output_neuron_count) + (feature_map_id * output_neuron_count_per_feature_map);
+					additional_buffer::iterator in_err_it_base = in_err_it_global + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
+					additional_buffer::const_iterator out_err_it_base = out_err_it_global + (entry_id * output_neuron_count) + (feature_map_id * output_neuron_count_per_feature_map);
 
+					// Windows do not cover the tail of the input when its size is not a multiple of the subsampling size
+					std::fill_n(in_err_it_base, input_neuron_count_per_feature_map, 0.0F);
 					std::fill_n(current_output_position.begin(), dimension_count, 0);
-					for(std::vector<float>::const_iterator out_it = out_err_it_base; out_it != out_err_it_base + output_neuron_count_per_feature_map; ++out_it)
+					for(additional_buffer::const_iterator out_it = out_err_it_base; out_it != out_err_it_base + output_neuron_count_per_feature_map; ++out_it)
 					{
 						// Define the starting position of the first input elem
-						std::vector<float>::iterator in_it = in_err_it_base;
+						additional_buffer::iterator in_it = in_err_it_base;
 						for(unsigned int i = 0; i < dimension_count; ++i)
 							in_it += current_output_position[i] * (*(subsampling_sizes_it + i)) * (*(input_slices_it + i));
 
@@ -51,8 +51,8 @@ namespace nnforge
 			const layer_configuration_specific& output_configuration_specific,
 			unsigned int entry_count) const
 		{
-			const std::vector<float>::const_iterator in_it_global = input_buffer->begin();
-			const std::vector<float>::iterator out_it_global = output_buffer->begin();
+			const additional_buffer::const_iterator in_it_global = input_buffer->begin();
+			const additional_buffer::iterator out_it_global = output_buffer->begin();
 			const unsigned int input_neuron_count = input_configuration_specific.get_neuron_count();
 			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
 			const unsigned int output_neuron_count = output_configuration_specific.get_neuron_count();
@@ -106,21 +106,21 @@ namespace nnforge
 					int entry_id = workload_id / output_feature_map_count;
 					int output_feature_map_id = workload_id - (entry_id * output_feature_map_count);
 
-					std::vector<float>::iterator out_it_base = out_it_global + (entry_id * output_neuron_count) + (output_feature_map_id * output_neuron_count_per_feature_map);
-					std::vector<float>::const_iterator in_it_base = in_it_global + (entry_id * input_neuron_count);
+					additional_buffer::iterator out_it_base = out_it_global + (entry_id * output_neuron_count) + (output_feature_map_id * output_neuron_count_per_feature_map);
+					additional_buffer::const_iterator in_it_base = in_it_global + (entry_id * input_neuron_count);
 
 					std::fill_n(current_output_position.begin(), dimension_count, 0);
-					for(std::vector<float>::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it)
+					for(additional_buffer::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it)
 					{
 						float sum = *(biases + output_feature_map_id);
 						std::vector<float>::const_iterator weights_it = weights + (output_feature_map_id * (const_window_elem_count * input_feature_map_count));
-						std::vector<float>::const_iterator in_it_base2 = in_it_base;
+						additional_buffer::const_iterator in_it_base2 = in_it_base;
 						for(unsigned int i = 0; i < dimension_count; ++i)
 							in_it_base2 += current_output_position[i] * (*(input_slices_it + i));
 						for(unsigned int input_feature_map_id = 0; input_feature_map_id < input_feature_map_count; ++input_feature_map_id)
 						{
 							// Define the starting position of the first input elem
-							std::vector<float>::const_iterator in_it = in_it_base2 + (input_feature_map_id * input_neuron_count_per_feature_map);
+							additional_buffer::const_iterator in_it = in_it_base2 + (input_feature_map_id * input_neuron_count_per_feature_map);
 
 							for(unsigned int i = 0; i < const_window_elem_count; ++i)
 							{
@@ -154,8 +154,8 @@ namespace nnforge
 			const layer_configuration_specific& output_configuration_specific,
 			unsigned int entry_count) const
 		{
-			const std::vector<float>::iterator in_err_it_global = input_errors->begin();
-			const std::vector<float>::const_iterator out_err_it_global = output_errors->begin();
+			const additional_buffer::iterator in_err_it_global = input_errors->begin();
+			const additional_buffer::const_iterator out_err_it_global = output_errors->begin();
 			const unsigned int input_neuron_count = input_configuration_specific.get_neuron_count();
 			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
 			const unsigned int output_neuron_count = output_configuration_specific.get_neuron_count();
@@ -208,23 +208,23 @@ namespace nnforge
 					int entry_id = workload_id / input_feature_map_count;
 					int input_feature_map_id = workload_id - (entry_id * input_feature_map_count);
 
-					std::vector<float>::const_iterator out_err_it_base = out_err_it_global + (entry_id * output_neuron_count);
-					std::vector<float>::iterator in_err_it_base = in_err_it_global + (entry_id * input_neuron_count) + (input_feature_map_id * input_neuron_count_per_feature_map);
+					additional_buffer::const_iterator out_err_it_base = out_err_it_global + (entry_id * output_neuron_count);
+					additional_buffer::iterator in_err_it_base = in_err_it_global + (entry_id * input_neuron_count) + (input_feature_map_id * input_neuron_count_per_feature_map);
 					std::vector<float>::const_iterator weights_it_base = weights + (const_window_elem_count * input_feature_map_id);
 
 					std::fill_n(in_err_it_base, input_neuron_count_per_feature_map, 0.0F);
 
 					std::fill_n(current_output_position.begin(), dimension_count, 0);
 
-					for(std::vector<float>::const_iterator out_err_it_base2 = out_err_it_base; out_err_it_base2 != out_err_it_base + output_neuron_count_per_feature_map; ++out_err_it_base2)
+					for(additional_buffer::const_iterator out_err_it_base2 = out_err_it_base; out_err_it_base2 != out_err_it_base + output_neuron_count_per_feature_map; ++out_err_it_base2)
 					{
-						std::vector<float>::iterator in_err_it = in_err_it_base;
+						additional_buffer::iterator in_err_it = in_err_it_base;
 						for(unsigned int i = 0; i < dimension_count; ++i)
 							in_err_it += current_output_position[i] * (*(input_slices_it + i));
 
 						for(unsigned int output_feature_map_id = 0; output_feature_map_id < output_feature_map_count; ++output_feature_map_id)
 						{
-							std::vector<float>::const_iterator out_err_it = out_err_it_base2 + (output_feature_map_id * output_neuron_count_per_feature_map);
+							additional_buffer::const_iterator out_err_it = out_err_it_base2 + (output_feature_map_id * output_neuron_count_per_feature_map);
 							std::vector<float>::const_iterator weights_it_base2 = weights_it_base + (output_feature_map_id * (const_window_elem_count * input_feature_map_count));
 							std::vector<float>::const_iterator weights_it = weights_it_base2;
 							float current_err = *out_err_it;
@@ -259,8 +259,8 @@ namespace nnforge
 			const layer_configuration_specific& output_configuration_specific,
 			unsigned int entry_count) const
 		{
-			const std::vector<float>::const_iterator in_it_global = input_neurons->begin();
-			const std::vector<float>::const_iterator out_err_it_global = output_errors->begin();
+			const additional_buffer::const_iterator in_it_global = input_neurons->begin();
+			const additional_buffer::const_iterator out_err_it_global = output_errors->begin();
 			const unsigned int input_neuron_count = input_configuration_specific.get_neuron_count();
 			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
 			const unsigned int output_neuron_count = output_configuration_specific.get_neuron_count();
@@ -317,22 +317,22 @@ namespace nnforge
 					int output_feature_map_id = workload_id / input_feature_map_count;
 					int input_feature_map_id = workload_id - (output_feature_map_id * input_feature_map_count);
 
-					std::vector<float>::const_iterator in_it_base = in_it_global + (input_feature_map_id * input_neuron_count_per_feature_map);
-					std::vector<float>::const_iterator out_err_it_base = out_err_it_global + (output_feature_map_id * output_neuron_count_per_feature_map);
+					additional_buffer::const_iterator in_it_base = in_it_global + (input_feature_map_id * input_neuron_count_per_feature_map);
+					additional_buffer::const_iterator out_err_it_base = out_err_it_global + (output_feature_map_id * output_neuron_count_per_feature_map);
 					std::vector<float>::iterator weights_it_base = weights + (output_feature_map_id * (const_window_elem_count * input_feature_map_count)) + (const_window_elem_count * input_feature_map_id);
 
 					std::fill_n(weights_global.begin(), const_window_elem_count, 0.0F);
 
 					for(unsigned int entry_id = 0; entry_id < const_entry_count; ++entry_id)
 					{
-						std::vector<float>::const_iterator in_it_base2 = in_it_base + (entry_id * input_neuron_count);
-						std::vector<float>::const_iterator out_err_it_base2 = out_err_it_base + (entry_id * output_neuron_count);
+						additional_buffer::const_iterator in_it_base2 = in_it_base + (entry_id * input_neuron_count);
+						additional_buffer::const_iterator out_err_it_base2 = out_err_it_base + (entry_id * output_neuron_count);
 
 						std::fill_n(current_output_position.begin(), dimension_count, 0);
 						std::fill_n(weights_local.begin(), const_window_elem_count, 0.0F);
-						for(std::vector<float>::const_iterator out_err_it = out_err_it_base2; out_err_it != out_err_it_base2 + output_neuron_count_per_feature_map; ++out_err_it)
+						for(additional_buffer::const_iterator out_err_it = out_err_it_base2; out_err_it != out_err_it_base2 + output_neuron_count_per_feature_map; ++out_err_it)
 						{
-							std::vector<float>::const_iterator in_it = in_it_base2;
+							additional_buffer::const_iterator in_it = in_it_base2;
 							for(unsigned int i = 0; i < dimension_count; ++i)
 								in_it += current_output_position[i] * (*(input_slices_it + i));
 
@@ -368,13 +368,13 @@ namespace nnforge
 			for(int workload_id = 0; workload_id < total_workload_bias; ++workload_id)
 			{
 				unsigned int output_feature_map_id = workload_id;
-				std::vector<float>::const_iterator out_err_it_base = out_err_it_global + (output_feature_map_id * output_neuron_count_per_feature_map);
+				additional_buffer::const_iterator out_err_it_base = out_err_it_global + (output_feature_map_id * output_neuron_count_per_feature_map);
 				float sum = 0.0F;
 				for(unsigned int entry_id = 0; entry_id < const_entry_count; ++entry_id)
 				{
-					std::vector<float>::const_iterator out_err_it_base2 = out_err_it_base + (entry_id * output_neuron_count);
+					additional_buffer::const_iterator out_err_it_base2 = out_err_it_base + (entry_id * output_neuron_count);
 					float sum_local = 0.0F;
-					for(std::vector<float>::const_iterator out_err_it = out_err_it_base2; out_err_it != out_err_it_base2 + output_neuron_count_per_feature_map; ++out_err_it)
+					for(additional_buffer::const_iterator out_err_it = out_err_it_base2; out_err_it != out_err_it_base2 + output_neuron_count_per_feature_map; ++out_err_it)
 						sum_local += *out_err_it;
 
 					sum += sum_local;
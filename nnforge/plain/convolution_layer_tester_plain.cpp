@@ -16,10 +16,26 @@
 
 #include "convolution_layer_tester_plain.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "../convolution_layer.h"
+#include "../hyperbolic_tangent_layer.h"
+#include "../rectified_linear_layer.h"
+#include "../sigmoid_layer.h"
+#include "../neural_network_exception.h"
 #include "../nn_types.h"
+#include "reduced_precision_layer_data.h"
+#include "quantized_layer_data.h"
+#include "../mapped_layer_data.h"
 
 #include <array>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <boost/format.hpp>
+#include <boost/uuid/uuid_io.hpp>
 
 namespace nnforge
 {
@@ -27,8 +43,74 @@ namespace nnforge
 	{
 		const int convolution_layer_tester_plain::max_dimension_count = 4;
 
+		const unsigned int convolution_layer_tester_plain::im2col_position_block_size = 64;
+		const unsigned int convolution_layer_tester_plain::im2col_input_block_size = 256;
+		const unsigned int convolution_layer_tester_plain::im2col_min_output_feature_map_count = 4;
+		const unsigned int convolution_layer_tester_plain::im2col_min_input_elem_count = 16;
+		// Each int8 product is at most 127 * 127 in magnitude, int32 sum of that many of them cannot overflow
+		const unsigned int convolution_layer_tester_plain::max_quantized_input_elem_count = static_cast<unsigned int>(std::numeric_limits<int>::max() / (127 * 127));
+
 		convolution_layer_tester_plain::convolution_layer_tester_plain()
+			: activation_type(activation_none)
+			, hyperbolic_tangent_steepness2(0.0F)
+			, hyperbolic_tangent_major_multiplier(0.0F)
+		{
+		}
+
+		convolution_layer_tester_plain::convolution_layer_tester_plain(const_layer_smart_ptr activation_layer_schema)
+			: activation_type(activation_none)
+			, hyperbolic_tangent_steepness2(0.0F)
+			, hyperbolic_tangent_major_multiplier(0.0F)
 		{
+			const boost::uuids::uuid& activation_uuid = activation_layer_schema->get_uuid();
+			if (activation_uuid == hyperbolic_tangent_layer::layer_guid)
+			{
+				nnforge_shared_ptr<const hyperbolic_tangent_layer> layer_derived = nnforge_dynamic_pointer_cast<const hyperbolic_tangent_layer>(activation_layer_schema);
+				activation_type = activation_hyperbolic_tangent;
+				hyperbolic_tangent_steepness2 = layer_derived->steepness * 2.0F;
+				hyperbolic_tangent_major_multiplier = layer_derived->major_multiplier;
+			}
+			else if (activation_uuid == rectified_linear_layer::layer_guid)
+				activation_type = activation_rectified_linear;
+			else if (activation_uuid == sigmoid_layer::layer_guid)
+				activation_type = activation_sigmoid;
+			else
+				throw neural_network_exception((boost::format("Layer %1% cannot be fused with convolution layer tester") % activation_uuid).str());
+		}
+
+		bool convolution_layer_tester_plain::is_activation_fusable(const_layer_smart_ptr layer_schema)
+		{
+			const boost::uuids::uuid& layer_uuid = layer_schema->get_uuid();
+			return (layer_uuid == hyperbolic_tangent_layer::layer_guid)
+				|| (layer_uuid == rectified_linear_layer::layer_guid)
+				|| (layer_uuid == sigmoid_layer::layer_guid);
+		}
+
+		// Matches the computations of the standalone activation testers exactly
+		void convolution_layer_tester_plain::apply_activation(
+			float * data,
+			unsigned int elem_count) const
+		{
+			switch (activation_type)
+			{
+			case activation_hyperbolic_tangent:
+				for(unsigned int i = 0; i < elem_count; ++i)
+				{
+					float inp2 = expf(data[i] * hyperbolic_tangent_steepness2);
+					data[i] = (inp2 - 1.0F) / (inp2 + 1.0F) * hyperbolic_tangent_major_multiplier;
+				}
+				break;
+			case activation_rectified_linear:
+				for(unsigned int i = 0; i < elem_count; ++i)
+					data[i] = std::max<float>(data[i], 0.0F);
+				break;
+			case activation_sigmoid:
+				for(unsigned int i = 0; i < elem_count; ++i)
+					data[i] = 1.0F / (expf(-data[i]) + 1.0F);
+				break;
+			default:
+				break;
+			}
 		}
 
 		convolution_layer_tester_plain::~convolution_layer_tester_plain()
@@ -40,6 +122,28 @@ namespace nnforge
 			return convolution_layer::layer_guid;
 		}
 
+		bool convolution_layer_tester_plain::is_reduced_precision_data_supported() const
+		{
+			return true;
+		}
+
+		bool convolution_layer_tester_plain::is_quantized_data_supported(
+			const_layer_smart_ptr layer_schema,
+			const layer_configuration_specific& input_configuration_specific) const
+		{
+			nnforge_shared_ptr<const convolution_layer> layer_derived = nnforge_dynamic_pointer_cast<const convolution_layer>(layer_schema);
+			unsigned int input_elem_count = input_configuration_specific.feature_map_count;
+			for(std::vector<unsigned int>::const_iterator it = layer_derived->window_sizes.begin(); it != layer_derived->window_sizes.end(); ++it)
+				input_elem_count *= *it;
+
+			return (input_elem_count <= max_quantized_input_elem_count);
+		}
+
+		bool convolution_layer_tester_plain::is_mapped_data_supported() const
+		{
+			return true;
+		}
+
 		void convolution_layer_tester_plain::test(
 			additional_buffer_smart_ptr input_buffer,
 			additional_buffer_set& additional_buffers,
@@ -50,8 +154,50 @@ namespace nnforge
 			const layer_configuration_specific& output_configuration_specific,
 			unsigned int entry_count) const
 		{
-			const std::vector<float>::const_iterator in_it_global = input_buffer->begin();
-			const std::vector<float>::iterator out_it_global = additional_buffers[0]->begin();
+			if (nnforge_dynamic_pointer_cast<const quantized_layer_data>(data))
+				test_quantized(
+					input_buffer,
+					additional_buffers,
+					plain_config,
+					layer_schema,
+					data,
+					input_configuration_specific,
+					output_configuration_specific,
+					entry_count);
+			else if (is_im2col_applicable(layer_schema, input_configuration_specific, output_configuration_specific))
+				test_im2col(
+					input_buffer,
+					additional_buffers,
+					plain_config,
+					layer_schema,
+					data,
+					input_configuration_specific,
+					output_configuration_specific,
+					entry_count);
+			else
+				test_direct(
+					input_buffer,
+					additional_buffers,
+					plain_config,
+					layer_schema,
+					data,
+					input_configuration_specific,
+					output_configuration_specific,
+					entry_count);
+		}
+
+		void convolution_layer_tester_plain::test_direct(
+			additional_buffer_smart_ptr input_buffer,
+			additional_buffer_set& additional_buffers,
+			plain_running_configuration_const_smart_ptr plain_config,
+			const_layer_smart_ptr layer_schema,
+			const_layer_data_smart_ptr data,
+			const layer_configuration_specific& input_configuration_specific,
+			const layer_configuration_specific& output_configuration_specific,
+			unsigned int entry_count) const
+		{
+			const additional_buffer::const_iterator in_it_global = input_buffer->begin();
+			const additional_buffer::iterator out_it_global = additional_buffers[0]->begin();
 			const unsigned int input_neuron_count = input_configuration_specific.get_neuron_count();
 			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
 			const unsigned int output_neuron_count = output_configuration_specific.get_neuron_count();
@@ -67,26 +213,22 @@ namespace nnforge
 			for(unsigned int i = 0; i < dimension_count; ++i)
 				window_elem_count *= window_sizes[i];
 			const unsigned int const_window_elem_count = window_elem_count;
-			const std::vector<float>::const_iterator weights = (*data)[0].begin();
-			const std::vector<float>::const_iterator biases = (*data)[1].begin();
 
-			std::vector<unsigned int> current_local_input_position(dimension_count, 0);
-			std::vector<unsigned int> offset_list(window_elem_count);
-			for(unsigned int i = 1; i < window_elem_count; ++i)
+			// Weights kept in reduced precision are widened for a single output feature map at a time
+			const_reduced_precision_layer_data_smart_ptr packed_data = nnforge_dynamic_pointer_cast<const reduced_precision_layer_data>(data);
+			std::vector<float> biases_widened;
+			if (packed_data)
 			{
-				int offset = 0;
-				for(unsigned int j = 0; j < dimension_count; ++j)
-				{
-					offset += static_cast<int>(input_slices[j]);
-					if ((++current_local_input_position[j]) < window_sizes[j])
-					{
-						offset_list[i] = offset_list[i-1] + offset;
-						break;
-					}
-					current_local_input_position[j] = 0;
-					offset -= static_cast<int>(window_sizes[j] * input_slices[j]);
-				}
+				biases_widened.resize(packed_data->packed[1].size());
+				weight_storage_type::widen(packed_data->storage, &(*packed_data->packed[1].begin()), &(*biases_widened.begin()), biases_widened.size());
 			}
+			const unsigned short * const packed_weights = packed_data ? &(*packed_data->packed[0].begin()) : 0;
+			const weight_storage_type::storage_type storage = packed_data ? packed_data->storage : weight_storage_type::type_float;
+			const_mapped_layer_data_smart_ptr mapped_data = nnforge_dynamic_pointer_cast<const mapped_layer_data>(data);
+			const float * const weights = packed_data ? 0 : (mapped_data ? mapped_data->part_list[0] : &(*(*data)[0].begin()));
+			const float * const biases = packed_data ? &(*biases_widened.begin()) : (mapped_data ? mapped_data->part_list[1] : &(*(*data)[1].begin()));
+
+			std::vector<unsigned int> offset_list = get_input_offset_list(window_sizes, input_configuration_specific);
 
 			const unsigned int output_feature_map_count = output_configuration_specific.feature_map_count;
 			const unsigned int input_feature_map_count = input_configuration_specific.feature_map_count;
@@ -98,6 +240,7 @@ namespace nnforge
 			#pragma omp parallel default(none) num_threads(plain_config->openmp_thread_count)
 			{
 				nnforge_array<unsigned int, max_dimension_count> current_output_position;
+				std::vector<float> weights_widened(packed_weights ? (const_window_elem_count * input_feature_map_count) : 0);
 
 				#pragma omp for schedule(guided)
 				for(int workload_id = 0; workload_id < total_workload; ++workload_id)
@@ -105,23 +248,38 @@ namespace nnforge
 					int entry_id = workload_id / output_feature_map_count;
 					int output_feature_map_id = workload_id - (entry_id * output_feature_map_count);
 
-					std::vector<float>::iterator out_it_base = out_it_global + (entry_id * output_neuron_count) + (output_feature_map_id * output_neuron_count_per_feature_map);
-					std::vector<float>::const_iterator in_it_base = in_it_global + (entry_id * input_neuron_count);
+					const float * weights_base;
+					if (packed_weights)
+					{
+						weight_storage_type::widen(
+							storage,
+							packed_weights + (output_feature_map_id * (const_window_elem_count * input_feature_map_count)),
+							&(*weights_widened.begin()),
+							weights_widened.size());
+						weights_base = &(*weights_widened.begin());
+					}
+					else
+					{
+						weights_base = weights + (output_feature_map_id * (const_window_elem_count * input_feature_map_count));
+					}
+
+					additional_buffer::iterator out_it_base = out_it_global + (entry_id * output_neuron_count) + (output_feature_map_id * output_neuron_count_per_feature_map);
+					additional_buffer::const_iterator in_it_base = in_it_global + (entry_id * input_neuron_count);
 
 					std::fill_n(current_output_position.begin(), dimension_count, 0);
-					for(std::vector<float>::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it)
+					for(additional_buffer::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it)
 					{
 						float sum = *(biases + output_feature_map_id);
-						std::vector<float>::const_iterator weights_it = weights + (output_feature_map_id * (const_window_elem_count * input_feature_map_count));
+						const float * weights_it = weights_base;
 
-						std::vector<float>::const_iterator in_it_base2 = in_it_base;
+						additional_buffer::const_iterator in_it_base2 = in_it_base;
 						for(unsigned int i = 0; i < dimension_count; ++i)
 							in_it_base2 += current_output_position[i] * (*(input_slices_it + i));
 
 						for(unsigned int input_feature_map_id = 0; input_feature_map_id < input_feature_map_count; ++input_feature_map_id)
 						{
 							// Define the starting position of the first input elem
-							std::vector<float>::const_iterator in_it = in_it_base2 + (input_feature_map_id * input_neuron_count_per_feature_map);
+							additional_buffer::const_iterator in_it = in_it_base2 + (input_feature_map_id * input_neuron_count_per_feature_map);
 
 							for(unsigned int i = 0; i < const_window_elem_count; ++i)
 							{
@@ -139,10 +297,454 @@ namespace nnforge
 							current_output_position[i] = 0;
 						}
 					}
+
+					if (activation_type != activation_none)
+						apply_activation(&(*out_it_base), output_neuron_count_per_feature_map);
+				}
+			}
+		}
+
+		void convolution_layer_tester_plain::test_im2col(
+			additional_buffer_smart_ptr input_buffer,
+			additional_buffer_set& additional_buffers,
+			plain_running_configuration_const_smart_ptr plain_config,
+			const_layer_smart_ptr layer_schema,
+			const_layer_data_smart_ptr data,
+			const layer_configuration_specific& input_configuration_specific,
+			const layer_configuration_specific& output_configuration_specific,
+			unsigned int entry_count) const
+		{
+			const float * const in_global = &(*input_buffer->begin());
+			float * const out_global = &(*additional_buffers[0]->begin());
+			const unsigned int input_neuron_count = input_configuration_specific.get_neuron_count();
+			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
+			const unsigned int output_neuron_count = output_configuration_specific.get_neuron_count();
+			const unsigned int output_neuron_count_per_feature_map = output_configuration_specific.get_neuron_count_per_feature_map();
+			nnforge_shared_ptr<const convolution_layer> layer_derived = nnforge_dynamic_pointer_cast<const convolution_layer>(layer_schema);
+			const std::vector<unsigned int>& window_sizes = layer_derived->window_sizes;
+			const unsigned int dimension_count = static_cast<unsigned int>(window_sizes.size());
+			std::vector<unsigned int> input_slices(input_configuration_specific.dimension_sizes.size());
+			input_slices[0] = 1;
+			for(unsigned int i = 0; i < dimension_count - 1; ++i)
+				input_slices[i + 1] = input_slices[i] * input_configuration_specific.dimension_sizes[i];
+			unsigned int window_elem_count = 1;
+			for(unsigned int i = 0; i < dimension_count; ++i)
+				window_elem_count *= window_sizes[i];
+
+			// Weights kept in reduced precision are widened block by block, for each group of output feature maps
+			const_reduced_precision_layer_data_smart_ptr packed_data = nnforge_dynamic_pointer_cast<const reduced_precision_layer_data>(data);
+			std::vector<float> biases_widened;
+			if (packed_data)
+			{
+				biases_widened.resize(packed_data->packed[1].size());
+				weight_storage_type::widen(packed_data->storage, &(*packed_data->packed[1].begin()), &(*biases_widened.begin()), biases_widened.size());
+			}
+			const unsigned short * const packed_weights = packed_data ? &(*packed_data->packed[0].begin()) : 0;
+			const weight_storage_type::storage_type storage = packed_data ? packed_data->storage : weight_storage_type::type_float;
+			const_mapped_layer_data_smart_ptr mapped_data = nnforge_dynamic_pointer_cast<const mapped_layer_data>(data);
+			const float * const weights = packed_data ? 0 : (mapped_data ? mapped_data->part_list[0] : &(*(*data)[0].begin()));
+			const float * const biases = packed_data ? &(*biases_widened.begin()) : (mapped_data ? mapped_data->part_list[1] : &(*(*data)[1].begin()));
+
+			const unsigned int output_feature_map_count = output_configuration_specific.feature_map_count;
+			const unsigned int input_feature_map_count = input_configuration_specific.feature_map_count;
+			const unsigned int input_elem_count = input_feature_map_count * window_elem_count;
+
+			// Offset of each window element relative to the window origin, for each input feature map
+			std::vector<unsigned int> window_offset_list = get_input_offset_list(window_sizes, input_configuration_specific);
+			std::vector<unsigned int> offset_list(input_elem_count);
+			for(unsigned int input_feature_map_id = 0; input_feature_map_id < input_feature_map_count; ++input_feature_map_id)
+				for(unsigned int i = 0; i < window_elem_count; ++i)
+					offset_list[input_feature_map_id * window_elem_count + i] = input_feature_map_id * input_neuron_count_per_feature_map + window_offset_list[i];
+
+			// Offset of the window origin for each output position
+			std::vector<unsigned int> position_offset_list(output_neuron_count_per_feature_map);
+			{
+				nnforge_array<unsigned int, max_dimension_count> current_output_position;
+				std::fill_n(current_output_position.begin(), dimension_count, 0);
+				for(std::vector<unsigned int>::iterator it = position_offset_list.begin(); it != position_offset_list.end(); ++it)
+				{
+					unsigned int offset = 0;
+					for(unsigned int i = 0; i < dimension_count; ++i)
+						offset += current_output_position[i] * input_slices[i];
+					*it = offset;
+
+					for(unsigned int i = 0; i < dimension_count; ++i)
+					{
+						if ((++current_output_position[i]) < output_configuration_specific.dimension_sizes[i])
+							break;
+						current_output_position[i] = 0;
+					}
+				}
+			}
+
+			const unsigned int position_block_count = (output_neuron_count_per_feature_map + im2col_position_block_size - 1) / im2col_position_block_size;
+			const int total_workload = entry_count * position_block_count;
+			const unsigned int * const offset_list_ptr = &(*offset_list.begin());
+			const unsigned int * const position_offset_list_ptr = &(*position_offset_list.begin());
+			const unsigned int output_feature_map_count_aligned = output_feature_map_count & ~3U;
+
+			#pragma omp parallel default(none) shared(additional_buffers) num_threads(plain_config->openmp_thread_count)
+			{
+				int thread_id = 0;
+				#ifdef _OPENMP
+				thread_id = omp_get_thread_num();
+				#endif
+
+				float * const patch = &(*additional_buffers[1 + thread_id]->begin());
+				std::vector<float> weights_widened(packed_weights ? (4 * im2col_input_block_size) : 0);
+
+				#pragma omp for schedule(guided)
+				for(int workload_id = 0; workload_id < total_workload; ++workload_id)
+				{
+					int entry_id = workload_id / position_block_count;
+					int position_block_id = workload_id - (entry_id * position_block_count);
+
+					const unsigned int position_start = position_block_id * im2col_position_block_size;
+					const unsigned int position_count = std::min(im2col_position_block_size, output_neuron_count_per_feature_map - position_start);
+					const float * const in_base = in_global + (entry_id * input_neuron_count);
+					float * const out_base = out_global + (entry_id * output_neuron_count) + position_start;
+					const unsigned int * const position_offsets = position_offset_list_ptr + position_start;
+
+					// Lower input into patch matrix: input_elem_count rows, position_count columns
+					for(unsigned int input_elem_id = 0; input_elem_id < input_elem_count; ++input_elem_id)
+					{
+						const float * const in_it = in_base + offset_list_ptr[input_elem_id];
+						float * const patch_it = patch + (input_elem_id * position_count);
+						for(unsigned int i = 0; i < position_count; ++i)
+							patch_it[i] = in_it[position_offsets[i]];
+					}
+
+					for(unsigned int output_feature_map_id = 0; output_feature_map_id < output_feature_map_count; ++output_feature_map_id)
+					{
+						const float bias = biases[output_feature_map_id];
+						float * const out_it = out_base + (output_feature_map_id * output_neuron_count_per_feature_map);
+						for(unsigned int i = 0; i < position_count; ++i)
+							out_it[i] = bias;
+					}
+
+					// Multiply weights by patch matrix, blocked by input elements to keep patch rows in cache
+					for(unsigned int input_elem_start = 0; input_elem_start < input_elem_count; input_elem_start += im2col_input_block_size)
+					{
+						const unsigned int input_elem_end = std::min(input_elem_start + im2col_input_block_size, input_elem_count);
+						// Widened weights are indexed relative to the start of the block
+						const unsigned int weight_index_offset = packed_weights ? input_elem_start : 0;
+
+						for(unsigned int output_feature_map_id = 0; output_feature_map_id < output_feature_map_count_aligned; output_feature_map_id += 4)
+						{
+							float * const out0 = out_base + (output_feature_map_id * output_neuron_count_per_feature_map);
+							float * const out1 = out0 + output_neuron_count_per_feature_map;
+							float * const out2 = out1 + output_neuron_count_per_feature_map;
+							float * const out3 = out2 + output_neuron_count_per_feature_map;
+							const float * weights0;
+							const float * weights1;
+							const float * weights2;
+							const float * weights3;
+							if (packed_weights)
+							{
+								for(unsigned int i = 0; i < 4; ++i)
+									weight_storage_type::widen(
+										storage,
+										packed_weights + ((output_feature_map_id + i) * input_elem_count) + input_elem_start,
+										&(*weights_widened.begin()) + (i * im2col_input_block_size),
+										input_elem_end - input_elem_start);
+								weights0 = &(*weights_widened.begin());
+								weights1 = weights0 + im2col_input_block_size;
+								weights2 = weights1 + im2col_input_block_size;
+								weights3 = weights2 + im2col_input_block_size;
+							}
+							else
+							{
+								weights0 = weights + (output_feature_map_id * input_elem_count);
+								weights1 = weights0 + input_elem_count;
+								weights2 = weights1 + input_elem_count;
+								weights3 = weights2 + input_elem_count;
+							}
+							for(unsigned int input_elem_id = input_elem_start; input_elem_id < input_elem_end; ++input_elem_id)
+							{
+								const float w0 = weights0[input_elem_id - weight_index_offset];
+								const float w1 = weights1[input_elem_id - weight_index_offset];
+								const float w2 = weights2[input_elem_id - weight_index_offset];
+								const float w3 = weights3[input_elem_id - weight_index_offset];
+								const float * const patch_it = patch + (input_elem_id * position_count);
+								for(unsigned int i = 0; i < position_count; ++i)
+								{
+									float p = patch_it[i];
+									out0[i] += w0 * p;
+									out1[i] += w1 * p;
+									out2[i] += w2 * p;
+									out3[i] += w3 * p;
+								}
+							}
+						}
+
+						for(unsigned int output_feature_map_id = output_feature_map_count_aligned; output_feature_map_id < output_feature_map_count; ++output_feature_map_id)
+						{
+							float * const out0 = out_base + (output_feature_map_id * output_neuron_count_per_feature_map);
+							const float * weights0;
+							if (packed_weights)
+							{
+								weight_storage_type::widen(
+									storage,
+									packed_weights + (output_feature_map_id * input_elem_count) + input_elem_start,
+									&(*weights_widened.begin()),
+									input_elem_end - input_elem_start);
+								weights0 = &(*weights_widened.begin());
+							}
+							else
+								weights0 = weights + (output_feature_map_id * input_elem_count);
+							for(unsigned int input_elem_id = input_elem_start; input_elem_id < input_elem_end; ++input_elem_id)
+							{
+								const float w0 = weights0[input_elem_id - weight_index_offset];
+								const float * const patch_it = patch + (input_elem_id * position_count);
+								for(unsigned int i = 0; i < position_count; ++i)
+									out0[i] += w0 * patch_it[i];
+							}
+						}
+					}
+
+					// The output block is still in cache
+					if (activation_type != activation_none)
+						for(unsigned int output_feature_map_id = 0; output_feature_map_id < output_feature_map_count; ++output_feature_map_id)
+							apply_activation(out_base + (output_feature_map_id * output_neuron_count_per_feature_map), position_count);
+				}
+			}
+		}
+
+		void convolution_layer_tester_plain::test_quantized(
+			additional_buffer_smart_ptr input_buffer,
+			additional_buffer_set& additional_buffers,
+			plain_running_configuration_const_smart_ptr plain_config,
+			const_layer_smart_ptr layer_schema,
+			const_layer_data_smart_ptr data,
+			const layer_configuration_specific& input_configuration_specific,
+			const layer_configuration_specific& output_configuration_specific,
+			unsigned int entry_count) const
+		{
+			const float * const in_global = &(*input_buffer->begin());
+			float * const out_global = &(*additional_buffers[0]->begin());
+			const unsigned int input_neuron_count = input_configuration_specific.get_neuron_count();
+			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
+			const unsigned int output_neuron_count = output_configuration_specific.get_neuron_count();
+			const unsigned int output_neuron_count_per_feature_map = output_configuration_specific.get_neuron_count_per_feature_map();
+			nnforge_shared_ptr<const convolution_layer> layer_derived = nnforge_dynamic_pointer_cast<const convolution_layer>(layer_schema);
+			const std::vector<unsigned int>& window_sizes = layer_derived->window_sizes;
+			const unsigned int dimension_count = static_cast<unsigned int>(window_sizes.size());
+			std::vector<unsigned int> input_slices(input_configuration_specific.dimension_sizes.size());
+			input_slices[0] = 1;
+			for(unsigned int i = 0; i < dimension_count - 1; ++i)
+				input_slices[i + 1] = input_slices[i] * input_configuration_specific.dimension_sizes[i];
+			unsigned int window_elem_count = 1;
+			for(unsigned int i = 0; i < dimension_count; ++i)
+				window_elem_count *= window_sizes[i];
+
+			const_quantized_layer_data_smart_ptr quantized_data = nnforge_dynamic_pointer_cast<const quantized_layer_data>(data);
+			const signed char * const weights = &(*quantized_data->weights.begin());
+			const float * const biases = &(*(*data)[1].begin());
+			const unsigned int output_feature_map_count = output_configuration_specific.feature_map_count;
+			const unsigned int input_feature_map_count = input_configuration_specific.feature_map_count;
+			const unsigned int input_elem_count = input_feature_map_count * window_elem_count;
+			const float input_mult = (quantized_data->input_scale > 0.0F) ? 1.0F / quantized_data->input_scale : 0.0F;
+
+			// Dequantization multiplier for each output feature map
+			std::vector<float> output_mult_list(output_feature_map_count);
+			for(unsigned int output_feature_map_id = 0; output_feature_map_id < output_feature_map_count; ++output_feature_map_id)
+				output_mult_list[output_feature_map_id] = quantized_data->weight_scale_list[output_feature_map_id] * quantized_data->input_scale;
+
+			std::vector<unsigned int> window_offset_list = get_input_offset_list(window_sizes, input_configuration_specific);
+			std::vector<unsigned int> offset_list(input_elem_count);
+			for(unsigned int input_feature_map_id = 0; input_feature_map_id < input_feature_map_count; ++input_feature_map_id)
+				for(unsigned int i = 0; i < window_elem_count; ++i)
+					offset_list[input_feature_map_id * window_elem_count + i] = input_feature_map_id * input_neuron_count_per_feature_map + window_offset_list[i];
+
+			std::vector<unsigned int> position_offset_list(output_neuron_count_per_feature_map);
+			{
+				nnforge_array<unsigned int, max_dimension_count> current_output_position;
+				std::fill_n(current_output_position.begin(), dimension_count, 0);
+				for(std::vector<unsigned int>::iterator it = position_offset_list.begin(); it != position_offset_list.end(); ++it)
+				{
+					unsigned int offset = 0;
+					for(unsigned int i = 0; i < dimension_count; ++i)
+						offset += current_output_position[i] * input_slices[i];
+					*it = offset;
+
+					for(unsigned int i = 0; i < dimension_count; ++i)
+					{
+						if ((++current_output_position[i]) < output_configuration_specific.dimension_sizes[i])
+							break;
+						current_output_position[i] = 0;
+					}
+				}
+			}
+
+			const unsigned int max_position_count = std::min(im2col_position_block_size, output_neuron_count_per_feature_map);
+			const unsigned int position_block_count = (output_neuron_count_per_feature_map + im2col_position_block_size - 1) / im2col_position_block_size;
+			const int total_workload = entry_count * position_block_count;
+			const unsigned int * const offset_list_ptr = &(*offset_list.begin());
+			const unsigned int * const position_offset_list_ptr = &(*position_offset_list.begin());
+			const float * const output_mult_list_ptr = &(*output_mult_list.begin());
+			const unsigned int output_feature_map_count_aligned = output_feature_map_count & ~3U;
+
+			// Each input element is used by several patches, so quantize the whole input once
+			// The last additional buffer is reserved for it, 4 int8 values are packed in each of its elements
+			signed char * const quantized_input = reinterpret_cast<signed char *>(&(*additional_buffers.back()->begin()));
+			const int total_input_neuron_count = entry_count * input_neuron_count;
+			#pragma omp parallel for default(none) schedule(static) num_threads(plain_config->openmp_thread_count)
+			for(int i = 0; i < total_input_neuron_count; ++i)
+			{
+				int val = static_cast<int>(floorf(in_global[i] * input_mult + 0.5F));
+				quantized_input[i] = static_cast<signed char>(std::min(std::max(val, -127), 127));
+			}
+
+			#pragma omp parallel default(none) num_threads(plain_config->openmp_thread_count)
+			{
+				// Quantized values are kept in the patch matrix as 16-bit integers to make the products cheap to widen
+				std::vector<short> patch_buf(input_elem_count * max_position_count);
+				std::vector<int> acc_buf(4 * max_position_count);
+				short * const patch = &(*patch_buf.begin());
+				int * const acc0 = &(*acc_buf.begin());
+				int * const acc1 = acc0 + max_position_count;
+				int * const acc2 = acc1 + max_position_count;
+				int * const acc3 = acc2 + max_position_count;
+
+				#pragma omp for schedule(guided)
+				for(int workload_id = 0; workload_id < total_workload; ++workload_id)
+				{
+					int entry_id = workload_id / position_block_count;
+					int position_block_id = workload_id - (entry_id * position_block_count);
+
+					const unsigned int position_start = position_block_id * im2col_position_block_size;
+					const unsigned int position_count = std::min(im2col_position_block_size, output_neuron_count_per_feature_map - position_start);
+					const signed char * const in_base = quantized_input + (entry_id * input_neuron_count);
+					float * const out_base = out_global + (entry_id * output_neuron_count) + position_start;
+					const unsigned int * const position_offsets = position_offset_list_ptr + position_start;
+
+					for(unsigned int input_elem_id = 0; input_elem_id < input_elem_count; ++input_elem_id)
+					{
+						const signed char * const in_it = in_base + offset_list_ptr[input_elem_id];
+						short * const patch_it = patch + (input_elem_id * position_count);
+						for(unsigned int i = 0; i < position_count; ++i)
+							patch_it[i] = in_it[position_offsets[i]];
+					}
+
+					for(unsigned int output_feature_map_id = 0; output_feature_map_id < output_feature_map_count_aligned; output_feature_map_id += 4)
+					{
+						for(unsigned int i = 0; i < position_count; ++i)
+						{
+							acc0[i] = 0;
+							acc1[i] = 0;
+							acc2[i] = 0;
+							acc3[i] = 0;
+						}
+
+						const signed char * const weights0 = weights + (output_feature_map_id * input_elem_count);
+						const signed char * const weights1 = weights0 + input_elem_count;
+						const signed char * const weights2 = weights1 + input_elem_count;
+						const signed char * const weights3 = weights2 + input_elem_count;
+						for(unsigned int input_elem_id = 0; input_elem_id < input_elem_count; ++input_elem_id)
+						{
+							const int w0 = weights0[input_elem_id];
+							const int w1 = weights1[input_elem_id];
+							const int w2 = weights2[input_elem_id];
+							const int w3 = weights3[input_elem_id];
+							const short * const patch_it = patch + (input_elem_id * position_count);
+							for(unsigned int i = 0; i < position_count; ++i)
+							{
+								int p = patch_it[i];
+								acc0[i] += w0 * p;
+								acc1[i] += w1 * p;
+								acc2[i] += w2 * p;
+								acc3[i] += w3 * p;
+							}
+						}
+
+						for(unsigned int j = 0; j < 4; ++j)
+						{
+							const int * const acc_it = acc0 + (j * max_position_count);
+							const float bias = biases[output_feature_map_id + j];
+							const float mult = output_mult_list_ptr[output_feature_map_id + j];
+							float * const out_it = out_base + ((output_feature_map_id + j) * output_neuron_count_per_feature_map);
+							for(unsigned int i = 0; i < position_count; ++i)
+								out_it[i] = bias + static_cast<float>(acc_it[i]) * mult;
+						}
+					}
+
+					for(unsigned int output_feature_map_id = output_feature_map_count_aligned; output_feature_map_id < output_feature_map_count; ++output_feature_map_id)
+					{
+						for(unsigned int i = 0; i < position_count; ++i)
+							acc0[i] = 0;
+
+						const signed char * const weights_it = weights + (output_feature_map_id * input_elem_count);
+						for(unsigned int input_elem_id = 0; input_elem_id < input_elem_count; ++input_elem_id)
+						{
+							const int w = weights_it[input_elem_id];
+							const short * const patch_it = patch + (input_elem_id * position_count);
+							for(unsigned int i = 0; i < position_count; ++i)
+								acc0[i] += w * patch_it[i];
+						}
+
+						const float bias = biases[output_feature_map_id];
+						const float mult = output_mult_list_ptr[output_feature_map_id];
+						float * const out_it = out_base + (output_feature_map_id * output_neuron_count_per_feature_map);
+						for(unsigned int i = 0; i < position_count; ++i)
+							out_it[i] = bias + static_cast<float>(acc0[i]) * mult;
+					}
+
+					if (activation_type != activation_none)
+						for(unsigned int output_feature_map_id = 0; output_feature_map_id < output_feature_map_count; ++output_feature_map_id)
+							apply_activation(out_base + (output_feature_map_id * output_neuron_count_per_feature_map), position_count);
 				}
 			}
 		}
 
+		bool convolution_layer_tester_plain::is_im2col_applicable(
+			const_layer_smart_ptr layer_schema,
+			const layer_configuration_specific& input_configuration_specific,
+			const layer_configuration_specific& output_configuration_specific)
+		{
+			nnforge_shared_ptr<const convolution_layer> layer_derived = nnforge_dynamic_pointer_cast<const convolution_layer>(layer_schema);
+			unsigned int window_elem_count = 1;
+			for(std::vector<unsigned int>::const_iterator it = layer_derived->window_sizes.begin(); it != layer_derived->window_sizes.end(); ++it)
+				window_elem_count *= *it;
+
+			// Patch matrix pays off only when it is reused by several output feature maps
+			return (output_configuration_specific.feature_map_count >= im2col_min_output_feature_map_count)
+				&& (input_configuration_specific.feature_map_count * window_elem_count >= im2col_min_input_elem_count);
+		}
+
+		std::vector<unsigned int> convolution_layer_tester_plain::get_input_offset_list(
+			const std::vector<unsigned int>& window_sizes,
+			const layer_configuration_specific& input_configuration_specific)
+		{
+			const unsigned int dimension_count = static_cast<unsigned int>(window_sizes.size());
+			std::vector<unsigned int> input_slices(input_configuration_specific.dimension_sizes.size());
+			input_slices[0] = 1;
+			for(unsigned int i = 0; i < dimension_count - 1; ++i)
+				input_slices[i + 1] = input_slices[i] * input_configuration_specific.dimension_sizes[i];
+			unsigned int window_elem_count = 1;
+			for(unsigned int i = 0; i < dimension_count; ++i)
+				window_elem_count *= window_sizes[i];
+
+			std::vector<unsigned int> current_local_input_position(dimension_count, 0);
+			std::vector<unsigned int> offset_list(window_elem_count);
+			for(unsigned int i = 1; i < window_elem_count; ++i)
+			{
+				int offset = 0;
+				for(unsigned int j = 0; j < dimension_count; ++j)
+				{
+					offset += static_cast<int>(input_slices[j]);
+					if ((++current_local_input_position[j]) < window_sizes[j])
+					{
+						offset_list[i] = offset_list[i-1] + offset;
+						break;
+					}
+					current_local_input_position[j] = 0;
+					offset -= static_cast<int>(window_sizes[j] * input_slices[j]);
+				}
+			}
+
+			return offset_list;
+		}
+
 		additional_buffer_smart_ptr convolution_layer_tester_plain::get_output_buffer(
 			additional_buffer_smart_ptr input_buffer,
 			additional_buffer_set& additional_buffers) const
@@ -160,6 +762,22 @@ namespace nnforge
 
 			res.push_back(std::make_pair<unsigned int, bool>(output_configuration_specific.get_neuron_count(), true));
 
+			if (is_im2col_applicable(layer_schema, input_configuration_specific, output_configuration_specific))
+			{
+				nnforge_shared_ptr<const convolution_layer> layer_derived = nnforge_dynamic_pointer_cast<const convolution_layer>(layer_schema);
+				unsigned int input_elem_count = input_configuration_specific.feature_map_count;
+				for(std::vector<unsigned int>::const_iterator it = layer_derived->window_sizes.begin(); it != layer_derived->window_sizes.end(); ++it)
+					input_elem_count *= *it;
+				unsigned int patch_elem_count = input_elem_count * std::min(im2col_position_block_size, output_configuration_specific.get_neuron_count_per_feature_map());
+
+				for(int i = 0; i < plain_config->openmp_thread_count; ++i)
+					res.push_back(std::make_pair(patch_elem_count, false));
+			}
+
+			// Input quantized to int8, it is accounted for even when the data is not quantized as the buffers are planned before that is known
+			if (is_quantized_data_supported(layer_schema, input_configuration_specific))
+				res.push_back(std::make_pair((input_configuration_specific.get_neuron_count() + 3) / 4, true));
+
 			return res;
 		}
 	}
@@ -27,6 +27,10 @@ namespace nnforge
 		public:
 			convolution_layer_tester_plain();
 
+			// The tester applies the activation layer to the output before storing it
+			// activation_layer_schema should be fusable, see is_activation_fusable
+			convolution_layer_tester_plain(const_layer_smart_ptr activation_layer_schema);
+
 			virtual ~convolution_layer_tester_plain();
 
 			virtual const boost::uuids::uuid& get_uuid() const;
@@ -41,10 +45,21 @@ namespace nnforge
 				const layer_configuration_specific& output_configuration_specific,
 				unsigned int entry_count) const;
 
+			virtual bool is_reduced_precision_data_supported() const;
+
+			// False when int32 sums over the window of all the input feature maps might overflow
+			virtual bool is_quantized_data_supported(
+				const_layer_smart_ptr layer_schema,
+				const layer_configuration_specific& input_configuration_specific) const;
+
+			virtual bool is_mapped_data_supported() const;
+
 			virtual additional_buffer_smart_ptr get_output_buffer(
 				additional_buffer_smart_ptr input_buffer,
 				additional_buffer_set& additional_buffers) const;
 
+			static bool is_activation_fusable(const_layer_smart_ptr layer_schema);
+
 		protected:
 			virtual std::vector<std::pair<unsigned int, bool> > get_elem_count_and_per_entry_flag_additional_buffers(
 				const_layer_smart_ptr layer_schema,
@@ -52,8 +67,73 @@ namespace nnforge
 				const layer_configuration_specific& output_configuration_specific,
 				plain_running_configuration_const_smart_ptr plain_config) const;
 
+		private:
+			void test_direct(
+				additional_buffer_smart_ptr input_buffer,
+				additional_buffer_set& additional_buffers,
+				plain_running_configuration_const_smart_ptr plain_config,
+				const_layer_smart_ptr layer_schema,
+				const_layer_data_smart_ptr data,
+				const layer_configuration_specific& input_configuration_specific,
+				const layer_configuration_specific& output_configuration_specific,
+				unsigned int entry_count) const;
+
+			// Lowers blocks of output positions into patch matrix and multiplies weights by it
+			void test_im2col(
+				additional_buffer_smart_ptr input_buffer,
+				additional_buffer_set& additional_buffers,
+				plain_running_configuration_const_smart_ptr plain_config,
+				const_layer_smart_ptr layer_schema,
+				const_layer_data_smart_ptr data,
+				const layer_configuration_specific& input_configuration_specific,
+				const layer_configuration_specific& output_configuration_specific,
+				unsigned int entry_count) const;
+
+			// Runs im2col scheme on int8 input and weights with int32 accumulation
+			void test_quantized(
+				additional_buffer_smart_ptr input_buffer,
+				additional_buffer_set& additional_buffers,
+				plain_running_configuration_const_smart_ptr plain_config,
+				const_layer_smart_ptr layer_schema,
+				const_layer_data_smart_ptr data,
+				const layer_configuration_specific& input_configuration_specific,
+				const layer_configuration_specific& output_configuration_specific,
+				unsigned int entry_count) const;
+
+			static bool is_im2col_applicable(
+				const_layer_smart_ptr layer_schema,
+				const layer_configuration_specific& input_configuration_specific,
+				const layer_configuration_specific& output_configuration_specific);
+
+			static std::vector<unsigned int> get_input_offset_list(
+				const std::vector<unsigned int>& window_sizes,
+				const layer_configuration_specific& input_configuration_specific);
+
+			void apply_activation(
+				float * data,
+				unsigned int elem_count) const;
+
+		private:
+			enum activation_type_enum
+			{
+				activation_none,
+				activation_hyperbolic_tangent,
+				activation_rectified_linear,
+				activation_sigmoid
+			};
+
+			activation_type_enum activation_type;
+			float hyperbolic_tangent_steepness2;
+			float hyperbolic_tangent_major_multiplier;
+
 		private:
 			static const int max_dimension_count;
+
+			static const unsigned int im2col_position_block_size;
+			static const unsigned int im2col_input_block_size;
+			static const unsigned int im2col_min_output_feature_map_count;
+			static const unsigned int im2col_min_input_elem_count;
+			static const unsigned int max_quantized_input_elem_count;
 		};
 	}
 }
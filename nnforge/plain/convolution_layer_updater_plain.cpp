@@ -21,12 +21,272 @@
 #include "../nn_types.h"
 
 #include <array>
+#include <boost/bind/bind.hpp>
 
 namespace nnforge
 {
 	namespace plain
 	{
 		const int convolution_layer_updater_plain::max_dimension_count = 4;
+		// Skipping zero errors costs a branch for each output element, it pays off when at least half of them are zeros
+		const float convolution_layer_updater_plain::min_sparse_error_ratio = 0.5F;
+
+		struct convolution_layer_updater_plain::test_body
+		{
+			bool same_input;
+			unsigned int input_neuron_count;
+			unsigned int input_neuron_count_per_feature_map;
+			unsigned int output_neuron_count;
+			unsigned int output_neuron_count_per_feature_map;
+			additional_buffer::const_iterator in_it_global;
+			additional_buffer::iterator out_it_global;
+			unsigned int dimension_count;
+			unsigned int const_window_elem_count;
+			layer_data_list::const_iterator data_list_it;
+			unsigned int output_feature_map_count;
+			unsigned int input_feature_map_count;
+			std::vector<unsigned int>::const_iterator output_dimension_sizes_it;
+			std::vector<unsigned int>::const_iterator input_slices_it;
+			std::vector<unsigned int>::const_iterator offset_list_it;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				nnforge_array<unsigned int, max_dimension_count> current_output_position;
+
+				for(int workload_id = begin; workload_id < end; ++workload_id)
+				{
+					int entry_id = workload_id / output_feature_map_count;
+					int output_feature_map_id = workload_id - (entry_id * output_feature_map_count);
+
+					const std::vector<float>::const_iterator weights = (**(data_list_it + entry_id))[0].begin();
+					const std::vector<float>::const_iterator biases = (**(data_list_it + entry_id))[1].begin();
+
+					additional_buffer::iterator out_it_base = out_it_global + (entry_id * output_neuron_count) + (output_feature_map_id * output_neuron_count_per_feature_map);
+					additional_buffer::const_iterator in_it_base = in_it_global + (same_input ? 0 : (entry_id * input_neuron_count));
+
+					std::fill_n(current_output_position.begin(), dimension_count, 0);
+					for(additional_buffer::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it)
+					{
+						float sum = *(biases + output_feature_map_id);
+						std::vector<float>::const_iterator weights_it = weights + (output_feature_map_id * (const_window_elem_count * input_feature_map_count));
+						additional_buffer::const_iterator in_it_base2 = in_it_base;
+						for(unsigned int i = 0; i < dimension_count; ++i)
+							in_it_base2 += current_output_position[i] * (*(input_slices_it + i));
+						for(unsigned int input_feature_map_id = 0; input_feature_map_id < input_feature_map_count; ++input_feature_map_id)
+						{
+							// Define the starting position of the first input elem
+							additional_buffer::const_iterator in_it = in_it_base2 + (input_feature_map_id * input_neuron_count_per_feature_map);
+
+							for(unsigned int i = 0; i < const_window_elem_count; ++i)
+							{
+								sum += (*(in_it + *(offset_list_it + i))) * (*weights_it);
+								++weights_it;
+							}
+						}
+						*out_it = sum;
+
+						// Go to the next output element
+						for(unsigned int i = 0; i < dimension_count; ++i)
+						{
+							if ((++current_output_position[i]) < *(output_dimension_sizes_it + i))
+								break;
+							current_output_position[i] = 0;
+						}
+					}
+				}
+			}
+		};
+
+		struct convolution_layer_updater_plain::backprop_body
+		{
+			additional_buffer::iterator in_err_it_global;
+			additional_buffer::const_iterator out_err_it_global;
+			unsigned int input_neuron_count;
+			unsigned int input_neuron_count_per_feature_map;
+			unsigned int output_neuron_count;
+			unsigned int output_neuron_count_per_feature_map;
+			unsigned int dimension_count;
+			unsigned int const_window_elem_count;
+			layer_data_list::const_iterator data_list_it;
+			unsigned int output_feature_map_count;
+			unsigned int input_feature_map_count;
+			std::vector<unsigned int>::const_iterator output_dimension_sizes_it;
+			std::vector<unsigned int>::const_iterator input_slices_it;
+			std::vector<unsigned int>::const_iterator offset_list_it;
+			// Output elements with zero error are skipped
+			bool sparse;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				nnforge_array<unsigned int, max_dimension_count> current_output_position;
+
+				for(int workload_id = begin; workload_id < end; ++workload_id)
+				{
+					int entry_id = workload_id / input_feature_map_count;
+					int input_feature_map_id = workload_id - (entry_id * input_feature_map_count);
+
+					const std::vector<float>::const_iterator weights = (**(data_list_it + entry_id))[0].begin();
+
+					additional_buffer::const_iterator out_err_it_base = out_err_it_global + (entry_id * output_neuron_count);
+					additional_buffer::iterator in_err_it_base = in_err_it_global + (entry_id * input_neuron_count) + (input_feature_map_id * input_neuron_count_per_feature_map);
+					std::vector<float>::const_iterator weights_it_base = weights + (const_window_elem_count * input_feature_map_id);
+
+					std::fill_n(in_err_it_base, input_neuron_count_per_feature_map, 0.0F);
+					std::fill_n(current_output_position.begin(), dimension_count, 0);
+					for(additional_buffer::const_iterator out_err_it_base2 = out_err_it_base; out_err_it_base2 != out_err_it_base + output_neuron_count_per_feature_map; ++out_err_it_base2)
+					{
+						additional_buffer::iterator in_err_it = in_err_it_base;
+						for(unsigned int i = 0; i < dimension_count; ++i)
+							in_err_it += current_output_position[i] * (*(input_slices_it + i));
+
+						for(unsigned int output_feature_map_id = 0; output_feature_map_id < output_feature_map_count; ++output_feature_map_id)
+						{
+							additional_buffer::const_iterator out_err_it = out_err_it_base2 + (output_feature_map_id * output_neuron_count_per_feature_map);
+							std::vector<float>::const_iterator weights_it_base2 = weights_it_base + (output_feature_map_id * (const_window_elem_count * input_feature_map_count));
+							std::vector<float>::const_iterator weights_it = weights_it_base2;
+							float current_err = *out_err_it;
+							if (sparse && (current_err == 0.0F))
+								continue;
+							for(unsigned int i = 0; i < const_window_elem_count; ++i)
+							{
+								float w = *weights_it;
+								*(in_err_it + *(offset_list_it + i)) += (w * current_err);
+								++weights_it;
+							}
+						}
+
+						// Go to the next output element
+						for(unsigned int i = 0; i < dimension_count; ++i)
+						{
+							if ((++current_output_position[i]) < *(output_dimension_sizes_it + i))
+								break;
+							current_output_position[i] = 0;
+						}
+					}
+				}
+			}
+		};
+
+		struct convolution_layer_updater_plain::update_weights_body
+		{
+			bool same_input;
+			unsigned int input_neuron_count;
+			unsigned int input_neuron_count_per_feature_map;
+			unsigned int output_neuron_count;
+			unsigned int output_neuron_count_per_feature_map;
+			additional_buffer::const_iterator in_it_global;
+			additional_buffer::const_iterator out_err_it_global;
+			unsigned int dimension_count;
+			unsigned int const_window_elem_count;
+			layer_data_list::iterator data_list_it;
+			layer_data_list::const_iterator learning_rate_list_it;
+			unsigned int output_feature_map_count;
+			unsigned int input_feature_map_count;
+			float weight_decay_scaled;
+			std::vector<unsigned int>::const_iterator output_dimension_sizes_it;
+			std::vector<unsigned int>::const_iterator input_slices_it;
+			std::vector<unsigned int>::const_iterator offset_list_it;
+			unsigned int mini_batch_size;
+			// Output elements with zero error are skipped
+			bool sparse;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				nnforge_array<unsigned int, max_dimension_count> current_output_position;
+				std::vector<float> weights_local(const_window_elem_count, 0.0F);
+
+				for(int workload_id = begin; workload_id < end; ++workload_id)
+				{
+					int entry_id = workload_id / (output_feature_map_count * input_feature_map_count);
+					int feature_map_pair_id = workload_id - (entry_id * output_feature_map_count * input_feature_map_count);
+					int output_feature_map_id = feature_map_pair_id / input_feature_map_count;
+					int input_feature_map_id = feature_map_pair_id - (output_feature_map_id * input_feature_map_count);
+
+					const std::vector<float>::iterator weights = (**(data_list_it + entry_id))[0].begin();
+					const std::vector<float>::const_iterator learning_rates = (**(learning_rate_list_it + entry_id))[0].begin();
+
+					std::vector<float>::iterator weights_it_base = weights + (output_feature_map_id * (const_window_elem_count * input_feature_map_count)) + (const_window_elem_count * input_feature_map_id);
+					std::vector<float>::const_iterator learning_rates_it_base = learning_rates + (output_feature_map_id * (const_window_elem_count * input_feature_map_count)) + (const_window_elem_count * input_feature_map_id);
+
+					std::fill_n(weights_local.begin(), const_window_elem_count, 0.0F);
+					for(unsigned int batch_entry_id = entry_id * mini_batch_size; batch_entry_id < (entry_id + 1) * mini_batch_size; ++batch_entry_id)
+					{
+						additional_buffer::const_iterator in_it_base = in_it_global + (same_input ? 0 : (batch_entry_id * input_neuron_count)) + (input_feature_map_id * input_neuron_count_per_feature_map);
+						additional_buffer::const_iterator out_err_it_base = out_err_it_global + (batch_entry_id * output_neuron_count) + (output_feature_map_id * output_neuron_count_per_feature_map);
+
+						std::fill_n(current_output_position.begin(), dimension_count, 0);
+						for(additional_buffer::const_iterator out_err_it = out_err_it_base; out_err_it != out_err_it_base + output_neuron_count_per_feature_map; ++out_err_it)
+						{
+							float current_err = *out_err_it;
+							if ((!sparse) || (current_err != 0.0F))
+							{
+								additional_buffer::const_iterator in_it = in_it_base;
+								for(unsigned int i = 0; i < dimension_count; ++i)
+									in_it += current_output_position[i] * (*(input_slices_it + i));
+
+								for(unsigned int i = 0; i < const_window_elem_count; ++i)
+								{
+									float in_neuron = *(in_it + *(offset_list_it + i));
+									weights_local[i] += (in_neuron * current_err);
+								}
+							}
+
+							// Go to the next output element
+							for(unsigned int i = 0; i < dimension_count; ++i)
+							{
+								if ((++current_output_position[i]) < *(output_dimension_sizes_it + i))
+									break;
+								current_output_position[i] = 0;
+							}
+						}
+					}
+
+					std::vector<float>::iterator weights_local_it = weights_local.begin();
+					std::vector<float>::const_iterator learning_rates_it = learning_rates_it_base;
+					for(std::vector<float>::iterator it = weights_it_base; it != weights_it_base + const_window_elem_count; ++it, ++weights_local_it, ++learning_rates_it)
+					{
+						float current_weight = *it;
+						float grd = *weights_local_it;
+						float lr = *learning_rates_it;
+						float new_weight = current_weight + lr * (grd - weight_decay_scaled * current_weight);
+						*it = new_weight;
+					}
+				}
+			}
+		};
+
+		struct convolution_layer_updater_plain::update_biases_body
+		{
+			additional_buffer::const_iterator out_err_it_global;
+			unsigned int output_neuron_count;
+			unsigned int output_neuron_count_per_feature_map;
+			layer_data_list::iterator data_list_it;
+			layer_data_list::const_iterator learning_rate_list_it;
+			unsigned int output_feature_map_count;
+			unsigned int mini_batch_size;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				for(int workload_id = begin; workload_id < end; ++workload_id)
+				{
+					int entry_id = workload_id / output_feature_map_count;
+					int output_feature_map_id = workload_id - (entry_id * output_feature_map_count);
+
+					float sum = 0.0F;
+					for(unsigned int batch_entry_id = entry_id * mini_batch_size; batch_entry_id < (entry_id + 1) * mini_batch_size; ++batch_entry_id)
+					{
+						additional_buffer::const_iterator out_err_it_base = out_err_it_global + (batch_entry_id * output_neuron_count) + (output_feature_map_id * output_neuron_count_per_feature_map);
+						for(additional_buffer::const_iterator out_err_it = out_err_it_base; out_err_it != out_err_it_base + output_neuron_count_per_feature_map; ++out_err_it)
+							sum += *out_err_it;
+					}
+
+					const std::vector<float>::iterator biases = (**(data_list_it + entry_id))[1].begin();
+					const std::vector<float>::const_iterator learning_rates = (**(learning_rate_list_it + entry_id))[1].begin();
+
+					*(biases + output_feature_map_id) += sum * *(learning_rates + output_feature_map_id);
+				}
+			}
+		};
 
 		convolution_layer_updater_plain::convolution_layer_updater_plain()
 		{
@@ -58,8 +318,8 @@ namespace nnforge
 			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
 			const unsigned int output_neuron_count = output_configuration_specific.get_neuron_count();
 			const unsigned int output_neuron_count_per_feature_map = output_configuration_specific.get_neuron_count_per_feature_map();
-			const std::vector<float>::const_iterator in_it_global = input_buffer->begin() + (same_input ? input_neuron_count * offset_input_entry_id : 0);
-			const std::vector<float>::iterator out_it_global = output_buffer->begin();
+			const additional_buffer::const_iterator in_it_global = input_buffer->begin() + (same_input ? input_neuron_count * offset_input_entry_id : 0);
+			const additional_buffer::iterator out_it_global = output_buffer->begin();
 			nnforge_shared_ptr<const convolution_layer> layer_derived = nnforge_dynamic_pointer_cast<const convolution_layer>(layer_schema);
 			const std::vector<unsigned int>& window_sizes = layer_derived->window_sizes;
 			const unsigned int dimension_count = static_cast<unsigned int>(window_sizes.size());
@@ -98,53 +358,8 @@ namespace nnforge
 			const std::vector<unsigned int>::const_iterator input_slices_it = input_slices.begin();
 			const std::vector<unsigned int>::const_iterator offset_list_it = offset_list.begin();
 
-			#pragma omp parallel default(none) num_threads(plain_config->openmp_thread_count)
-			{
-				nnforge_array<unsigned int, max_dimension_count> current_output_position;
-
-				#pragma omp for schedule(guided)
-				for(int workload_id = 0; workload_id < total_workload; ++workload_id)
-				{
-					int entry_id = workload_id / output_feature_map_count;
-					int output_feature_map_id = workload_id - (entry_id * output_feature_map_count);
-
-					const std::vector<float>::const_iterator weights = (**(data_list_it + entry_id))[0].begin();
-					const std::vector<float>::const_iterator biases = (**(data_list_it + entry_id))[1].begin();
-
-					std::vector<float>::iterator out_it_base = out_it_global + (entry_id * output_neuron_count) + (output_feature_map_id * output_neuron_count_per_feature_map);
-					std::vector<float>::const_iterator in_it_base = in_it_global + (same_input ? 0 : (entry_id * input_neuron_count));
-
-					std::fill_n(current_output_position.begin(), dimension_count, 0);
-					for(std::vector<float>::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it)
-					{
-						float sum = *(biases + output_feature_map_id);
-						std::vector<float>::const_iterator weights_it = weights + (output_feature_map_id * (const_window_elem_count * input_feature_map_count));
-						std::vector<float>::const_iterator in_it_base2 = in_it_base;
-						for(unsigned int i = 0; i < dimension_count; ++i)
-							in_it_base2 += current_output_position[i] * (*(input_slices_it + i));
-						for(unsigned int input_feature_map_id = 0; input_feature_map_id < input_feature_map_count; ++input_feature_map_id)
-						{
-							// Define the starting position of the first input elem
-							std::vector<float>::const_iterator in_it = in_it_base2 + (input_feature_map_id * input_neuron_count_per_feature_map);
-
-							for(unsigned int i = 0; i < const_window_elem_count; ++i)
-							{
-								sum += (*(in_it + *(offset_list_it + i))) * (*weights_it);
-								++weights_it;
-							}
-						}
-						*out_it = sum;
-
-						// Go to the next output element
-						for(unsigned int i = 0; i < dimension_count; ++i)
-						{
-							if ((++current_output_position[i]) < *(output_dimension_sizes_it + i))
-								break;
-							current_output_position[i] = 0;
-						}
-					}
-				}
-			}
+			const test_body body = { same_input, input_neuron_count, input_neuron_count_per_feature_map, output_neuron_count, output_neuron_count_per_feature_map, in_it_global, out_it_global, dimension_count, const_window_elem_count, data_list_it, output_feature_map_count, input_feature_map_count, output_dimension_sizes_it, input_slices_it, offset_list_it };
+			plain_config->parallel_for(total_workload, body);
 		}
 
 		void convolution_layer_updater_plain::backprop(
@@ -158,10 +373,11 @@ namespace nnforge
 			const layer_data_list& data,
 			const layer_configuration_specific& input_configuration_specific,
 			const layer_configuration_specific& output_configuration_specific,
-			unsigned int updater_count) const
+			unsigned int updater_count,
+			unsigned int output_errors_zero_count) const
 		{
-			const std::vector<float>::iterator in_err_it_global = input_errors->begin();
-			const std::vector<float>::const_iterator out_err_it_global = output_errors->begin();
+			const additional_buffer::iterator in_err_it_global = input_errors->begin();
+			const additional_buffer::const_iterator out_err_it_global = output_errors->begin();
 			const unsigned int input_neuron_count = input_configuration_specific.get_neuron_count();
 			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
 			const unsigned int output_neuron_count = output_configuration_specific.get_neuron_count();
@@ -203,55 +419,10 @@ namespace nnforge
 			const std::vector<unsigned int>::const_iterator output_dimension_sizes_it = output_configuration_specific.dimension_sizes.begin();
 			const std::vector<unsigned int>::const_iterator input_slices_it = input_slices.begin();
 			const std::vector<unsigned int>::const_iterator offset_list_it = offset_list.begin();
+			const bool sparse = is_sparse(output_errors_zero_count, updater_count * output_neuron_count);
 
-			#pragma omp parallel default(none) num_threads(plain_config->openmp_thread_count)
-			{
-				nnforge_array<unsigned int, max_dimension_count> current_output_position;
-
-				#pragma omp for schedule(guided)
-				for(int workload_id = 0; workload_id < total_workload; ++workload_id)
-				{
-					int entry_id = workload_id / input_feature_map_count;
-					int input_feature_map_id = workload_id - (entry_id * input_feature_map_count);
-
-					const std::vector<float>::const_iterator weights = (**(data_list_it + entry_id))[0].begin();
-
-					std::vector<float>::const_iterator out_err_it_base = out_err_it_global + (entry_id * output_neuron_count);
-					std::vector<float>::iterator in_err_it_base = in_err_it_global + (entry_id * input_neuron_count) + (input_feature_map_id * input_neuron_count_per_feature_map);
-					std::vector<float>::const_iterator weights_it_base = weights + (const_window_elem_count * input_feature_map_id);
-
-					std::fill_n(in_err_it_base, input_neuron_count_per_feature_map, 0.0F);
-					std::fill_n(current_output_position.begin(), dimension_count, 0);
-					for(std::vector<float>::const_iterator out_err_it_base2 = out_err_it_base; out_err_it_base2 != out_err_it_base + output_neuron_count_per_feature_map; ++out_err_it_base2)
-					{
-						std::vector<float>::iterator in_err_it = in_err_it_base;
-						for(unsigned int i = 0; i < dimension_count; ++i)
-							in_err_it += current_output_position[i] * (*(input_slices_it + i));
-
-						for(unsigned int output_feature_map_id = 0; output_feature_map_id < output_feature_map_count; ++output_feature_map_id)
-						{
-							std::vector<float>::const_iterator out_err_it = out_err_it_base2 + (output_feature_map_id * output_neuron_count_per_feature_map);
-							std::vector<float>::const_iterator weights_it_base2 = weights_it_base + (output_feature_map_id * (const_window_elem_count * input_feature_map_count));
-							std::vector<float>::const_iterator weights_it = weights_it_base2;
-							float current_err = *out_err_it;
-							for(unsigned int i = 0; i < const_window_elem_count; ++i)
-							{
-								float w = *weights_it;
-								*(in_err_it + *(offset_list_it + i)) += (w * current_err);
-								++weights_it;
-							}
-						}
-
-						// Go to the next output element
-						for(unsigned int i = 0; i < dimension_count; ++i)
-						{
-							if ((++current_output_position[i]) < *(output_dimension_sizes_it + i))
-								break;
-							current_output_position[i] = 0;
-						}
-					}
-				}
-			}
+			const backprop_body body = { in_err_it_global, out_err_it_global, input_neuron_count, input_neuron_count_per_feature_map, output_neuron_count, output_neuron_count_per_feature_map, dimension_count, const_window_elem_count, data_list_it, output_feature_map_count, input_feature_map_count, output_dimension_sizes_it, input_slices_it, offset_list_it, sparse };
+			plain_config->parallel_for(total_workload, body);
 		}
 
 		void convolution_layer_updater_plain::update_weights(
@@ -265,16 +436,18 @@ namespace nnforge
 			const layer_configuration_specific& input_configuration_specific,
 			const layer_configuration_specific& output_configuration_specific,
 			unsigned int updater_count,
+			unsigned int mini_batch_size,
 			int offset_input_entry_id,
-			const float weight_decay) const
+			const float weight_decay,
+			unsigned int output_errors_zero_count) const
 		{
 			const bool same_input = (offset_input_entry_id >= 0);
 			const unsigned int input_neuron_count = input_configuration_specific.get_neuron_count();
 			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
 			const unsigned int output_neuron_count = output_configuration_specific.get_neuron_count();
 			const unsigned int output_neuron_count_per_feature_map = output_configuration_specific.get_neuron_count_per_feature_map();
-			const std::vector<float>::const_iterator in_it_global = input_neurons->begin() + (same_input ? input_neuron_count * offset_input_entry_id : 0);
-			const std::vector<float>::const_iterator out_err_it_global = output_errors->begin();
+			const additional_buffer::const_iterator in_it_global = input_neurons->begin() + (same_input ? input_neuron_count * offset_input_entry_id : 0);
+			const additional_buffer::const_iterator out_err_it_global = output_errors->begin();
 			nnforge_shared_ptr<const convolution_layer> layer_derived = nnforge_dynamic_pointer_cast<const convolution_layer>(layer_schema);
 			const std::vector<unsigned int>& window_sizes = layer_derived->window_sizes;
 			const unsigned int dimension_count = static_cast<unsigned int>(window_sizes.size());
@@ -311,90 +484,45 @@ namespace nnforge
 			const unsigned int input_feature_map_count = input_configuration_specific.feature_map_count;
 			const int total_workload = output_feature_map_count * input_feature_map_count * updater_count;
 			const unsigned int const_entry_count = updater_count;
+			// Gradients are summed over the mini-batch, so weight decay is scaled to match mini_batch_size single-entry updates
+			const float weight_decay_scaled = weight_decay * static_cast<float>(mini_batch_size);
 			const std::vector<unsigned int>::const_iterator output_dimension_sizes_it = output_configuration_specific.dimension_sizes.begin();
 			const std::vector<unsigned int>::const_iterator input_slices_it = input_slices.begin();
 			const std::vector<unsigned int>::const_iterator offset_list_it = offset_list.begin();
+			const bool sparse = is_sparse(output_errors_zero_count, updater_count * mini_batch_size * output_neuron_count);
 
-			#pragma omp parallel default(none) num_threads(plain_config->openmp_thread_count)
-			{
-				nnforge_array<unsigned int, max_dimension_count> current_output_position;
-				std::vector<float> weights_local(const_window_elem_count, 0.0F);
-
-				#pragma omp for schedule(guided)
-				for(int workload_id = 0; workload_id < total_workload; ++workload_id)
-				{
-					int entry_id = workload_id / (output_feature_map_count * input_feature_map_count);
-					int feature_map_pair_id = workload_id - (entry_id * output_feature_map_count * input_feature_map_count);
-					int output_feature_map_id = feature_map_pair_id / input_feature_map_count;
-					int input_feature_map_id = feature_map_pair_id - (output_feature_map_id * input_feature_map_count);
-
-					const std::vector<float>::iterator weights = (**(data_list_it + entry_id))[0].begin();
-					const std::vector<float>::const_iterator learning_rates = (**(learning_rate_list_it + entry_id))[0].begin();
-
-					std::vector<float>::const_iterator in_it_base = in_it_global + (same_input ? 0 : (entry_id * input_neuron_count)) + (input_feature_map_id * input_neuron_count_per_feature_map);
-					std::vector<float>::const_iterator out_err_it_base = out_err_it_global + (entry_id * output_neuron_count) + (output_feature_map_id * output_neuron_count_per_feature_map);
-					std::vector<float>::iterator weights_it_base = weights + (output_feature_map_id * (const_window_elem_count * input_feature_map_count)) + (const_window_elem_count * input_feature_map_id);
-					std::vector<float>::const_iterator learning_rates_it_base = learning_rates + (output_feature_map_id * (const_window_elem_count * input_feature_map_count)) + (const_window_elem_count * input_feature_map_id);
-
-					std::fill_n(weights_local.begin(), const_window_elem_count, 0.0F);
-					std::fill_n(current_output_position.begin(), dimension_count, 0);
-					for(std::vector<float>::const_iterator out_err_it = out_err_it_base; out_err_it != out_err_it_base + output_neuron_count_per_feature_map; ++out_err_it)
-					{
-						std::vector<float>::const_iterator in_it = in_it_base;
-						for(unsigned int i = 0; i < dimension_count; ++i)
-							in_it += current_output_position[i] * (*(input_slices_it + i));
-
-						float current_err = *out_err_it;
-						for(unsigned int i = 0; i < const_window_elem_count; ++i)
-						{
-							float in_neuron = *(in_it + *(offset_list_it + i));
-							weights_local[i] += (in_neuron * current_err);
-						}
-
-						// Go to the next output element
-						for(unsigned int i = 0; i < dimension_count; ++i)
-						{
-							if ((++current_output_position[i]) < *(output_dimension_sizes_it + i))
-								break;
-							current_output_position[i] = 0;
-						}
-					}
-
-					std::vector<float>::iterator weights_local_it = weights_local.begin();
-					std::vector<float>::const_iterator learning_rates_it = learning_rates_it_base;
-					for(std::vector<float>::iterator it = weights_it_base; it != weights_it_base + const_window_elem_count; ++it, ++weights_local_it, ++learning_rates_it)
-					{
-						float current_weight = *it;
-						float grd = *weights_local_it;
-						float lr = *learning_rates_it;
-						float new_weight = current_weight + lr * (grd - weight_decay * current_weight);
-						*it = new_weight;
-					}
-				}
-			}
+			const update_weights_body weights_body = { same_input, input_neuron_count, input_neuron_count_per_feature_map, output_neuron_count, output_neuron_count_per_feature_map, in_it_global, out_err_it_global, dimension_count, const_window_elem_count, data_list_it, learning_rate_list_it, output_feature_map_count, input_feature_map_count, weight_decay_scaled, output_dimension_sizes_it, input_slices_it, offset_list_it, mini_batch_size, sparse };
+			const task_scheduler::range_function weights_func = weights_body;
 
 			const int total_workload_bias = output_feature_map_count * updater_count;
-			#pragma omp parallel for default(none) schedule(guided) num_threads(plain_config->openmp_thread_count)
-			for(int workload_id = 0; workload_id < total_workload_bias; ++workload_id)
-			{
-				int entry_id = workload_id / output_feature_map_count;
-				int output_feature_map_id = workload_id - (entry_id * output_feature_map_count);
-
-				std::vector<float>::const_iterator out_err_it_base = out_err_it_global + (entry_id * output_neuron_count) + (output_feature_map_id * output_neuron_count_per_feature_map);
-				float sum = 0.0F;
-				for(std::vector<float>::const_iterator out_err_it = out_err_it_base; out_err_it != out_err_it_base + output_neuron_count_per_feature_map; ++out_err_it)
-					sum += *out_err_it;
-
-				const std::vector<float>::iterator biases = (**(data_list_it + entry_id))[1].begin();
-				const std::vector<float>::const_iterator learning_rates = (**(learning_rate_list_it + entry_id))[1].begin();
-
-				*(biases + output_feature_map_id) += sum * *(learning_rates + output_feature_map_id);
-			}
+			const update_biases_body biases_body = { out_err_it_global, output_neuron_count, output_neuron_count_per_feature_map, data_list_it, learning_rate_list_it, output_feature_map_count, mini_batch_size };
+			const task_scheduler::range_function biases_func = biases_body;
+
+			// Weights and biases are independent, they are updated concurrently when the task scheduler is on
+			task_group group(plain_config->scheduler);
+			group.run(boost::bind(&plain_running_configuration::parallel_for, plain_config, total_workload, boost::cref(weights_func)));
+			group.run(boost::bind(&plain_running_configuration::parallel_for, plain_config, total_workload_bias, boost::cref(biases_func)));
+			group.wait();
 		}
 
 		bool convolution_layer_updater_plain::is_in_place_backprop() const
 		{
 			return false;
 		}
+
+		bool convolution_layer_updater_plain::is_output_errors_zero_count_used() const
+		{
+			return true;
+		}
+
+		bool convolution_layer_updater_plain::is_sparse(
+			unsigned int zero_count,
+			unsigned int elem_count)
+		{
+			if (elem_count == 0)
+				return false;
+
+			return (static_cast<float>(zero_count) >= static_cast<float>(elem_count) * min_sparse_error_ratio);
+		}
 	}
 }
@@ -54,7 +54,8 @@ namespace nnforge
 				const layer_data_list& data,
 				const layer_configuration_specific& input_configuration_specific,
 				const layer_configuration_specific& output_configuration_specific,
-				unsigned int updater_count) const;
+				unsigned int updater_count,
+				unsigned int output_errors_zero_count) const;
 
 			virtual void update_weights(
 				const_additional_buffer_smart_ptr input_neurons,
@@ -67,14 +68,30 @@ namespace nnforge
 				const layer_configuration_specific& input_configuration_specific,
 				const layer_configuration_specific& output_configuration_specific,
 				unsigned int updater_count,
+				unsigned int mini_batch_size,
 				int offset_input_entry_id,
-				const float weight_decay) const;
+				const float weight_decay,
+				unsigned int output_errors_zero_count) const;
+
+			virtual bool is_output_errors_zero_count_used() const;
 
 		protected:
 			virtual bool is_in_place_backprop() const;
 
 		private:
 			static const int max_dimension_count;
+			static const float min_sparse_error_ratio;
+
+			// Returns true when the share of zeros in the errors is high enough for the kernels to skip them
+			static bool is_sparse(
+				unsigned int zero_count,
+				unsigned int elem_count);
+
+			// Kernel bodies run by plain_running_configuration::parallel_for
+			struct test_body;
+			struct backprop_body;
+			struct update_weights_body;
+			struct update_biases_body;
 		};
 	}
 }
@@ -25,6 +25,33 @@ namespace nnforge
 {
 	namespace plain
 	{
+		struct convolution_weight_vector_bound_plain::normalize_body
+		{
+			unsigned int weight_block_size;
+			unsigned int output_feature_map_count;
+			layer_data_list::iterator data_list_it;
+			float max_l2_norm_squared;
+			accum_helper_struct accum_helper;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				for(int workload_id = begin; workload_id < end; ++workload_id)
+				{
+					int entry_id = workload_id / output_feature_map_count;
+					int output_feature_map_id = workload_id - (entry_id * output_feature_map_count);
+
+					std::vector<float>::iterator weights = (**(data_list_it + entry_id))[0].begin() + (output_feature_map_id * weight_block_size);
+
+					float l2_norm_squared = std::accumulate(weights, weights + weight_block_size, 0.0F, accum_helper);
+					if (l2_norm_squared > max_l2_norm_squared)
+					{
+						float mult = sqrtf(max_l2_norm_squared / l2_norm_squared);
+						std::transform(weights, weights + weight_block_size, weights, scale_helper_struct(mult));
+					}
+				}
+			}
+		};
+
 		convolution_weight_vector_bound_plain::convolution_weight_vector_bound_plain()
 		{
 		}
@@ -57,21 +84,8 @@ namespace nnforge
 			const float max_l2_norm_squared = bound.max_l2_norm * bound.max_l2_norm;
 			const accum_helper_struct accum_helper;
 
-			#pragma omp parallel for default(none) num_threads(plain_config->openmp_thread_count) schedule(guided)
-			for(int workload_id = 0; workload_id < total_workload; ++workload_id)
-			{
-				int entry_id = workload_id / output_feature_map_count;
-				int output_feature_map_id = workload_id - (entry_id * output_feature_map_count);
-
-				std::vector<float>::iterator weights = (**(data_list_it + entry_id))[0].begin() + (output_feature_map_id * weight_block_size);
-
-				float l2_norm_squared = std::accumulate(weights, weights + weight_block_size, 0.0F, accum_helper);
-				if (l2_norm_squared > max_l2_norm_squared)
-				{
-					float mult = sqrtf(max_l2_norm_squared / l2_norm_squared);
-					std::transform(weights, weights + weight_block_size, weights, scale_helper_struct(mult));
-				}
-			}
+			const normalize_body body = { weight_block_size, output_feature_map_count, data_list_it, max_l2_norm_squared, accum_helper };
+			plain_config->parallel_for(total_workload, body);
 		}
 	}
 }
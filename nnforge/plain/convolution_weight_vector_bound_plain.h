@@ -55,6 +55,9 @@ namespace nnforge
 
 				float mult;
 			};
+
+			// Kernel body run by plain_running_configuration::parallel_for
+			struct normalize_body;
 		};
 	}
 }
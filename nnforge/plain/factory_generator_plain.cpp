@@ -38,6 +38,11 @@ namespace nnforge
 			: plain_openmp_thread_count(1)
 			#endif
 			, plain_max_global_memory_usage(0.5F)
+			, plain_updater_mini_batch_size(1)
+			, plain_tester_weight_storage("float")
+			, plain_numa_aware(false)
+			, plain_numa_network_per_node(false)
+			, plain_task_scheduler(false)
 		{
 		}
 
@@ -47,7 +52,7 @@ namespace nnforge
 
 		void factory_generator_plain::initialize()
 		{
-			plain_config = plain_running_configuration_const_smart_ptr(new plain_running_configuration(plain_openmp_thread_count, plain_max_global_memory_usage));
+			plain_config = plain_running_configuration_const_smart_ptr(new plain_running_configuration(plain_openmp_thread_count, plain_max_global_memory_usage, static_cast<unsigned int>(plain_updater_mini_batch_size), weight_storage_type::parse(plain_tester_weight_storage), plain_numa_aware, plain_numa_network_per_node, plain_task_scheduler));
 		}
 
 		network_tester_factory_smart_ptr factory_generator_plain::create_tester_factory() const
@@ -70,6 +75,26 @@ namespace nnforge
 			return network_analyzer_factory_smart_ptr(new network_analyzer_plain_factory(plain_config));
 		}
 
+		std::vector<string_option> factory_generator_plain::get_string_options()
+		{
+			std::vector<string_option> res;
+
+			res.push_back(string_option("plain_tester_weight_storage", &plain_tester_weight_storage, "float", "precision plain tester keeps weights in (float, fp16, bf16), reduced precision is supported by convolution layers."));
+
+			return res;
+		}
+
+		std::vector<bool_option> factory_generator_plain::get_bool_options()
+		{
+			std::vector<bool_option> res;
+
+			res.push_back(bool_option("plain_numa_aware", &plain_numa_aware, false, "pin OpenMP threads to NUMA nodes and place large buffers by first touch of the threads working on them."));
+			res.push_back(bool_option("plain_numa_network_per_node", &plain_numa_network_per_node, false, "train networks of multi-network update on different NUMA nodes, requires plain_numa_aware."));
+			res.push_back(bool_option("plain_task_scheduler", &plain_task_scheduler, false, "run updater kernels as tasks on persistent work-stealing pool instead of OpenMP regions."));
+
+			return res;
+		}
+
 		std::vector<float_option> factory_generator_plain::get_float_options()
 		{
 			std::vector<float_option> res;
@@ -86,6 +111,7 @@ namespace nnforge
 			#ifdef _OPENMP
 			res.push_back(int_option("plain_openmp_thread_count", &plain_openmp_thread_count, omp_get_max_threads(), "count of threads to be used in OpenMP."));
 			#endif
+			res.push_back(int_option("plain_updater_mini_batch_size", &plain_updater_mini_batch_size, 1, "count of entries processed by plain updater in single pass, weights are updated once per mini-batch."));
 
 			return res;
 		}
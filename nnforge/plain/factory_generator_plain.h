@@ -42,6 +42,10 @@ namespace nnforge
 
 			virtual void info() const;
 
+			virtual std::vector<string_option> get_string_options();
+
+			virtual std::vector<bool_option> get_bool_options();
+
 			virtual std::vector<float_option> get_float_options();
 
 			virtual std::vector<int_option> get_int_options();
@@ -49,6 +53,11 @@ namespace nnforge
 		protected:
 			float plain_max_global_memory_usage;
 			int plain_openmp_thread_count;
+			int plain_updater_mini_batch_size;
+			std::string plain_tester_weight_storage;
+			bool plain_numa_aware;
+			bool plain_numa_network_per_node;
+			bool plain_task_scheduler;
 
 			plain_running_configuration_const_smart_ptr plain_config;
 		};
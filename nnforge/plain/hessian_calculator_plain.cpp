@@ -17,6 +17,7 @@
 #include "hessian_calculator_plain.h"
 
 #include <boost/format.hpp>
+#include <algorithm>
 
 #include "layer_tester_plain_factory.h"
 #include "layer_hessian_plain_factory.h"
@@ -32,6 +33,8 @@ namespace nnforge
 			: hessian_calculator(schema)
 			, plain_config(plain_config)
 		{
+			plain_config->bind_openmp_threads();
+
 			const const_layer_list& layer_list = *schema;
 
 			testing_layer_count = 0;
@@ -62,7 +65,17 @@ namespace nnforge
 			network_data_smart_ptr data,
 			unsigned int hessian_entry_to_process_count)
 		{
-			network_data_smart_ptr hessian(new network_data(*schema));
+			return actual_get_hessian(reader, std::vector<network_data_smart_ptr>(1, data), hessian_entry_to_process_count).front();
+		}
+
+		std::vector<network_data_smart_ptr> hessian_calculator_plain::actual_get_hessian(
+			unsupervised_data_reader& reader,
+			const std::vector<network_data_smart_ptr>& data_list,
+			unsigned int hessian_entry_to_process_count)
+		{
+			std::vector<network_data_smart_ptr> res;
+			for(unsigned int i = 0; i < data_list.size(); ++i)
+				res.push_back(network_data_smart_ptr(new network_data(*schema)));
 
 			reader.reset();
 
@@ -78,20 +91,25 @@ namespace nnforge
 			buffers_config.add_per_entry_buffer(input_neuron_count * input_neuron_elem_size); // input
 			buffers_config.add_per_entry_buffer(input_neuron_count * sizeof(float)); // converted input
 			buffers_config.add_per_entry_buffer(output_neuron_count * sizeof(float)); // initial error
-			for(std::vector<layer_data_smart_ptr>::const_iterator it = data->begin(); it != data->end(); ++it)
+			for(std::vector<network_data_smart_ptr>::const_iterator data_it = data_list.begin(); data_it != data_list.end(); ++data_it)
 			{
-				for(layer_data::const_iterator it2 = (*it)->begin(); it2 != (*it)->end(); ++it2)
+				for(std::vector<layer_data_smart_ptr>::const_iterator it = (*data_it)->begin(); it != (*data_it)->end(); ++it)
 				{
-					buffers_config.add_constant_buffer(it2->size() * sizeof(float)); // data
-					buffers_config.add_constant_buffer(it2->size() * sizeof(float)); // hessian
+					for(layer_data::const_iterator it2 = (*it)->begin(); it2 != (*it)->end(); ++it2)
+					{
+						buffers_config.add_constant_buffer(it2->size() * sizeof(float)); // data
+						buffers_config.add_constant_buffer(it2->size() * sizeof(float)); // hessian
+					}
 				}
 			}
 
 			unsigned int max_entry_count = std::min<unsigned int>(plain_config->get_max_entry_count(buffers_config), hessian_entry_to_process_count);
+			// Data and hessians of all the networks might not fit the memory limit, process single entry at once then
+			max_entry_count = std::max<unsigned int>(max_entry_count, 1);
 
 			std::vector<unsigned char> input_buf(max_entry_count * input_neuron_count * input_neuron_elem_size);
-			additional_buffer_smart_ptr initial_error_buf(new std::vector<float>(max_entry_count * output_neuron_count));
-			additional_buffer_smart_ptr input_converted_buf(new std::vector<float>(input_neuron_count * max_entry_count));
+			additional_buffer_smart_ptr initial_error_buf = plain_config->allocate_buffer(max_entry_count * output_neuron_count);
+			additional_buffer_smart_ptr input_converted_buf = plain_config->allocate_buffer(input_neuron_count * max_entry_count);
 
 			additional_buffer_smart_ptr output_buffer = input_converted_buf;
 			std::vector<std::pair<additional_buffer_smart_ptr, additional_buffer_set> > input_buffer_and_additional_testing_buffers_pack;
@@ -139,18 +157,12 @@ namespace nnforge
 			unsigned int entries_read_count = 0;
 			while (entries_remained_for_loading && (entries_read_count < hessian_entry_to_process_count))
 			{
-				unsigned int entries_available_for_processing_count = 0;
-				while((entries_available_for_processing_count < max_entry_count) && (entries_read_count < hessian_entry_to_process_count))
-				{
-					bool entry_read = reader.read(
-						&(*(input_buf.begin() + (input_neuron_count * entries_available_for_processing_count * input_neuron_elem_size))));
-
-					if (!entry_read)
-						throw neural_network_exception((boost::format("Unable to read %1% entries to calculate hessian, %2% read") % hessian_entry_to_process_count % entries_read_count).str());
+				unsigned int entries_to_read_count = std::min(max_entry_count, hessian_entry_to_process_count - entries_read_count);
+				unsigned int entries_available_for_processing_count = reader.read_batch(entries_to_read_count, &(*input_buf.begin()));
+				entries_read_count += entries_available_for_processing_count;
 
-					entries_available_for_processing_count++;
-					entries_read_count++;
-				}
+				if (entries_available_for_processing_count < entries_to_read_count)
+					throw neural_network_exception((boost::format("Unable to read %1% entries to calculate hessian, %2% read") % hessian_entry_to_process_count % entries_read_count).str());
 
 				if (entries_available_for_processing_count == 0)
 					break;
@@ -159,8 +171,9 @@ namespace nnforge
 
 				// Convert input
 				{
+					profiling_scope scope(profiling, 0, profiling_result::phase_input_conversion);
 					const int elem_count = static_cast<int>(entries_available_for_processing_count * input_neuron_count);
-					const std::vector<float>::iterator input_converted_buf_it_start = input_converted_buf->begin();
+					const additional_buffer::iterator input_converted_buf_it_start = input_converted_buf->begin();
 					if (type_code == neuron_data_type::type_byte)
 					{
 						const unsigned char * const input_buf_it_start = &(*input_buf.begin());
@@ -179,16 +192,16 @@ namespace nnforge
 						throw neural_network_exception((boost::format("actual_get_hessian cannot handle input neurons of type %1%") % type_code).str());
 				}
 
-				// Run ann
+				// Run layers without weights, their output is the same for all the networks
+				const const_layer_list& layer_list = *schema;
 				{
-					const const_layer_list& layer_list = *schema;
 					const_layer_list::const_iterator layer_it = layer_list.begin();
 					layer_configuration_specific_list::const_iterator input_config_it = layer_config_list.begin();
 					std::vector<std::pair<additional_buffer_smart_ptr, additional_buffer_set> >::iterator buffers_it = input_buffer_and_additional_testing_buffers_pack.begin();
-					layer_data_list::const_iterator data_it = data->begin();
-					// Run testing
+					layer_data_list::const_iterator data_it = data_list.front()->begin();
 					for(std::vector<const_layer_tester_plain_smart_ptr>::const_iterator it = tester_list.begin(); it != tester_list.end(); ++it, ++layer_it, ++input_config_it, ++buffers_it, ++data_it)
 					{
+						profiling_scope scope(profiling, static_cast<unsigned int>(layer_it - layer_list.begin()), profiling_result::phase_forward, static_cast<float>(entries_available_for_processing_count) * (*layer_it)->get_forward_flops(*input_config_it));
 						(*it)->test(
 							buffers_it->first,
 							buffers_it->second,
@@ -199,79 +212,95 @@ namespace nnforge
 							*(input_config_it + 1),
 							entries_available_for_processing_count);
 					}
+				}
+
+				for(unsigned int network_id = 0; network_id < data_list.size(); ++network_id)
+				{
+					const network_data& data = *data_list[network_id];
+					network_data& hessian = *res[network_id];
+
 					// Forward hessian
-					std::vector<std::pair<additional_buffer_smart_ptr, hessian_additional_buffer_set> >::iterator hessian_buffers_it = input_buffer_and_additional_hessian_buffers_pack.begin();
-					for(std::vector<const_layer_hessian_plain_smart_ptr>::const_iterator it = hessian_list.begin(); it != hessian_list.end(); ++it, ++layer_it, ++input_config_it, ++hessian_buffers_it, ++data_it)
 					{
-						(*it)->test(
-							hessian_buffers_it->first,
-							hessian_buffers_it->second.output_neurons_buffer,
-							hessian_buffers_it->second.additional_buffers,
-							plain_config,
-							*layer_it,
-							*data_it,
-							*input_config_it,
-							*(input_config_it + 1),
-							entries_available_for_processing_count);
+						const_layer_list::const_iterator layer_it = layer_list.begin() + testing_layer_count;
+						layer_configuration_specific_list::const_iterator input_config_it = layer_config_list.begin() + testing_layer_count;
+						layer_data_list::const_iterator data_it = data.begin() + testing_layer_count;
+						std::vector<std::pair<additional_buffer_smart_ptr, hessian_additional_buffer_set> >::iterator hessian_buffers_it = input_buffer_and_additional_hessian_buffers_pack.begin();
+						for(std::vector<const_layer_hessian_plain_smart_ptr>::const_iterator it = hessian_list.begin(); it != hessian_list.end(); ++it, ++layer_it, ++input_config_it, ++hessian_buffers_it, ++data_it)
+						{
+							profiling_scope scope(profiling, static_cast<unsigned int>(layer_it - layer_list.begin()), profiling_result::phase_forward, static_cast<float>(entries_available_for_processing_count) * (*layer_it)->get_forward_flops(*input_config_it));
+							(*it)->test(
+								hessian_buffers_it->first,
+								hessian_buffers_it->second.output_neurons_buffer,
+								hessian_buffers_it->second.additional_buffers,
+								plain_config,
+								*layer_it,
+								*data_it,
+								*input_config_it,
+								*(input_config_it + 1),
+								entries_available_for_processing_count);
+						}
 					}
-				}
 
-				// Set initial errors to 1.0F
-				{
-					const int elem_count = static_cast<int>(entries_available_for_processing_count * output_neuron_count);
-					const std::vector<float>::iterator initial_error_buf_it = initial_error_buf->begin();
-					#pragma omp parallel for default(none) schedule(guided) num_threads(plain_config->openmp_thread_count)
-					for(int i = 0; i < elem_count; ++i)
+					// Set initial errors to 1.0F
 					{
-						*(initial_error_buf_it + i) = 1.0F;
+						const int elem_count = static_cast<int>(entries_available_for_processing_count * output_neuron_count);
+						const additional_buffer::iterator initial_error_buf_it = initial_error_buf->begin();
+						#pragma omp parallel for default(none) schedule(guided) num_threads(plain_config->openmp_thread_count)
+						for(int i = 0; i < elem_count; ++i)
+						{
+							*(initial_error_buf_it + i) = 1.0F;
+						}
 					}
-				}
 
-				// Backward hessian
-				{
-					const const_layer_list& layer_list = *schema;
-					const_layer_list::const_reverse_iterator layer_it = layer_list.rbegin();
-					std::vector<std::pair<additional_buffer_smart_ptr, hessian_additional_buffer_set> >::reverse_iterator hessian_buffers_it = input_buffer_and_additional_hessian_buffers_pack.rbegin();
-					layer_configuration_specific_list::const_reverse_iterator input_config_it = layer_config_list.rbegin();
-					layer_data_list::const_reverse_iterator data_it = data->rbegin();
-					layer_data_list::reverse_iterator hessian_data_it = hessian->rbegin();
-					additional_buffer_smart_ptr output_errors = initial_error_buf;
-					for(std::vector<const_layer_hessian_plain_smart_ptr>::const_reverse_iterator it = hessian_list.rbegin(); it != hessian_list.rend(); ++it, ++layer_it, ++input_config_it, ++hessian_buffers_it, ++data_it, ++hessian_data_it)
+					// Backward hessian
 					{
-						if (it != hessian_list.rend() - 1)
+						const_layer_list::const_reverse_iterator layer_it = layer_list.rbegin();
+						std::vector<std::pair<additional_buffer_smart_ptr, hessian_additional_buffer_set> >::reverse_iterator hessian_buffers_it = input_buffer_and_additional_hessian_buffers_pack.rbegin();
+						layer_configuration_specific_list::const_reverse_iterator input_config_it = layer_config_list.rbegin();
+						layer_data_list::const_reverse_iterator data_it = data.rbegin();
+						layer_data_list::reverse_iterator hessian_data_it = hessian.rbegin();
+						additional_buffer_smart_ptr output_errors = initial_error_buf;
+						unsigned int reverse_layer_id = static_cast<unsigned int>(layer_list.size()) - 1;
+						for(std::vector<const_layer_hessian_plain_smart_ptr>::const_reverse_iterator it = hessian_list.rbegin(); it != hessian_list.rend(); ++it, ++layer_it, ++input_config_it, ++hessian_buffers_it, ++data_it, ++hessian_data_it, --reverse_layer_id)
 						{
-							(*it)->backprop(
-								hessian_buffers_it->second.input_errors_buffer,
+							if (it != hessian_list.rend() - 1)
+							{
+								profiling_scope scope(profiling, reverse_layer_id, profiling_result::phase_backprop, static_cast<float>(entries_available_for_processing_count) * (*layer_it)->get_backward_flops_2nd(*(input_config_it + 1)));
+								(*it)->backprop(
+									hessian_buffers_it->second.input_errors_buffer,
+									output_errors,
+									hessian_buffers_it->second.output_neurons_buffer,
+									hessian_buffers_it->second.additional_buffers,
+									plain_config,
+									*layer_it,
+									*data_it,
+									*(input_config_it + 1),
+									*input_config_it,
+									entries_available_for_processing_count);
+							}
+
+							profiling_scope scope(profiling, reverse_layer_id, profiling_result::phase_update_weights, static_cast<float>(entries_available_for_processing_count) * (*layer_it)->get_weights_update_flops_2nd(*(input_config_it + 1)));
+							(*it)->update_hessian(
+								hessian_buffers_it->first,
 								output_errors,
-								hessian_buffers_it->second.output_neurons_buffer,
 								hessian_buffers_it->second.additional_buffers,
+								*hessian_data_it,
 								plain_config,
 								*layer_it,
-								*data_it,
 								*(input_config_it + 1),
 								*input_config_it,
 								entries_available_for_processing_count);
-						}
-
-						(*it)->update_hessian(
-							hessian_buffers_it->first,
-							output_errors,
-							hessian_buffers_it->second.additional_buffers,
-							*hessian_data_it,
-							plain_config,
-							*layer_it,
-							*(input_config_it + 1),
-							*input_config_it,
-							entries_available_for_processing_count);
 
-						output_errors = hessian_buffers_it->second.input_errors_buffer;
+							output_errors = hessian_buffers_it->second.input_errors_buffer;
+						}
 					}
 				}
 			}
 
 			const float mult = 1.0F / static_cast<float>(entries_read_count);
+			for(std::vector<network_data_smart_ptr>::iterator hessian_it = res.begin(); hessian_it != res.end(); ++hessian_it)
 			{
-				for(layer_data_list::iterator it = hessian->begin(); it != hessian->end(); ++it)
+				for(layer_data_list::iterator it = (*hessian_it)->begin(); it != (*hessian_it)->end(); ++it)
 				{
 					for(layer_data::iterator it2 = (*it)->begin(); it2 != (*it)->end(); ++it2)
 					{
@@ -286,7 +315,7 @@ namespace nnforge
 				}
 			}
 
-			return hessian;
+			return res;
 		}
 
 		void hessian_calculator_plain::layer_config_list_modified()
@@ -43,6 +43,13 @@ namespace nnforge
 				network_data_smart_ptr data,
 				unsigned int hessian_entry_to_process_count);
 
+			// schema, data and reader are guaranteed to be compatible
+			// The input is read and converted once, layers without weights are run once as well
+			virtual std::vector<network_data_smart_ptr> actual_get_hessian(
+				unsupervised_data_reader& reader,
+				const std::vector<network_data_smart_ptr>& data_list,
+				unsigned int hessian_entry_to_process_count);
+
 			// The method is called when client calls set_input_configuration_specific and the convolution specific configuration is modified.
 			// The layer_config_list is guaranteed to be compatible with schema
 			virtual void layer_config_list_modified();
@@ -48,8 +48,8 @@ namespace nnforge
 			unsigned int entry_count) const
 		{
 			const int elem_count = static_cast<int>(entry_count * input_configuration_specific.get_neuron_count());
-			const std::vector<float>::const_iterator in_it = input_buffer->begin();
-			const std::vector<float>::iterator out_it = output_buffer->begin();
+			const additional_buffer::const_iterator in_it = input_buffer->begin();
+			const additional_buffer::iterator out_it = output_buffer->begin();
 
 			nnforge_shared_ptr<const hyperbolic_tangent_layer> layer_derived = nnforge_dynamic_pointer_cast<const hyperbolic_tangent_layer>(layer_schema);
 			const float hyperbolic_tangent_steepness2 = layer_derived->steepness * 2.0F;
@@ -78,8 +78,8 @@ namespace nnforge
 			unsigned int entry_count) const
 		{
 			const int elem_count = static_cast<int>(entry_count * input_configuration_specific.get_neuron_count());
-			const std::vector<float>::iterator in_err_it = input_errors->begin();
-			const std::vector<float>::const_iterator out_it = output_neurons->begin();
+			const additional_buffer::iterator in_err_it = input_errors->begin();
+			const additional_buffer::const_iterator out_it = output_neurons->begin();
 
 			nnforge_shared_ptr<const hyperbolic_tangent_layer> layer_derived = nnforge_dynamic_pointer_cast<const hyperbolic_tangent_layer>(layer_schema);
 			const float hyperbolic_tangent_major_multiplier_reverse = 1.0F / layer_derived->major_multiplier;
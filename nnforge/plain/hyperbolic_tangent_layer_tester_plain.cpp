@@ -47,7 +47,7 @@ namespace nnforge
 			unsigned int entry_count) const
 		{
 			const int elem_count = static_cast<int>(entry_count * input_configuration_specific.get_neuron_count());
-			const std::vector<float>::iterator in_it = input_buffer->begin();
+			const additional_buffer::iterator in_it = input_buffer->begin();
 
 			nnforge_shared_ptr<const hyperbolic_tangent_layer> layer_derived = nnforge_dynamic_pointer_cast<const hyperbolic_tangent_layer>(layer_schema);
 			const float hyperbolic_tangent_steepness2 = layer_derived->steepness * 2.0F;
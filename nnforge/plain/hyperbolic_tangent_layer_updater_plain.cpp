@@ -24,6 +24,44 @@ namespace nnforge
 {
 	namespace plain
 	{
+		struct hyperbolic_tangent_layer_updater_plain::test_body
+		{
+			additional_buffer::const_iterator in_it;
+			additional_buffer::iterator out_it;
+			float hyperbolic_tangent_steepness2;
+			float hyperbolic_tangent_major_multiplier;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				for(int i = begin; i < end; ++i)
+				{
+					float inp = *(in_it + i);
+					float inp2 = expf(inp * hyperbolic_tangent_steepness2);
+					float res = (inp2 - 1.0F) / (inp2 + 1.0F) * hyperbolic_tangent_major_multiplier;
+					*(out_it + i) = res;
+				}
+			}
+		};
+
+		struct hyperbolic_tangent_layer_updater_plain::backprop_body
+		{
+			additional_buffer::iterator in_err_it;
+			additional_buffer::const_iterator out_it;
+			float hyperbolic_tangent_major_multiplier_reverse;
+			float hyperbolic_tangent_steepness3;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				for(int i = begin; i < end; ++i)
+				{
+					float out_neuron = *(out_it + i);
+					float normalized_value = out_neuron * hyperbolic_tangent_major_multiplier_reverse;
+					float der1st = hyperbolic_tangent_steepness3 * (1.0F - (normalized_value * normalized_value));
+					*(in_err_it + i) *= der1st;
+				}
+			}
+		};
+
 		hyperbolic_tangent_layer_updater_plain::hyperbolic_tangent_layer_updater_plain()
 		{
 		}
@@ -53,21 +91,15 @@ namespace nnforge
 				throw neural_network_exception("hyperbolic_tangent_layer_updater_plain is not able to run using the same input");
 
 			const int elem_count = static_cast<int>(updater_count * input_configuration_specific.get_neuron_count());
-			const std::vector<float>::const_iterator in_it = input_buffer->begin();
-			const std::vector<float>::iterator out_it = output_buffer->begin();
+			const additional_buffer::const_iterator in_it = input_buffer->begin();
+			const additional_buffer::iterator out_it = output_buffer->begin();
 
 			nnforge_shared_ptr<const hyperbolic_tangent_layer> layer_derived = nnforge_dynamic_pointer_cast<const hyperbolic_tangent_layer>(layer_schema);
 			const float hyperbolic_tangent_steepness2 = layer_derived->steepness * 2.0F;
 			const float hyperbolic_tangent_major_multiplier = layer_derived->major_multiplier;
 
-			#pragma omp parallel for default(none) schedule(guided) num_threads(plain_config->openmp_thread_count)
-			for(int i = 0; i < elem_count; ++i)
-			{
-				float inp = *(in_it + i);
-				float inp2 = expf(inp * hyperbolic_tangent_steepness2);
-				float res = (inp2 - 1.0F) / (inp2 + 1.0F) * hyperbolic_tangent_major_multiplier;
-				*(out_it + i) = res;
-			}
+			const test_body body = { in_it, out_it, hyperbolic_tangent_steepness2, hyperbolic_tangent_major_multiplier };
+			plain_config->parallel_for(elem_count, body);
 		}
 
 		void hyperbolic_tangent_layer_updater_plain::backprop(
@@ -81,23 +113,18 @@ namespace nnforge
 			const layer_data_list& data,
 			const layer_configuration_specific& input_configuration_specific,
 			const layer_configuration_specific& output_configuration_specific,
-			unsigned int updater_count) const
+			unsigned int updater_count,
+			unsigned int output_errors_zero_count) const
 		{
 			const int elem_count = static_cast<int>(updater_count * input_configuration_specific.get_neuron_count());
-			const std::vector<float>::iterator in_err_it = input_errors->begin();
-			const std::vector<float>::const_iterator out_it = output_neurons->begin();
+			const additional_buffer::iterator in_err_it = input_errors->begin();
+			const additional_buffer::const_iterator out_it = output_neurons->begin();
 
 			nnforge_shared_ptr<const hyperbolic_tangent_layer> layer_derived = nnforge_dynamic_pointer_cast<const hyperbolic_tangent_layer>(layer_schema);
 			const float hyperbolic_tangent_major_multiplier_reverse = 1.0F / layer_derived->major_multiplier;
 			const float hyperbolic_tangent_steepness3 = layer_derived->steepness * layer_derived->major_multiplier;
-			#pragma omp parallel for default(none) schedule(guided) num_threads(plain_config->openmp_thread_count)
-			for(int i = 0; i < elem_count; ++i)
-			{
-				float out_neuron = *(out_it + i);
-				float normalized_value = out_neuron * hyperbolic_tangent_major_multiplier_reverse;
-				float der1st = hyperbolic_tangent_steepness3 * (1.0F - (normalized_value * normalized_value));
-				*(in_err_it + i) *= der1st;
-			}
+			const backprop_body body = { in_err_it, out_it, hyperbolic_tangent_major_multiplier_reverse, hyperbolic_tangent_steepness3 };
+			plain_config->parallel_for(elem_count, body);
 		}
 
 		bool hyperbolic_tangent_layer_updater_plain::is_in_place_backprop() const
@@ -24,13 +24,14 @@
 
 #include "plain_running_configuration.h"
 #include "buffer_plain_size_configuration.h"
+#include "aligned_allocator.h"
 
 namespace nnforge
 {
 	namespace plain
 	{
-		typedef nnforge_shared_ptr<std::vector<float> > additional_buffer_smart_ptr;
-		typedef nnforge_shared_ptr<const std::vector<float> > const_additional_buffer_smart_ptr;
+		typedef nnforge_shared_ptr<additional_buffer> additional_buffer_smart_ptr;
+		typedef nnforge_shared_ptr<const additional_buffer> const_additional_buffer_smart_ptr;
 		struct hessian_additional_buffer_set
 		{
 			additional_buffer_smart_ptr output_neurons_buffer;
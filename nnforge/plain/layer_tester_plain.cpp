@@ -59,6 +59,19 @@ namespace nnforge
 			return std::vector<std::pair<unsigned int, bool> >();
 		}
 
+		std::vector<std::pair<unsigned int, bool> > layer_tester_plain::get_additional_buffer_elem_count_list(
+			const_layer_smart_ptr layer_schema,
+			const layer_configuration_specific& input_configuration_specific,
+			const layer_configuration_specific& output_configuration_specific,
+			plain_running_configuration_const_smart_ptr plain_config) const
+		{
+			return get_elem_count_and_per_entry_flag_additional_buffers(
+				layer_schema,
+				input_configuration_specific,
+				output_configuration_specific,
+				plain_config);
+		}
+
 		additional_buffer_set layer_tester_plain::allocate_additional_buffers(
 			unsigned int max_entry_count,
 			const_layer_smart_ptr layer_schema,
@@ -75,7 +88,7 @@ namespace nnforge
 				plain_config);
 
 			for(std::vector<std::pair<unsigned int, bool> >::const_iterator it = buffer_sizes_per_entry_aligned.begin(); it != buffer_sizes_per_entry_aligned.end(); ++it)
-				res.push_back(additional_buffer_smart_ptr(new std::vector<float>(it->first * (it->second ? max_entry_count : 1))));
+				res.push_back(plain_config->allocate_buffer(it->first * (it->second ? max_entry_count : 1)));
 
 			return res;
 		}
@@ -86,5 +99,22 @@ namespace nnforge
 		{
 			return input_buffer;
 		}
+
+		bool layer_tester_plain::is_reduced_precision_data_supported() const
+		{
+			return false;
+		}
+
+		bool layer_tester_plain::is_quantized_data_supported(
+			const_layer_smart_ptr layer_schema,
+			const layer_configuration_specific& input_configuration_specific) const
+		{
+			return false;
+		}
+
+		bool layer_tester_plain::is_mapped_data_supported() const
+		{
+			return false;
+		}
 	}
 }
@@ -24,12 +24,13 @@
 
 #include "plain_running_configuration.h"
 #include "buffer_plain_size_configuration.h"
+#include "aligned_allocator.h"
 
 namespace nnforge
 {
 	namespace plain
 	{
-		typedef nnforge_shared_ptr<std::vector<float> > additional_buffer_smart_ptr;
+		typedef nnforge_shared_ptr<additional_buffer> additional_buffer_smart_ptr;
 		typedef std::vector<additional_buffer_smart_ptr> additional_buffer_set;
 
 		class layer_tester_plain
@@ -46,6 +47,13 @@ namespace nnforge
 				const layer_configuration_specific& output_configuration_specific,
 				plain_running_configuration_const_smart_ptr plain_config) const;
 
+			// Returns element count and per-entry flag for each of the additional buffers allocate_additional_buffers creates
+			std::vector<std::pair<unsigned int, bool> > get_additional_buffer_elem_count_list(
+				const_layer_smart_ptr layer_schema,
+				const layer_configuration_specific& input_configuration_specific,
+				const layer_configuration_specific& output_configuration_specific,
+				plain_running_configuration_const_smart_ptr plain_config) const;
+
 			additional_buffer_set allocate_additional_buffers(
 				unsigned int max_entry_count,
 				const_layer_smart_ptr layer_schema,
@@ -67,6 +75,17 @@ namespace nnforge
 				const layer_configuration_specific& output_configuration_specific,
 				unsigned int entry_count) const = 0;
 
+			// The tester accepts reduced_precision_layer_data and widens weights on the fly
+			virtual bool is_reduced_precision_data_supported() const;
+
+			// The tester accepts quantized_layer_data for the layer and runs with int8 inputs and weights
+			virtual bool is_quantized_data_supported(
+				const_layer_smart_ptr layer_schema,
+				const layer_configuration_specific& input_configuration_specific) const;
+
+			// The tester accepts mapped_layer_data and reads weights from the mapped file in place
+			virtual bool is_mapped_data_supported() const;
+
 		protected:
 			layer_tester_plain();
 
@@ -115,12 +115,12 @@ namespace nnforge
 				backprop_required);
 
 			for(std::vector<std::pair<unsigned int, bool> >::const_iterator it = buffer_sizes_per_entry_aligned.begin(); it != buffer_sizes_per_entry_aligned.end(); ++it)
-				res.additional_buffers.push_back(additional_buffer_smart_ptr(new std::vector<float>(it->first * (it->second ? updater_entry_count : 1))));
+				res.additional_buffers.push_back(plain_config->allocate_buffer(it->first * (it->second ? updater_entry_count : 1)));
 
-			res.output_neurons_buffer = additional_buffer_smart_ptr(new std::vector<float>(output_configuration_specific.get_neuron_count() * updater_entry_count));
+			res.output_neurons_buffer = plain_config->allocate_buffer(output_configuration_specific.get_neuron_count() * updater_entry_count);
 
 			if (backprop_required && !is_in_place_backprop())
-				res.input_errors_buffer = additional_buffer_smart_ptr(new std::vector<float>(input_configuration_specific.get_neuron_count() * updater_entry_count));
+				res.input_errors_buffer = plain_config->allocate_buffer(input_configuration_specific.get_neuron_count() * updater_entry_count);
 
 			return res;
 		}
@@ -136,9 +136,16 @@ namespace nnforge
 			const layer_configuration_specific& input_configuration_specific,
 			const layer_configuration_specific& output_configuration_specific,
 			unsigned int updater_count,
+			unsigned int mini_batch_size,
 			int offset_input_entry_id,
-			const float weight_decay) const
+			const float weight_decay,
+			unsigned int output_errors_zero_count) const
 		{
 		}
+
+		bool layer_updater_plain::is_output_errors_zero_count_used() const
+		{
+			return false;
+		}
 	}
 }
@@ -24,13 +24,14 @@
 
 #include "plain_running_configuration.h"
 #include "buffer_plain_size_configuration.h"
+#include "aligned_allocator.h"
 
 namespace nnforge
 {
 	namespace plain
 	{
-		typedef nnforge_shared_ptr<std::vector<float> > additional_buffer_smart_ptr;
-		typedef nnforge_shared_ptr<const std::vector<float> > const_additional_buffer_smart_ptr;
+		typedef nnforge_shared_ptr<additional_buffer> additional_buffer_smart_ptr;
+		typedef nnforge_shared_ptr<const additional_buffer> const_additional_buffer_smart_ptr;
 		struct updater_additional_buffer_set
 		{
 			additional_buffer_smart_ptr output_neurons_buffer;
@@ -82,6 +83,8 @@ namespace nnforge
 				unsigned int updater_count,
 				int offset_input_entry_id) const = 0;
 
+			// output_errors_zero_count is the number of zeros in output_errors, counted by the network updater once per layer and mini-batch.
+			// It is valid only for the layers returning true from is_output_errors_zero_count_used, 0 is passed to the others
 			virtual void backprop(
 				additional_buffer_smart_ptr input_errors,
 				const_additional_buffer_smart_ptr input_neurons,
@@ -93,8 +96,12 @@ namespace nnforge
 				const layer_data_list& data,
 				const layer_configuration_specific& input_configuration_specific,
 				const layer_configuration_specific& output_configuration_specific,
-				unsigned int updater_count) const = 0;
+				unsigned int updater_count,
+				unsigned int output_errors_zero_count) const = 0;
 
+			// input_neurons and output_errors contain mini_batch_size entries for each of updater_count networks,
+			// data and learning_rate contain single item per network. Weights are updated once per mini-batch
+			// output_errors_zero_count is the same as for backprop
 			virtual void update_weights(
 				const_additional_buffer_smart_ptr input_neurons,
 				const_additional_buffer_smart_ptr output_errors,
@@ -106,8 +113,13 @@ namespace nnforge
 				const layer_configuration_specific& input_configuration_specific,
 				const layer_configuration_specific& output_configuration_specific,
 				unsigned int updater_count,
+				unsigned int mini_batch_size,
 				int offset_input_entry_id,
-				const float weight_decay) const;
+				const float weight_decay,
+				unsigned int output_errors_zero_count) const;
+
+			// The layer skips zero output errors and needs their count for backprop and update_weights
+			virtual bool is_output_errors_zero_count_used() const;
 
 		protected:
 			layer_updater_plain();
@@ -70,8 +70,8 @@ namespace nnforge
 			const unsigned int feature_maps_unaffected_count = static_cast<unsigned int>(feature_maps_affected.size());
 			const std::vector<unsigned int>::const_iterator input_slices_it = input_slices.begin();
 			const std::vector<unsigned int>::const_iterator feature_maps_affected_it = feature_maps_affected.begin();
-			const std::vector<float>::const_iterator input_buffer_it = input_buffer->begin();
-			const std::vector<float>::iterator output_buffer_it = output_buffer->begin();
+			const additional_buffer::const_iterator input_buffer_it = input_buffer->begin();
+			const additional_buffer::iterator output_buffer_it = output_buffer->begin();
 			const std::vector<std::vector<float> >::const_iterator window_weights_list_it = window_weights_list.begin();
 
 			const int total_workload = entry_count * feature_maps_affected_count;
@@ -99,8 +99,8 @@ namespace nnforge
 					unsigned int feature_map_id = *(feature_maps_affected_it + affected_feature_map_id);
 					for(unsigned int dimension_id = 0; dimension_id < dimension_count; ++dimension_id)
 					{
-						std::vector<float>::iterator out_it_base = local_additional_buffers[current_output_buffer_index]->begin();
-						std::vector<float>::const_iterator in_it;
+						additional_buffer::iterator out_it_base = local_additional_buffers[current_output_buffer_index]->begin();
+						additional_buffer::const_iterator in_it;
 						if (dimension_id > 0)
 							in_it = local_additional_buffers[1 - current_output_buffer_index]->begin();
 						else
@@ -109,7 +109,7 @@ namespace nnforge
 						int input_slice_size = *(input_slices_it + dimension_id);
 
 						std::vector<unsigned int> current_output_position(dimension_count, 0);
-						for(std::vector<float>::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it, ++in_it)
+						for(additional_buffer::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it, ++in_it)
 						{
 							const std::vector<float>& current_window_weights_list = *(window_weights_list_it + dimension_id);
 							float sum = *in_it * current_window_weights_list[0];
@@ -144,9 +144,9 @@ namespace nnforge
 
 					// Subtract the gaussian blur
 					{
-						std::vector<float>::const_iterator original_in_it = input_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
-						std::vector<float>::iterator out_it = output_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
-						std::vector<float>::const_iterator in_it = local_additional_buffers[1 - current_output_buffer_index]->begin();
+						additional_buffer::const_iterator original_in_it = input_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
+						additional_buffer::iterator out_it = output_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
+						additional_buffer::const_iterator in_it = local_additional_buffers[1 - current_output_buffer_index]->begin();
 						for(int i = 0; i < static_cast<int>(input_neuron_count_per_feature_map); ++i)
 							*(out_it + i) = *(original_in_it + i) - *(in_it + i);
 					}
@@ -160,8 +160,8 @@ namespace nnforge
 					for(std::vector<unsigned int>::const_iterator it = feature_maps_unaffected.begin(); it != feature_maps_unaffected.end(); ++it)
 					{
 						unsigned int feature_map_id = *it;
-						std::vector<float>::const_iterator original_in_it = input_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
-						std::vector<float>::iterator out_it = output_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
+						additional_buffer::const_iterator original_in_it = input_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
+						additional_buffer::iterator out_it = output_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
 						std::copy(original_in_it, original_in_it + input_neuron_count_per_feature_map, out_it);
 					}
 				}
@@ -197,7 +197,7 @@ namespace nnforge
 			const unsigned int feature_maps_affected_count = static_cast<unsigned int>(feature_maps_affected.size());
 			const std::vector<unsigned int>::const_iterator input_slices_it = input_slices.begin();
 			const std::vector<unsigned int>::const_iterator feature_maps_affected_it = feature_maps_affected.begin();
-			const std::vector<float>::iterator input_buffer_it = input_errors->begin();
+			const additional_buffer::iterator input_buffer_it = input_errors->begin();
 			const std::vector<std::vector<float> >::const_iterator window_weights_list_it = window_weights_list.begin();
 
 			float central_weight = 1.0F;
@@ -230,8 +230,8 @@ namespace nnforge
 					unsigned int feature_map_id = *(feature_maps_affected_it + affected_feature_map_id);
 					for(unsigned int dimension_id = 0; dimension_id < dimension_count; ++dimension_id)
 					{
-						std::vector<float>::iterator out_it_base = local_additional_buffers[current_output_buffer_index]->begin();
-						std::vector<float>::const_iterator in_it;
+						additional_buffer::iterator out_it_base = local_additional_buffers[current_output_buffer_index]->begin();
+						additional_buffer::const_iterator in_it;
 						if (dimension_id > 0)
 							in_it = local_additional_buffers[1 - current_output_buffer_index]->begin();
 						else
@@ -240,7 +240,7 @@ namespace nnforge
 						int input_slice_size = *(input_slices_it + dimension_id);
 
 						std::vector<unsigned int> current_output_position(dimension_count, 0);
-						for(std::vector<float>::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it, ++in_it)
+						for(additional_buffer::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it, ++in_it)
 						{
 							const std::vector<float>& current_window_weights_list = *(window_weights_list_it + dimension_id);
 							float weight = current_window_weights_list[0];
@@ -276,8 +276,8 @@ namespace nnforge
 					} // for(unsigned int dimension_id
 
 					{
-						std::vector<float>::iterator out_it = input_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
-						std::vector<float>::const_iterator in_it = local_additional_buffers[1 - current_output_buffer_index]->begin();
+						additional_buffer::iterator out_it = input_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
+						additional_buffer::const_iterator in_it = local_additional_buffers[1 - current_output_buffer_index]->begin();
 						for(int i = 0; i < static_cast<int>(input_neuron_count_per_feature_map); ++i)
 							*(out_it + i) = (*(out_it + i) * const_central_mult) + *(in_it + i);
 					}
@@ -28,74 +28,31 @@ namespace nnforge
 {
 	namespace plain
 	{
-		local_contrast_subtractive_layer_updater_plain::local_contrast_subtractive_layer_updater_plain()
+		struct local_contrast_subtractive_layer_updater_plain::test_body
 		{
-		}
-
-		local_contrast_subtractive_layer_updater_plain::~local_contrast_subtractive_layer_updater_plain()
-		{
-		}
-
-		const boost::uuids::uuid& local_contrast_subtractive_layer_updater_plain::get_uuid() const
-		{
-			return local_contrast_subtractive_layer::layer_guid;
-		}
-
-		void local_contrast_subtractive_layer_updater_plain::test(
-			const_additional_buffer_smart_ptr input_buffer,
-			additional_buffer_smart_ptr output_buffer,
-			std::vector<additional_buffer_smart_ptr>& additional_buffers,
-			plain_running_configuration_const_smart_ptr plain_config,
-			const_layer_smart_ptr layer_schema,
-			const layer_data_list& data,
-			const layer_configuration_specific& input_configuration_specific,
-			const layer_configuration_specific& output_configuration_specific,
-			unsigned int updater_count,
-			int offset_input_entry_id) const
-		{
-			if (offset_input_entry_id >= 0)
-				throw neural_network_exception("local_contrast_subtractive_layer_updater_plain is not able to run using the same input");
-
-			const unsigned int input_neuron_count = input_configuration_specific.get_neuron_count();
-			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
-			const unsigned int output_neuron_count = output_configuration_specific.get_neuron_count();
-			const unsigned int output_neuron_count_per_feature_map = output_configuration_specific.get_neuron_count_per_feature_map();
-			nnforge_shared_ptr<const local_contrast_subtractive_layer> layer_derived = nnforge_dynamic_pointer_cast<const local_contrast_subtractive_layer>(layer_schema);
-			const std::vector<std::vector<float> >& window_weights_list = layer_derived->window_weights_list;
-			const std::vector<unsigned int>& feature_maps_affected = layer_derived->feature_maps_affected;
-			const std::vector<unsigned int>& feature_maps_unaffected = layer_derived->feature_maps_unaffected;
-			const unsigned int dimension_count = static_cast<unsigned int>(window_weights_list.size());
-			std::vector<unsigned int> input_slices(input_configuration_specific.dimension_sizes.size());
-			input_slices[0] = 1;
-			for(unsigned int i = 0; i < dimension_count - 1; ++i)
-				input_slices[i + 1] = input_slices[i] * input_configuration_specific.dimension_sizes[i];
-
-			const std::vector<unsigned int>::const_iterator dimension_sizes_it = output_configuration_specific.dimension_sizes.begin();
-			const unsigned int feature_maps_affected_count = static_cast<unsigned int>(feature_maps_affected.size());
-			const unsigned int feature_maps_unaffected_count = static_cast<unsigned int>(feature_maps_affected.size());
-			const std::vector<unsigned int>::const_iterator input_slices_it = input_slices.begin();
-			const std::vector<unsigned int>::const_iterator feature_maps_affected_it = feature_maps_affected.begin();
-			const std::vector<float>::const_iterator input_buffer_it = input_buffer->begin();
-			const std::vector<float>::iterator output_buffer_it = output_buffer->begin();
-			const std::vector<std::vector<float> >::const_iterator window_weights_list_it = window_weights_list.begin();
-
-			const int total_workload = updater_count * feature_maps_affected_count;
-			const int openmp_thread_count = plain_config->openmp_thread_count;
-			
-			#pragma omp parallel default(none) shared(additional_buffers) num_threads(openmp_thread_count)
+			unsigned int input_neuron_count;
+			unsigned int input_neuron_count_per_feature_map;
+			unsigned int output_neuron_count_per_feature_map;
+			unsigned int dimension_count;
+			std::vector<unsigned int>::const_iterator dimension_sizes_it;
+			unsigned int feature_maps_affected_count;
+			std::vector<unsigned int>::const_iterator input_slices_it;
+			std::vector<unsigned int>::const_iterator feature_maps_affected_it;
+			additional_buffer::const_iterator input_buffer_it;
+			additional_buffer::iterator output_buffer_it;
+			std::vector<std::vector<float> >::const_iterator window_weights_list_it;
+			int openmp_thread_count;
+			std::vector<additional_buffer_smart_ptr>::const_iterator additional_buffers_it;
+
+			void operator()(int begin, int end, int thread_id) const
 			{
 				std::vector<additional_buffer_smart_ptr> local_additional_buffers;
-				int thread_id = 0;
-				#ifdef _OPENMP
-				thread_id = omp_get_thread_num();
-				#endif
 
-				local_additional_buffers.push_back(additional_buffers[thread_id]);
+				local_additional_buffers.push_back(*(additional_buffers_it + thread_id));
 				if (dimension_count > 1)
-					local_additional_buffers.push_back(additional_buffers[openmp_thread_count + thread_id]);
+					local_additional_buffers.push_back(*(additional_buffers_it + (openmp_thread_count + thread_id)));
 
-				#pragma omp for schedule(guided)
-				for(int workload_id = 0; workload_id < total_workload; ++workload_id)
+				for(int workload_id = begin; workload_id < end; ++workload_id)
 				{
 					int entry_id = workload_id / feature_maps_affected_count;
 					int affected_feature_map_id = workload_id - (entry_id * feature_maps_affected_count);
@@ -104,8 +61,8 @@ namespace nnforge
 					unsigned int feature_map_id = *(feature_maps_affected_it + affected_feature_map_id);
 					for(unsigned int dimension_id = 0; dimension_id < dimension_count; ++dimension_id)
 					{
-						std::vector<float>::iterator out_it_base = local_additional_buffers[current_output_buffer_index]->begin();
-						std::vector<float>::const_iterator in_it;
+						additional_buffer::iterator out_it_base = local_additional_buffers[current_output_buffer_index]->begin();
+						additional_buffer::const_iterator in_it;
 						if (dimension_id > 0)
 							in_it = local_additional_buffers[1 - current_output_buffer_index]->begin();
 						else
@@ -114,7 +71,7 @@ namespace nnforge
 						int input_slice_size = *(input_slices_it + dimension_id);
 
 						std::vector<unsigned int> current_output_position(dimension_count, 0);
-						for(std::vector<float>::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it, ++in_it)
+						for(additional_buffer::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it, ++in_it)
 						{
 							const std::vector<float>& current_window_weights_list = *(window_weights_list_it + dimension_id);
 							float sum = *in_it * current_window_weights_list[0];
@@ -149,80 +106,40 @@ namespace nnforge
 
 					// Subtract the gaussian blur
 					{
-						std::vector<float>::const_iterator original_in_it = input_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
-						std::vector<float>::iterator out_it = output_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
-						std::vector<float>::const_iterator in_it = local_additional_buffers[1 - current_output_buffer_index]->begin();
+						additional_buffer::const_iterator original_in_it = input_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
+						additional_buffer::iterator out_it = output_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
+						additional_buffer::const_iterator in_it = local_additional_buffers[1 - current_output_buffer_index]->begin();
 						for(int i = 0; i < static_cast<int>(input_neuron_count_per_feature_map); ++i)
 							*(out_it + i) = *(original_in_it + i) - *(in_it + i);
 					}
 				}
-			} // #pragma parallel
-
-			if (feature_maps_unaffected_count > 0)
-			{
-				for(unsigned int entry_id = 0; entry_id < updater_count; ++entry_id)
-				{
-					for(std::vector<unsigned int>::const_iterator it = feature_maps_unaffected.begin(); it != feature_maps_unaffected.end(); ++it)
-					{
-						unsigned int feature_map_id = *it;
-						std::vector<float>::const_iterator original_in_it = input_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
-						std::vector<float>::iterator out_it = output_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
-						std::copy(original_in_it, original_in_it + input_neuron_count_per_feature_map, out_it);
-					}
-				}
 			}
-		}
+		};
 
-		void local_contrast_subtractive_layer_updater_plain::backprop(
-			additional_buffer_smart_ptr input_errors,
-			const_additional_buffer_smart_ptr input_neurons,
-			const_additional_buffer_smart_ptr output_errors,
-			const_additional_buffer_smart_ptr output_neurons,
-			std::vector<additional_buffer_smart_ptr>& additional_buffers,
-			plain_running_configuration_const_smart_ptr plain_config,
-			const_layer_smart_ptr layer_schema,
-			const layer_data_list& data,
-			const layer_configuration_specific& input_configuration_specific,
-			const layer_configuration_specific& output_configuration_specific,
-			unsigned int updater_count) const
+		struct local_contrast_subtractive_layer_updater_plain::backprop_body
 		{
-			const unsigned int input_neuron_count = input_configuration_specific.get_neuron_count();
-			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
-			const unsigned int output_neuron_count = output_configuration_specific.get_neuron_count();
-			const unsigned int output_neuron_count_per_feature_map = output_configuration_specific.get_neuron_count_per_feature_map();
-			nnforge_shared_ptr<const local_contrast_subtractive_layer> layer_derived = nnforge_dynamic_pointer_cast<const local_contrast_subtractive_layer>(layer_schema);
-			const std::vector<std::vector<float> >& window_weights_list = layer_derived->window_weights_list;
-			const std::vector<unsigned int>& feature_maps_affected = layer_derived->feature_maps_affected;
-			const unsigned int dimension_count = static_cast<unsigned int>(window_weights_list.size());
-			std::vector<unsigned int> input_slices(input_configuration_specific.dimension_sizes.size());
-			input_slices[0] = 1;
-			for(unsigned int i = 0; i < dimension_count - 1; ++i)
-				input_slices[i + 1] = input_slices[i] * input_configuration_specific.dimension_sizes[i];
-
-			const std::vector<unsigned int>::const_iterator dimension_sizes_it = output_configuration_specific.dimension_sizes.begin();
-			const unsigned int feature_maps_affected_count = static_cast<unsigned int>(feature_maps_affected.size());
-			const std::vector<unsigned int>::const_iterator input_slices_it = input_slices.begin();
-			const std::vector<unsigned int>::const_iterator feature_maps_affected_it = feature_maps_affected.begin();
-			const std::vector<float>::iterator input_buffer_it = input_errors->begin();
-			const std::vector<std::vector<float> >::const_iterator window_weights_list_it = window_weights_list.begin();
-
-			const int total_workload = updater_count * feature_maps_affected_count;
-			const int openmp_thread_count = plain_config->openmp_thread_count;
-			
-			#pragma omp parallel default(none) shared(additional_buffers) num_threads(openmp_thread_count)
+			unsigned int input_neuron_count;
+			unsigned int input_neuron_count_per_feature_map;
+			unsigned int output_neuron_count_per_feature_map;
+			unsigned int dimension_count;
+			std::vector<unsigned int>::const_iterator dimension_sizes_it;
+			unsigned int feature_maps_affected_count;
+			std::vector<unsigned int>::const_iterator input_slices_it;
+			std::vector<unsigned int>::const_iterator feature_maps_affected_it;
+			additional_buffer::iterator input_buffer_it;
+			std::vector<std::vector<float> >::const_iterator window_weights_list_it;
+			int openmp_thread_count;
+			std::vector<additional_buffer_smart_ptr>::const_iterator additional_buffers_it;
+
+			void operator()(int begin, int end, int thread_id) const
 			{
 				std::vector<additional_buffer_smart_ptr> local_additional_buffers;
-				int thread_id = 0;
-				#ifdef _OPENMP
-				thread_id = omp_get_thread_num();
-				#endif
 
-				local_additional_buffers.push_back(additional_buffers[thread_id]);
+				local_additional_buffers.push_back(*(additional_buffers_it + thread_id));
 				if (dimension_count > 1)
-					local_additional_buffers.push_back(additional_buffers[openmp_thread_count + thread_id]);
+					local_additional_buffers.push_back(*(additional_buffers_it + (openmp_thread_count + thread_id)));
 
-				#pragma omp for schedule(guided)
-				for(int workload_id = 0; workload_id < total_workload; ++workload_id)
+				for(int workload_id = begin; workload_id < end; ++workload_id)
 				{
 					int entry_id = workload_id / feature_maps_affected_count;
 					int affected_feature_map_id = workload_id - (entry_id * feature_maps_affected_count);
@@ -231,8 +148,8 @@ namespace nnforge
 					unsigned int feature_map_id = *(feature_maps_affected_it + affected_feature_map_id);
 					for(unsigned int dimension_id = 0; dimension_id < dimension_count; ++dimension_id)
 					{
-						std::vector<float>::iterator out_it_base = local_additional_buffers[current_output_buffer_index]->begin();
-						std::vector<float>::const_iterator in_it;
+						additional_buffer::iterator out_it_base = local_additional_buffers[current_output_buffer_index]->begin();
+						additional_buffer::const_iterator in_it;
 						if (dimension_id > 0)
 							in_it = local_additional_buffers[1 - current_output_buffer_index]->begin();
 						else
@@ -241,7 +158,7 @@ namespace nnforge
 						int input_slice_size = *(input_slices_it + dimension_id);
 
 						std::vector<unsigned int> current_output_position(dimension_count, 0);
-						for(std::vector<float>::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it, ++in_it)
+						for(additional_buffer::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it, ++in_it)
 						{
 							const std::vector<float>& current_window_weights_list = *(window_weights_list_it + dimension_id);
 							float sum = *in_it * current_window_weights_list[0];
@@ -275,13 +192,126 @@ namespace nnforge
 					} // for(unsigned int dimension_id
 
 					{
-						std::vector<float>::iterator out_it = input_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
-						std::vector<float>::const_iterator in_it = local_additional_buffers[1 - current_output_buffer_index]->begin();
+						additional_buffer::iterator out_it = input_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
+						additional_buffer::const_iterator in_it = local_additional_buffers[1 - current_output_buffer_index]->begin();
 						for(int i = 0; i < static_cast<int>(input_neuron_count_per_feature_map); ++i)
 							*(out_it + i) -= *(in_it + i);
 					}
 				}
-			} // #pragma parallel
+			}
+		};
+
+		local_contrast_subtractive_layer_updater_plain::local_contrast_subtractive_layer_updater_plain()
+		{
+		}
+
+		local_contrast_subtractive_layer_updater_plain::~local_contrast_subtractive_layer_updater_plain()
+		{
+		}
+
+		const boost::uuids::uuid& local_contrast_subtractive_layer_updater_plain::get_uuid() const
+		{
+			return local_contrast_subtractive_layer::layer_guid;
+		}
+
+		void local_contrast_subtractive_layer_updater_plain::test(
+			const_additional_buffer_smart_ptr input_buffer,
+			additional_buffer_smart_ptr output_buffer,
+			std::vector<additional_buffer_smart_ptr>& additional_buffers,
+			plain_running_configuration_const_smart_ptr plain_config,
+			const_layer_smart_ptr layer_schema,
+			const layer_data_list& data,
+			const layer_configuration_specific& input_configuration_specific,
+			const layer_configuration_specific& output_configuration_specific,
+			unsigned int updater_count,
+			int offset_input_entry_id) const
+		{
+			if (offset_input_entry_id >= 0)
+				throw neural_network_exception("local_contrast_subtractive_layer_updater_plain is not able to run using the same input");
+
+			const unsigned int input_neuron_count = input_configuration_specific.get_neuron_count();
+			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
+			const unsigned int output_neuron_count = output_configuration_specific.get_neuron_count();
+			const unsigned int output_neuron_count_per_feature_map = output_configuration_specific.get_neuron_count_per_feature_map();
+			nnforge_shared_ptr<const local_contrast_subtractive_layer> layer_derived = nnforge_dynamic_pointer_cast<const local_contrast_subtractive_layer>(layer_schema);
+			const std::vector<std::vector<float> >& window_weights_list = layer_derived->window_weights_list;
+			const std::vector<unsigned int>& feature_maps_affected = layer_derived->feature_maps_affected;
+			const std::vector<unsigned int>& feature_maps_unaffected = layer_derived->feature_maps_unaffected;
+			const unsigned int dimension_count = static_cast<unsigned int>(window_weights_list.size());
+			std::vector<unsigned int> input_slices(input_configuration_specific.dimension_sizes.size());
+			input_slices[0] = 1;
+			for(unsigned int i = 0; i < dimension_count - 1; ++i)
+				input_slices[i + 1] = input_slices[i] * input_configuration_specific.dimension_sizes[i];
+
+			const std::vector<unsigned int>::const_iterator dimension_sizes_it = output_configuration_specific.dimension_sizes.begin();
+			const unsigned int feature_maps_affected_count = static_cast<unsigned int>(feature_maps_affected.size());
+			const unsigned int feature_maps_unaffected_count = static_cast<unsigned int>(feature_maps_affected.size());
+			const std::vector<unsigned int>::const_iterator input_slices_it = input_slices.begin();
+			const std::vector<unsigned int>::const_iterator feature_maps_affected_it = feature_maps_affected.begin();
+			const additional_buffer::const_iterator input_buffer_it = input_buffer->begin();
+			const additional_buffer::iterator output_buffer_it = output_buffer->begin();
+			const std::vector<std::vector<float> >::const_iterator window_weights_list_it = window_weights_list.begin();
+
+			const int total_workload = updater_count * feature_maps_affected_count;
+			const int openmp_thread_count = plain_config->openmp_thread_count;
+			
+			const test_body body = { input_neuron_count, input_neuron_count_per_feature_map, output_neuron_count_per_feature_map, dimension_count, dimension_sizes_it, feature_maps_affected_count, input_slices_it, feature_maps_affected_it, input_buffer_it, output_buffer_it, window_weights_list_it, openmp_thread_count, additional_buffers.begin() };
+			plain_config->parallel_for(total_workload, body);
+
+			if (feature_maps_unaffected_count > 0)
+			{
+				for(unsigned int entry_id = 0; entry_id < updater_count; ++entry_id)
+				{
+					for(std::vector<unsigned int>::const_iterator it = feature_maps_unaffected.begin(); it != feature_maps_unaffected.end(); ++it)
+					{
+						unsigned int feature_map_id = *it;
+						additional_buffer::const_iterator original_in_it = input_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
+						additional_buffer::iterator out_it = output_buffer_it + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
+						std::copy(original_in_it, original_in_it + input_neuron_count_per_feature_map, out_it);
+					}
+				}
+			}
+		}
+
+		void local_contrast_subtractive_layer_updater_plain::backprop(
+			additional_buffer_smart_ptr input_errors,
+			const_additional_buffer_smart_ptr input_neurons,
+			const_additional_buffer_smart_ptr output_errors,
+			const_additional_buffer_smart_ptr output_neurons,
+			std::vector<additional_buffer_smart_ptr>& additional_buffers,
+			plain_running_configuration_const_smart_ptr plain_config,
+			const_layer_smart_ptr layer_schema,
+			const layer_data_list& data,
+			const layer_configuration_specific& input_configuration_specific,
+			const layer_configuration_specific& output_configuration_specific,
+			unsigned int updater_count,
+			unsigned int output_errors_zero_count) const
+		{
+			const unsigned int input_neuron_count = input_configuration_specific.get_neuron_count();
+			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
+			const unsigned int output_neuron_count = output_configuration_specific.get_neuron_count();
+			const unsigned int output_neuron_count_per_feature_map = output_configuration_specific.get_neuron_count_per_feature_map();
+			nnforge_shared_ptr<const local_contrast_subtractive_layer> layer_derived = nnforge_dynamic_pointer_cast<const local_contrast_subtractive_layer>(layer_schema);
+			const std::vector<std::vector<float> >& window_weights_list = layer_derived->window_weights_list;
+			const std::vector<unsigned int>& feature_maps_affected = layer_derived->feature_maps_affected;
+			const unsigned int dimension_count = static_cast<unsigned int>(window_weights_list.size());
+			std::vector<unsigned int> input_slices(input_configuration_specific.dimension_sizes.size());
+			input_slices[0] = 1;
+			for(unsigned int i = 0; i < dimension_count - 1; ++i)
+				input_slices[i + 1] = input_slices[i] * input_configuration_specific.dimension_sizes[i];
+
+			const std::vector<unsigned int>::const_iterator dimension_sizes_it = output_configuration_specific.dimension_sizes.begin();
+			const unsigned int feature_maps_affected_count = static_cast<unsigned int>(feature_maps_affected.size());
+			const std::vector<unsigned int>::const_iterator input_slices_it = input_slices.begin();
+			const std::vector<unsigned int>::const_iterator feature_maps_affected_it = feature_maps_affected.begin();
+			const additional_buffer::iterator input_buffer_it = input_errors->begin();
+			const std::vector<std::vector<float> >::const_iterator window_weights_list_it = window_weights_list.begin();
+
+			const int total_workload = updater_count * feature_maps_affected_count;
+			const int openmp_thread_count = plain_config->openmp_thread_count;
+			
+			const backprop_body body = { input_neuron_count, input_neuron_count_per_feature_map, output_neuron_count_per_feature_map, dimension_count, dimension_sizes_it, feature_maps_affected_count, input_slices_it, feature_maps_affected_it, input_buffer_it, window_weights_list_it, openmp_thread_count, additional_buffers.begin() };
+			plain_config->parallel_for(total_workload, body);
 		}
 
 		std::vector<std::pair<unsigned int, bool> > local_contrast_subtractive_layer_updater_plain::get_elem_count_and_per_entry_flag_additional_buffers(
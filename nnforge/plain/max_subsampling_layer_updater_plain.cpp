@@ -28,6 +28,131 @@ namespace nnforge
 	{
 		const int max_subsampling_layer_updater_plain::max_dimension_count = 4;
 
+		struct max_subsampling_layer_updater_plain::test_body
+		{
+			additional_buffer::const_iterator in_it_global;
+			additional_buffer::iterator out_it_global;
+			additional_buffer::iterator max_indexes_it_global;
+			unsigned int input_neuron_count;
+			unsigned int input_neuron_count_per_feature_map;
+			unsigned int output_neuron_count;
+			unsigned int output_neuron_count_per_feature_map;
+			unsigned int dimension_count;
+			unsigned int const_subsampling_elem_count;
+			unsigned int feature_map_count;
+			std::vector<unsigned int>::const_iterator dimension_sizes_it;
+			std::vector<unsigned int>::const_iterator subsampling_sizes_it;
+			std::vector<unsigned int>::const_iterator input_slices_it;
+			std::vector<unsigned int>::const_iterator offset_list_it;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				nnforge_array<unsigned int, max_dimension_count> current_output_position;
+
+				for(int workload_id = begin; workload_id < end; ++workload_id)
+				{
+					int entry_id = workload_id / feature_map_count;
+					int feature_map_id = workload_id - (entry_id * feature_map_count);
+
+					additional_buffer::const_iterator in_it_base = in_it_global + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
+					additional_buffer::iterator out_it_base = out_it_global + (entry_id * output_neuron_count) + (feature_map_id * output_neuron_count_per_feature_map);
+					additional_buffer::iterator max_indexes_it_base = max_indexes_it_global + (entry_id * output_neuron_count) + (feature_map_id * output_neuron_count_per_feature_map);
+
+					std::fill_n(current_output_position.begin(), dimension_count, 0);
+					additional_buffer::iterator max_indexes_it = max_indexes_it_base;
+					for(additional_buffer::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it, ++max_indexes_it)
+					{
+						// Define the starting position of the first input elem
+						additional_buffer::const_iterator in_it = in_it_base;
+						for(unsigned int i = 0; i < dimension_count; ++i)
+							in_it += current_output_position[i] * (*(subsampling_sizes_it + i)) * (*(input_slices_it + i));
+
+						unsigned int max_index = 0;
+						float best_val = -1.0e38F;
+						for(unsigned int i = 0; i < const_subsampling_elem_count; ++i)
+						{
+							float new_val = *(in_it + (*(offset_list_it + i)));
+							if (new_val > best_val)
+							{
+								best_val = new_val;
+								max_index = i;
+							}
+						}
+						*out_it = best_val;
+						*((unsigned int *)(&(*max_indexes_it))) = max_index;
+
+						// Go to the next output element
+						for(unsigned int i = 0; i < dimension_count; ++i)
+						{
+							if ((++current_output_position[i]) < *( dimension_sizes_it + i))
+								break;
+							current_output_position[i] = 0;
+						}
+					}
+				}
+			}
+		};
+
+		struct max_subsampling_layer_updater_plain::backprop_body
+		{
+			additional_buffer::iterator in_err_it_global;
+			additional_buffer::const_iterator out_err_it_global;
+			additional_buffer::const_iterator max_indexes_it_global;
+			unsigned int input_neuron_count;
+			unsigned int input_neuron_count_per_feature_map;
+			unsigned int output_neuron_count;
+			unsigned int output_neuron_count_per_feature_map;
+			unsigned int dimension_count;
+			unsigned int const_subsampling_elem_count;
+			unsigned int feature_map_count;
+			std::vector<unsigned int>::const_iterator dimension_sizes_it;
+			std::vector<unsigned int>::const_iterator subsampling_sizes_it;
+			std::vector<unsigned int>::const_iterator input_slices_it;
+			std::vector<unsigned int>::const_iterator offset_list_it;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				nnforge_array<unsigned int, max_dimension_count> current_output_position;
+
+				for(int workload_id = begin; workload_id < end; ++workload_id)
+				{
+					int entry_id = workload_id / feature_map_count;
+					int feature_map_id = workload_id - (entry_id * feature_map_count);
+
+					additional_buffer::iterator in_err_it_base = in_err_it_global + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
+					additional_buffer::const_iterator out_err_it_base = out_err_it_global + (entry_id * output_neuron_count) + (feature_map_id * output_neuron_count_per_feature_map);
+					additional_buffer::const_iterator max_indexes_it_base = max_indexes_it_global + (entry_id * output_neuron_count) + (feature_map_id * output_neuron_count_per_feature_map);
+
+					// Windows do not cover the tail of the input when its size is not a multiple of the subsampling size
+					std::fill_n(in_err_it_base, input_neuron_count_per_feature_map, 0.0F);
+					std::fill_n(current_output_position.begin(), dimension_count, 0);
+					additional_buffer::const_iterator max_indexes_it = max_indexes_it_base;
+					for(additional_buffer::const_iterator out_it = out_err_it_base; out_it != out_err_it_base + output_neuron_count_per_feature_map; ++out_it, ++max_indexes_it)
+					{
+						// Define the starting position of the first input elem
+						additional_buffer::iterator in_it = in_err_it_base;
+						for(unsigned int i = 0; i < dimension_count; ++i)
+							in_it += current_output_position[i] * (*(subsampling_sizes_it + i)) * (*(input_slices_it + i));
+
+						float err = *out_it;
+						unsigned int max_index = *((unsigned int *)(&(*max_indexes_it)));
+						for(unsigned int i = 0; i < const_subsampling_elem_count; ++i)
+						{
+							*(in_it + (*(offset_list_it + i))) = ((i == max_index) ? err : 0.0F);
+						}
+
+						// Go to the next output element
+						for(unsigned int i = 0; i < dimension_count; ++i)
+						{
+							if ((++current_output_position[i]) < *( dimension_sizes_it + i))
+								break;
+							current_output_position[i] = 0;
+						}
+					}
+				}
+			}
+		};
+
 		max_subsampling_layer_updater_plain::max_subsampling_layer_updater_plain()
 		{
 		}
@@ -56,9 +181,9 @@ namespace nnforge
 			if (offset_input_entry_id >= 0)
 				throw neural_network_exception("max_subsampling_layer_updater_plain is not able to run using the same input");
 
-			const std::vector<float>::const_iterator in_it_global = input_buffer->begin();
-			const std::vector<float>::iterator out_it_global = output_buffer->begin();
-			const std::vector<float>::iterator max_indexes_it_global = additional_buffers[0]->begin();
+			const additional_buffer::const_iterator in_it_global = input_buffer->begin();
+			const additional_buffer::iterator out_it_global = output_buffer->begin();
+			const additional_buffer::iterator max_indexes_it_global = additional_buffers[0]->begin();
 			const unsigned int input_neuron_count = input_configuration_specific.get_neuron_count();
 			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
 			const unsigned int output_neuron_count = output_configuration_specific.get_neuron_count();
@@ -100,53 +225,8 @@ namespace nnforge
 			const std::vector<unsigned int>::const_iterator input_slices_it = input_slices.begin();
 			const std::vector<unsigned int>::const_iterator offset_list_it = offset_list.begin();
 
-			#pragma omp parallel default(none) num_threads(plain_config->openmp_thread_count)
-			{
-				nnforge_array<unsigned int, max_dimension_count> current_output_position;
-
-				#pragma omp for schedule(guided)
-				for(int workload_id = 0; workload_id < total_workload; ++workload_id)
-				{
-					int entry_id = workload_id / feature_map_count;
-					int feature_map_id = workload_id - (entry_id * feature_map_count);
-
-					std::vector<float>::const_iterator in_it_base = in_it_global + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
-					std::vector<float>::iterator out_it_base = out_it_global + (entry_id * output_neuron_count) + (feature_map_id * output_neuron_count_per_feature_map);
-					std::vector<float>::iterator max_indexes_it_base = max_indexes_it_global + (entry_id * output_neuron_count) + (feature_map_id * output_neuron_count_per_feature_map);
-
-					std::fill_n(current_output_position.begin(), dimension_count, 0);
-					std::vector<float>::iterator max_indexes_it = max_indexes_it_base;
-					for(std::vector<float>::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it, ++max_indexes_it)
-					{
-						// Define the starting position of the first input elem
-						std::vector<float>::const_iterator in_it = in_it_base;
-						for(unsigned int i = 0; i < dimension_count; ++i)
-							in_it += current_output_position[i] * (*(subsampling_sizes_it + i)) * (*(input_slices_it + i));
-
-						unsigned int max_index = 0;
-						float best_val = -1.0e38F;
-						for(unsigned int i = 0; i < const_subsampling_elem_count; ++i)
-						{
-							float new_val = *(in_it + (*(offset_list_it + i)));
-							if (new_val > best_val)
-							{
-								best_val = new_val;
-								max_index = i;
-							}
-						}
-						*out_it = best_val;
-						*((unsigned int *)(&(*max_indexes_it))) = max_index;
-
-						// Go to the next output element
-						for(unsigned int i = 0; i < dimension_count; ++i)
-						{
-							if ((++current_output_position[i]) < *( dimension_sizes_it + i))
-								break;
-							current_output_position[i] = 0;
-						}
-					}
-				}
-			}
+			const test_body body = { in_it_global, out_it_global, max_indexes_it_global, input_neuron_count, input_neuron_count_per_feature_map, output_neuron_count, output_neuron_count_per_feature_map, dimension_count, const_subsampling_elem_count, feature_map_count, dimension_sizes_it, subsampling_sizes_it, input_slices_it, offset_list_it };
+			plain_config->parallel_for(total_workload, body);
 		}
 
 		void max_subsampling_layer_updater_plain::backprop(
@@ -160,11 +240,12 @@ namespace nnforge
 			const layer_data_list& data,
 			const layer_configuration_specific& input_configuration_specific,
 			const layer_configuration_specific& output_configuration_specific,
-			unsigned int updater_count) const
+			unsigned int updater_count,
+			unsigned int output_errors_zero_count) const
 		{
-			const std::vector<float>::iterator in_err_it_global = input_errors->begin();
-			const std::vector<float>::const_iterator out_err_it_global = output_errors->begin();
-			const std::vector<float>::const_iterator max_indexes_it_global = additional_buffers[0]->begin();
+			const additional_buffer::iterator in_err_it_global = input_errors->begin();
+			const additional_buffer::const_iterator out_err_it_global = output_errors->begin();
+			const additional_buffer::const_iterator max_indexes_it_global = additional_buffers[0]->begin();
 			const unsigned int input_neuron_count = input_configuration_specific.get_neuron_count();
 			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
 			const unsigned int output_neuron_count = output_configuration_specific.get_neuron_count();
@@ -206,46 +287,8 @@ namespace nnforge
 			const std::vector<unsigned int>::const_iterator input_slices_it = input_slices.begin();
 			const std::vector<unsigned int>::const_iterator offset_list_it = offset_list.begin();
 
-			#pragma omp parallel default(none) num_threads(plain_config->openmp_thread_count)
-			{
-				nnforge_array<unsigned int, max_dimension_count> current_output_position;
-
-				#pragma omp for schedule(guided)
-				for(int workload_id = 0; workload_id < total_workload; ++workload_id)
-				{
-					int entry_id = workload_id / feature_map_count;
-					int feature_map_id = workload_id - (entry_id * feature_map_count);
-
-					std::vector<float>::iterator in_err_it_base = in_err_it_global + (entry_id * input_neuron_count) + (feature_map_id * input_neuron_count_per_feature_map);
-					std::vector<float>::const_iterator out_err_it_base = out_err_it_global + (entry_id * output_neuron_count) + (feature_map_id * output_neuron_count_per_feature_map);
-					std::vector<float>::const_iterator max_indexes_it_base = max_indexes_it_global + (entry_id * output_neuron_count) + (feature_map_id * output_neuron_count_per_feature_map);
-
-					std::fill_n(current_output_position.begin(), dimension_count, 0);
-					std::vector<float>::const_iterator max_indexes_it = max_indexes_it_base;
-					for(std::vector<float>::const_iterator out_it = out_err_it_base; out_it != out_err_it_base + output_neuron_count_per_feature_map; ++out_it, ++max_indexes_it)
-					{
-						// Define the starting position of the first input elem
-						std::vector<float>::iterator in_it = in_err_it_base;
-						for(unsigned int i = 0; i < dimension_count; ++i)
-							in_it += current_output_position[i] * (*(subsampling_sizes_it + i)) * (*(input_slices_it + i));
-
-						float err = *out_it;
-						unsigned int max_index = *((unsigned int *)(&(*max_indexes_it)));
-						for(unsigned int i = 0; i < const_subsampling_elem_count; ++i)
-						{
-							*(in_it + (*(offset_list_it + i))) = ((i == max_index) ? err : 0.0F);
-						}
-
-						// Go to the next output element
-						for(unsigned int i = 0; i < dimension_count; ++i)
-						{
-							if ((++current_output_position[i]) < *( dimension_sizes_it + i))
-								break;
-							current_output_position[i] = 0;
-						}
-					}
-				}
-			}
+			const backprop_body body = { in_err_it_global, out_err_it_global, max_indexes_it_global, input_neuron_count, input_neuron_count_per_feature_map, output_neuron_count, output_neuron_count_per_feature_map, dimension_count, const_subsampling_elem_count, feature_map_count, dimension_sizes_it, subsampling_sizes_it, input_slices_it, offset_list_it };
+			plain_config->parallel_for(total_workload, body);
 		}
 
 		std::vector<std::pair<unsigned int, bool> > max_subsampling_layer_updater_plain::get_elem_count_and_per_entry_flag_additional_buffers(
@@ -54,7 +54,8 @@ namespace nnforge
 				const layer_data_list& data,
 				const layer_configuration_specific& input_configuration_specific,
 				const layer_configuration_specific& output_configuration_specific,
-				unsigned int updater_count) const;
+				unsigned int updater_count,
+				unsigned int output_errors_zero_count) const;
 
 		protected:
 			virtual bool is_in_place_backprop() const;
@@ -68,6 +69,10 @@ namespace nnforge
 
 		private:
 			static const int max_dimension_count;
+
+			// Kernel bodies run by plain_running_configuration::parallel_for
+			struct test_body;
+			struct backprop_body;
 		};
 	}
 }
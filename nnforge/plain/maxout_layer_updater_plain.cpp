@@ -26,6 +26,88 @@ namespace nnforge
 {
 	namespace plain
 	{
+		struct maxout_layer_updater_plain::test_body
+		{
+			additional_buffer::const_iterator in_it_global;
+			additional_buffer::iterator out_it_global;
+			additional_buffer::iterator max_feature_map_positions_it_global;
+			unsigned int input_neuron_count;
+			unsigned int input_neuron_count_per_feature_map;
+			unsigned int output_neuron_count;
+			unsigned int output_neuron_count_per_feature_map;
+			unsigned int feature_map_subsampling_size;
+			int output_feature_map_count;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				for(int workload_id = begin; workload_id < end; ++workload_id)
+				{
+					int entry_id = workload_id / output_feature_map_count;
+					int output_feature_map_id = workload_id - (entry_id * output_feature_map_count);
+
+					additional_buffer::const_iterator in_it_base = in_it_global + (entry_id * input_neuron_count) + (output_feature_map_id * input_neuron_count_per_feature_map);
+					int output_offset = (entry_id * output_neuron_count) + (output_feature_map_id * output_neuron_count_per_feature_map);
+					additional_buffer::iterator out_it_base = out_it_global + output_offset;
+					additional_buffer::iterator max_feature_map_positions_it = max_feature_map_positions_it_global + output_offset;
+
+					for(additional_buffer::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it, ++max_feature_map_positions_it, ++in_it_base)
+					{
+						additional_buffer::const_iterator in_it = in_it_base;
+						float current_max = *in_it;
+						int max_feature_map_pos = 0;
+						for(unsigned int i = 1; i < feature_map_subsampling_size; ++i)
+						{
+							in_it += output_feature_map_count * output_neuron_count_per_feature_map;
+							float new_val = *in_it;
+							if (new_val > current_max)
+							{
+								current_max = new_val;
+								max_feature_map_pos = i;
+							}
+						}
+						*out_it = current_max;
+						*((unsigned int *)(&(*max_feature_map_positions_it))) = max_feature_map_pos;
+					}
+				}
+			}
+		};
+
+		struct maxout_layer_updater_plain::backprop_body
+		{
+			additional_buffer::iterator in_err_it_global;
+			additional_buffer::const_iterator out_err_it_global;
+			additional_buffer::const_iterator max_feature_map_positions_it_global;
+			unsigned int input_neuron_count;
+			unsigned int input_neuron_count_per_feature_map;
+			unsigned int output_neuron_count;
+			unsigned int output_neuron_count_per_feature_map;
+			unsigned int feature_map_subsampling_size;
+			int output_feature_map_count;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				for(int workload_id = begin; workload_id < end; ++workload_id)
+				{
+					int entry_id = workload_id / output_feature_map_count;
+					int output_feature_map_id = workload_id - (entry_id * output_feature_map_count);
+
+					additional_buffer::iterator in_err_it_base = in_err_it_global + (entry_id * input_neuron_count) + (output_feature_map_id * input_neuron_count_per_feature_map);
+					int output_offset = (entry_id * output_neuron_count) + (output_feature_map_id * output_neuron_count_per_feature_map);
+					additional_buffer::const_iterator out_err_it_base = out_err_it_global + output_offset;
+					additional_buffer::const_iterator max_feature_map_positions_it = max_feature_map_positions_it_global + output_offset;
+
+					for(additional_buffer::const_iterator out_err_it = out_err_it_base; out_err_it != out_err_it_base + output_neuron_count_per_feature_map; ++out_err_it, ++max_feature_map_positions_it, ++in_err_it_base)
+					{
+						additional_buffer::iterator in_err_it = in_err_it_base;
+						float current_err = *out_err_it;
+						unsigned int max_feature_map_position = *((const unsigned int *)(&(*max_feature_map_positions_it)));
+						for(unsigned int i = 0; i < feature_map_subsampling_size; ++i)
+							in_err_it[output_feature_map_count * output_neuron_count_per_feature_map * i] = ((i == max_feature_map_position) ? current_err : 0.0F);
+					}
+				}
+			}
+		};
+
 		maxout_layer_updater_plain::maxout_layer_updater_plain()
 		{
 		}
@@ -54,9 +136,9 @@ namespace nnforge
 			if (offset_input_entry_id >= 0)
 				throw neural_network_exception("maxout_layer_updater_plain is not able to run using the same input");
 
-			const std::vector<float>::const_iterator in_it_global = input_buffer->begin();
-			const std::vector<float>::iterator out_it_global = output_buffer->begin();
-			const std::vector<float>::iterator max_feature_map_positions_it_global = additional_buffers[0]->begin();
+			const additional_buffer::const_iterator in_it_global = input_buffer->begin();
+			const additional_buffer::iterator out_it_global = output_buffer->begin();
+			const additional_buffer::iterator max_feature_map_positions_it_global = additional_buffers[0]->begin();
 
 			const unsigned int input_neuron_count = input_configuration_specific.get_neuron_count();
 			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
@@ -67,39 +149,8 @@ namespace nnforge
 			const int output_feature_map_count = output_configuration_specific.feature_map_count;
 			const int total_workload = updater_count * output_feature_map_count;
 
-			#pragma omp parallel default(none) num_threads(plain_config->openmp_thread_count)
-			{
-				#pragma omp for schedule(guided)
-				for(int workload_id = 0; workload_id < total_workload; ++workload_id)
-				{
-					int entry_id = workload_id / output_feature_map_count;
-					int output_feature_map_id = workload_id - (entry_id * output_feature_map_count);
-
-					std::vector<float>::const_iterator in_it_base = in_it_global + (entry_id * input_neuron_count) + (output_feature_map_id * input_neuron_count_per_feature_map);
-					int output_offset = (entry_id * output_neuron_count) + (output_feature_map_id * output_neuron_count_per_feature_map);
-					std::vector<float>::iterator out_it_base = out_it_global + output_offset;
-					std::vector<float>::iterator max_feature_map_positions_it = max_feature_map_positions_it_global + output_offset;
-
-					for(std::vector<float>::iterator out_it = out_it_base; out_it != out_it_base + output_neuron_count_per_feature_map; ++out_it, ++max_feature_map_positions_it, ++in_it_base)
-					{
-						std::vector<float>::const_iterator in_it = in_it_base;
-						float current_max = *in_it;
-						int max_feature_map_pos = 0;
-						for(unsigned int i = 1; i < feature_map_subsampling_size; ++i)
-						{
-							in_it += output_feature_map_count * output_neuron_count_per_feature_map;
-							float new_val = *in_it;
-							if (new_val > current_max)
-							{
-								current_max = new_val;
-								max_feature_map_pos = i;
-							}
-						}
-						*out_it = current_max;
-						*((unsigned int *)(&(*max_feature_map_positions_it))) = max_feature_map_pos;
-					}
-				}
-			}
+			const test_body body = { in_it_global, out_it_global, max_feature_map_positions_it_global, input_neuron_count, input_neuron_count_per_feature_map, output_neuron_count, output_neuron_count_per_feature_map, feature_map_subsampling_size, output_feature_map_count };
+			plain_config->parallel_for(total_workload, body);
 		}
 
 		void maxout_layer_updater_plain::backprop(
@@ -113,11 +164,12 @@ namespace nnforge
 			const layer_data_list& data,
 			const layer_configuration_specific& input_configuration_specific,
 			const layer_configuration_specific& output_configuration_specific,
-			unsigned int updater_count) const
+			unsigned int updater_count,
+			unsigned int output_errors_zero_count) const
 		{
-			const std::vector<float>::iterator in_err_it_global = input_errors->begin();
-			const std::vector<float>::const_iterator out_err_it_global = output_errors->begin();
-			const std::vector<float>::const_iterator max_feature_map_positions_it_global = additional_buffers[0]->begin();
+			const additional_buffer::iterator in_err_it_global = input_errors->begin();
+			const additional_buffer::const_iterator out_err_it_global = output_errors->begin();
+			const additional_buffer::const_iterator max_feature_map_positions_it_global = additional_buffers[0]->begin();
 
 			const unsigned int input_neuron_count = input_configuration_specific.get_neuron_count();
 			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
@@ -128,29 +180,8 @@ namespace nnforge
 			const int output_feature_map_count = output_configuration_specific.feature_map_count;
 			const int total_workload = updater_count * output_feature_map_count;
 
-			#pragma omp parallel default(none) num_threads(plain_config->openmp_thread_count)
-			{
-				#pragma omp for schedule(guided)
-				for(int workload_id = 0; workload_id < total_workload; ++workload_id)
-				{
-					int entry_id = workload_id / output_feature_map_count;
-					int output_feature_map_id = workload_id - (entry_id * output_feature_map_count);
-
-					std::vector<float>::iterator in_err_it_base = in_err_it_global + (entry_id * input_neuron_count) + (output_feature_map_id * input_neuron_count_per_feature_map);
-					int output_offset = (entry_id * output_neuron_count) + (output_feature_map_id * output_neuron_count_per_feature_map);
-					std::vector<float>::const_iterator out_err_it_base = out_err_it_global + output_offset;
-					std::vector<float>::const_iterator max_feature_map_positions_it = max_feature_map_positions_it_global + output_offset;
-
-					for(std::vector<float>::const_iterator out_err_it = out_err_it_base; out_err_it != out_err_it_base + output_neuron_count_per_feature_map; ++out_err_it, ++max_feature_map_positions_it, ++in_err_it_base)
-					{
-						std::vector<float>::iterator in_err_it = in_err_it_base;
-						float current_err = *out_err_it;
-						unsigned int max_feature_map_position = *((const unsigned int *)(&(*max_feature_map_positions_it)));
-						for(unsigned int i = 0; i < feature_map_subsampling_size; ++i)
-							in_err_it[output_feature_map_count * output_neuron_count_per_feature_map * i] = ((i == max_feature_map_position) ? current_err : 0.0F);
-					}
-				}
-			}
+			const backprop_body body = { in_err_it_global, out_err_it_global, max_feature_map_positions_it_global, input_neuron_count, input_neuron_count_per_feature_map, output_neuron_count, output_neuron_count_per_feature_map, feature_map_subsampling_size, output_feature_map_count };
+			plain_config->parallel_for(total_workload, body);
 		}
 
 		std::vector<std::pair<unsigned int, bool> > maxout_layer_updater_plain::get_elem_count_and_per_entry_flag_additional_buffers(
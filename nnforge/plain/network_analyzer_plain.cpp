@@ -17,6 +17,7 @@
 #include "network_analyzer_plain.h"
 
 #include "layer_updater_plain_factory.h"
+#include "sparsity_util.h"
 #include "../neural_network_exception.h"
 
 #include <boost/format.hpp>
@@ -48,8 +49,8 @@ namespace nnforge
 
 			const unsigned int input_neuron_count = layer_config_list.front().get_neuron_count();
 			const unsigned int output_neuron_count = layer_config_list.back().get_neuron_count();
-			input_converted_buf = additional_buffer_smart_ptr(new std::vector<float>(input_neuron_count));
-			initial_error_buf = additional_buffer_smart_ptr(new std::vector<float>(output_neuron_count));
+			input_converted_buf = additional_buffer_smart_ptr(new additional_buffer(input_neuron_count));
+			initial_error_buf = additional_buffer_smart_ptr(new additional_buffer(output_neuron_count));
 
 			additional_buffer_smart_ptr output_buffer = input_converted_buf;
 
@@ -96,7 +97,7 @@ namespace nnforge
 			const unsigned int input_neuron_count = layer_config_list[0].get_neuron_count();
 
 			const int elem_count = static_cast<int>(input_neuron_count);
-			const std::vector<float>::iterator input_converted_buf_it_start = input_converted_buf->begin();
+			const additional_buffer::iterator input_converted_buf_it_start = input_converted_buf->begin();
 			if (type_code == neuron_data_type::type_byte)
 			{
 				const unsigned char * const input_buf_it_start = static_cast<const unsigned char *>(input);
@@ -212,6 +213,10 @@ namespace nnforge
 				std::vector<layer_data_list>::reverse_iterator data_it = data_list_reorganized.rbegin() + (data_list_reorganized.size() - output_layer_id - 1);
 				for(std::vector<const_layer_updater_plain_smart_ptr>::const_reverse_iterator it = updater_list.rbegin() + (updater_list.size() - output_layer_id - 1); it != updater_list.rend(); ++it, ++layer_it, ++input_config_it, ++updater_buffers_it, ++data_it, ++output_errors_it)
 				{
+					unsigned int output_errors_zero_count = 0;
+					if ((*it)->is_output_errors_zero_count_used())
+						output_errors_zero_count = sparsity_util::get_zero_count(&(*(*output_errors_it)->begin()), input_config_it->get_neuron_count(), plain_config);
+
 					(*it)->backprop(
 						updater_buffers_it->second.input_errors_buffer,
 						updater_buffers_it->first,
@@ -223,7 +228,8 @@ namespace nnforge
 						*data_it,
 						*(input_config_it + 1),
 						*input_config_it,
-						1);
+						1,
+						output_errors_zero_count);
 				}
 			}
 
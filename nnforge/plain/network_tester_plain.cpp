@@ -17,9 +17,18 @@
 #include "network_tester_plain.h"
 
 #include "layer_tester_plain_factory.h"
+#include "convolution_layer_tester_plain.h"
+#include "fused_layer_tester_plain.h"
+#include "reduced_precision_layer_data.h"
+#include "quantized_layer_data.h"
+#include "../mapped_layer_data.h"
+#include "../convolution_layer.h"
 #include "../neural_network_exception.h"
 
 #include <boost/format.hpp>
+#include <algorithm>
+#include <functional>
+#include <numeric>
 
 namespace nnforge
 {
@@ -31,9 +40,27 @@ namespace nnforge
 			: network_tester(schema)
 			, plain_config(plain_config)
 		{
+			plain_config->bind_openmp_threads();
+
 			const const_layer_list& layer_list = *schema;
 			for(const_layer_list::const_iterator it = layer_list.begin(); it != layer_list.end(); ++it)
 				tester_list.push_back(plain::single_layer_tester_plain_factory::get_const_instance().get_tester_plain_layer((*it)->get_uuid()));
+
+			for(unsigned int i = 0; i < layer_list.size(); ++i)
+			{
+				if ((layer_list[i]->get_uuid() == convolution_layer::layer_guid)
+					&& (i + 1 < layer_list.size())
+					&& convolution_layer_tester_plain::is_activation_fusable(layer_list[i + 1]))
+				{
+					fused_tester_list.push_back(const_layer_tester_plain_smart_ptr(new convolution_layer_tester_plain(layer_list[i + 1])));
+					fused_tester_list.push_back(const_layer_tester_plain_smart_ptr(new fused_layer_tester_plain(layer_list[i + 1]->get_uuid())));
+					++i;
+				}
+				else
+				{
+					fused_tester_list.push_back(tester_list[i]);
+				}
+			}
 		}
 
 		network_tester_plain::~network_tester_plain()
@@ -55,31 +82,25 @@ namespace nnforge
 			output_neuron_value_set_smart_ptr predicted_output_neuron_value_set(new output_neuron_value_set(entry_count, output_neuron_count));
 
 			buffer_plain_size_configuration buffers_config;
-			update_buffers_configuration_testing(buffers_config);
+			update_buffers_configuration_testing(buffers_config, std::vector<network_data_smart_ptr>(1, net_data));
 			buffers_config.add_per_entry_buffer(input_neuron_count * input_neuron_elem_size); // input
 			buffers_config.add_per_entry_buffer(input_neuron_count * sizeof(float)); // converted input
 
-			const unsigned int max_entry_count = std::min<unsigned int>(plain_config->get_max_entry_count(buffers_config), reader.get_entry_count());
+			// Process single entry at once if even it doesn't fit the memory limit, the planner allocates no storage for 0 entries
+			const unsigned int max_entry_count = std::max<unsigned int>(std::min<unsigned int>(plain_config->get_max_entry_count(buffers_config), reader.get_entry_count()), 1);
 
 			std::vector<unsigned char> input_buf(input_neuron_count * max_entry_count * input_neuron_elem_size);
-			additional_buffer_smart_ptr input_converted_buf(new std::vector<float>(input_neuron_count * max_entry_count));
+			additional_buffer_smart_ptr input_converted_buf = plain_config->allocate_buffer(input_neuron_count * max_entry_count);
 
 			additional_buffer_smart_ptr output_buffer = input_converted_buf;
 			std::vector<std::pair<additional_buffer_smart_ptr, additional_buffer_set> > input_buffer_and_additional_buffers_pack;
 			{
-				const const_layer_list& layer_list = *schema;
-				const_layer_list::const_iterator layer_it = layer_list.begin();
-				layer_configuration_specific_list::const_iterator input_config_it = layer_config_list.begin();
-				for(std::vector<const_layer_tester_plain_smart_ptr>::const_iterator it = tester_list.begin(); it != tester_list.end(); ++it, ++layer_it, ++input_config_it)
+				std::vector<additional_buffer_set> additional_buffers_list = buffer_planner->get_additional_buffers(max_entry_count);
+				std::vector<additional_buffer_set>::iterator additional_buffers_it = additional_buffers_list.begin();
+				for(std::vector<const_layer_tester_plain_smart_ptr>::const_iterator it = fused_tester_list.begin(); it != fused_tester_list.end(); ++it, ++additional_buffers_it)
 				{
-					additional_buffer_set additional_buffers = (*it)->allocate_additional_buffers(
-						max_entry_count,
-						*layer_it,
-						*input_config_it,
-						*(input_config_it + 1),
-						plain_config);
-					input_buffer_and_additional_buffers_pack.push_back(std::make_pair(output_buffer, additional_buffers));
-					output_buffer = (*it)->get_output_buffer(output_buffer, additional_buffers);
+					input_buffer_and_additional_buffers_pack.push_back(std::make_pair(output_buffer, *additional_buffers_it));
+					output_buffer = (*it)->get_output_buffer(output_buffer, *additional_buffers_it);
 				}
 			}
 
@@ -87,25 +108,18 @@ namespace nnforge
 			unsigned int entries_copied_count = 0;
 			while (entries_remained_for_loading)
 			{
-				unsigned int entries_available_for_processing_count = 0;
-				while(entries_available_for_processing_count < max_entry_count)
-				{
-					bool entry_read = reader.read(&(*(input_buf.begin() + (input_neuron_count * entries_available_for_processing_count * input_neuron_elem_size))));
-					if (!entry_read)
-					{
-						entries_remained_for_loading = false;
-						break;
-					}
-					entries_available_for_processing_count++;
-				}
+				unsigned int entries_available_for_processing_count = reader.read_batch(max_entry_count, &(*input_buf.begin()));
+				if (entries_available_for_processing_count < max_entry_count)
+					entries_remained_for_loading = false;
 
 				if (entries_available_for_processing_count == 0)
 					break;
 
 				// Convert input
 				{
+					profiling_scope scope(profiling, 0, profiling_result::phase_input_conversion);
 					const int elem_count = static_cast<int>(entries_available_for_processing_count * input_neuron_count);
-					const std::vector<float>::iterator input_converted_buf_it_start = input_converted_buf->begin();
+					const additional_buffer::iterator input_converted_buf_it_start = input_converted_buf->begin();
 					if (type_code == neuron_data_type::type_byte)
 					{
 						const unsigned char * const input_buf_it_start = &(*input_buf.begin());
@@ -130,8 +144,9 @@ namespace nnforge
 					layer_configuration_specific_list::const_iterator input_config_it = layer_config_list.begin();
 					std::vector<std::pair<additional_buffer_smart_ptr, additional_buffer_set> >::iterator buffers_it = input_buffer_and_additional_buffers_pack.begin();
 					layer_data_list::const_iterator data_it = net_data->begin();
-					for(std::vector<const_layer_tester_plain_smart_ptr>::const_iterator it = tester_list.begin(); it != tester_list.end(); ++it, ++layer_it, ++input_config_it, ++buffers_it, ++data_it)
+					for(std::vector<const_layer_tester_plain_smart_ptr>::const_iterator it = fused_tester_list.begin(); it != fused_tester_list.end(); ++it, ++layer_it, ++input_config_it, ++buffers_it, ++data_it)
 					{
+						profiling_scope scope(profiling, static_cast<unsigned int>(layer_it - layer_list.begin()), profiling_result::phase_forward, static_cast<float>(entries_available_for_processing_count) * forward_flops_list[layer_it - layer_list.begin()]);
 						(*it)->test(
 							buffers_it->first,
 							buffers_it->second,
@@ -147,12 +162,12 @@ namespace nnforge
 				// Copy predicted values
 				{
 					const int total_workload = static_cast<int>(entries_available_for_processing_count);
-					const std::vector<float>::const_iterator output_buffer_it = output_buffer->begin();
+					const additional_buffer::const_iterator output_buffer_it = output_buffer->begin();
 					const std::vector<std::vector<float> >::iterator neuron_value_list_it = predicted_output_neuron_value_set->neuron_value_list.begin() + entries_copied_count;
 					#pragma omp parallel for default(none) schedule(guided) num_threads(plain_config->openmp_thread_count)
 					for(int i = 0; i < total_workload; ++i)
 					{
-						std::vector<float>::const_iterator src_it = output_buffer_it + (i * output_neuron_count);
+						additional_buffer::const_iterator src_it = output_buffer_it + (i * output_neuron_count);
 						std::vector<float>& value_list_dest = *(neuron_value_list_it + i);
 						std::copy(src_it, src_it + output_neuron_count, value_list_dest.begin());
 					}
@@ -164,9 +179,245 @@ namespace nnforge
 			return predicted_output_neuron_value_set;
 		}
 
+		output_neuron_value_set_smart_ptr network_tester_plain::actual_run(
+			unsupervised_data_reader& reader,
+			const std::vector<network_data_smart_ptr>& original_data_list,
+			output_neuron_value_set::merge_type_enum merge_type,
+			unsigned int sample_count)
+		{
+			reader.reset();
+
+			if (quantization)
+				throw neural_network_exception("Quantization data is specific to a single network, running several networks in single pass cannot use it");
+
+			std::vector<network_data_smart_ptr> data_list;
+			for(std::vector<network_data_smart_ptr>::const_iterator it = original_data_list.begin(); it != original_data_list.end(); ++it)
+				data_list.push_back(get_packed_data(*it));
+
+			const unsigned int input_neuron_count = reader.get_input_configuration().get_neuron_count();
+			const unsigned int output_neuron_count = (layer_config_list.end() - 1)->get_neuron_count();
+			const unsigned int entry_count = reader.get_entry_count();
+			const unsigned int network_count = static_cast<unsigned int>(data_list.size());
+			neuron_data_type::input_type type_code = reader.get_input_type();
+			size_t input_neuron_elem_size = reader.get_input_neuron_elem_size();
+
+			output_neuron_value_set_smart_ptr predicted_output_neuron_value_set(new output_neuron_value_set(entry_count / sample_count, output_neuron_count));
+
+			buffer_plain_size_configuration buffers_config;
+			update_buffers_configuration_testing(buffers_config, data_list);
+			buffers_config.add_per_entry_buffer(input_neuron_count * input_neuron_elem_size); // input
+			buffers_config.add_per_entry_buffer(input_neuron_count * sizeof(float)); // converted input
+			buffers_config.add_per_entry_buffer(input_neuron_count * sizeof(float)); // converted input copy, used when the 1st layer works in-place
+			buffers_config.add_per_entry_buffer(output_neuron_count * sizeof(float) * network_count); // predicted values of all the networks
+
+			// Keep all the samples of the entry in the same chunk so that they are compacted before merging
+			unsigned int max_entry_count = std::min<unsigned int>(plain_config->get_max_entry_count(buffers_config), entry_count);
+			max_entry_count = std::max<unsigned int>(max_entry_count - (max_entry_count % sample_count), sample_count);
+
+			std::vector<unsigned char> input_buf(input_neuron_count * max_entry_count * input_neuron_elem_size);
+			additional_buffer_smart_ptr input_converted_buf = plain_config->allocate_buffer(input_neuron_count * max_entry_count);
+			std::vector<float> predicted_buf(output_neuron_count * (max_entry_count / sample_count) * network_count);
+
+			additional_buffer_smart_ptr output_buffer = input_converted_buf;
+			std::vector<std::pair<additional_buffer_smart_ptr, additional_buffer_set> > input_buffer_and_additional_buffers_pack;
+			{
+				std::vector<additional_buffer_set> additional_buffers_list = buffer_planner->get_additional_buffers(max_entry_count);
+				std::vector<additional_buffer_set>::iterator additional_buffers_it = additional_buffers_list.begin();
+				for(std::vector<const_layer_tester_plain_smart_ptr>::const_iterator it = fused_tester_list.begin(); it != fused_tester_list.end(); ++it, ++additional_buffers_it)
+				{
+					input_buffer_and_additional_buffers_pack.push_back(std::make_pair(output_buffer, *additional_buffers_it));
+					output_buffer = (*it)->get_output_buffer(output_buffer, *additional_buffers_it);
+				}
+			}
+
+			// The 1st layer overwrites converted input, so keep the original copy for the subsequent networks
+			additional_buffer_smart_ptr input_converted_copy_buf;
+			additional_buffer_smart_ptr first_layer_output_buffer = (input_buffer_and_additional_buffers_pack.size() > 1) ? input_buffer_and_additional_buffers_pack[1].first : output_buffer;
+			if ((network_count > 1) && (first_layer_output_buffer == input_converted_buf))
+				input_converted_copy_buf = plain_config->allocate_buffer(input_neuron_count * max_entry_count);
+			additional_buffer_smart_ptr input_conversion_target_buf = input_converted_copy_buf ? input_converted_copy_buf : input_converted_buf;
+
+			bool entries_remained_for_loading = true;
+			unsigned int entries_copied_count = 0;
+			while (entries_remained_for_loading)
+			{
+				unsigned int entries_available_for_processing_count = reader.read_batch(max_entry_count, &(*input_buf.begin()));
+				if (entries_available_for_processing_count < max_entry_count)
+					entries_remained_for_loading = false;
+
+				if (entries_available_for_processing_count == 0)
+					break;
+
+				const unsigned int compacted_entry_count = entries_available_for_processing_count / sample_count;
+
+				// Convert input
+				{
+					profiling_scope scope(profiling, 0, profiling_result::phase_input_conversion);
+					const int elem_count = static_cast<int>(entries_available_for_processing_count * input_neuron_count);
+					const additional_buffer::iterator input_converted_buf_it_start = input_conversion_target_buf->begin();
+					if (type_code == neuron_data_type::type_byte)
+					{
+						const unsigned char * const input_buf_it_start = &(*input_buf.begin());
+						#pragma omp parallel for default(none) schedule(guided) num_threads(plain_config->openmp_thread_count)
+						for(int i = 0; i < elem_count; ++i)
+							*(input_converted_buf_it_start + i) = static_cast<float>(*(input_buf_it_start + i)) * (1.0F / 255.0F);
+					}
+					else if (type_code == neuron_data_type::type_float)
+					{
+						const float * const input_buf_it_start = reinterpret_cast<float *>(&(*input_buf.begin()));
+						#pragma omp parallel for default(none) schedule(guided) num_threads(plain_config->openmp_thread_count)
+						for(int i = 0; i < elem_count; ++i)
+							*(input_converted_buf_it_start + i) = *(input_buf_it_start + i);
+					}
+					else throw neural_network_exception((boost::format("actual_run cannot handle input neurons of type %1%") % type_code).str());
+				}
+
+				for(unsigned int network_id = 0; network_id < network_count; ++network_id)
+				{
+					if (input_converted_copy_buf)
+						std::copy(input_converted_copy_buf->begin(), input_converted_copy_buf->begin() + (entries_available_for_processing_count * input_neuron_count), input_converted_buf->begin());
+
+					// Run ann
+					{
+						const const_layer_list& layer_list = *schema;
+						const_layer_list::const_iterator layer_it = layer_list.begin();
+						layer_configuration_specific_list::const_iterator input_config_it = layer_config_list.begin();
+						std::vector<std::pair<additional_buffer_smart_ptr, additional_buffer_set> >::iterator buffers_it = input_buffer_and_additional_buffers_pack.begin();
+						layer_data_list::const_iterator data_it = data_list[network_id]->begin();
+						for(std::vector<const_layer_tester_plain_smart_ptr>::const_iterator it = fused_tester_list.begin(); it != fused_tester_list.end(); ++it, ++layer_it, ++input_config_it, ++buffers_it, ++data_it)
+						{
+							profiling_scope scope(profiling, static_cast<unsigned int>(layer_it - layer_list.begin()), profiling_result::phase_forward, static_cast<float>(entries_available_for_processing_count) * forward_flops_list[layer_it - layer_list.begin()]);
+							(*it)->test(
+								buffers_it->first,
+								buffers_it->second,
+								plain_config,
+								*layer_it,
+								*data_it,
+								*input_config_it,
+								*(input_config_it + 1),
+								entries_available_for_processing_count);
+						}
+					}
+
+					// Compact predicted values over samples
+					{
+						const int total_workload = static_cast<int>(compacted_entry_count);
+						const additional_buffer::const_iterator output_buffer_it = output_buffer->begin();
+						const std::vector<float>::iterator predicted_buf_it = predicted_buf.begin() + (network_id * max_entry_count / sample_count * output_neuron_count);
+						const float mult = 1.0F / static_cast<float>(sample_count);
+						#pragma omp parallel for default(none) schedule(guided) num_threads(plain_config->openmp_thread_count)
+						for(int i = 0; i < total_workload; ++i)
+						{
+							additional_buffer::const_iterator src_it = output_buffer_it + (i * sample_count * output_neuron_count);
+							std::vector<float>::iterator dst_it = predicted_buf_it + (i * output_neuron_count);
+							std::copy(src_it, src_it + output_neuron_count, dst_it);
+							for(unsigned int sample_id = 1; sample_id < sample_count; ++sample_id)
+							{
+								src_it += output_neuron_count;
+								std::transform(dst_it, dst_it + output_neuron_count, src_it, dst_it, std::plus<float>());
+							}
+							if (sample_count > 1)
+								for(std::vector<float>::iterator it = dst_it; it != dst_it + output_neuron_count; ++it)
+									*it *= mult;
+						}
+					}
+				}
+
+				// Merge predicted values across networks
+				{
+					const int total_workload = static_cast<int>(compacted_entry_count);
+					const std::vector<float>::const_iterator predicted_buf_it = predicted_buf.begin();
+					const unsigned int network_stride = max_entry_count / sample_count * output_neuron_count;
+					const std::vector<std::vector<float> >::iterator neuron_value_list_it = predicted_output_neuron_value_set->neuron_value_list.begin() + (entries_copied_count / sample_count);
+					const float mult = 1.0F / static_cast<float>(network_count);
+					#pragma omp parallel default(none) num_threads(plain_config->openmp_thread_count)
+					{
+						std::vector<float> val_list(network_count);
+
+						#pragma omp for schedule(guided)
+						for(int i = 0; i < total_workload; ++i)
+						{
+							std::vector<float>& value_list_dest = *(neuron_value_list_it + i);
+							for(unsigned int neuron_id = 0; neuron_id < output_neuron_count; ++neuron_id)
+							{
+								std::vector<float>::const_iterator src_it = predicted_buf_it + (i * output_neuron_count + neuron_id);
+								for(unsigned int network_id = 0; network_id < network_count; ++network_id)
+									val_list[network_id] = *(src_it + (network_id * network_stride));
+
+								float val;
+								if (merge_type == output_neuron_value_set::merge_median)
+								{
+									std::sort(val_list.begin(), val_list.end());
+									if (network_count & 1)
+										val = val_list[network_count >> 1];
+									else
+										val = (val_list[network_count >> 1] + val_list[(network_count >> 1) - 1]) * 0.5F;
+								}
+								else
+									val = std::accumulate(val_list.begin(), val_list.end(), 0.0F) * mult;
+
+								value_list_dest[neuron_id] = val;
+							}
+						}
+					}
+				}
+
+				entries_copied_count += entries_available_for_processing_count;
+			}
+
+			return predicted_output_neuron_value_set;
+		}
+
 		void network_tester_plain::actual_set_data(network_data_smart_ptr data)
 		{
-			net_data = data;
+			net_data = get_packed_data(data);
+		}
+
+		network_data_smart_ptr network_tester_plain::get_packed_data(network_data_smart_ptr data) const
+		{
+			network_data_smart_ptr res;
+			const const_layer_list& layer_list = *schema;
+			const_layer_tester_plain_list::const_iterator fused_tester_it = fused_tester_list.begin();
+			const_layer_tester_plain_list::const_iterator tester_it = tester_list.begin();
+			for(unsigned int layer_id = 0; layer_id < data->size(); ++layer_id, ++fused_tester_it, ++tester_it)
+			{
+				layer_data_smart_ptr layer_data_it = (*data)[layer_id];
+				if (nnforge_dynamic_pointer_cast<reduced_precision_layer_data>(layer_data_it) || nnforge_dynamic_pointer_cast<quantized_layer_data>(layer_data_it))
+					continue;
+				mapped_layer_data_smart_ptr mapped_data = nnforge_dynamic_pointer_cast<mapped_layer_data>(layer_data_it);
+				if (!mapped_data && layer_data_it->is_empty())
+					continue;
+
+				// Both the fused and the unfused testers get the same data
+				bool quantize = quantization && (quantization->input_range_list[layer_id] > 0.0F) && !quantization->weight_list[layer_id].empty()
+					&& (*fused_tester_it)->is_quantized_data_supported(layer_list[layer_id], layer_config_list[layer_id])
+					&& (*tester_it)->is_quantized_data_supported(layer_list[layer_id], layer_config_list[layer_id]);
+				bool reduce_precision = !quantize && (plain_config->tester_weight_storage != weight_storage_type::type_float)
+					&& (*fused_tester_it)->is_reduced_precision_data_supported() && (*tester_it)->is_reduced_precision_data_supported();
+				bool unmap = !quantize && !reduce_precision && mapped_data
+					&& !((*fused_tester_it)->is_mapped_data_supported() && (*tester_it)->is_mapped_data_supported());
+				if (!quantize && !reduce_precision && !unmap)
+					continue;
+
+				if (mapped_data)
+					layer_data_it = mapped_data->copy();
+
+				if (!res)
+					res = network_data_smart_ptr(new network_data(*data));
+				if (quantize)
+					(*res)[layer_id] = layer_data_smart_ptr(new quantized_layer_data(*layer_data_it, *quantization, layer_id));
+				else if (reduce_precision)
+					(*res)[layer_id] = layer_data_smart_ptr(new reduced_precision_layer_data(*layer_data_it, plain_config->tester_weight_storage));
+				else
+					(*res)[layer_id] = layer_data_it;
+			}
+
+			return res ? res : data;
+		}
+
+		bool network_tester_plain::is_mapped_data_supported() const
+		{
+			return true;
 		}
 
 		std::vector<layer_configuration_specific_snapshot_smart_ptr> network_tester_plain::actual_get_snapshot(
@@ -179,7 +430,7 @@ namespace nnforge
 			const unsigned int input_feature_map_count = layer_config_list[0].feature_map_count;
 			const unsigned int neuron_count_per_input_feature_map = layer_config_list[0].get_neuron_count_per_feature_map();
 
-			additional_buffer_smart_ptr input_converted_buf(new std::vector<float>(input_neuron_count));
+			additional_buffer_smart_ptr input_converted_buf(new additional_buffer(input_neuron_count));
 
 			additional_buffer_smart_ptr output_buffer = input_converted_buf;
 			std::vector<std::pair<additional_buffer_smart_ptr, additional_buffer_set> > input_buffer_and_additional_buffers_pack;
@@ -209,7 +460,7 @@ namespace nnforge
 				layer_configuration_specific_snapshot_smart_ptr input_elem(new layer_configuration_specific_snapshot(layer_config_list[0]));
 				res.push_back(input_elem);
 				const int elem_count = static_cast<int>(input_neuron_count);
-				const std::vector<float>::iterator input_converted_buf_it_start = input_converted_buf->begin();
+				const additional_buffer::iterator input_converted_buf_it_start = input_converted_buf->begin();
 				const std::vector<float>::iterator input_elem_it_start = input_elem->data.begin();
 				if (type_code == neuron_data_type::type_byte)
 				{
@@ -284,33 +535,25 @@ namespace nnforge
 			const unsigned int input_feature_map_count = layer_config_list[0].feature_map_count;
 			const unsigned int neuron_count_per_input_feature_map = layer_config_list[0].get_neuron_count_per_feature_map();
 
-			additional_buffer_smart_ptr input_converted_buf(new std::vector<float>(input_neuron_count));
+			additional_buffer_smart_ptr input_converted_buf(new additional_buffer(input_neuron_count));
 
 			additional_buffer_smart_ptr output_buffer = input_converted_buf;
 			std::vector<std::pair<additional_buffer_smart_ptr, additional_buffer_set> > input_buffer_and_additional_buffers_pack;
 			{
-				const const_layer_list& layer_list = *schema;
-				const_layer_list::const_iterator layer_it = layer_list.begin();
-				layer_configuration_specific_list::const_iterator input_config_it = layer_config_list.begin();
-				for(std::vector<const_layer_tester_plain_smart_ptr>::const_iterator it = tester_list.begin(); it != tester_list.end(); ++it)
+				std::vector<additional_buffer_set> additional_buffers_list = buffer_planner->get_additional_buffers(1);
+				std::vector<additional_buffer_set>::iterator additional_buffers_it = additional_buffers_list.begin();
+				for(std::vector<const_layer_tester_plain_smart_ptr>::const_iterator it = fused_tester_list.begin(); it != fused_tester_list.end(); ++it, ++additional_buffers_it)
 				{
-					additional_buffer_set additional_buffers = (*it)->allocate_additional_buffers(
-						1,
-						*layer_it,
-						*input_config_it,
-						*(input_config_it + 1),
-						plain_config);
-					input_buffer_and_additional_buffers_pack.push_back(std::make_pair(output_buffer, additional_buffers));
-					output_buffer = (*it)->get_output_buffer(output_buffer, additional_buffers);
-					++layer_it;
-					++input_config_it;
+					input_buffer_and_additional_buffers_pack.push_back(std::make_pair(output_buffer, *additional_buffers_it));
+					output_buffer = (*it)->get_output_buffer(output_buffer, *additional_buffers_it);
 				}
 			}
 
 			// Convert input
 			{
+				profiling_scope scope(profiling, 0, profiling_result::phase_input_conversion);
 				const int elem_count = static_cast<int>(input_neuron_count);
-				const std::vector<float>::iterator input_converted_buf_it_start = input_converted_buf->begin();
+				const additional_buffer::iterator input_converted_buf_it_start = input_converted_buf->begin();
 				if (type_code == neuron_data_type::type_byte)
 				{
 					const unsigned char * const input_buf_it_start = static_cast<const unsigned char *>(input);
@@ -336,8 +579,9 @@ namespace nnforge
 				layer_configuration_specific_list::const_iterator input_config_it = layer_config_list.begin();
 				std::vector<std::pair<additional_buffer_smart_ptr, additional_buffer_set> >::iterator buffers_it = input_buffer_and_additional_buffers_pack.begin();
 				layer_data_list::const_iterator data_it = net_data->begin();
-				for(std::vector<const_layer_tester_plain_smart_ptr>::const_iterator it = tester_list.begin(); it != tester_list.end(); ++it, ++layer_it, ++input_config_it, ++buffers_it, ++data_it)
+				for(std::vector<const_layer_tester_plain_smart_ptr>::const_iterator it = fused_tester_list.begin(); it != fused_tester_list.end(); ++it, ++layer_it, ++input_config_it, ++buffers_it, ++data_it)
 				{
+					profiling_scope scope(profiling, static_cast<unsigned int>(layer_it - layer_list.begin()), profiling_result::phase_forward, forward_flops_list[layer_it - layer_list.begin()]);
 					(*it)->test(
 						buffers_it->first,
 						buffers_it->second,
@@ -350,33 +594,54 @@ namespace nnforge
 				}
 			}
 
-			std::copy(output_buffer->begin(), output_buffer->end(), res->data.begin());
+			// Shared storage might be larger than the output
+			std::copy(output_buffer->begin(), output_buffer->begin() + res->data.size(), res->data.begin());
 
 			return res;
 		}
 
 		void network_tester_plain::layer_config_list_modified()
 		{
-		}
-
-		void network_tester_plain::update_buffers_configuration_testing(buffer_plain_size_configuration& buffer_configuration) const
-		{
-			for(std::vector<layer_data_smart_ptr>::const_iterator it = net_data->begin(); it != net_data->end(); ++it)
-				for(layer_data::const_iterator it2 = (*it)->begin(); it2 != (*it)->end(); ++it2)
-					buffer_configuration.add_constant_buffer(it2->size() * sizeof(float));
+			buffer_planner = additional_buffer_planner_smart_ptr(new additional_buffer_planner(
+				fused_tester_list,
+				*schema,
+				layer_config_list,
+				plain_config));
 
 			const const_layer_list& layer_list = *schema;
-			const_layer_list::const_iterator layer_it = layer_list.begin();
-			layer_configuration_specific_list::const_iterator input_config_it = layer_config_list.begin();
-			for(std::vector<const_layer_tester_plain_smart_ptr>::const_iterator it = tester_list.begin(); it != tester_list.end(); ++it, ++layer_it, ++input_config_it)
+			forward_flops_list.assign(layer_list.size(), 0.0F);
+			for(unsigned int layer_id = 0; layer_id < layer_list.size(); ++layer_id)
 			{
-				(*it)->update_buffer_configuration(
-					buffer_configuration,
-					*layer_it,
-					*input_config_it,
-					*(input_config_it + 1),
-					plain_config);
+				// The layer fused into the previous one is accounted for there
+				unsigned int target_layer_id = layer_id;
+				if (nnforge_dynamic_pointer_cast<const fused_layer_tester_plain>(fused_tester_list[layer_id]))
+					--target_layer_id;
+				forward_flops_list[target_layer_id] += layer_list[layer_id]->get_forward_flops(layer_config_list[layer_id]);
 			}
 		}
+
+		void network_tester_plain::update_buffers_configuration_testing(
+			buffer_plain_size_configuration& buffer_configuration,
+			const std::vector<network_data_smart_ptr>& data_list) const
+		{
+			for(std::vector<network_data_smart_ptr>::const_iterator data_it = data_list.begin(); data_it != data_list.end(); ++data_it)
+				for(std::vector<layer_data_smart_ptr>::const_iterator it = (*data_it)->begin(); it != (*data_it)->end(); ++it)
+				{
+					nnforge_shared_ptr<const reduced_precision_layer_data> packed_data = nnforge_dynamic_pointer_cast<const reduced_precision_layer_data>(*it);
+					nnforge_shared_ptr<const quantized_layer_data> quantized_data = nnforge_dynamic_pointer_cast<const quantized_layer_data>(*it);
+					nnforge_shared_ptr<const mapped_layer_data> mapped_data = nnforge_dynamic_pointer_cast<const mapped_layer_data>(*it);
+					if (packed_data)
+						buffer_configuration.add_constant_buffer(packed_data->get_packed_size());
+					else if (quantized_data)
+						buffer_configuration.add_constant_buffer(quantized_data->get_packed_size());
+					else if (mapped_data)
+						buffer_configuration.add_constant_buffer(mapped_data->get_mapped_size());
+					else
+						for(layer_data::const_iterator it2 = (*it)->begin(); it2 != (*it)->end(); ++it2)
+							buffer_configuration.add_constant_buffer(it2->size() * sizeof(float));
+				}
+
+			buffer_planner->update_buffer_configuration(buffer_configuration);
+		}
 	}
 }
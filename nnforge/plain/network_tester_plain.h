@@ -20,11 +20,14 @@
 #include "plain_running_configuration.h"
 #include "layer_tester_plain.h"
 #include "buffer_plain_size_configuration.h"
+#include "additional_buffer_planner.h"
 
 namespace nnforge
 {
 	namespace plain
 	{
+		// Buffers of the testers are kept in the storage shared across runs, see additional_buffer_planner,
+		// thus the tester should not run on several threads at once, each thread should create its own tester
 		class network_tester_plain : public network_tester
 		{
 		public:
@@ -38,6 +41,14 @@ namespace nnforge
 			// schema, data and reader are guaranteed to be compatible
 			virtual output_neuron_value_set_smart_ptr actual_run(unsupervised_data_reader& reader);
 
+			// schema, data list and reader are guaranteed to be compatible, entry count of the reader is evenly divisible by sample_count
+			// Each chunk of input data is read and converted once and then fed to all the networks
+			virtual output_neuron_value_set_smart_ptr actual_run(
+				unsupervised_data_reader& reader,
+				const std::vector<network_data_smart_ptr>& data_list,
+				output_neuron_value_set::merge_type_enum merge_type,
+				unsigned int sample_count);
+
 			// The method is called when client calls set_data. The data is guaranteed to be compatible with schema
 			virtual void actual_set_data(network_data_smart_ptr data);
 
@@ -55,15 +66,30 @@ namespace nnforge
 			// The layer_config_list is guaranteed to be compatible with schema
 			virtual void layer_config_list_modified();
 
+			// Mapped weights are used in place by the testers supporting them, get_packed_data copies them for the others
+			virtual bool is_mapped_data_supported() const;
+
 		private:
 			network_tester_plain(const network_tester_plain&);
 			network_tester_plain& operator =(const network_tester_plain&);
 
-			void update_buffers_configuration_testing(buffer_plain_size_configuration& buffer_configuration) const;
+			void update_buffers_configuration_testing(
+				buffer_plain_size_configuration& buffer_configuration,
+				const std::vector<network_data_smart_ptr>& data_list) const;
+
+			// Returns data with weights of the layers, which testers support it, quantized according to quantization data
+			// or kept in plain_config->tester_weight_storage precision, mapped weights are copied for testers not supporting them.
+			// The original data is not modified
+			network_data_smart_ptr get_packed_data(network_data_smart_ptr data) const;
 
 			plain_running_configuration_const_smart_ptr plain_config;
 
 			const_layer_tester_plain_list tester_list;
+			// Same as tester_list with convolution + activation pairs fused into a single kernel
+			const_layer_tester_plain_list fused_tester_list;
+			additional_buffer_planner_smart_ptr buffer_planner;
+			// Forward flops per entry for each layer of fused_tester_list
+			std::vector<float> forward_flops_list;
 			network_data_smart_ptr net_data;
 		};
 	}
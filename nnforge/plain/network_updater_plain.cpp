@@ -17,12 +17,16 @@
 #include "network_updater_plain.h"
 
 #include <stack>
+#include <algorithm>
 
 #include <boost/format.hpp>
+#include <boost/bind.hpp>
 
 #include "layer_tester_plain_factory.h"
 #include "layer_updater_plain_factory.h"
 #include "weight_vector_bound_plain_factory.h"
+#include "numa_util.h"
+#include "sparsity_util.h"
 
 #include "../neural_network_exception.h"
 #include "../nn_types.h"
@@ -30,10 +34,154 @@
 #include "../debug_util.h"
 #include <boost/filesystem.hpp>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace nnforge
 {
 	namespace plain
 	{
+		// Buffers and state of a single updater thread or a group of threads running nested team
+		struct updater_thread_context
+		{
+			// Configuration the layers are run with
+			plain_running_configuration_const_smart_ptr config;
+			profiling_result_smart_ptr profiling;
+			// The context trains networks [first_updater_entry_id, first_updater_entry_id + updater_entry_count)
+			unsigned int first_updater_entry_id;
+			unsigned int updater_entry_count;
+			// Data and learning rates of the networks trained, indexed by updater layer, then by network
+			std::vector<layer_data_list> data_list;
+			std::vector<layer_data_list> learning_rate_vector_list;
+			std::vector<std::pair<additional_buffer_smart_ptr, updater_additional_buffer_set> > input_buffer_and_additional_updater_buffers_pack;
+			additional_buffer_smart_ptr output_buffer;
+			additional_buffer_smart_ptr initial_error_buf;
+			additional_buffer_smart_ptr mini_batch_input_buf;
+			std::vector<testing_result_smart_ptr> res;
+			std::vector<layer_data_list> data_list_mini_batch;
+			unsigned int data_list_mini_batch_size;
+			random_generator gen;
+		};
+
+		// Kernel bodies run by plain_running_configuration::parallel_for
+		struct copy_mini_batch_body
+		{
+			additional_buffer::const_iterator src_it;
+			additional_buffer::iterator dst_it;
+			unsigned int current_mini_batch_size;
+			unsigned int updater_input_neuron_count;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				for(int workload_id = begin; workload_id < end; ++workload_id)
+				{
+					int batch_entry_id = workload_id % current_mini_batch_size;
+					std::copy(
+						src_it + (batch_entry_id * updater_input_neuron_count),
+						src_it + ((batch_entry_id + 1) * updater_input_neuron_count),
+						dst_it + (workload_id * updater_input_neuron_count));
+				}
+			}
+		};
+
+		struct initial_error_body
+		{
+			additional_buffer::iterator initial_error_it;
+			const float * actual_output_buf_it;
+			additional_buffer::const_iterator output_buffer_it;
+			std::vector<testing_result_smart_ptr>::iterator testing_res_it;
+			unsigned int current_mini_batch_size;
+			unsigned int output_neuron_count;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				for(int updater_entry_id = begin; updater_entry_id < end; ++updater_entry_id)
+				{
+					testing_result& tr = **(testing_res_it + updater_entry_id);
+
+					for(unsigned int batch_entry_id = 0; batch_entry_id < current_mini_batch_size; ++batch_entry_id)
+					{
+						const unsigned int updater_batch_entry_id = updater_entry_id * current_mini_batch_size + batch_entry_id;
+						const float * predicted_vals = &(*(output_buffer_it + (updater_batch_entry_id * output_neuron_count)));
+						const float * actual_vals = actual_output_buf_it + (batch_entry_id * output_neuron_count);
+						float * initial_errors = &(*(initial_error_it + (updater_batch_entry_id * output_neuron_count)));
+
+						tr.add_error(actual_vals, predicted_vals, output_neuron_count);
+						tr.ef->calculate_gradient(actual_vals, predicted_vals, initial_errors, output_neuron_count);
+					}
+				}
+			}
+		};
+
+		struct dropout_body
+		{
+			std::vector<float>::const_iterator rnd_it;
+			additional_buffer::iterator in_it;
+			float dropout_rate;
+			unsigned int mask;
+			unsigned int offset_in_random_list;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				for(int i = begin; i < end; ++i)
+				{
+					unsigned int random_elem_id = (i + offset_in_random_list) & mask;
+					if (*(rnd_it + random_elem_id) < dropout_rate)
+						*(in_it + i) = 0.0F;
+				}
+			}
+		};
+
+		// Updates weights of a single layer and applies the bound, run as a task concurrently with backprop of the layers below
+		struct update_weights_task
+		{
+			const_layer_updater_plain_smart_ptr updater;
+			const_weight_vector_bound_plain_smart_ptr bound_updater;
+			const weight_vector_bound * bound;
+			additional_buffer_smart_ptr input_neurons;
+			additional_buffer_smart_ptr output_errors;
+			std::vector<additional_buffer_smart_ptr> * additional_buffers;
+			layer_data_list * data;
+			const layer_data_list * learning_rate;
+			plain_running_configuration_const_smart_ptr config;
+			const_layer_smart_ptr layer_schema;
+			const layer_configuration_specific * input_configuration_specific;
+			const layer_configuration_specific * output_configuration_specific;
+			unsigned int updater_count;
+			unsigned int mini_batch_size;
+			int offset_input_entry_id;
+			float weight_decay;
+			unsigned int output_errors_zero_count;
+
+			void operator()() const
+			{
+				updater->update_weights(
+					input_neurons,
+					output_errors,
+					*additional_buffers,
+					*data,
+					*learning_rate,
+					config,
+					layer_schema,
+					*input_configuration_specific,
+					*output_configuration_specific,
+					updater_count,
+					mini_batch_size,
+					offset_input_entry_id,
+					weight_decay,
+					output_errors_zero_count);
+
+				if (bound_updater)
+					bound_updater->normalize_weights(
+						*bound,
+						*data,
+						config,
+						layer_schema,
+						updater_count);
+			}
+		};
+
 		unsigned int network_updater_plain::max_entry_count_in_single_batch = 1024;
 
 		network_updater_plain::network_updater_plain(
@@ -42,10 +190,36 @@ namespace nnforge
 			const std::map<unsigned int, float>& layer_to_dropout_rate_map,
 			const std::map<unsigned int, weight_vector_bound>& layer_to_weight_vector_bound_map,
 			float weight_decay,
-			plain_running_configuration_const_smart_ptr plain_config)
+			plain_running_configuration_const_smart_ptr plain_config,
+			unsigned int asynchronous_thread_count)
 			: network_updater(schema, ef, layer_to_dropout_rate_map, layer_to_weight_vector_bound_map, weight_decay)
 			, plain_config(plain_config)
+			, asynchronous_thread_count(asynchronous_thread_count)
 		{
+			if (asynchronous_thread_count > 0)
+				asynchronous_thread_config = plain_running_configuration_const_smart_ptr(new plain_running_configuration(
+					1,
+					plain_config->max_memory_usage_gigabytes,
+					plain_config->updater_mini_batch_size,
+					plain_config->tester_weight_storage));
+
+			plain_config->bind_openmp_threads();
+
+			// Nested teams take the threads pinned to their node, their configurations don't pin threads again
+			if (plain_config->numa_aware && plain_config->numa_network_per_node)
+			{
+				const unsigned int node_count = plain_config->get_numa_node_count();
+				std::vector<int> node_thread_count_list(node_count, 0);
+				for(int thread_id = 0; thread_id < plain_config->openmp_thread_count; ++thread_id)
+					++node_thread_count_list[numa_util::get_openmp_thread_node_id(thread_id, plain_config->openmp_thread_count, node_count)];
+				for(unsigned int node_id = 0; node_id < node_count; ++node_id)
+					numa_node_config_list.push_back(plain_running_configuration_const_smart_ptr(new plain_running_configuration(
+						std::max(node_thread_count_list[node_id], 1),
+						plain_config->max_memory_usage_gigabytes,
+						plain_config->updater_mini_batch_size,
+						plain_config->tester_weight_storage)));
+			}
+
 			const const_layer_list& layer_list = *schema;
 
 			testing_layer_count = 0;
@@ -99,15 +273,65 @@ namespace nnforge
 			if (updater_entry_count == 0)
 				return res;
 
-			for(unsigned int i = 0; i < learning_rate_vector_list.size(); ++i)
-				res.push_back(testing_result_smart_ptr(new testing_result(ef)));
+			// Thread contexts: single one running layers with all the threads, one per thread in asynchronous mode,
+			// one per NUMA node running nested team when networks are trained on different nodes,
+			// or one per network when the networks run as separate tasks on the scheduler
+			const bool network_per_node = (asynchronous_thread_count == 0) && !numa_node_config_list.empty() && (numa_node_config_list.size() > 1) && (updater_entry_count > 1);
+			const bool network_per_task = (asynchronous_thread_count == 0) && !network_per_node && (plain_config->scheduler != 0) && (updater_entry_count > 1);
+			unsigned int context_count = 1;
+			if (asynchronous_thread_count > 0)
+				context_count = asynchronous_thread_count;
+			else if (network_per_node)
+				context_count = std::min(static_cast<unsigned int>(numa_node_config_list.size()), updater_entry_count);
+			else if (network_per_task)
+				context_count = updater_entry_count;
+
+			std::vector<updater_thread_context> context_list(context_count);
+			for(unsigned int context_id = 0; context_id < context_count; ++context_id)
+			{
+				updater_thread_context& context = context_list[context_id];
+				if (network_per_node)
+				{
+					context.config = numa_node_config_list[context_id];
+					context.first_updater_entry_id = updater_entry_count * context_id / context_count;
+					context.updater_entry_count = updater_entry_count * (context_id + 1) / context_count - context.first_updater_entry_id;
+				}
+				else if (network_per_task)
+				{
+					context.config = plain_config;
+					context.first_updater_entry_id = context_id;
+					context.updater_entry_count = 1;
+				}
+				else
+				{
+					context.config = (asynchronous_thread_count > 0) ? asynchronous_thread_config : plain_config;
+					context.first_updater_entry_id = 0;
+					context.updater_entry_count = updater_entry_count;
+				}
+				// Profiling result is not thread safe, layers of the updater part are profiled with single context only
+				context.profiling = (context_count == 1) ? profiling : profiling_result_smart_ptr();
+			}
+
+			// Updater layers process mini_batch_size entries for each network in a single call
+			const unsigned int mini_batch_size = plain_config->updater_mini_batch_size;
+			const unsigned int updater_input_neuron_count = layer_config_list[testing_layer_count].get_neuron_count();
 
 			buffer_plain_size_configuration buffers_config;
-			update_buffers_configuration(buffers_config, updater_entry_count);
+			{
+				std::vector<unsigned int> updater_entry_count_list;
+				for(std::vector<updater_thread_context>::const_iterator it = context_list.begin(); it != context_list.end(); ++it)
+					updater_entry_count_list.push_back(it->updater_entry_count * mini_batch_size);
+				update_buffers_configuration(buffers_config, updater_entry_count_list);
+			}
 			buffers_config.add_per_entry_buffer(input_neuron_count * input_neuron_elem_size); // input
 			buffers_config.add_per_entry_buffer(input_neuron_count * sizeof(float)); // converted input
 			buffers_config.add_per_entry_buffer(output_neuron_count * sizeof(float)); // output
-			buffers_config.add_constant_buffer(output_neuron_count * sizeof(float) * updater_entry_count); // initial error
+			for(std::vector<updater_thread_context>::const_iterator it = context_list.begin(); it != context_list.end(); ++it)
+			{
+				buffers_config.add_constant_buffer(output_neuron_count * sizeof(float) * it->updater_entry_count * mini_batch_size); // initial error
+				if (mini_batch_size > 1)
+					buffers_config.add_constant_buffer(updater_input_neuron_count * sizeof(float) * it->updater_entry_count * mini_batch_size); // mini-batch input
+			}
 			for(std::vector<network_data_smart_ptr>::iterator it3 = data_list.begin(); it3 != data_list.end(); ++it3)
 			{
 				for(std::vector<layer_data_smart_ptr>::iterator it = (*it3)->begin(); it != (*it3)->end(); ++it)
@@ -116,6 +340,11 @@ namespace nnforge
 					{
 						buffers_config.add_constant_buffer(it2->size() * sizeof(float)); // data
 						buffers_config.add_constant_buffer(it2->size() * sizeof(float)); // training speed
+						if (network_per_node)
+						{
+							buffers_config.add_constant_buffer(it2->size() * sizeof(float)); // node local data
+							buffers_config.add_constant_buffer(it2->size() * sizeof(float)); // node local training speed
+						}
 					}
 				}
 			}
@@ -134,12 +363,14 @@ namespace nnforge
 
 			std::vector<unsigned char> input_buf(max_entry_count * input_neuron_count * input_neuron_elem_size);
 			std::vector<float> actual_output_buf(max_entry_count * output_neuron_count);
-			additional_buffer_smart_ptr initial_error_buf(new std::vector<float>(updater_entry_count * output_neuron_count));
-			additional_buffer_smart_ptr input_converted_buf(new std::vector<float>(input_neuron_count * max_entry_count));
+			additional_buffer_smart_ptr input_converted_buf = plain_config->allocate_buffer(input_neuron_count * max_entry_count);
+
+			random_generator gen = rnd::get_random_generator();
+			nnforge_uniform_int_distribution<unsigned int> dist(0, static_cast<unsigned int>(random_uniform_list.size() - 1));
+			unsigned int mask = static_cast<unsigned int>(random_uniform_list.size() - 1);
 
 			additional_buffer_smart_ptr output_buffer = input_converted_buf;
 			std::vector<std::pair<additional_buffer_smart_ptr, additional_buffer_set> > input_buffer_and_additional_testing_buffers_pack;
-			std::vector<std::pair<additional_buffer_smart_ptr, updater_additional_buffer_set> > input_buffer_and_additional_updater_buffers_pack;
 			{
 				const const_layer_list& layer_list = *schema;
 				const_layer_list::const_iterator layer_it = layer_list.begin();
@@ -155,49 +386,65 @@ namespace nnforge
 					input_buffer_and_additional_testing_buffers_pack.push_back(std::make_pair(output_buffer, additional_buffers));
 					output_buffer = (*it)->get_output_buffer(output_buffer, additional_buffers);
 				}
-				for(const_layer_updater_plain_list::const_iterator it = updater_list.begin(); it != updater_list.end(); ++it, ++layer_it, ++input_config_it)
-				{
-					updater_additional_buffer_set additional_buffers = (*it)->allocate_additional_buffers(
-						updater_entry_count,
-						*layer_it,
-						*input_config_it,
-						*(input_config_it + 1),
-						plain_config,
-						(it != updater_list.begin()));
-					input_buffer_and_additional_updater_buffers_pack.push_back(std::make_pair(output_buffer, additional_buffers));
-					output_buffer = additional_buffers.output_neurons_buffer;
-				}
 			}
+
+			// Output of the testing part is shared by all the contexts
+			std::vector<unsigned int> seed_list(context_count);
+			for(std::vector<unsigned int>::iterator it = seed_list.begin(); it != seed_list.end(); ++it)
+				*it = static_cast<unsigned int>(gen());
+			if (network_per_node)
 			{
-				additional_buffer_smart_ptr output_errors = initial_error_buf;
-				for(std::vector<std::pair<additional_buffer_smart_ptr, updater_additional_buffer_set> >::reverse_iterator it = input_buffer_and_additional_updater_buffers_pack.rbegin(); it != input_buffer_and_additional_updater_buffers_pack.rend() - 1; ++it)
+				#ifdef _OPENMP
+				if (omp_get_max_active_levels() < 2)
+					omp_set_max_active_levels(2);
+				#endif
+
+				// Buffers and copies of the weights are allocated by the threads pinned to the node they are used on
+				#pragma omp parallel num_threads(context_count)
 				{
-					if (it->second.input_errors_buffer != 0)
-						output_errors = it->second.input_errors_buffer;
-					else
-						it->second.input_errors_buffer = output_errors;
+					int context_id = 0;
+					#ifdef _OPENMP
+					context_id = omp_get_thread_num();
+					#endif
+					const std::vector<unsigned int> original_cpu_list = numa_util::get_current_thread_cpu_list();
+					numa_util::bind_current_thread(plain_config->numa_node_cpu_list[context_id]);
+
+					init_thread_context(
+						context_list[context_id],
+						output_buffer,
+						data_list_reorganized,
+						learning_rate_vector_list_reorganized,
+						true,
+						output_neuron_count,
+						static_cast<unsigned int>(learning_rate_vector_list.size()),
+						seed_list[context_id]);
+
+					numa_util::bind_current_thread(original_cpu_list);
 				}
 			}
+			else
+			{
+				for(unsigned int context_id = 0; context_id < context_count; ++context_id)
+					init_thread_context(
+						context_list[context_id],
+						output_buffer,
+						data_list_reorganized,
+						learning_rate_vector_list_reorganized,
+						false,
+						output_neuron_count,
+						static_cast<unsigned int>(learning_rate_vector_list.size()),
+						seed_list[context_id]);
+			}
 
-			random_generator gen = rnd::get_random_generator();
-			nnforge_uniform_int_distribution<unsigned int> dist(0, static_cast<unsigned int>(random_uniform_list.size() - 1));
-			unsigned int mask = static_cast<unsigned int>(random_uniform_list.size() - 1);
 			bool entries_remained_for_loading = true;
 			while (entries_remained_for_loading)
 			{
-				unsigned int entries_available_for_processing_count = 0;
-				while(entries_available_for_processing_count < max_entry_count)
-				{
-					bool entry_read = reader.read(
-						&(*(input_buf.begin() + (input_neuron_count * entries_available_for_processing_count * input_neuron_elem_size))),
-						&(*(actual_output_buf.begin() + (output_neuron_count * entries_available_for_processing_count))));
-					if (!entry_read)
-					{
-						entries_remained_for_loading = false;
-						break;
-					}
-					entries_available_for_processing_count++;
-				}
+				unsigned int entries_available_for_processing_count = reader.read_batch(
+					max_entry_count,
+					&(*input_buf.begin()),
+					&(*actual_output_buf.begin()));
+				if (entries_available_for_processing_count < max_entry_count)
+					entries_remained_for_loading = false;
 
 				if (entries_available_for_processing_count == 0)
 					break;
@@ -206,8 +453,9 @@ namespace nnforge
 
 				// Convert input
 				{
+					profiling_scope scope(profiling, 0, profiling_result::phase_input_conversion);
 					const int elem_count = static_cast<int>(entries_available_for_processing_count * input_neuron_count);
-					const std::vector<float>::iterator input_converted_buf_it_start = input_converted_buf->begin();
+					const additional_buffer::iterator input_converted_buf_it_start = input_converted_buf->begin();
 					if (type_code == neuron_data_type::type_byte)
 					{
 						const unsigned char * const input_buf_it_start = &(*input_buf.begin());
@@ -238,24 +486,29 @@ namespace nnforge
 						std::map<unsigned int, float>::const_iterator dropout_it = layer_to_dropout_rate_map.find(layer_id);
 						if (dropout_it != layer_to_dropout_rate_map.end())
 						{
+							profiling_scope scope(profiling, layer_id, profiling_result::phase_dropout);
 							unsigned int offset = dist(gen);
 							apply_dropout(
 								buffers_it->first,
 								dropout_it->second,
 								mask,
 								entries_available_for_processing_count * layer_config_list[layer_id].get_neuron_count(),
-								offset);
+								offset,
+								plain_config);
 						}
 
-						(*it)->test(
-							buffers_it->first,
-							buffers_it->second,
-							plain_config,
-							*layer_it,
-							const_layer_data_smart_ptr(),
-							*input_config_it,
-							*(input_config_it + 1),
-							entries_available_for_processing_count);
+						{
+							profiling_scope scope(profiling, layer_id, profiling_result::phase_forward, static_cast<float>(entries_available_for_processing_count) * (*layer_it)->get_forward_flops(*input_config_it));
+							(*it)->test(
+								buffers_it->first,
+								buffers_it->second,
+								plain_config,
+								*layer_it,
+								const_layer_data_smart_ptr(),
+								*input_config_it,
+								*(input_config_it + 1),
+								entries_available_for_processing_count);
+						}
 					}
 				}
 
@@ -264,163 +517,413 @@ namespace nnforge
 					std::map<unsigned int, float>::const_iterator dropout_it = layer_to_dropout_rate_map.find(testing_layer_count);
 					if (dropout_it != layer_to_dropout_rate_map.end())
 					{
+						profiling_scope scope(profiling, testing_layer_count, profiling_result::phase_dropout);
 						unsigned int offset = dist(gen);
 						apply_dropout(
-							input_buffer_and_additional_updater_buffers_pack[0].first,
+							output_buffer,
 							dropout_it->second,
 							mask,
 							entries_available_for_processing_count * layer_config_list[testing_layer_count].get_neuron_count(),
-							offset);
+							offset,
+							plain_config);
 					}
 				}
 
-				for(unsigned int input_entry_id = 0; input_entry_id < entries_available_for_processing_count; ++input_entry_id)
+				const float * const actual_output_values = &(*actual_output_buf.begin());
+				const unsigned int mini_batch_count = (entries_available_for_processing_count + mini_batch_size - 1) / mini_batch_size;
+				if (network_per_node)
 				{
-					std::stack<unsigned int> offset_list;
+					// Each node runs all the mini-batches for its networks, threads are pinned to the node for the time
+					#pragma omp parallel num_threads(context_count)
+					{
+						int context_id = 0;
+						#ifdef _OPENMP
+						context_id = omp_get_thread_num();
+						#endif
+						const std::vector<unsigned int> original_cpu_list = numa_util::get_current_thread_cpu_list();
+						numa_util::bind_current_thread(plain_config->numa_node_cpu_list[context_id]);
+
+						update_mini_batches(
+							context_list[context_id],
+							entries_available_for_processing_count,
+							actual_output_values);
 
-					// Forward updater
+						numa_util::bind_current_thread(original_cpu_list);
+					}
+				}
+				else if (network_per_task)
+				{
+					// There is no barrier between the networks, threads done with their part of the layer of one network
+					// take the tasks of the others. The batch is waited for as its buffers are reused by the next one
+					task_group network_group(plain_config->scheduler);
+					for(std::vector<updater_thread_context>::iterator it = context_list.begin(); it != context_list.end(); ++it)
+						network_group.run(boost::bind(
+							&network_updater_plain::update_mini_batches,
+							this,
+							boost::ref(*it),
+							entries_available_for_processing_count,
+							actual_output_values));
+					network_group.wait();
+				}
+				else
+				{
+					// Mini-batches are distributed among threads dynamically, there is no synchronization on weights between threads
+					#pragma omp parallel for schedule(dynamic) num_threads(context_count) if(context_count > 1)
+					for(int mini_batch_id = 0; mini_batch_id < static_cast<int>(mini_batch_count); ++mini_batch_id)
 					{
-						const_layer_list::const_iterator layer_it = layer_list.begin() + testing_layer_count;
-						layer_configuration_specific_list::const_iterator input_config_it = layer_config_list.begin() + testing_layer_count;
-						std::vector<std::pair<additional_buffer_smart_ptr, updater_additional_buffer_set> >::iterator updater_buffers_it = input_buffer_and_additional_updater_buffers_pack.begin();
-						std::vector<layer_data_list>::const_iterator data_it = data_list_reorganized.begin();
-						unsigned int layer_id = testing_layer_count;
-						for(std::vector<const_layer_updater_plain_smart_ptr>::const_iterator it = updater_list.begin(); it != updater_list.end(); ++it, ++layer_it, ++input_config_it, ++updater_buffers_it, ++data_it, ++layer_id)
-						{
-							if (it != updater_list.begin())
-							{
-								std::map<unsigned int, float>::const_iterator dropout_it = layer_to_dropout_rate_map.find(layer_id);
-								if (dropout_it != layer_to_dropout_rate_map.end())
-								{
-									unsigned int offset = dist(gen);
-									offset_list.push(offset);
-									apply_dropout(
-										updater_buffers_it->first,
-										dropout_it->second,
-										mask,
-										updater_entry_count * layer_config_list[layer_id].get_neuron_count(),
-										offset);
-								}
-							}
+						int context_id = 0;
+						#ifdef _OPENMP
+						context_id = omp_get_thread_num();
+						#endif
+						update_mini_batch(
+							context_list[context_id],
+							static_cast<unsigned int>(mini_batch_id) * mini_batch_size,
+							entries_available_for_processing_count,
+							actual_output_values);
+					}
+				}
+			}
 
-							(*it)->test(
+			if (network_per_node)
+			{
+				// Copy node local weights back
+				for(std::vector<updater_thread_context>::const_iterator context_it = context_list.begin(); context_it != context_list.end(); ++context_it)
+					for(unsigned int layer_id = 0; layer_id < data_list_reorganized.size(); ++layer_id)
+						for(unsigned int i = 0; i < context_it->updater_entry_count; ++i)
+							*data_list_reorganized[layer_id][context_it->first_updater_entry_id + i] = *context_it->data_list[layer_id][i];
+			}
+
+			if (context_count == 1)
+				return context_list[0].res;
+
+			for(unsigned int updater_entry_id = 0; updater_entry_id < learning_rate_vector_list.size(); ++updater_entry_id)
+			{
+				double cumulative_error = 0.0;
+				unsigned int entry_count = 0;
+				for(std::vector<updater_thread_context>::const_iterator context_it = context_list.begin(); context_it != context_list.end(); ++context_it)
+				{
+					if ((updater_entry_id < context_it->first_updater_entry_id) || (updater_entry_id >= context_it->first_updater_entry_id + context_it->updater_entry_count))
+						continue;
+
+					const testing_result& tr = *context_it->res[updater_entry_id - context_it->first_updater_entry_id];
+					if (tr.get_entry_count() > 0)
+					{
+						cumulative_error += static_cast<double>(tr.get_error()) * static_cast<double>(tr.get_entry_count());
+						entry_count += tr.get_entry_count();
+					}
+				}
+
+				testing_result_smart_ptr new_res(new testing_result(ef));
+				new_res->init(cumulative_error, entry_count);
+				res.push_back(new_res);
+			}
+
+			return res;
+		}
+
+		void network_updater_plain::init_thread_context(
+			updater_thread_context& context,
+			additional_buffer_smart_ptr input_buffer,
+			const std::vector<layer_data_list>& data_list,
+			const std::vector<layer_data_list>& learning_rate_vector_list,
+			bool copy_data,
+			unsigned int output_neuron_count,
+			unsigned int learning_rate_vector_count,
+			unsigned int seed) const
+		{
+			const unsigned int updater_batch_entry_count = context.updater_entry_count * plain_config->updater_mini_batch_size;
+			const unsigned int updater_input_neuron_count = layer_config_list[testing_layer_count].get_neuron_count();
+
+			context.data_list.resize(data_list.size());
+			context.learning_rate_vector_list.resize(learning_rate_vector_list.size());
+			for(unsigned int layer_id = 0; layer_id < data_list.size(); ++layer_id)
+			{
+				for(unsigned int i = context.first_updater_entry_id; i < context.first_updater_entry_id + context.updater_entry_count; ++i)
+				{
+					if (copy_data)
+					{
+						context.data_list[layer_id].push_back(layer_data_smart_ptr(new layer_data(*data_list[layer_id][i])));
+						context.learning_rate_vector_list[layer_id].push_back(layer_data_smart_ptr(new layer_data(*learning_rate_vector_list[layer_id][i])));
+					}
+					else
+					{
+						context.data_list[layer_id].push_back(data_list[layer_id][i]);
+						context.learning_rate_vector_list[layer_id].push_back(learning_rate_vector_list[layer_id][i]);
+					}
+				}
+			}
+
+			context.output_buffer = input_buffer;
+			const const_layer_list& layer_list = *schema;
+			const_layer_list::const_iterator layer_it = layer_list.begin() + testing_layer_count;
+			layer_configuration_specific_list::const_iterator input_config_it = layer_config_list.begin() + testing_layer_count;
+			for(const_layer_updater_plain_list::const_iterator it = updater_list.begin(); it != updater_list.end(); ++it, ++layer_it, ++input_config_it)
+			{
+				updater_additional_buffer_set additional_buffers = (*it)->allocate_additional_buffers(
+					updater_batch_entry_count,
+					*layer_it,
+					*input_config_it,
+					*(input_config_it + 1),
+					context.config,
+					(it != updater_list.begin()));
+				context.input_buffer_and_additional_updater_buffers_pack.push_back(std::make_pair(context.output_buffer, additional_buffers));
+				context.output_buffer = additional_buffers.output_neurons_buffer;
+			}
+
+			context.initial_error_buf = context.config->allocate_buffer(updater_batch_entry_count * output_neuron_count);
+			if (plain_config->updater_mini_batch_size > 1)
+				context.mini_batch_input_buf = context.config->allocate_buffer(updater_batch_entry_count * updater_input_neuron_count);
+
+			additional_buffer_smart_ptr output_errors = context.initial_error_buf;
+			for(std::vector<std::pair<additional_buffer_smart_ptr, updater_additional_buffer_set> >::reverse_iterator it = context.input_buffer_and_additional_updater_buffers_pack.rbegin(); it != context.input_buffer_and_additional_updater_buffers_pack.rend() - 1; ++it)
+			{
+				if (it->second.input_errors_buffer != 0)
+					output_errors = it->second.input_errors_buffer;
+				else
+					it->second.input_errors_buffer = output_errors;
+			}
+
+			for(unsigned int i = 0; i < learning_rate_vector_count; ++i)
+				if ((i >= context.first_updater_entry_id) && (i < context.first_updater_entry_id + context.updater_entry_count))
+					context.res.push_back(testing_result_smart_ptr(new testing_result(ef)));
+
+			context.data_list_mini_batch_size = 0;
+			context.gen = rnd::get_random_generator(seed);
+		}
+
+		void network_updater_plain::update_mini_batches(
+			updater_thread_context& context,
+			unsigned int entries_available_for_processing_count,
+			const float * actual_output_values) const
+		{
+			const unsigned int mini_batch_size = plain_config->updater_mini_batch_size;
+			const unsigned int mini_batch_count = (entries_available_for_processing_count + mini_batch_size - 1) / mini_batch_size;
+			for(unsigned int mini_batch_id = 0; mini_batch_id < mini_batch_count; ++mini_batch_id)
+				update_mini_batch(
+					context,
+					mini_batch_id * mini_batch_size,
+					entries_available_for_processing_count,
+					actual_output_values);
+		}
+
+		void network_updater_plain::update_mini_batch(
+			updater_thread_context& context,
+			unsigned int input_entry_id,
+			unsigned int entries_available_for_processing_count,
+			const float * actual_output_values) const
+		{
+			const unsigned int mini_batch_size = plain_config->updater_mini_batch_size;
+			const unsigned int updater_input_neuron_count = layer_config_list[testing_layer_count].get_neuron_count();
+			const unsigned int output_neuron_count = layer_config_list.back().get_neuron_count();
+			const unsigned int updater_entry_count = context.updater_entry_count;
+			const plain_running_configuration_const_smart_ptr& thread_config = context.config;
+			const const_layer_list& layer_list = *schema;
+			const unsigned int mask = static_cast<unsigned int>(random_uniform_list.size() - 1);
+			nnforge_uniform_int_distribution<unsigned int> dist(0, mask);
+
+			std::stack<unsigned int> offset_list;
+
+			const unsigned int current_mini_batch_size = std::min(mini_batch_size, entries_available_for_processing_count - input_entry_id);
+			const unsigned int current_updater_entry_count = updater_entry_count * current_mini_batch_size;
+			if (current_mini_batch_size != context.data_list_mini_batch_size)
+			{
+				context.data_list_mini_batch = get_data_list_for_mini_batch(context.data_list, current_mini_batch_size);
+				context.data_list_mini_batch_size = current_mini_batch_size;
+			}
+
+			// Single entry is shared by all the networks, mini-batch is copied for each network
+			additional_buffer_smart_ptr updater_input_buf = context.input_buffer_and_additional_updater_buffers_pack[0].first;
+			int offset_input_entry_id = static_cast<int>(input_entry_id);
+			if (mini_batch_size > 1)
+			{
+				const additional_buffer::const_iterator src_it = updater_input_buf->begin() + (input_entry_id * updater_input_neuron_count);
+				const additional_buffer::iterator dst_it = context.mini_batch_input_buf->begin();
+				const int total_workload = static_cast<int>(current_updater_entry_count);
+				const copy_mini_batch_body body = { src_it, dst_it, current_mini_batch_size, updater_input_neuron_count };
+				thread_config->parallel_for(total_workload, body);
+
+				updater_input_buf = context.mini_batch_input_buf;
+				offset_input_entry_id = -1;
+			}
+
+			// Forward updater
+			{
+				const_layer_list::const_iterator layer_it = layer_list.begin() + testing_layer_count;
+				layer_configuration_specific_list::const_iterator input_config_it = layer_config_list.begin() + testing_layer_count;
+				std::vector<std::pair<additional_buffer_smart_ptr, updater_additional_buffer_set> >::iterator updater_buffers_it = context.input_buffer_and_additional_updater_buffers_pack.begin();
+				std::vector<layer_data_list>::const_iterator data_it = context.data_list_mini_batch.begin();
+				unsigned int layer_id = testing_layer_count;
+				for(std::vector<const_layer_updater_plain_smart_ptr>::const_iterator it = updater_list.begin(); it != updater_list.end(); ++it, ++layer_it, ++input_config_it, ++updater_buffers_it, ++data_it, ++layer_id)
+				{
+					if (it != updater_list.begin())
+					{
+						std::map<unsigned int, float>::const_iterator dropout_it = layer_to_dropout_rate_map.find(layer_id);
+						if (dropout_it != layer_to_dropout_rate_map.end())
+						{
+							profiling_scope scope(context.profiling, layer_id, profiling_result::phase_dropout);
+							unsigned int offset = dist(context.gen);
+							offset_list.push(offset);
+							apply_dropout(
 								updater_buffers_it->first,
-								updater_buffers_it->second.output_neurons_buffer,
-								updater_buffers_it->second.additional_buffers,
-								plain_config,
-								*layer_it,
-								*data_it,
-								*input_config_it,
-								*(input_config_it + 1),
-								updater_entry_count,
-								(it == updater_list.begin()) ? input_entry_id : -1);
+								dropout_it->second,
+								mask,
+								current_updater_entry_count * layer_config_list[layer_id].get_neuron_count(),
+								offset,
+								thread_config);
 						}
 					}
 
-					// Set initial error and compute temporary MSE
 					{
-						const std::vector<float>::iterator initial_error_it = initial_error_buf->begin();
-						const std::vector<float>::const_iterator actual_output_buf_it = actual_output_buf.begin() + (output_neuron_count * input_entry_id);
-						const std::vector<float>::const_iterator output_buffer_it = output_buffer->begin();
-						const std::vector<testing_result_smart_ptr>::iterator testing_res_it = res.begin();
-						const int elem_count = updater_entry_count;
-						#pragma omp parallel for default(none) schedule(guided) num_threads(plain_config->openmp_thread_count)
-						for(int updater_entry_id = 0; updater_entry_id < elem_count; ++updater_entry_id)
-						{
-							const float * predicted_vals = &(*(output_buffer_it + (updater_entry_id * output_neuron_count)));
-							const float * actual_vals = &(*actual_output_buf_it);
-							float * initial_errors = &(*(initial_error_it + (updater_entry_id * output_neuron_count)));
-							testing_result& tr = **(testing_res_it + updater_entry_id);
+						profiling_scope scope(context.profiling, layer_id, profiling_result::phase_forward, static_cast<float>(current_updater_entry_count) * (*layer_it)->get_forward_flops(*input_config_it));
+						(*it)->test(
+							(it == updater_list.begin()) ? updater_input_buf : updater_buffers_it->first,
+							updater_buffers_it->second.output_neurons_buffer,
+							updater_buffers_it->second.additional_buffers,
+							thread_config,
+							*layer_it,
+							*data_it,
+							*input_config_it,
+							*(input_config_it + 1),
+							current_updater_entry_count,
+							(it == updater_list.begin()) ? offset_input_entry_id : -1);
+					}
+				}
+			}
+
+			// Set initial error and compute temporary MSE
+			{
+				const additional_buffer::iterator initial_error_it = context.initial_error_buf->begin();
+				const float * const actual_output_buf_it = actual_output_values + (output_neuron_count * input_entry_id);
+				const additional_buffer::const_iterator output_buffer_it = context.output_buffer->begin();
+				const std::vector<testing_result_smart_ptr>::iterator testing_res_it = context.res.begin();
+				const int elem_count = updater_entry_count;
+				const initial_error_body body = { initial_error_it, actual_output_buf_it, output_buffer_it, testing_res_it, current_mini_batch_size, output_neuron_count };
+				thread_config->parallel_for(elem_count, body);
+			}
+
+			// Run backward and update weights
+			{
+				const_layer_list::const_reverse_iterator layer_it = layer_list.rbegin();
+				std::vector<std::pair<additional_buffer_smart_ptr, updater_additional_buffer_set> >::reverse_iterator updater_buffers_it = context.input_buffer_and_additional_updater_buffers_pack.rbegin();
+				layer_configuration_specific_list::const_reverse_iterator input_config_it = layer_config_list.rbegin();
+				std::vector<layer_data_list>::reverse_iterator data_it = context.data_list.rbegin();
+				std::vector<layer_data_list>::const_reverse_iterator data_mini_batch_it = context.data_list_mini_batch.rbegin();
+				std::vector<layer_data_list>::const_reverse_iterator learning_rate_it = context.learning_rate_vector_list.rbegin();
+				additional_buffer_smart_ptr output_errors = context.initial_error_buf;
+				unsigned int reverse_layer_id = static_cast<unsigned int>(updater_list.size() + testing_layer_count) - 1;
+				// With the task scheduler weights of the layer are updated as a task while the layers below run backprop,
+				// the layer's inputs and output errors are not touched by them unless the layer runs backprop in-place.
+				// Updates are run inline when profiling, to keep phases separate
+				task_group update_group(thread_config->scheduler);
+				for(std::vector<const_layer_updater_plain_smart_ptr>::const_reverse_iterator it = updater_list.rbegin(); it != updater_list.rend(); ++it, ++layer_it, ++input_config_it, ++updater_buffers_it, ++data_it, ++data_mini_batch_it, ++learning_rate_it, --reverse_layer_id)
+				{
+					// Zeros are counted once for both backprop and update_weights, they see the errors before backprop modifies them
+					const unsigned int output_elem_count = current_updater_entry_count * input_config_it->get_neuron_count();
+					unsigned int output_errors_zero_count = 0;
+					if ((*it)->is_output_errors_zero_count_used() || context.profiling)
+						output_errors_zero_count = sparsity_util::get_zero_count(&(*output_errors->begin()), output_elem_count, thread_config);
 
-							tr.add_error(actual_vals, predicted_vals, output_neuron_count);
-							tr.ef->calculate_gradient(actual_vals, predicted_vals, initial_errors, output_neuron_count);
+					if (context.profiling)
+					{
+						context.profiling->add_sparsity(
+							reverse_layer_id,
+							profiling_result::sparsity_output_errors,
+							output_errors_zero_count,
+							output_elem_count);
+						if (it != updater_list.rend() - 1)
+						{
+							const unsigned int input_elem_count = current_updater_entry_count * (input_config_it + 1)->get_neuron_count();
+							context.profiling->add_sparsity(
+								reverse_layer_id,
+								profiling_result::sparsity_input_neurons,
+								sparsity_util::get_zero_count(&(*updater_buffers_it->first->begin()), input_elem_count, thread_config),
+								input_elem_count);
 						}
 					}
 
-					// Run backward and update weights
+					if (it != updater_list.rend() - 1)
 					{
-						const_layer_list::const_reverse_iterator layer_it = layer_list.rbegin();
-						std::vector<std::pair<additional_buffer_smart_ptr, updater_additional_buffer_set> >::reverse_iterator updater_buffers_it = input_buffer_and_additional_updater_buffers_pack.rbegin();
-						layer_configuration_specific_list::const_reverse_iterator input_config_it = layer_config_list.rbegin();
-						std::vector<layer_data_list>::reverse_iterator data_it = data_list_reorganized.rbegin();
-						std::vector<layer_data_list>::const_reverse_iterator learning_rate_it = learning_rate_vector_list_reorganized.rbegin();
-						additional_buffer_smart_ptr output_errors = initial_error_buf;
-						unsigned int reverse_layer_id = static_cast<unsigned int>(updater_list.size() + testing_layer_count) - 1;
-						for(std::vector<const_layer_updater_plain_smart_ptr>::const_reverse_iterator it = updater_list.rbegin(); it != updater_list.rend(); ++it, ++layer_it, ++input_config_it, ++updater_buffers_it, ++data_it, ++learning_rate_it, --reverse_layer_id)
 						{
-							if (it != updater_list.rend() - 1)
-							{
-								(*it)->backprop(
-									updater_buffers_it->second.input_errors_buffer,
-									updater_buffers_it->first,
-									output_errors,
-									updater_buffers_it->second.output_neurons_buffer,
-									updater_buffers_it->second.additional_buffers,
-									plain_config,
-									*layer_it,
-									*data_it,
-									*(input_config_it + 1),
-									*input_config_it,
-									updater_entry_count);
-								/*
-								{
-									boost::filesystem::path dir = "Debug";
-									dir /= "CPU";
-									boost::filesystem::create_directories(dir);
-									debug_util::dump_list(
-										&(*updater_buffers_it->second.input_errors_buffer->begin()),
-										updater_buffers_it->second.input_errors_buffer->size(),
-										(dir / (boost::format("input_errors_%1%.txt") % reverse_layer_id).str()).string().c_str());
-								}
-								*/
-
-								std::map<unsigned int, float>::const_iterator dropout_it = layer_to_dropout_rate_map.find(reverse_layer_id);
-								if (dropout_it != layer_to_dropout_rate_map.end())
-								{
-									unsigned int offset = offset_list.top();
-									offset_list.pop();
-									apply_dropout(
-										updater_buffers_it->second.input_errors_buffer,
-										dropout_it->second,
-										mask,
-										updater_entry_count * layer_config_list[reverse_layer_id].get_neuron_count(),
-										offset);
-								}
-							}
-
-							(*it)->update_weights(
+							profiling_scope scope(context.profiling, reverse_layer_id, profiling_result::phase_backprop, static_cast<float>(current_updater_entry_count) * (*layer_it)->get_backward_flops(*(input_config_it + 1)));
+							(*it)->backprop(
+								updater_buffers_it->second.input_errors_buffer,
 								updater_buffers_it->first,
 								output_errors,
+								updater_buffers_it->second.output_neurons_buffer,
 								updater_buffers_it->second.additional_buffers,
-								*data_it,
-								*learning_rate_it,
-								plain_config,
+								thread_config,
 								*layer_it,
+								*data_mini_batch_it,
 								*(input_config_it + 1),
 								*input_config_it,
-								updater_entry_count,
-								(it == updater_list.rend() - 1) ? input_entry_id : -1,
-								weight_decay);
-
-							weight_vector_bound_map::iterator bound_it = weight_vector_bounds.find(reverse_layer_id);
-							if (bound_it != weight_vector_bounds.end())
-							{
-								const weight_vector_bound& bound = layer_to_weight_vector_bound_map.find(reverse_layer_id)->second;
-								bound_it->second->normalize_weights(
-									bound,
-									*data_it,
-									plain_config,
-									*layer_it,
-									updater_entry_count);
-							}
-
-							output_errors = updater_buffers_it->second.input_errors_buffer;
+								current_updater_entry_count,
+								output_errors_zero_count);
+						}
+						/*
+						{
+							boost::filesystem::path dir = "Debug";
+							dir /= "CPU";
+							boost::filesystem::create_directories(dir);
+							debug_util::dump_list(
+								&(*updater_buffers_it->second.input_errors_buffer->begin()),
+								updater_buffers_it->second.input_errors_buffer->size(),
+								(dir / (boost::format("input_errors_%1%.txt") % reverse_layer_id).str()).string().c_str());
+						}
+						*/
+
+						std::map<unsigned int, float>::const_iterator dropout_it = layer_to_dropout_rate_map.find(reverse_layer_id);
+						if (dropout_it != layer_to_dropout_rate_map.end())
+						{
+							profiling_scope scope(context.profiling, reverse_layer_id, profiling_result::phase_dropout);
+							unsigned int offset = offset_list.top();
+							offset_list.pop();
+							apply_dropout(
+								updater_buffers_it->second.input_errors_buffer,
+								dropout_it->second,
+								mask,
+								current_updater_entry_count * layer_config_list[reverse_layer_id].get_neuron_count(),
+								offset,
+								thread_config);
 						}
 					}
+
+					update_weights_task task;
+					task.updater = *it;
+					task.bound = 0;
+					weight_vector_bound_map::const_iterator bound_it = weight_vector_bounds.find(reverse_layer_id);
+					if (bound_it != weight_vector_bounds.end())
+					{
+						task.bound_updater = bound_it->second;
+						task.bound = &layer_to_weight_vector_bound_map.find(reverse_layer_id)->second;
+					}
+					task.input_neurons = (it == updater_list.rend() - 1) ? updater_input_buf : updater_buffers_it->first;
+					task.output_errors = output_errors;
+					task.additional_buffers = &updater_buffers_it->second.additional_buffers;
+					task.data = &(*data_it);
+					task.learning_rate = &(*learning_rate_it);
+					task.config = thread_config;
+					task.layer_schema = *layer_it;
+					task.input_configuration_specific = &(*(input_config_it + 1));
+					task.output_configuration_specific = &(*input_config_it);
+					task.updater_count = updater_entry_count;
+					task.mini_batch_size = current_mini_batch_size;
+					task.offset_input_entry_id = (it == updater_list.rend() - 1) ? offset_input_entry_id : -1;
+					task.weight_decay = weight_decay;
+					task.output_errors_zero_count = output_errors_zero_count;
+
+					if (thread_config->scheduler && (!context.profiling) && ((it == updater_list.rend() - 1) || (updater_buffers_it->second.input_errors_buffer != output_errors)))
+						update_group.run(task);
+					else
+					{
+						profiling_scope scope(context.profiling, reverse_layer_id, profiling_result::phase_update_weights, static_cast<float>(current_updater_entry_count) * (*layer_it)->get_weights_update_flops(*(input_config_it + 1)));
+						task();
+					}
+
+					output_errors = updater_buffers_it->second.input_errors_buffer;
 				}
-			}
 
-			return res;
+				update_group.wait();
+			}
 		}
 
 		void network_updater_plain::layer_config_list_modified()
@@ -445,12 +948,32 @@ namespace nnforge
 					(it != updater_list.begin()));
 			}
 
-			return plain_config->get_max_entry_count(buffer_configuration, 0.5F);
+			unsigned int max_entry_count = plain_config->get_max_entry_count(buffer_configuration, 0.5F);
+			// The trainer would silently skip training otherwise
+			if (max_entry_count < plain_config->updater_mini_batch_size)
+				throw neural_network_exception((boost::format("Single mini-batch doesn't fit into memory: plain_updater_mini_batch_size is %1% while at most %2% entries fit into half of %3% GB of plain_max_global_memory_usage, decrease the former or increase the latter")
+					% plain_config->updater_mini_batch_size % max_entry_count % plain_config->max_memory_usage_gigabytes).str());
+
+			return max_entry_count / plain_config->updater_mini_batch_size;
+		}
+
+		std::vector<layer_data_list> network_updater_plain::get_data_list_for_mini_batch(
+			const std::vector<layer_data_list>& data_list,
+			unsigned int mini_batch_size)
+		{
+			std::vector<layer_data_list> res(data_list.size());
+
+			std::vector<layer_data_list>::iterator dst_it = res.begin();
+			for(std::vector<layer_data_list>::const_iterator it = data_list.begin(); it != data_list.end(); ++it, ++dst_it)
+				for(layer_data_list::const_iterator it2 = it->begin(); it2 != it->end(); ++it2)
+					dst_it->insert(dst_it->end(), mini_batch_size, *it2);
+
+			return res;
 		}
 
 		void network_updater_plain::update_buffers_configuration(
 			buffer_plain_size_configuration& buffer_configuration,
-			unsigned int updater_entry_count) const
+			const std::vector<unsigned int>& updater_entry_count_list) const
 		{
 			const const_layer_list& layer_list = *schema;
 			const_layer_list::const_iterator layer_it = layer_list.begin();
@@ -464,16 +987,22 @@ namespace nnforge
 					*(input_config_it + 1),
 					plain_config);
 			}
-			for(const_layer_updater_plain_list::const_iterator it = updater_list.begin(); it != updater_list.end(); ++it, ++layer_it, ++input_config_it)
+			// Each updater thread context has its own buffers
+			for(std::vector<unsigned int>::const_iterator entry_count_it = updater_entry_count_list.begin(); entry_count_it != updater_entry_count_list.end(); ++entry_count_it)
 			{
-				(*it)->update_buffer_configuration(
-					buffer_configuration,
-					*layer_it,
-					*input_config_it,
-					*(input_config_it + 1),
-					plain_config,
-					(it != updater_list.begin()),
-					updater_entry_count);
+				const_layer_list::const_iterator updater_layer_it = layer_it;
+				layer_configuration_specific_list::const_iterator updater_input_config_it = input_config_it;
+				for(const_layer_updater_plain_list::const_iterator it = updater_list.begin(); it != updater_list.end(); ++it, ++updater_layer_it, ++updater_input_config_it)
+				{
+					(*it)->update_buffer_configuration(
+						buffer_configuration,
+						*updater_layer_it,
+						*updater_input_config_it,
+						*(updater_input_config_it + 1),
+						plain_config,
+						(it != updater_list.begin()),
+						*entry_count_it);
+				}
 			}
 		}
 
@@ -482,18 +1011,14 @@ namespace nnforge
 			const float dropout_rate,
 			const unsigned int mask,
 			const unsigned int elem_count,
-			const unsigned int offset_in_random_list) const
+			const unsigned int offset_in_random_list,
+			plain_running_configuration_const_smart_ptr config) const
 		{
 			const std::vector<float>::const_iterator rnd_it = random_uniform_list.begin();
-			const std::vector<float>::iterator in_it = target_buffer->begin();
+			const additional_buffer::iterator in_it = target_buffer->begin();
 
-			#pragma omp parallel for default(none) schedule(guided) num_threads(plain_config->openmp_thread_count)
-			for(int i = 0; i < elem_count; ++i)
-			{
-				unsigned int random_elem_id = (i + offset_in_random_list) & mask;
-				if (*(rnd_it + random_elem_id) < dropout_rate)
-					*(in_it + i) = 0.0F;
-			}
+			const dropout_body body = { rnd_it, in_it, dropout_rate, mask, offset_in_random_list };
+			config->parallel_for(static_cast<int>(elem_count), body);
 		}
 	}
 }
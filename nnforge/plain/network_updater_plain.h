@@ -28,16 +28,25 @@ namespace nnforge
 {
 	namespace plain
 	{
+		struct updater_thread_context;
+
 		class network_updater_plain : public network_updater
 		{
 		public:
+			// asynchronous_thread_count == 0 means layers parallelize inside each mini-batch
+			// Otherwise mini-batches are processed concurrently in asynchronous_thread_count threads (Hogwild),
+			// each thread runs forward, backward and update for its mini-batch against the shared weights without locking
+			// With numa_network_per_node set in plain_config the synchronous multi-network update trains
+			// groups of networks on different NUMA nodes, each group with node local copies of its weights
+			// With the task scheduler in plain_config each network of the synchronous multi-network update runs as a separate task
 			network_updater_plain(
 				network_schema_smart_ptr schema,
 				const_error_function_smart_ptr ef,
 				const std::map<unsigned int, float>& layer_to_dropout_rate_map,
 				const std::map<unsigned int, weight_vector_bound>& layer_to_weight_vector_bound_map,
 				float weight_decay,
-				plain_running_configuration_const_smart_ptr plain_config);
+				plain_running_configuration_const_smart_ptr plain_config,
+				unsigned int asynchronous_thread_count = 0);
 
 			~network_updater_plain();
 
@@ -58,18 +67,55 @@ namespace nnforge
 			network_updater_plain(const network_updater_plain&);
 			network_updater_plain& operator =(const network_updater_plain&);
 
+			// Updater buffers are added for each entry count in the list, there is a separate set of them for each thread context
 			void update_buffers_configuration(
 				buffer_plain_size_configuration& buffer_configuration,
-				unsigned int updater_entry_count) const;
+				const std::vector<unsigned int>& updater_entry_count_list) const;
+
+			// Allocates buffers of the updater layers and sets up data lists of the context,
+			// data_list and learning_rate_vector_list are indexed by updater layer, then by network
+			void init_thread_context(
+				updater_thread_context& context,
+				additional_buffer_smart_ptr input_buffer,
+				const std::vector<layer_data_list>& data_list,
+				const std::vector<layer_data_list>& learning_rate_vector_list,
+				bool copy_data,
+				unsigned int output_neuron_count,
+				unsigned int learning_rate_vector_count,
+				unsigned int seed) const;
+
+			// Runs forward, backward and update of the updater layers for a single mini-batch starting at input_entry_id
+			void update_mini_batch(
+				updater_thread_context& context,
+				unsigned int input_entry_id,
+				unsigned int entries_available_for_processing_count,
+				const float * actual_output_values) const;
+
+			// Runs all the mini-batches of the batch one after another
+			void update_mini_batches(
+				updater_thread_context& context,
+				unsigned int entries_available_for_processing_count,
+				const float * actual_output_values) const;
+
+			// Repeats data of each network mini_batch_size times, so that layers could index it by entry
+			static std::vector<layer_data_list> get_data_list_for_mini_batch(
+				const std::vector<layer_data_list>& data_list,
+				unsigned int mini_batch_size);
 
 			void apply_dropout(
 				additional_buffer_smart_ptr target_buffer,
 				const float dropout_rate,
 				const unsigned int mask,
 				const unsigned int updater_count,
-				const unsigned int offset_in_random_list) const;
+				const unsigned int offset_in_random_list,
+				plain_running_configuration_const_smart_ptr config) const;
 
 			plain_running_configuration_const_smart_ptr plain_config;
+			unsigned int asynchronous_thread_count;
+			// Configuration layers run with in asynchronous mode, single thread
+			plain_running_configuration_const_smart_ptr asynchronous_thread_config;
+			// Configurations of the nested teams running on each NUMA node when numa_network_per_node is set
+			std::vector<plain_running_configuration_const_smart_ptr> numa_node_config_list;
 
 			unsigned int testing_layer_count;
 			const_layer_list::const_iterator start_layer_nonempty_weights_iterator;
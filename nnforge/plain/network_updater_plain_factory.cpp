@@ -46,5 +46,28 @@ namespace nnforge
 				weight_decay,
 				plain_config));
 		}
+
+		network_updater_smart_ptr network_updater_plain_factory::create_asynchronous(
+			network_schema_smart_ptr schema,
+			const_error_function_smart_ptr ef,
+			const std::map<unsigned int, float>& layer_to_dropout_rate_map,
+			const std::map<unsigned int, weight_vector_bound>& layer_to_weight_vector_bound_map,
+			float weight_decay,
+			unsigned int thread_count) const
+		{
+			return network_updater_smart_ptr(new network_updater_plain(
+				schema,
+				ef,
+				layer_to_dropout_rate_map,
+				layer_to_weight_vector_bound_map,
+				weight_decay,
+				plain_config,
+				(thread_count > 0) ? thread_count : get_default_asynchronous_thread_count()));
+		}
+
+		unsigned int network_updater_plain_factory::get_default_asynchronous_thread_count() const
+		{
+			return static_cast<unsigned int>(plain_config->openmp_thread_count);
+		}
 	}
 }
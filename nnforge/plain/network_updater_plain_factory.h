@@ -37,6 +37,16 @@ namespace nnforge
 				const std::map<unsigned int, weight_vector_bound>& layer_to_weight_vector_bound_map,
 				float weight_decay) const;
 
+			virtual network_updater_smart_ptr create_asynchronous(
+				network_schema_smart_ptr schema,
+				const_error_function_smart_ptr ef,
+				const std::map<unsigned int, float>& layer_to_dropout_rate_map,
+				const std::map<unsigned int, weight_vector_bound>& layer_to_weight_vector_bound_map,
+				float weight_decay,
+				unsigned int thread_count) const;
+
+			virtual unsigned int get_default_asynchronous_thread_count() const;
+
 		protected:
 			plain_running_configuration_const_smart_ptr plain_config;
 		};
@@ -0,0 +1,181 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "numa_util.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/algorithm/string.hpp>
+#include <string>
+#include <algorithm>
+
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace nnforge
+{
+	namespace plain
+	{
+		std::vector<std::vector<unsigned int> > numa_util::get_node_cpu_list()
+		{
+			std::vector<std::vector<unsigned int> > res;
+
+			#ifdef __linux__
+			boost::filesystem::path node_folder("/sys/devices/system/node");
+			for(unsigned int node_id = 0; ; ++node_id)
+			{
+				boost::filesystem::path cpu_list_path = node_folder / (std::string("node") + boost::lexical_cast<std::string>(node_id)) / "cpulist";
+				if (!boost::filesystem::exists(cpu_list_path))
+					break;
+
+				std::string cpu_list_str;
+				{
+					boost::filesystem::ifstream in(cpu_list_path);
+					std::getline(in, cpu_list_str);
+				}
+				boost::algorithm::trim(cpu_list_str);
+
+				// The list looks like "0-7,16-23"
+				std::vector<unsigned int> cpu_list;
+				std::vector<std::string> range_list;
+				boost::algorithm::split(range_list, cpu_list_str, boost::algorithm::is_any_of(","), boost::algorithm::token_compress_on);
+				for(std::vector<std::string>::const_iterator it = range_list.begin(); it != range_list.end(); ++it)
+				{
+					if (it->empty())
+						continue;
+					std::string::size_type dash_pos = it->find('-');
+					unsigned int first_cpu = boost::lexical_cast<unsigned int>(it->substr(0, dash_pos));
+					unsigned int last_cpu = (dash_pos == std::string::npos) ? first_cpu : boost::lexical_cast<unsigned int>(it->substr(dash_pos + 1));
+					for(unsigned int cpu_id = first_cpu; cpu_id <= last_cpu; ++cpu_id)
+						cpu_list.push_back(cpu_id);
+				}
+
+				// Memory-only nodes have no CPUs
+				if (!cpu_list.empty())
+					res.push_back(cpu_list);
+			}
+			#endif
+
+			if (res.empty())
+				res.push_back(std::vector<unsigned int>());
+
+			return res;
+		}
+
+		bool numa_util::bind_current_thread(const std::vector<unsigned int>& cpu_list)
+		{
+			#ifdef __linux__
+			if (cpu_list.empty())
+				return false;
+
+			cpu_set_t cpu_set;
+			CPU_ZERO(&cpu_set);
+			for(std::vector<unsigned int>::const_iterator it = cpu_list.begin(); it != cpu_list.end(); ++it)
+				if (*it < CPU_SETSIZE)
+					CPU_SET(*it, &cpu_set);
+
+			return (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) == 0);
+			#else
+			return false;
+			#endif
+		}
+
+		std::vector<unsigned int> numa_util::get_current_thread_cpu_list()
+		{
+			std::vector<unsigned int> res;
+
+			#ifdef __linux__
+			cpu_set_t cpu_set;
+			CPU_ZERO(&cpu_set);
+			if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0)
+			{
+				for(unsigned int cpu_id = 0; cpu_id < CPU_SETSIZE; ++cpu_id)
+					if (CPU_ISSET(cpu_id, &cpu_set))
+						res.push_back(cpu_id);
+			}
+			#endif
+
+			return res;
+		}
+
+		unsigned int numa_util::get_openmp_thread_node_id(
+			unsigned int thread_id,
+			unsigned int thread_count,
+			unsigned int node_count)
+		{
+			return std::min(thread_id * node_count / std::max(thread_count, 1U), node_count - 1);
+		}
+
+		void numa_util::bind_openmp_threads(
+			const std::vector<std::vector<unsigned int> >& node_cpu_list,
+			int thread_count)
+		{
+			const int node_count = static_cast<int>(node_cpu_list.size());
+			if (node_count <= 1)
+				return;
+
+			#pragma omp parallel default(none) shared(node_cpu_list) num_threads(thread_count)
+			{
+				int thread_id = 0;
+				int actual_thread_count = 1;
+				#ifdef _OPENMP
+				thread_id = omp_get_thread_num();
+				actual_thread_count = omp_get_num_threads();
+				#endif
+
+				if (thread_id > 0)
+					bind_current_thread(node_cpu_list[get_openmp_thread_node_id(thread_id, actual_thread_count, node_count)]);
+			}
+		}
+
+		void numa_util::first_touch(
+			float * buffer,
+			size_t elem_count,
+			int thread_count)
+		{
+			#ifdef __linux__
+			const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+			// Buffers smaller than this fit into caches anyway
+			const size_t min_page_count = 64;
+
+			size_t begin_address = reinterpret_cast<size_t>(buffer);
+			size_t end_address = reinterpret_cast<size_t>(buffer + elem_count);
+			size_t page_begin_address = (begin_address + page_size - 1) & ~(page_size - 1);
+			size_t page_end_address = end_address & ~(page_size - 1);
+			if ((page_end_address <= page_begin_address) || ((page_end_address - page_begin_address) / page_size < min_page_count))
+				return;
+
+			// Private anonymous pages read as zeros after being released and get allocated again on first write
+			unsigned char * const pages = reinterpret_cast<unsigned char *>(page_begin_address);
+			madvise(pages, page_end_address - page_begin_address, MADV_DONTNEED);
+
+			const int page_count = static_cast<int>((page_end_address - page_begin_address) / page_size);
+			#pragma omp parallel for default(none) schedule(static) num_threads(thread_count)
+			for(int page_id = 0; page_id < page_count; ++page_id)
+				*(pages + static_cast<size_t>(page_id) * page_size) = 0;
+			#endif
+		}
+	}
+}
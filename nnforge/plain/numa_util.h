@@ -0,0 +1,66 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+namespace nnforge
+{
+	namespace plain
+	{
+		// NUMA topology and placement helpers, Linux only, they are no-ops on other platforms
+		class numa_util
+		{
+		public:
+			// Returns CPU list for each NUMA node
+			// Single node with empty CPU list is returned when topology is unknown
+			static std::vector<std::vector<unsigned int> > get_node_cpu_list();
+
+			// Restricts the calling thread to the CPUs in the list, returns false if it is not supported
+			static bool bind_current_thread(const std::vector<unsigned int>& cpu_list);
+
+			// Returns CPUs the calling thread is allowed to run on, empty list if it is not supported
+			static std::vector<unsigned int> get_current_thread_cpu_list();
+
+			// Returns the node the thread of OpenMP team is pinned to by bind_openmp_threads
+			static unsigned int get_openmp_thread_node_id(
+				unsigned int thread_id,
+				unsigned int thread_count,
+				unsigned int node_count);
+
+			// Pins threads of OpenMP team of thread_count threads, consecutive blocks of threads go to consecutive nodes
+			// The calling thread (thread 0 of the team) is left intact, threads it creates later would inherit its affinity otherwise
+			static void bind_openmp_threads(
+				const std::vector<std::vector<unsigned int> >& node_cpu_list,
+				int thread_count);
+
+			// Releases whole pages of the buffer and touches them again in parallel with static schedule,
+			// so that each page is placed on the node of the thread touching it.
+			// Content of the buffer is undefined after the call, small buffers are left untouched
+			static void first_touch(
+				float * buffer,
+				size_t elem_count,
+				int thread_count);
+
+		private:
+			numa_util();
+			~numa_util();
+		};
+	}
+}
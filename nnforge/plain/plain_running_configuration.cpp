@@ -16,6 +16,10 @@
 
 #include "plain_running_configuration.h"
 
+#include "numa_util.h"
+
+#include <algorithm>
+
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -26,13 +30,40 @@ namespace nnforge
 	{
 		plain_running_configuration::plain_running_configuration(
 			int openmp_thread_count,
-			float max_memory_usage_gigabytes)
+			float max_memory_usage_gigabytes,
+			unsigned int updater_mini_batch_size,
+			weight_storage_type::storage_type tester_weight_storage,
+			bool numa_aware,
+			bool numa_network_per_node,
+			bool use_task_scheduler)
 			: openmp_thread_count(openmp_thread_count)
 			, max_memory_usage_gigabytes(max_memory_usage_gigabytes)
+			, updater_mini_batch_size(updater_mini_batch_size)
+			, tester_weight_storage(tester_weight_storage)
+			, numa_aware(numa_aware)
+			, numa_network_per_node(numa_network_per_node)
 		{
+			if (this->updater_mini_batch_size == 0)
+				this->updater_mini_batch_size = 1;
+
 			#ifndef _OPENMP
 			this->openmp_thread_count = 1;
 			#endif
+
+			if (numa_aware)
+				numa_node_cpu_list = numa_util::get_node_cpu_list();
+			else
+				numa_node_cpu_list.push_back(std::vector<unsigned int>());
+
+			if (use_task_scheduler && (this->openmp_thread_count > 1))
+			{
+				// Scheduler threads are pinned the same way OpenMP threads are, the caller running as thread 0 is not pinned
+				std::vector<std::vector<unsigned int> > thread_cpu_list;
+				if (numa_aware)
+					for(int thread_id = 0; thread_id < this->openmp_thread_count; ++thread_id)
+						thread_cpu_list.push_back(numa_node_cpu_list[numa_util::get_openmp_thread_node_id(thread_id, this->openmp_thread_count, get_numa_node_count())]);
+				scheduler = task_scheduler_smart_ptr(new task_scheduler(this->openmp_thread_count, thread_cpu_list));
+			}
 		}
 
 		unsigned int plain_running_configuration::get_max_entry_count(
@@ -45,6 +76,61 @@ namespace nnforge
 			return static_cast<unsigned int>(entry_count_limited_by_global);
 		}
 
+		unsigned int plain_running_configuration::get_numa_node_count() const
+		{
+			return static_cast<unsigned int>(numa_node_cpu_list.size());
+		}
+
+		void plain_running_configuration::bind_openmp_threads() const
+		{
+			if (numa_aware)
+				numa_util::bind_openmp_threads(numa_node_cpu_list, openmp_thread_count);
+		}
+
+		nnforge_shared_ptr<additional_buffer> plain_running_configuration::allocate_buffer(size_t elem_count) const
+		{
+			nnforge_shared_ptr<additional_buffer> res(new additional_buffer(elem_count));
+
+			if (numa_aware && (elem_count > 0))
+				numa_util::first_touch(&(*res->begin()), elem_count, openmp_thread_count);
+
+			return res;
+		}
+
+		void plain_running_configuration::parallel_for(
+			int item_count,
+			const task_scheduler::range_function& func) const
+		{
+			if (scheduler != 0)
+			{
+				scheduler->parallel_for(item_count, func);
+				return;
+			}
+
+			if (openmp_thread_count <= 1)
+			{
+				if (item_count > 0)
+					func(0, item_count, 0);
+				return;
+			}
+
+			const int total_item_count = item_count;
+			const int chunk_count = std::min(total_item_count, openmp_thread_count * 4);
+			const int thread_count = openmp_thread_count;
+			#pragma omp parallel for default(none) schedule(dynamic) num_threads(thread_count)
+			for(int chunk_id = 0; chunk_id < chunk_count; ++chunk_id)
+			{
+				int thread_id = 0;
+				#ifdef _OPENMP
+				thread_id = omp_get_thread_num();
+				#endif
+				func(
+					static_cast<int>(static_cast<long long>(total_item_count) * chunk_id / chunk_count),
+					static_cast<int>(static_cast<long long>(total_item_count) * (chunk_id + 1) / chunk_count),
+					thread_id);
+			}
+		}
+
 		std::ostream& operator<< (std::ostream& out, const plain_running_configuration& running_configuration)
 		{
 			out << "--- Configuration ---" << std::endl;
@@ -58,6 +144,14 @@ namespace nnforge
 
 			out << "Max memory usage = " << running_configuration.max_memory_usage_gigabytes << " GB" << std::endl;
 			out << "OpenMP thread count = " << running_configuration.openmp_thread_count << std::endl;
+			out << "Updater mini-batch size = " << running_configuration.updater_mini_batch_size << std::endl;
+			out << "Tester weight storage = " << weight_storage_type::get_name(running_configuration.tester_weight_storage) << std::endl;
+			out << "NUMA aware = " << (running_configuration.numa_aware ? "yes" : "no");
+			if (running_configuration.numa_aware)
+				out << ", " << running_configuration.get_numa_node_count() << " nodes";
+			out << std::endl;
+			out << "NUMA network per node = " << (running_configuration.numa_network_per_node ? "yes" : "no") << std::endl;
+			out << "Task scheduler = " << ((running_configuration.scheduler != 0) ? "yes" : "no") << std::endl;
 
 			return out;
 		}
@@ -17,10 +17,14 @@
 #pragma once
 
 #include <ostream>
+#include <vector>
 
 #include "buffer_plain_size_configuration.h"
+#include "aligned_allocator.h"
+#include "task_scheduler.h"
 
 #include "../nn_types.h"
+#include "../weight_storage_type.h"
 
 namespace nnforge
 {
@@ -31,14 +35,45 @@ namespace nnforge
 		public:
 			plain_running_configuration(
 				int openmp_thread_count,
-				float max_memory_usage_gigabytes);
+				float max_memory_usage_gigabytes,
+				unsigned int updater_mini_batch_size = 1,
+				weight_storage_type::storage_type tester_weight_storage = weight_storage_type::type_float,
+				bool numa_aware = false,
+				bool numa_network_per_node = false,
+				bool use_task_scheduler = false);
 
 			unsigned int get_max_entry_count(
 				const buffer_plain_size_configuration& buffers_config,
 				float ratio = 1.0F) const;
 
+			unsigned int get_numa_node_count() const;
+
+			// Pins OpenMP worker threads to NUMA nodes when numa_aware is set, the calling thread keeps its affinity
+			// Updaters and testers call it on creation, the configuration itself doesn't touch the threads
+			void bind_openmp_threads() const;
+
+			// Pages of large buffers are spread across NUMA nodes of the threads when numa_aware is set
+			nnforge_shared_ptr<additional_buffer> allocate_buffer(size_t elem_count) const;
+
+			// Runs func over [0, item_count) in chunks, on the task scheduler when it is enabled and on OpenMP team otherwise
+			void parallel_for(
+				int item_count,
+				const task_scheduler::range_function& func) const;
+
 			float max_memory_usage_gigabytes;
 			int openmp_thread_count;
+			// Count of entries the updater runs through the layers at once, weights are updated once per such mini-batch
+			unsigned int updater_mini_batch_size;
+			// Precision the tester keeps weights in, for the layers supporting it
+			weight_storage_type::storage_type tester_weight_storage;
+			// OpenMP worker threads are pinned to NUMA nodes and large buffers are placed by first touch
+			bool numa_aware;
+			// Multi-network updater trains networks on different NUMA nodes, each node running its share of threads
+			bool numa_network_per_node;
+			// CPU list for each NUMA node, single node with empty list when topology is unknown or NUMA awareness is off
+			std::vector<std::vector<unsigned int> > numa_node_cpu_list;
+			// Persistent work-stealing pool of openmp_thread_count threads, null when the scheduler is off
+			task_scheduler_smart_ptr scheduler;
 
 		private:
 			plain_running_configuration();
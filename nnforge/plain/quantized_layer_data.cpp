@@ -0,0 +1,50 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "quantized_layer_data.h"
+
+#include "../neural_network_exception.h"
+
+#include <boost/format.hpp>
+
+namespace nnforge
+{
+	namespace plain
+	{
+		quantized_layer_data::quantized_layer_data(
+			const layer_data& data,
+			const quantization_data& quantization,
+			unsigned int layer_id)
+			: weights(quantization.weight_list[layer_id])
+			, weight_scale_list(quantization.weight_scale_list[layer_id])
+			, input_scale(quantization.input_range_list[layer_id] / 127.0F)
+		{
+			if (data.size() != 2)
+				throw neural_network_exception("Quantized layer data should be created from weights and biases");
+			if ((weights.size() != data[0].size()) || (weight_scale_list.size() != data[1].size()))
+				throw neural_network_exception((boost::format("Quantized weights of layer %1% don't match network data, run calibrate_quantization again") % layer_id).str());
+
+			resize(2);
+			at(1) = data[1];
+		}
+
+		size_t quantized_layer_data::get_packed_size() const
+		{
+			return weights.size() * sizeof(signed char) + (weight_scale_list.size() + at(1).size()) * sizeof(float);
+		}
+	}
+}
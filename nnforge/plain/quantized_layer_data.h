@@ -0,0 +1,52 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include "../layer_data.h"
+#include "../quantization_data.h"
+#include "../nn_types.h"
+
+#include <vector>
+
+namespace nnforge
+{
+	namespace plain
+	{
+		// Layer data with weights (part 0) quantized to int8 symmetrically with a scale per output feature map
+		// Biases (part 1) are kept in float, weights part is empty
+		// Input of the layer is quantized with input_scale, the result is dequantized with input_scale * weight scale
+		class quantized_layer_data : public layer_data
+		{
+		public:
+			// Int8 weights and scales are taken from quantization data as is, biases are taken from the float data
+			quantized_layer_data(
+				const layer_data& data,
+				const quantization_data& quantization,
+				unsigned int layer_id);
+
+			size_t get_packed_size() const;
+
+			std::vector<signed char> weights;
+			std::vector<float> weight_scale_list;
+			float input_scale;
+		};
+
+		typedef nnforge_shared_ptr<quantized_layer_data> quantized_layer_data_smart_ptr;
+		typedef nnforge_shared_ptr<const quantized_layer_data> const_quantized_layer_data_smart_ptr;
+	}
+}
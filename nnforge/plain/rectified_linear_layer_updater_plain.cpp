@@ -23,6 +23,34 @@ namespace nnforge
 {
 	namespace plain
 	{
+		struct rectified_linear_layer_updater_plain::test_body
+		{
+			additional_buffer::const_iterator in_it;
+			additional_buffer::iterator out_it;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				for(int i = begin; i < end; ++i)
+					*(out_it + i) = std::max<float>(*(in_it + i), 0.0F);
+			}
+		};
+
+		struct rectified_linear_layer_updater_plain::backprop_body
+		{
+			additional_buffer::iterator in_err_it;
+			additional_buffer::const_iterator out_it;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				for(int i = begin; i < end; ++i)
+				{
+					float val = *(out_it + i);
+					if (val == 0.0F)
+						*(in_err_it + i) = 0.0F;
+				}
+			}
+		};
+
 		rectified_linear_layer_updater_plain::rectified_linear_layer_updater_plain()
 		{
 		}
@@ -52,12 +80,11 @@ namespace nnforge
 				throw neural_network_exception("hyperbolic_tangent_layer_updater_plain is not able to run using the same input");
 
 			const int elem_count = static_cast<int>(updater_count * input_configuration_specific.get_neuron_count());
-			const std::vector<float>::const_iterator in_it = input_buffer->begin();
-			const std::vector<float>::iterator out_it = output_buffer->begin();
+			const additional_buffer::const_iterator in_it = input_buffer->begin();
+			const additional_buffer::iterator out_it = output_buffer->begin();
 
-			#pragma omp parallel for default(none) schedule(guided) num_threads(plain_config->openmp_thread_count)
-			for(int i = 0; i < elem_count; ++i)
-				*(out_it + i) = std::max<float>(*(in_it + i), 0.0F);
+			const test_body body = { in_it, out_it };
+			plain_config->parallel_for(elem_count, body);
 		}
 
 		void rectified_linear_layer_updater_plain::backprop(
@@ -71,19 +98,15 @@ namespace nnforge
 			const layer_data_list& data,
 			const layer_configuration_specific& input_configuration_specific,
 			const layer_configuration_specific& output_configuration_specific,
-			unsigned int updater_count) const
+			unsigned int updater_count,
+			unsigned int output_errors_zero_count) const
 		{
 			const int elem_count = static_cast<int>(updater_count * input_configuration_specific.get_neuron_count());
-			const std::vector<float>::iterator in_err_it = input_errors->begin();
-			const std::vector<float>::const_iterator out_it = output_neurons->begin();
+			const additional_buffer::iterator in_err_it = input_errors->begin();
+			const additional_buffer::const_iterator out_it = output_neurons->begin();
 
-			#pragma omp parallel for default(none) schedule(guided) num_threads(plain_config->openmp_thread_count)
-			for(int i = 0; i < elem_count; ++i)
-			{
-				float val = *(out_it + i);
-				if (val == 0.0F)
-					*(in_err_it + i) = 0.0F;
-			}
+			const backprop_body body = { in_err_it, out_it };
+			plain_config->parallel_for(elem_count, body);
 		}
 
 		bool rectified_linear_layer_updater_plain::is_in_place_backprop() const
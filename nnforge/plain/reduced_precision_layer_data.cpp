@@ -0,0 +1,50 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "reduced_precision_layer_data.h"
+
+namespace nnforge
+{
+	namespace plain
+	{
+		reduced_precision_layer_data::reduced_precision_layer_data(
+			const layer_data& data,
+			weight_storage_type::storage_type storage)
+			: storage(storage)
+		{
+			resize(data.size());
+			packed.resize(data.size());
+			for(unsigned int part_id = 0; part_id < data.size(); ++part_id)
+			{
+				const std::vector<float>& src = data[part_id];
+				std::vector<unsigned short>& dst = packed[part_id];
+				dst.resize(src.size());
+				if (!src.empty())
+					weight_storage_type::narrow(storage, &(*src.begin()), &(*dst.begin()), src.size());
+			}
+		}
+
+		size_t reduced_precision_layer_data::get_packed_size() const
+		{
+			size_t res = 0;
+			for(std::vector<std::vector<unsigned short> >::const_iterator it = packed.begin(); it != packed.end(); ++it)
+				res += it->size() * sizeof(unsigned short);
+
+			return res;
+		}
+	}
+}
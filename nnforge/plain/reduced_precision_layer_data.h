@@ -0,0 +1,48 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include "../layer_data.h"
+#include "../weight_storage_type.h"
+#include "../nn_types.h"
+
+#include <vector>
+
+namespace nnforge
+{
+	namespace plain
+	{
+		// Layer data with weights kept in reduced precision, the float vectors are empty
+		// Only layer testers which support it receive such data, they widen weights to float on the fly
+		class reduced_precision_layer_data : public layer_data
+		{
+		public:
+			reduced_precision_layer_data(
+				const layer_data& data,
+				weight_storage_type::storage_type storage);
+
+			size_t get_packed_size() const;
+
+			weight_storage_type::storage_type storage;
+			std::vector<std::vector<unsigned short> > packed;
+		};
+
+		typedef nnforge_shared_ptr<reduced_precision_layer_data> reduced_precision_layer_data_smart_ptr;
+		typedef nnforge_shared_ptr<const reduced_precision_layer_data> const_reduced_precision_layer_data_smart_ptr;
+	}
+}
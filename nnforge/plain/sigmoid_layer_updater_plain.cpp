@@ -24,6 +24,38 @@ namespace nnforge
 {
 	namespace plain
 	{
+		struct sigmoid_layer_updater_plain::test_body
+		{
+			additional_buffer::const_iterator in_it;
+			additional_buffer::iterator out_it;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				for(int i = begin; i < end; ++i)
+				{
+					float inp = *(in_it + i);
+					float res = 1.0F / (expf(-inp) + 1.0F);
+					*(out_it + i) = res;
+				}
+			}
+		};
+
+		struct sigmoid_layer_updater_plain::backprop_body
+		{
+			additional_buffer::iterator in_err_it;
+			additional_buffer::const_iterator out_it;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				for(int i = begin; i < end; ++i)
+				{
+					float out_neuron = *(out_it + i);
+					float der1st = out_neuron * (1.0F - out_neuron);
+					*(in_err_it + i) *= der1st;
+				}
+			}
+		};
+
 		sigmoid_layer_updater_plain::sigmoid_layer_updater_plain()
 		{
 		}
@@ -53,16 +85,11 @@ namespace nnforge
 				throw neural_network_exception("sigmoid_layer_updater_plain is not able to run using the same input");
 
 			const int elem_count = static_cast<int>(updater_count * input_configuration_specific.get_neuron_count());
-			const std::vector<float>::const_iterator in_it = input_buffer->begin();
-			const std::vector<float>::iterator out_it = output_buffer->begin();
+			const additional_buffer::const_iterator in_it = input_buffer->begin();
+			const additional_buffer::iterator out_it = output_buffer->begin();
 
-			#pragma omp parallel for default(none) schedule(guided) num_threads(plain_config->openmp_thread_count)
-			for(int i = 0; i < elem_count; ++i)
-			{
-				float inp = *(in_it + i);
-				float res = 1.0F / (expf(-inp) + 1.0F);
-				*(out_it + i) = res;
-			}
+			const test_body body = { in_it, out_it };
+			plain_config->parallel_for(elem_count, body);
 		}
 
 		void sigmoid_layer_updater_plain::backprop(
@@ -76,19 +103,15 @@ namespace nnforge
 			const layer_data_list& data,
 			const layer_configuration_specific& input_configuration_specific,
 			const layer_configuration_specific& output_configuration_specific,
-			unsigned int updater_count) const
+			unsigned int updater_count,
+			unsigned int output_errors_zero_count) const
 		{
 			const int elem_count = static_cast<int>(updater_count * input_configuration_specific.get_neuron_count());
-			const std::vector<float>::iterator in_err_it = input_errors->begin();
-			const std::vector<float>::const_iterator out_it = output_neurons->begin();
+			const additional_buffer::iterator in_err_it = input_errors->begin();
+			const additional_buffer::const_iterator out_it = output_neurons->begin();
 
-			#pragma omp parallel for default(none) schedule(guided) num_threads(plain_config->openmp_thread_count)
-			for(int i = 0; i < elem_count; ++i)
-			{
-				float out_neuron = *(out_it + i);
-				float der1st = out_neuron * (1.0F - out_neuron);
-				*(in_err_it + i) *= der1st;
-			}
+			const backprop_body body = { in_err_it, out_it };
+			plain_config->parallel_for(elem_count, body);
 		}
 
 		bool sigmoid_layer_updater_plain::is_in_place_backprop() const
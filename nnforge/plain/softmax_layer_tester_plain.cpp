@@ -53,7 +53,7 @@ namespace nnforge
 			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
 			const unsigned int feature_map_count = static_cast<unsigned int>(input_configuration_specific.feature_map_count);
 
-			const std::vector<float>::iterator input_buffer_it = input_buffer->begin();
+			const additional_buffer::iterator input_buffer_it = input_buffer->begin();
 
 			const int total_workload = entry_count * input_neuron_count_per_feature_map;
 			const int openmp_thread_count = plain_config->openmp_thread_count;
@@ -65,14 +65,14 @@ namespace nnforge
 				thread_id = omp_get_thread_num();
 				#endif
 
-				std::vector<float>& local_additional_buffer = *(additional_buffers[thread_id]);
+				additional_buffer& local_additional_buffer = *(additional_buffers[thread_id]);
 
 				#pragma omp for schedule(guided)
 				for(int workload_id = 0; workload_id < total_workload; ++workload_id)
 				{
 					int entry_id = workload_id / input_neuron_count_per_feature_map;
 					int neuron_id = workload_id - (entry_id * input_neuron_count_per_feature_map);
-					const std::vector<float>::iterator in_it = input_buffer_it + (entry_id * input_neuron_count) + neuron_id;
+					const additional_buffer::iterator in_it = input_buffer_it + (entry_id * input_neuron_count) + neuron_id;
 
 					float sum = 0.0F;
 					for(unsigned int feature_map_id = 0; feature_map_id < feature_map_count; ++feature_map_id)
@@ -27,6 +27,77 @@ namespace nnforge
 {
 	namespace plain
 	{
+		struct softmax_layer_updater_plain::test_body
+		{
+			unsigned int input_neuron_count;
+			unsigned int input_neuron_count_per_feature_map;
+			unsigned int feature_map_count;
+			additional_buffer::const_iterator input_buffer_it;
+			additional_buffer::iterator output_buffer_it;
+			std::vector<additional_buffer_smart_ptr>::const_iterator additional_buffers_it;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				additional_buffer& local_additional_buffer = **(additional_buffers_it + thread_id);
+
+				for(int workload_id = begin; workload_id < end; ++workload_id)
+				{
+					int entry_id = workload_id / input_neuron_count_per_feature_map;
+					int neuron_id = workload_id - (entry_id * input_neuron_count_per_feature_map);
+
+					const additional_buffer::const_iterator in_it = input_buffer_it + (entry_id * input_neuron_count) + neuron_id;
+					const additional_buffer::iterator out_it = output_buffer_it + (entry_id * input_neuron_count) + neuron_id;
+
+					float sum = 0.0F;
+					for(unsigned int feature_map_id = 0; feature_map_id < feature_map_count; ++feature_map_id)
+					{
+						float val = expf(*(in_it + (feature_map_id * input_neuron_count_per_feature_map)));
+						sum += val;
+						local_additional_buffer[feature_map_id] = val;
+					}
+					float mult = 1.0F / sum;
+					for(unsigned int feature_map_id = 0; feature_map_id < feature_map_count; ++feature_map_id)
+						*(out_it + (feature_map_id * input_neuron_count_per_feature_map)) = local_additional_buffer[feature_map_id] * mult;
+				} // for(int workload_id
+			}
+		};
+
+		struct softmax_layer_updater_plain::backprop_body
+		{
+			unsigned int input_neuron_count;
+			unsigned int input_neuron_count_per_feature_map;
+			unsigned int feature_map_count;
+			additional_buffer::iterator input_errors_it;
+			additional_buffer::const_iterator output_errors_it;
+			additional_buffer::const_iterator output_neurons_it;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				for(int workload_id = begin; workload_id < end; ++workload_id)
+				{
+					int entry_id = workload_id / input_neuron_count_per_feature_map;
+					int neuron_id = workload_id - (entry_id * input_neuron_count_per_feature_map);
+
+					const additional_buffer::iterator in_errors_it = input_errors_it + (entry_id * input_neuron_count) + neuron_id;
+					const additional_buffer::const_iterator out_errors_it = output_errors_it + (entry_id * input_neuron_count) + neuron_id;
+					const additional_buffer::const_iterator out_neurons_it = output_neurons_it + (entry_id * input_neuron_count) + neuron_id;
+
+					float sum = 0.0F;
+					for(unsigned int feature_map_id = 0; feature_map_id < feature_map_count; ++feature_map_id)
+					{
+						unsigned int offset = feature_map_id * input_neuron_count_per_feature_map;
+						sum += (*(out_errors_it + offset)) * (*(out_neurons_it + offset));
+					}
+
+					for(unsigned int feature_map_id = 0; feature_map_id < feature_map_count; ++feature_map_id)
+					{
+						unsigned int offset = feature_map_id * input_neuron_count_per_feature_map;
+						*(in_errors_it + offset) = (*(out_neurons_it + offset)) * (*(out_errors_it + offset) - sum);
+					}
+				} // for(int workload_id
+			}
+		};
+
 		softmax_layer_updater_plain::softmax_layer_updater_plain()
 		{
 		}
@@ -59,42 +130,13 @@ namespace nnforge
 			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
 			const unsigned int feature_map_count = static_cast<unsigned int>(input_configuration_specific.feature_map_count);
 
-			const std::vector<float>::const_iterator input_buffer_it = input_buffer->begin();
-			const std::vector<float>::iterator output_buffer_it = output_buffer->begin();
+			const additional_buffer::const_iterator input_buffer_it = input_buffer->begin();
+			const additional_buffer::iterator output_buffer_it = output_buffer->begin();
 
 			const int total_workload = updater_count * input_neuron_count_per_feature_map;
-			const int openmp_thread_count = plain_config->openmp_thread_count;
 			
-			#pragma omp parallel default(none) shared(additional_buffers) num_threads(openmp_thread_count)
-			{
-				int thread_id = 0;
-				#ifdef _OPENMP
-				thread_id = omp_get_thread_num();
-				#endif
-
-				std::vector<float>& local_additional_buffer = *(additional_buffers[thread_id]);
-
-				#pragma omp for schedule(guided)
-				for(int workload_id = 0; workload_id < total_workload; ++workload_id)
-				{
-					int entry_id = workload_id / input_neuron_count_per_feature_map;
-					int neuron_id = workload_id - (entry_id * input_neuron_count_per_feature_map);
-
-					const std::vector<float>::const_iterator in_it = input_buffer_it + (entry_id * input_neuron_count) + neuron_id;
-					const std::vector<float>::iterator out_it = output_buffer_it + (entry_id * input_neuron_count) + neuron_id;
-
-					float sum = 0.0F;
-					for(unsigned int feature_map_id = 0; feature_map_id < feature_map_count; ++feature_map_id)
-					{
-						float val = expf(*(in_it + (feature_map_id * input_neuron_count_per_feature_map)));
-						sum += val;
-						local_additional_buffer[feature_map_id] = val;
-					}
-					float mult = 1.0F / sum;
-					for(unsigned int feature_map_id = 0; feature_map_id < feature_map_count; ++feature_map_id)
-						*(out_it + (feature_map_id * input_neuron_count_per_feature_map)) = local_additional_buffer[feature_map_id] * mult;
-				} // for(int workload_id
-			} // #pragma parallel
+			const test_body body = { input_neuron_count, input_neuron_count_per_feature_map, feature_map_count, input_buffer_it, output_buffer_it, additional_buffers.begin() };
+			plain_config->parallel_for(total_workload, body);
 		}
 
 		void softmax_layer_updater_plain::backprop(
@@ -108,50 +150,21 @@ namespace nnforge
 			const layer_data_list& data,
 			const layer_configuration_specific& input_configuration_specific,
 			const layer_configuration_specific& output_configuration_specific,
-			unsigned int updater_count) const
+			unsigned int updater_count,
+			unsigned int output_errors_zero_count) const
 		{
 			const unsigned int input_neuron_count = input_configuration_specific.get_neuron_count();
 			const unsigned int input_neuron_count_per_feature_map = input_configuration_specific.get_neuron_count_per_feature_map();
 			const unsigned int feature_map_count = static_cast<unsigned int>(input_configuration_specific.feature_map_count);
 
-			const std::vector<float>::iterator input_errors_it = input_errors->begin();
-			const std::vector<float>::const_iterator output_errors_it = output_errors->begin();
-			const std::vector<float>::const_iterator output_neurons_it = output_neurons->begin();
+			const additional_buffer::iterator input_errors_it = input_errors->begin();
+			const additional_buffer::const_iterator output_errors_it = output_errors->begin();
+			const additional_buffer::const_iterator output_neurons_it = output_neurons->begin();
 
 			const int total_workload = updater_count * input_neuron_count_per_feature_map;
-			const int openmp_thread_count = plain_config->openmp_thread_count;
 			
-			#pragma omp parallel default(none) shared(additional_buffers) num_threads(openmp_thread_count)
-			{
-				int thread_id = 0;
-				#ifdef _OPENMP
-				thread_id = omp_get_thread_num();
-				#endif
-
-				#pragma omp for schedule(guided)
-				for(int workload_id = 0; workload_id < total_workload; ++workload_id)
-				{
-					int entry_id = workload_id / input_neuron_count_per_feature_map;
-					int neuron_id = workload_id - (entry_id * input_neuron_count_per_feature_map);
-
-					const std::vector<float>::iterator in_errors_it = input_errors_it + (entry_id * input_neuron_count) + neuron_id;
-					const std::vector<float>::const_iterator out_errors_it = output_errors_it + (entry_id * input_neuron_count) + neuron_id;
-					const std::vector<float>::const_iterator out_neurons_it = output_neurons_it + (entry_id * input_neuron_count) + neuron_id;
-
-					float sum = 0.0F;
-					for(unsigned int feature_map_id = 0; feature_map_id < feature_map_count; ++feature_map_id)
-					{
-						unsigned int offset = feature_map_id * input_neuron_count_per_feature_map;
-						sum += (*(out_errors_it + offset)) * (*(out_neurons_it + offset));
-					}
-
-					for(unsigned int feature_map_id = 0; feature_map_id < feature_map_count; ++feature_map_id)
-					{
-						unsigned int offset = feature_map_id * input_neuron_count_per_feature_map;
-						*(in_errors_it + offset) = (*(out_neurons_it + offset)) * (*(out_errors_it + offset) - sum);
-					}
-				} // for(int workload_id
-			} // #pragma parallel
+			const backprop_body body = { input_neuron_count, input_neuron_count_per_feature_map, feature_map_count, input_errors_it, output_errors_it, output_neurons_it };
+			plain_config->parallel_for(total_workload, body);
 		}
 
 		bool softmax_layer_updater_plain::is_in_place_backprop() const
@@ -0,0 +1,56 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "sparsity_util.h"
+
+#include <vector>
+#include <numeric>
+
+namespace nnforge
+{
+	namespace plain
+	{
+		struct sparsity_util::zero_count_body
+		{
+			const float * buffer;
+			std::vector<unsigned int>::iterator zero_count_it;
+
+			void operator()(int begin, int end, int thread_id) const
+			{
+				unsigned int zero_count = 0;
+				for(const float * it = buffer + begin; it != buffer + end; ++it)
+					if (*it == 0.0F)
+						++zero_count;
+
+				*(zero_count_it + thread_id) += zero_count;
+			}
+		};
+
+		unsigned int sparsity_util::get_zero_count(
+			const float * buffer,
+			unsigned int elem_count,
+			plain_running_configuration_const_smart_ptr plain_config)
+		{
+			// Each thread accumulates its own count, they are summed at the end
+			std::vector<unsigned int> zero_count_list(plain_config->openmp_thread_count, 0);
+
+			const zero_count_body body = { buffer, zero_count_list.begin() };
+			plain_config->parallel_for(static_cast<int>(elem_count), body);
+
+			return std::accumulate(zero_count_list.begin(), zero_count_list.end(), 0U);
+		}
+	}
+}
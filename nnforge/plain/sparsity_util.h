@@ -0,0 +1,42 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include "plain_running_configuration.h"
+
+namespace nnforge
+{
+	namespace plain
+	{
+		// Helpers for the kernels skipping zero values of the sparse activations and errors
+		class sparsity_util
+		{
+		public:
+			// Returns count of exact zeros in [buffer, buffer + elem_count), the count is run in parallel
+			static unsigned int get_zero_count(
+				const float * buffer,
+				unsigned int elem_count,
+				plain_running_configuration_const_smart_ptr plain_config);
+
+		private:
+			sparsity_util();
+			~sparsity_util();
+
+			struct zero_count_body;
+		};
+	}
+}
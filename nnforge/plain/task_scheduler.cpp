@@ -0,0 +1,325 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "task_scheduler.h"
+
+#include "numa_util.h"
+#include "../neural_network_exception.h"
+
+#include <deque>
+#include <algorithm>
+#include <stdexcept>
+#include <boost/thread.hpp>
+#include <boost/atomic.hpp>
+#include <boost/format.hpp>
+
+namespace nnforge
+{
+	namespace plain
+	{
+		struct task_queue
+		{
+			boost::mutex m;
+			std::deque<task_scheduler::task_item> tasks;
+		};
+
+		struct task_scheduler_thread_struct
+		{
+			task_scheduler_thread_struct()
+				: queued_task_count(0)
+				, stop(false)
+			{
+			}
+
+			std::vector<nnforge_shared_ptr<task_queue> > queues;
+			boost::atomic<int> queued_task_count;
+			boost::mutex m;
+			boost::condition_variable task_cv;
+			bool stop;
+			boost::thread_specific_ptr<unsigned int> thread_id;
+			boost::thread_group threads;
+		};
+
+		struct task_group_state
+		{
+			task_group_state()
+				: pending_task_count(0)
+			{
+			}
+
+			boost::atomic<int> pending_task_count;
+			boost::mutex m;
+			std::string error;
+		};
+
+		const int task_scheduler::chunk_count_per_thread = 4;
+		const int task_scheduler::spin_count = 256;
+
+		task_scheduler::task_scheduler(
+			unsigned int thread_count,
+			const std::vector<std::vector<unsigned int> >& thread_cpu_list)
+			: thread_count(thread_count)
+			, impl(0)
+		{
+			if (thread_count == 0)
+				throw neural_network_exception("Thread count for task scheduler should be positive");
+
+			task_scheduler_thread_struct * tst = new task_scheduler_thread_struct();
+			impl = tst;
+			for(unsigned int thread_id = 0; thread_id < thread_count; ++thread_id)
+				tst->queues.push_back(nnforge_shared_ptr<task_queue>(new task_queue()));
+			// Thread 0 is the calling one
+			for(unsigned int thread_id = 1; thread_id < thread_count; ++thread_id)
+				tst->threads.add_thread(new boost::thread(
+					&task_scheduler::run_worker,
+					this,
+					thread_id,
+					(thread_id < thread_cpu_list.size()) ? thread_cpu_list[thread_id] : std::vector<unsigned int>()));
+		}
+
+		task_scheduler::~task_scheduler()
+		{
+			task_scheduler_thread_struct * tst = static_cast<task_scheduler_thread_struct *>(impl);
+			{
+				boost::lock_guard<boost::mutex> lock(tst->m);
+				tst->stop = true;
+			}
+			tst->task_cv.notify_all();
+			tst->threads.join_all();
+
+			delete tst;
+		}
+
+		unsigned int task_scheduler::get_thread_count() const
+		{
+			return thread_count;
+		}
+
+		unsigned int task_scheduler::get_current_thread_id() const
+		{
+			task_scheduler_thread_struct * tst = static_cast<task_scheduler_thread_struct *>(impl);
+			unsigned int * thread_id = tst->thread_id.get();
+			return (thread_id != 0) ? *thread_id : 0;
+		}
+
+		void task_scheduler::parallel_for(
+			int item_count,
+			const range_function& func)
+		{
+			const int chunk_count = std::min(item_count, static_cast<int>(thread_count) * chunk_count_per_thread);
+			if (chunk_count <= 1)
+			{
+				if (item_count > 0)
+					func(0, item_count, get_current_thread_id());
+				return;
+			}
+
+			task_group_state group;
+			std::vector<task_item> task_list(chunk_count);
+			for(int chunk_id = 0; chunk_id < chunk_count; ++chunk_id)
+			{
+				task_item& task = task_list[chunk_id];
+				task.range_func = &func;
+				task.begin = static_cast<int>(static_cast<long long>(item_count) * chunk_id / chunk_count);
+				task.end = static_cast<int>(static_cast<long long>(item_count) * (chunk_id + 1) / chunk_count);
+				task.group = &group;
+			}
+			group.pending_task_count = chunk_count;
+			push(task_list);
+
+			wait(&group);
+
+			if (!group.error.empty())
+				throw neural_network_exception(group.error);
+		}
+
+		void task_scheduler::push(const std::vector<task_item>& task_list)
+		{
+			task_scheduler_thread_struct * tst = static_cast<task_scheduler_thread_struct *>(impl);
+
+			{
+				task_queue& queue = *tst->queues[get_current_thread_id()];
+				boost::lock_guard<boost::mutex> lock(queue.m);
+				queue.tasks.insert(queue.tasks.end(), task_list.begin(), task_list.end());
+			}
+			tst->queued_task_count += static_cast<int>(task_list.size());
+
+			// Taking the mutex guarantees the worker about to sleep either sees the new tasks or gets notified
+			{
+				boost::lock_guard<boost::mutex> lock(tst->m);
+			}
+			tst->task_cv.notify_all();
+		}
+
+		bool task_scheduler::try_run_task(unsigned int thread_id)
+		{
+			task_scheduler_thread_struct * tst = static_cast<task_scheduler_thread_struct *>(impl);
+
+			task_item task;
+			bool found = false;
+			{
+				task_queue& queue = *tst->queues[thread_id];
+				boost::lock_guard<boost::mutex> lock(queue.m);
+				if (!queue.tasks.empty())
+				{
+					task = queue.tasks.back();
+					queue.tasks.pop_back();
+					found = true;
+				}
+			}
+			for(unsigned int i = 1; (i < thread_count) && !found; ++i)
+			{
+				task_queue& queue = *tst->queues[(thread_id + i) % thread_count];
+				boost::lock_guard<boost::mutex> lock(queue.m);
+				if (!queue.tasks.empty())
+				{
+					task = queue.tasks.front();
+					queue.tasks.pop_front();
+					found = true;
+				}
+			}
+
+			if (!found)
+				return false;
+
+			--tst->queued_task_count;
+			run_task(task, thread_id);
+
+			return true;
+		}
+
+		void task_scheduler::run_task(
+			const task_item& task,
+			unsigned int thread_id)
+		{
+			task_group_state * group = static_cast<task_group_state *>(task.group);
+			try
+			{
+				if (task.range_func != 0)
+					(*task.range_func)(task.begin, task.end, static_cast<int>(thread_id));
+				else
+					task.func();
+			}
+			catch (std::exception& e)
+			{
+				boost::lock_guard<boost::mutex> lock(group->m);
+				if (group->error.empty())
+					group->error = e.what();
+			}
+			--group->pending_task_count;
+		}
+
+		void task_scheduler::wait(void * group)
+		{
+			task_group_state * state = static_cast<task_group_state *>(group);
+			const unsigned int thread_id = get_current_thread_id();
+			// The waiting thread runs tasks of any group, including the ones queued by the tasks of its own group
+			while (state->pending_task_count > 0)
+			{
+				if (!try_run_task(thread_id))
+					boost::this_thread::yield();
+			}
+		}
+
+		void task_scheduler::run_worker(
+			unsigned int thread_id,
+			std::vector<unsigned int> cpu_list)
+		{
+			task_scheduler_thread_struct * tst = static_cast<task_scheduler_thread_struct *>(impl);
+
+			tst->thread_id.reset(new unsigned int(thread_id));
+			if (!cpu_list.empty())
+				numa_util::bind_current_thread(cpu_list);
+
+			while (true)
+			{
+				if (try_run_task(thread_id))
+					continue;
+
+				// Kernels are usually queued back to back, spin for a while before going to sleep
+				bool tasks_available = false;
+				for(int i = 0; (i < spin_count) && !tasks_available; ++i)
+				{
+					if (tst->queued_task_count > 0)
+						tasks_available = true;
+					else
+						boost::this_thread::yield();
+				}
+				if (tasks_available)
+					continue;
+
+				boost::unique_lock<boost::mutex> lock(tst->m);
+				while ((!tst->stop) && (tst->queued_task_count == 0))
+					tst->task_cv.wait(lock);
+				if (tst->stop)
+					return;
+			}
+		}
+
+		task_group::task_group(task_scheduler_smart_ptr scheduler)
+			: scheduler(((scheduler != 0) && (scheduler->get_thread_count() > 1)) ? scheduler : task_scheduler_smart_ptr())
+			, impl(0)
+		{
+			if (this->scheduler != 0)
+				impl = new task_group_state();
+		}
+
+		task_group::~task_group()
+		{
+			if (impl != 0)
+			{
+				scheduler->wait(impl);
+				delete static_cast<task_group_state *>(impl);
+			}
+		}
+
+		void task_group::run(const task_scheduler::task_function& func)
+		{
+			if (scheduler == 0)
+			{
+				func();
+				return;
+			}
+
+			task_group_state * state = static_cast<task_group_state *>(impl);
+			std::vector<task_scheduler::task_item> task_list(1);
+			task_list[0].func = func;
+			task_list[0].range_func = 0;
+			task_list[0].begin = 0;
+			task_list[0].end = 0;
+			task_list[0].group = state;
+			++state->pending_task_count;
+			scheduler->push(task_list);
+		}
+
+		void task_group::wait()
+		{
+			if (scheduler == 0)
+				return;
+
+			task_group_state * state = static_cast<task_group_state *>(impl);
+			scheduler->wait(state);
+
+			std::string error;
+			{
+				boost::lock_guard<boost::mutex> lock(state->m);
+				error.swap(state->error);
+			}
+			if (!error.empty())
+				throw neural_network_exception((boost::format("Task failed: %1%") % error).str());
+		}
+	}
+}
@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include "../nn_types.h"
+
+#include <vector>
+#include <string>
+#include <boost/function.hpp>
+
+namespace nnforge
+{
+	namespace plain
+	{
+		// Persistent pool of threads, each of them having its own task queue.
+		// The thread queueing tasks runs them from the back of its queue, idle threads steal tasks from the front of the queues of others.
+		// The thread calling the scheduler from outside takes part in running tasks as thread 0,
+		// it is expected to be the only external thread using the scheduler at a time
+		class task_scheduler
+		{
+		public:
+			// The function is called for items [begin, end) with the ID of the thread running it, ID is in [0, thread_count)
+			typedef boost::function<void (int, int, int)> range_function;
+			typedef boost::function<void ()> task_function;
+
+			// thread_cpu_list is either empty or contains the CPUs each thread is pinned to, empty list for the thread means no pinning
+			task_scheduler(
+				unsigned int thread_count,
+				const std::vector<std::vector<unsigned int> >& thread_cpu_list = std::vector<std::vector<unsigned int> >());
+
+			~task_scheduler();
+
+			unsigned int get_thread_count() const;
+
+			// Splits items into chunks run as separate tasks, returns when all of them are done
+			void parallel_for(
+				int item_count,
+				const range_function& func);
+
+		private:
+			friend class task_group;
+			friend struct task_queue;
+
+			struct task_item
+			{
+				task_function func;
+				const range_function * range_func;
+				int begin;
+				int end;
+				void * group;
+			};
+
+			void push(const std::vector<task_item>& task_list);
+
+			bool try_run_task(unsigned int thread_id);
+
+			void run_task(
+				const task_item& task,
+				unsigned int thread_id);
+
+			void wait(void * group);
+
+			unsigned int get_current_thread_id() const;
+
+			void run_worker(
+				unsigned int thread_id,
+				std::vector<unsigned int> cpu_list);
+
+		private:
+			unsigned int thread_count;
+
+			void * impl;
+
+			static const int chunk_count_per_thread;
+			static const int spin_count;
+
+		private:
+			task_scheduler(const task_scheduler&);
+			task_scheduler& operator =(const task_scheduler&);
+		};
+
+		typedef nnforge_shared_ptr<task_scheduler> task_scheduler_smart_ptr;
+
+		// Tasks of the group may run concurrently with each other and with the thread waiting for them.
+		// Without scheduler the tasks are run immediately by run
+		class task_group
+		{
+		public:
+			task_group(task_scheduler_smart_ptr scheduler);
+
+			// Waits for the tasks left, errors are not reported
+			~task_group();
+
+			void run(const task_scheduler::task_function& func);
+
+			// Throws neural_network_exception if any of the tasks failed
+			void wait();
+
+		private:
+			task_scheduler_smart_ptr scheduler;
+			void * impl;
+
+		private:
+			task_group(const task_group&);
+			task_group& operator =(const task_group&);
+		};
+	}
+}
@@ -0,0 +1,153 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "profiling_result.h"
+
+#include <boost/format.hpp>
+
+namespace nnforge
+{
+	profiling_result::profiling_result(unsigned int layer_count)
+		: seconds_list(layer_count, std::vector<double>(phase_count, 0.0))
+		, flops_list(layer_count, std::vector<double>(phase_count, 0.0))
+		, zero_count_list(layer_count, std::vector<double>(sparsity_type_count, 0.0))
+		, elem_count_list(layer_count, std::vector<double>(sparsity_type_count, 0.0))
+	{
+	}
+
+	void profiling_result::add(
+		unsigned int layer_id,
+		phase_type phase,
+		float seconds,
+		float flops)
+	{
+		seconds_list[layer_id][phase] += static_cast<double>(seconds);
+		flops_list[layer_id][phase] += static_cast<double>(flops);
+	}
+
+	void profiling_result::add_sparsity(
+		unsigned int layer_id,
+		sparsity_type type,
+		unsigned int zero_count,
+		unsigned int elem_count)
+	{
+		zero_count_list[layer_id][type] += static_cast<double>(zero_count);
+		elem_count_list[layer_id][type] += static_cast<double>(elem_count);
+	}
+
+	float profiling_result::get_total_seconds() const
+	{
+		double res = 0.0;
+		for(std::vector<std::vector<double> >::const_iterator it = seconds_list.begin(); it != seconds_list.end(); ++it)
+			for(std::vector<double>::const_iterator it2 = it->begin(); it2 != it->end(); ++it2)
+				res += *it2;
+
+		return static_cast<float>(res);
+	}
+
+	const char * profiling_result::get_phase_name(phase_type phase)
+	{
+		switch (phase)
+		{
+		case phase_input_conversion:
+			return "input_conversion";
+		case phase_forward:
+			return "forward";
+		case phase_dropout:
+			return "dropout";
+		case phase_backprop:
+			return "backprop";
+		case phase_update_weights:
+			return "update_weights";
+		default:
+			return "unknown";
+		}
+	}
+
+	const char * profiling_result::get_sparsity_name(sparsity_type type)
+	{
+		switch (type)
+		{
+		case sparsity_input_neurons:
+			return "input_neurons";
+		case sparsity_output_errors:
+			return "output_errors";
+		default:
+			return "unknown";
+		}
+	}
+
+	std::ostream& operator<< (std::ostream& out, const profiling_result& val)
+	{
+		float total_seconds = val.get_total_seconds();
+		if (total_seconds == 0.0F)
+		{
+			out << "No per-layer timings collected" << std::endl;
+			return out;
+		}
+
+		for(unsigned int layer_id = 0; layer_id < val.seconds_list.size(); ++layer_id)
+		{
+			for(int phase = 0; phase < profiling_result::phase_count; ++phase)
+			{
+				double seconds = val.seconds_list[layer_id][phase];
+				if (seconds == 0.0)
+					continue;
+
+				out << (boost::format("Layer %|1$2d| %|2$-16s| %|3$10.3f| ms %|4$5.1f|%%") % layer_id % profiling_result::get_phase_name(static_cast<profiling_result::phase_type>(phase)) % (seconds * 1000.0) % (seconds * 100.0 / total_seconds));
+				double flops = val.flops_list[layer_id][phase];
+				if (flops > 0.0)
+					out << (boost::format(" %|1$8.2f| GFLOPs") % (flops / seconds * 1.0e-9));
+				out << std::endl;
+			}
+			for(int type = 0; type < profiling_result::sparsity_type_count; ++type)
+			{
+				double elem_count = val.elem_count_list[layer_id][type];
+				if (elem_count == 0.0)
+					continue;
+
+				out << (boost::format("Layer %|1$2d| %|2$-16s| %|3$5.1f|%% zeros") % layer_id % profiling_result::get_sparsity_name(static_cast<profiling_result::sparsity_type>(type)) % (val.zero_count_list[layer_id][type] * 100.0 / elem_count)) << std::endl;
+			}
+		}
+		out << (boost::format("Total %|1$.3f| ms") % (total_seconds * 1000.0F)) << std::endl;
+
+		return out;
+	}
+
+	profiling_scope::profiling_scope(
+		profiling_result_smart_ptr result,
+		unsigned int layer_id,
+		profiling_result::phase_type phase,
+		float flops)
+		: result(result)
+		, layer_id(layer_id)
+		, phase(phase)
+		, flops(flops)
+	{
+		if (result)
+			start = boost::chrono::high_resolution_clock::now();
+	}
+
+	profiling_scope::~profiling_scope()
+	{
+		if (result)
+		{
+			boost::chrono::duration<float> sec = boost::chrono::high_resolution_clock::now() - start;
+			result->add(layer_id, phase, sec.count(), flops);
+		}
+	}
+}
@@ -0,0 +1,108 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include "nn_types.h"
+
+#include <vector>
+#include <ostream>
+#include <boost/chrono.hpp>
+
+namespace nnforge
+{
+	// Wall time and floating point operations accumulated per layer and per phase
+	class profiling_result
+	{
+	public:
+		enum phase_type
+		{
+			phase_input_conversion = 0,
+			phase_forward = 1,
+			phase_dropout = 2,
+			phase_backprop = 3,
+			phase_update_weights = 4,
+			phase_count = 5
+		};
+
+		enum sparsity_type
+		{
+			sparsity_input_neurons = 0,
+			sparsity_output_errors = 1,
+			sparsity_type_count = 2
+		};
+
+		profiling_result(unsigned int layer_count);
+
+		void add(
+			unsigned int layer_id,
+			phase_type phase,
+			float seconds,
+			float flops);
+
+		// Accumulates count of exact zeros in the activations or errors of the layer
+		void add_sparsity(
+			unsigned int layer_id,
+			sparsity_type type,
+			unsigned int zero_count,
+			unsigned int elem_count);
+
+		float get_total_seconds() const;
+
+		static const char * get_phase_name(phase_type phase);
+
+		static const char * get_sparsity_name(sparsity_type type);
+
+		// Indexed by layer_id first, then by phase
+		std::vector<std::vector<double> > seconds_list;
+		std::vector<std::vector<double> > flops_list;
+		// Indexed by layer_id first, then by sparsity type
+		std::vector<std::vector<double> > zero_count_list;
+		std::vector<std::vector<double> > elem_count_list;
+
+	private:
+		profiling_result();
+	};
+
+	std::ostream& operator<< (std::ostream& out, const profiling_result& val);
+
+	typedef nnforge_shared_ptr<profiling_result> profiling_result_smart_ptr;
+
+	// Adds the time elapsed between construction and destruction to the result, does nothing if the result is empty
+	class profiling_scope
+	{
+	public:
+		profiling_scope(
+			profiling_result_smart_ptr result,
+			unsigned int layer_id,
+			profiling_result::phase_type phase,
+			float flops = 0.0F);
+
+		~profiling_scope();
+
+	private:
+		profiling_result_smart_ptr result;
+		unsigned int layer_id;
+		profiling_result::phase_type phase;
+		float flops;
+		boost::chrono::steady_clock::time_point start;
+
+	private:
+		profiling_scope(const profiling_scope&);
+		profiling_scope& operator =(const profiling_scope&);
+	};
+}
@@ -0,0 +1,74 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "quantization_calibrator.h"
+
+#include "neural_network_exception.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace nnforge
+{
+	quantization_calibrator::quantization_calibrator(network_tester_smart_ptr tester)
+		: tester(tester)
+	{
+	}
+
+	quantization_calibrator::~quantization_calibrator()
+	{
+	}
+
+	quantization_data_smart_ptr quantization_calibrator::calibrate(
+		unsupervised_data_reader& reader,
+		unsigned int max_entry_count)
+	{
+		reader.reset();
+
+		layer_configuration_specific input_configuration = reader.get_input_configuration();
+		tester->set_input_configuration_specific(input_configuration);
+
+		const unsigned int input_neuron_count = input_configuration.get_neuron_count();
+		neuron_data_type::input_type type_code = reader.get_input_type();
+		std::vector<unsigned char> input(input_neuron_count * reader.get_input_neuron_elem_size());
+
+		quantization_data_smart_ptr res;
+		unsigned int entry_count = 0;
+		while (((max_entry_count == 0) || (entry_count < max_entry_count)) && reader.read(&(*input.begin())))
+		{
+			// The 1st snapshot is the input of the network, the last one is its output
+			std::vector<layer_configuration_specific_snapshot_smart_ptr> snapshot = tester->get_snapshot(&(*input.begin()), type_code, input_neuron_count);
+			if (!res)
+				res = quantization_data_smart_ptr(new quantization_data(static_cast<unsigned int>(snapshot.size() - 1)));
+
+			for(unsigned int layer_id = 0; layer_id < res->input_range_list.size(); ++layer_id)
+			{
+				const std::vector<float>& data = snapshot[layer_id]->data;
+				float& range = res->input_range_list[layer_id];
+				for(std::vector<float>::const_iterator it = data.begin(); it != data.end(); ++it)
+					range = std::max(range, fabsf(*it));
+			}
+
+			++entry_count;
+		}
+
+		if (!res)
+			throw neural_network_exception("No entries available for quantization calibration");
+
+		return res;
+	}
+}
@@ -0,0 +1,47 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include "network_tester.h"
+#include "quantization_data.h"
+#include "unsupervised_data_reader.h"
+
+namespace nnforge
+{
+	// Collects input ranges of all the layers by running entries through the tester one by one
+	// The tester should have float data set and no quantization data set
+	class quantization_calibrator
+	{
+	public:
+		quantization_calibrator(network_tester_smart_ptr tester);
+
+		~quantization_calibrator();
+
+		// Reads at most max_entry_count entries from the reader, 0 means all of them
+		quantization_data_smart_ptr calibrate(
+			unsupervised_data_reader& reader,
+			unsigned int max_entry_count);
+
+	private:
+		network_tester_smart_ptr tester;
+
+	private:
+		quantization_calibrator(const quantization_calibrator&);
+		quantization_calibrator& operator =(const quantization_calibrator&);
+	};
+}
@@ -0,0 +1,162 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "quantization_data.h"
+
+#include "neural_network_exception.h"
+
+#include <boost/uuid/uuid_io.hpp>
+#include <boost/format.hpp>
+#include <cmath>
+#include <algorithm>
+
+namespace nnforge
+{
+	// {3E9B6C41-72D8-4F0A-9C15-A6E27B4D8F93}
+	const boost::uuids::uuid quantization_data::quantization_data_guid =
+	{ 0x3e, 0x9b, 0x6c, 0x41
+	, 0x72, 0xd8
+	, 0x4f, 0x0a
+	, 0x9c, 0x15
+	, 0xa6, 0xe2, 0x7b, 0x4d, 0x8f, 0x93 };
+
+	quantization_data::quantization_data()
+	{
+	}
+
+	quantization_data::quantization_data(unsigned int layer_count)
+		: input_range_list(layer_count, 0.0F)
+		, weight_list(layer_count)
+		, weight_scale_list(layer_count)
+	{
+	}
+
+	const boost::uuids::uuid& quantization_data::get_uuid() const
+	{
+		return quantization_data_guid;
+	}
+
+	void quantization_data::quantize_weights(const network_data& data)
+	{
+		if (data.size() != input_range_list.size())
+			throw neural_network_exception((boost::format("Network data contains %1% layers while quantization data contains %2%") % data.size() % input_range_list.size()).str());
+
+		for(unsigned int layer_id = 0; layer_id < data.size(); ++layer_id)
+		{
+			std::vector<signed char>& weights = weight_list[layer_id];
+			std::vector<float>& scales = weight_scale_list[layer_id];
+			weights.clear();
+			scales.clear();
+
+			const layer_data& src = *data[layer_id];
+			if ((input_range_list[layer_id] <= 0.0F) || (src.size() != 2) || src[1].empty() || src[0].empty() || ((src[0].size() % src[1].size()) != 0))
+				continue;
+
+			const std::vector<float>& src_weights = src[0];
+			const unsigned int output_feature_map_count = static_cast<unsigned int>(src[1].size());
+			const unsigned int weight_count_per_output_feature_map = static_cast<unsigned int>(src_weights.size()) / output_feature_map_count;
+
+			weights.resize(src_weights.size());
+			scales.resize(output_feature_map_count);
+			for(unsigned int output_feature_map_id = 0; output_feature_map_id < output_feature_map_count; ++output_feature_map_id)
+			{
+				std::vector<float>::const_iterator src_it = src_weights.begin() + (output_feature_map_id * weight_count_per_output_feature_map);
+				std::vector<signed char>::iterator dst_it = weights.begin() + (output_feature_map_id * weight_count_per_output_feature_map);
+
+				float max_abs = 0.0F;
+				for(unsigned int i = 0; i < weight_count_per_output_feature_map; ++i)
+					max_abs = std::max(max_abs, fabsf(src_it[i]));
+
+				float scale = max_abs / 127.0F;
+				scales[output_feature_map_id] = scale;
+				float mult = (scale > 0.0F) ? 1.0F / scale : 0.0F;
+				for(unsigned int i = 0; i < weight_count_per_output_feature_map; ++i)
+				{
+					int val = static_cast<int>(floorf(src_it[i] * mult + 0.5F));
+					dst_it[i] = static_cast<signed char>(std::min(std::max(val, -127), 127));
+				}
+			}
+		}
+	}
+
+	void quantization_data::write(std::ostream& binary_stream_to_write_to) const
+	{
+		binary_stream_to_write_to.exceptions(std::ostream::eofbit | std::ostream::failbit | std::ostream::badbit);
+
+		const boost::uuids::uuid& guid = get_uuid();
+		binary_stream_to_write_to.write(reinterpret_cast<const char*>(guid.data), sizeof(guid.data));
+
+		unsigned int layer_count = static_cast<unsigned int>(input_range_list.size());
+		binary_stream_to_write_to.write(reinterpret_cast<const char*>(&layer_count), sizeof(layer_count));
+		if (layer_count > 0)
+			binary_stream_to_write_to.write(reinterpret_cast<const char*>(&(*input_range_list.begin())), sizeof(float) * layer_count);
+
+		for(unsigned int layer_id = 0; layer_id < layer_count; ++layer_id)
+		{
+			const std::vector<signed char>& weights = weight_list[layer_id];
+			const std::vector<float>& scales = weight_scale_list[layer_id];
+
+			unsigned int weight_count = static_cast<unsigned int>(weights.size());
+			binary_stream_to_write_to.write(reinterpret_cast<const char*>(&weight_count), sizeof(weight_count));
+			if (weight_count > 0)
+				binary_stream_to_write_to.write(reinterpret_cast<const char*>(&(*weights.begin())), sizeof(signed char) * weight_count);
+
+			unsigned int scale_count = static_cast<unsigned int>(scales.size());
+			binary_stream_to_write_to.write(reinterpret_cast<const char*>(&scale_count), sizeof(scale_count));
+			if (scale_count > 0)
+				binary_stream_to_write_to.write(reinterpret_cast<const char*>(&(*scales.begin())), sizeof(float) * scale_count);
+		}
+
+		binary_stream_to_write_to.flush();
+	}
+
+	void quantization_data::read(std::istream& binary_stream_to_read_from)
+	{
+		binary_stream_to_read_from.exceptions(std::ostream::eofbit | std::ostream::failbit | std::ostream::badbit);
+
+		boost::uuids::uuid quantization_data_guid_read;
+		binary_stream_to_read_from.read(reinterpret_cast<char*>(quantization_data_guid_read.data), sizeof(quantization_data_guid_read.data));
+		if (quantization_data_guid_read != get_uuid())
+			throw neural_network_exception((boost::format("Unknown quantization data GUID encountered in input stream: %1%") % quantization_data_guid_read).str());
+
+		unsigned int layer_count;
+		binary_stream_to_read_from.read(reinterpret_cast<char*>(&layer_count), sizeof(layer_count));
+		input_range_list.resize(layer_count);
+		if (layer_count > 0)
+			binary_stream_to_read_from.read(reinterpret_cast<char*>(&(*input_range_list.begin())), sizeof(float) * layer_count);
+
+		weight_list.resize(layer_count);
+		weight_scale_list.resize(layer_count);
+		for(unsigned int layer_id = 0; layer_id < layer_count; ++layer_id)
+		{
+			std::vector<signed char>& weights = weight_list[layer_id];
+			std::vector<float>& scales = weight_scale_list[layer_id];
+
+			unsigned int weight_count;
+			binary_stream_to_read_from.read(reinterpret_cast<char*>(&weight_count), sizeof(weight_count));
+			weights.resize(weight_count);
+			if (weight_count > 0)
+				binary_stream_to_read_from.read(reinterpret_cast<char*>(&(*weights.begin())), sizeof(signed char) * weight_count);
+
+			unsigned int scale_count;
+			binary_stream_to_read_from.read(reinterpret_cast<char*>(&scale_count), sizeof(scale_count));
+			scales.resize(scale_count);
+			if (scale_count > 0)
+				binary_stream_to_read_from.read(reinterpret_cast<char*>(&(*scales.begin())), sizeof(float) * scale_count);
+		}
+	}
+}
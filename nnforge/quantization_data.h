@@ -0,0 +1,66 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include "nn_types.h"
+#include "network_data.h"
+
+#include <vector>
+#include <ostream>
+#include <istream>
+#include <boost/uuid/uuid.hpp>
+
+namespace nnforge
+{
+	// Quantized model: ranges of layer inputs collected on calibration data and int8 weights,
+	// backends use the ranges to quantize inputs to int8 and run with the stored weights
+	class quantization_data
+	{
+	public:
+		quantization_data();
+
+		quantization_data(unsigned int layer_count);
+
+		const boost::uuids::uuid& get_uuid() const;
+
+		// The stream should be created with std::ios_base::binary flag
+		// The method modifies binary_stream_to_write_to to throw exceptions in case of failure
+		void write(std::ostream& binary_stream_to_write_to) const;
+
+		// The stream should be created with std::ios_base::binary flag
+		// The method modifies binary_stream_to_read_from to throw exceptions in case of failure
+		void read(std::istream& binary_stream_to_read_from);
+
+		// Quantizes weights of the layers having weights and per output feature map biases, and with the input range set.
+		// The weights are quantized symmetrically with a scale per output feature map, biases are kept in float network data
+		void quantize_weights(const network_data& data);
+
+		// Max absolute value of the input for each layer, 0 means the input of the layer is not quantized
+		std::vector<float> input_range_list;
+		// Quantized weights (part 0 of layer data) for each layer, empty for the layers not quantized
+		std::vector<std::vector<signed char> > weight_list;
+		// Scale for each output feature map, the weight is weight_list value multiplied by the scale
+		std::vector<std::vector<float> > weight_scale_list;
+
+	private:
+		static const boost::uuids::uuid quantization_data_guid;
+	};
+
+	typedef nnforge_shared_ptr<quantization_data> quantization_data_smart_ptr;
+	typedef nnforge_shared_ptr<const quantization_data> const_quantization_data_smart_ptr;
+}
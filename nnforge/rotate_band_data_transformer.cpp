@@ -44,6 +44,22 @@ namespace nnforge
 		neuron_data_type::input_type type,
 		const layer_configuration_specific& original_config,
 		unsigned int sample_id)
+	{
+		transform(data, data_transformed, type, original_config, sample_id, generator);
+	}
+
+	bool rotate_band_data_transformer::is_parallel_transform_supported() const
+	{
+		return true;
+	}
+
+	void rotate_band_data_transformer::transform(
+		const void * data,
+		void * data_transformed,
+		neuron_data_type::input_type type,
+		const layer_configuration_specific& original_config,
+		unsigned int sample_id,
+		random_generator& generator)
 	{
 		const std::vector<unsigned int>& dimension_sizes = original_config.dimension_sizes;
 
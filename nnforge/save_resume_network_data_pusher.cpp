@@ -23,9 +23,17 @@
 
 namespace nnforge
 {
-	save_resume_network_data_pusher::save_resume_network_data_pusher(const boost::filesystem::path& folder_path)
+	save_resume_network_data_pusher::save_resume_network_data_pusher(
+		const boost::filesystem::path& folder_path,
+		unsigned int epoch_interval,
+		float time_interval)
 		: folder_path(folder_path)
+		, epoch_interval(epoch_interval)
+		, time_interval(time_interval)
+		, creation_time(boost::chrono::steady_clock::now())
 	{
+		if ((epoch_interval == 0) && (time_interval <= 0.0F))
+			throw neural_network_exception("Either epoch interval or time interval should be set for saving resume data");
 	}
 
 	save_resume_network_data_pusher::~save_resume_network_data_pusher()
@@ -33,6 +41,35 @@ namespace nnforge
 	}
 
 	void save_resume_network_data_pusher::push(const training_task_state& task_state)
+	{
+		if (is_save_required(task_state))
+			save(task_state);
+	}
+
+	bool save_resume_network_data_pusher::is_save_required(const training_task_state& task_state)
+	{
+		if ((epoch_interval > 0) && (task_state.get_current_epoch() % epoch_interval == 0))
+		{
+			last_save_time_map[task_state.index_peeked] = boost::chrono::steady_clock::now();
+			return true;
+		}
+
+		if (time_interval > 0.0F)
+		{
+			boost::chrono::steady_clock::time_point now = boost::chrono::steady_clock::now();
+			std::map<unsigned int, boost::chrono::steady_clock::time_point>::const_iterator it = last_save_time_map.find(task_state.index_peeked);
+			boost::chrono::duration<float> sec = now - ((it != last_save_time_map.end()) ? it->second : creation_time);
+			if (sec.count() >= time_interval)
+			{
+				last_save_time_map[task_state.index_peeked] = now;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void save_resume_network_data_pusher::save(const training_task_state& task_state) const
 	{
 		unsigned int index = task_state.index_peeked;
 		network_data_smart_ptr data = task_state.data;
@@ -49,5 +86,23 @@ namespace nnforge
 		}
 
 		boost::filesystem::rename(temp_filepath, filepath);
+
+		if (task_state.hessian)
+		{
+			std::string hessian_filename = (boost::format("ann_trained_%|1$03d|_epoch_%|2$05d|.hessian") % index % task_state.get_current_epoch()).str();
+			std::string hessian_temp_filename = hessian_filename + ".temp";
+
+			boost::filesystem::path hessian_filepath = folder_path / hessian_filename;
+			boost::filesystem::path hessian_temp_filepath = folder_path / hessian_temp_filename;
+
+			{
+				boost::filesystem::ofstream file_with_hessian(hessian_temp_filepath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+				file_with_hessian.exceptions(std::ostream::eofbit | std::ostream::failbit | std::ostream::badbit);
+				file_with_hessian.write(reinterpret_cast<const char*>(&task_state.hessian_epoch), sizeof(task_state.hessian_epoch));
+				task_state.hessian->write(file_with_hessian);
+			}
+
+			boost::filesystem::rename(hessian_temp_filepath, hessian_filepath);
+		}
 	}
 }
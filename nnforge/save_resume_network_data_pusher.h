@@ -19,19 +19,36 @@
 #include "network_data_pusher.h"
 
 #include <boost/filesystem.hpp>
+#include <boost/chrono.hpp>
+#include <map>
 
 namespace nnforge
 {
+	// Each network is saved when its epoch is a multiple of epoch_interval or when time_interval seconds passed since it was last saved
+	// Setting either of them to 0 disables the corresponding condition
 	class save_resume_network_data_pusher : public network_data_pusher
 	{
 	public:
-		save_resume_network_data_pusher(const boost::filesystem::path& folder_path);
+		save_resume_network_data_pusher(
+			const boost::filesystem::path& folder_path,
+			unsigned int epoch_interval = 1,
+			float time_interval = 0.0F);
 
 		virtual ~save_resume_network_data_pusher();
 
 		virtual void push(const training_task_state& task_state);
 
+	protected:
+		bool is_save_required(const training_task_state& task_state);
+
+		// Data is written to temporary files first which are renamed after, thus partially written files are never picked up on resume
+		void save(const training_task_state& task_state) const;
+
 	private:
 		boost::filesystem::path folder_path;
+		unsigned int epoch_interval;
+		float time_interval;
+		std::map<unsigned int, boost::chrono::steady_clock::time_point> last_save_time_map;
+		boost::chrono::steady_clock::time_point creation_time;
 	};
 }
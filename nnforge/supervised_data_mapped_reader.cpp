@@ -0,0 +1,193 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "supervised_data_mapped_reader.h"
+
+#include "supervised_data_stream_schema.h"
+#include "neural_network_exception.h"
+
+#include <boost/interprocess/streams/bufferstream.hpp>
+#include <boost/uuid/uuid_io.hpp>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace nnforge
+{
+	const size_t supervised_data_mapped_reader::readahead_window_size = 64 * 1024 * 1024;
+
+	supervised_data_mapped_reader::supervised_data_mapped_reader(const boost::filesystem::path& file_path)
+		: mapping(file_path.string().c_str(), boost::interprocess::read_only)
+		, entry_read_count(0)
+		, readahead_offset(0)
+	{
+		// Empty file cannot be mapped
+		if (boost::filesystem::file_size(file_path) == 0)
+			throw neural_network_exception((boost::format("Supervised data file %1% is truncated: the header doesn't fit into %2% bytes") % file_path.string() % 0).str());
+		boost::interprocess::mapped_region(mapping, boost::interprocess::read_only).swap(region);
+
+		const unsigned char * region_begin = static_cast<const unsigned char *>(region.get_address());
+		size_t region_size = region.get_size();
+
+		boost::interprocess::ibufferstream in_stream(reinterpret_cast<const char *>(region_begin), region_size, std::ios_base::in | std::ios_base::binary);
+		in_stream.exceptions(std::ostream::eofbit | std::ostream::failbit | std::ostream::badbit);
+
+		size_t header_size;
+		try
+		{
+			boost::uuids::uuid guid_read;
+			in_stream.read(reinterpret_cast<char*>(guid_read.data), sizeof(guid_read.data));
+			if (guid_read != supervised_data_stream_schema::supervised_data_stream_guid)
+				throw neural_network_exception((boost::format("Unknown supervised data GUID encountered in %1%: %2%") % file_path.string() % guid_read).str());
+
+			input_configuration.read(in_stream);
+			output_configuration.read(in_stream);
+
+			unsigned int type_code_read;
+			in_stream.read(reinterpret_cast<char*>(&type_code_read), sizeof(type_code_read));
+			type_code = static_cast<neuron_data_type::input_type>(type_code_read);
+
+			in_stream.read(reinterpret_cast<char*>(&entry_count), sizeof(entry_count));
+
+			header_size = static_cast<size_t>(in_stream.tellg());
+		}
+		catch (const std::ios_base::failure&)
+		{
+			throw neural_network_exception((boost::format("Supervised data file %1% is truncated: the header doesn't fit into %2% bytes") % file_path.string() % region_size).str());
+		}
+
+		input_neuron_count = input_configuration.get_neuron_count();
+		output_neuron_count = output_configuration.get_neuron_count();
+		data_begin = region_begin + header_size;
+		input_entry_size = get_input_neuron_elem_size() * input_neuron_count;
+		entry_size = input_entry_size + sizeof(float) * output_neuron_count;
+
+		if (header_size + entry_size * entry_count > region_size)
+			throw neural_network_exception((boost::format("Supervised data file %1% is truncated: %2% entries declared, %3% bytes available") % file_path.string() % entry_count % (region_size - header_size)).str());
+
+		region.advise(boost::interprocess::mapped_region::advice_sequential);
+		readahead(0);
+	}
+
+	supervised_data_mapped_reader::~supervised_data_mapped_reader()
+	{
+	}
+
+	void supervised_data_mapped_reader::reset()
+	{
+		rewind(0);
+	}
+
+	const unsigned char * supervised_data_mapped_reader::get_current_entry()
+	{
+		size_t offset = entry_size * entry_read_count;
+		if (offset + entry_size > readahead_offset)
+			readahead(offset);
+
+		return data_begin + offset;
+	}
+
+	bool supervised_data_mapped_reader::read(
+		void * input_neurons,
+		float * output_neurons)
+	{
+		if (!entry_available())
+			return false;
+
+		const unsigned char * entry = get_current_entry();
+
+		if (input_neurons)
+			memcpy(input_neurons, entry, input_entry_size);
+
+		if (output_neurons)
+			memcpy(output_neurons, entry + input_entry_size, sizeof(float) * output_neuron_count);
+
+		entry_read_count++;
+
+		return true;
+	}
+
+	unsigned int supervised_data_mapped_reader::read_batch(
+		unsigned int requested_entry_count,
+		void * input_neurons,
+		float * output_neurons)
+	{
+		unsigned int entries_to_read_count = std::min(requested_entry_count, entry_count - entry_read_count);
+
+		for(unsigned int i = 0; i < entries_to_read_count; ++i)
+		{
+			const unsigned char * entry = get_current_entry();
+
+			if (input_neurons)
+				memcpy(static_cast<unsigned char *>(input_neurons) + (input_entry_size * i), entry, input_entry_size);
+
+			if (output_neurons)
+				memcpy(output_neurons + (output_neuron_count * i), entry + input_entry_size, sizeof(float) * output_neuron_count);
+
+			entry_read_count++;
+		}
+
+		return entries_to_read_count;
+	}
+
+	bool supervised_data_mapped_reader::raw_read(std::vector<unsigned char>& all_elems)
+	{
+		if (!entry_available())
+			return false;
+
+		const unsigned char * entry = get_current_entry();
+		all_elems.assign(entry, entry + entry_size);
+
+		entry_read_count++;
+
+		return true;
+	}
+
+	bool supervised_data_mapped_reader::entry_available()
+	{
+		return (entry_read_count < entry_count);
+	}
+
+	void supervised_data_mapped_reader::rewind(unsigned int entry_id)
+	{
+		entry_read_count = entry_id;
+		readahead(entry_size * entry_read_count);
+	}
+
+	void supervised_data_mapped_reader::readahead(size_t offset)
+	{
+		size_t data_size = entry_size * entry_count;
+		readahead_offset = std::min(offset + readahead_window_size, data_size);
+
+#ifndef _WIN32
+		if (offset >= readahead_offset)
+			return;
+
+		// madvise requires the address to be aligned to page boundary
+		size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+		size_t begin = reinterpret_cast<size_t>(data_begin + offset);
+		size_t aligned_begin = begin - (begin % page_size);
+		size_t end = reinterpret_cast<size_t>(data_begin + readahead_offset);
+		posix_madvise(reinterpret_cast<void *>(aligned_begin), end - aligned_begin, POSIX_MADV_WILLNEED);
+#endif
+	}
+}
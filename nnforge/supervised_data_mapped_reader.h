@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include "supervised_data_reader.h"
+#include "neuron_data_type.h"
+#include "nn_types.h"
+
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace nnforge
+{
+	// The reader maps the file in supervised data stream format to memory instead of streaming it
+	// Sequential access is advised to the OS, the data ahead of the current entry is prefetched
+	class supervised_data_mapped_reader : public supervised_data_reader
+	{
+	public:
+		supervised_data_mapped_reader(const boost::filesystem::path& file_path);
+
+		virtual ~supervised_data_mapped_reader();
+
+		virtual void reset();
+
+		virtual bool read(
+			void * input_neurons,
+			float * output_neurons);
+
+		virtual unsigned int read_batch(
+			unsigned int requested_entry_count,
+			void * input_neurons,
+			float * output_neurons);
+
+		virtual bool raw_read(std::vector<unsigned char>& all_elems);
+
+		virtual layer_configuration_specific get_input_configuration() const
+		{
+			return input_configuration;
+		}
+
+		virtual layer_configuration_specific get_output_configuration() const
+		{
+			return output_configuration;
+		}
+
+		virtual neuron_data_type::input_type get_input_type() const
+		{
+			return type_code;
+		}
+
+		virtual unsigned int get_entry_count() const
+		{
+			return entry_count;
+		}
+
+		virtual void rewind(unsigned int entry_id);
+
+	protected:
+		bool entry_available();
+
+		const unsigned char * get_current_entry();
+
+		void readahead(size_t offset);
+
+	protected:
+		boost::interprocess::file_mapping mapping;
+		boost::interprocess::mapped_region region;
+		const unsigned char * data_begin;
+		size_t input_entry_size;
+		size_t entry_size;
+		unsigned int input_neuron_count;
+		unsigned int output_neuron_count;
+		layer_configuration_specific input_configuration;
+		layer_configuration_specific output_configuration;
+		neuron_data_type::input_type type_code;
+		unsigned int entry_count;
+
+		unsigned int entry_read_count;
+		size_t readahead_offset;
+
+		static const size_t readahead_window_size;
+
+	private:
+		supervised_data_mapped_reader(const supervised_data_mapped_reader&);
+		supervised_data_mapped_reader& operator =(const supervised_data_mapped_reader&);
+	};
+
+	typedef nnforge_shared_ptr<supervised_data_mapped_reader> supervised_data_mapped_reader_smart_ptr;
+}
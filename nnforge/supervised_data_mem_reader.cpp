@@ -19,6 +19,7 @@
 
 #include <boost/format.hpp>
 #include <cstring>
+#include <algorithm>
 
 namespace nnforge
 {
@@ -85,11 +86,40 @@ namespace nnforge
 		if (output_neurons)
 		{
 			const float * output_src = &(*output_data_list[entry_read_count]->begin());
-			memcpy(output_neurons, output_src, input_neuron_count * sizeof(float));
+			memcpy(output_neurons, output_src, output_neuron_count * sizeof(float));
 		}
 
 		entry_read_count++;
 
 		return true;
 	}
+
+	unsigned int supervised_data_mem_reader::read_batch(
+		unsigned int requested_entry_count,
+		void * input_neurons,
+		float * output_neurons)
+	{
+		unsigned int entries_to_read_count = std::min(requested_entry_count, entry_count - entry_read_count);
+		size_t input_entry_size = input_neuron_count * neuron_data_type::get_input_size(type_code);
+
+		for(unsigned int i = 0; i < entries_to_read_count; ++i)
+		{
+			unsigned int entry_id = entry_read_count + i;
+
+			if (input_neurons)
+			{
+				const void * input_src = (type_code == neuron_data_type::type_byte)
+					? static_cast<const void *>(&(*input_data_list_byte[entry_id]->begin()))
+					: static_cast<const void *>(&(*input_data_list_float[entry_id]->begin()));
+				memcpy(static_cast<unsigned char *>(input_neurons) + (input_entry_size * i), input_src, input_entry_size);
+			}
+
+			if (output_neurons)
+				memcpy(output_neurons + (output_neuron_count * i), &(*output_data_list[entry_id]->begin()), output_neuron_count * sizeof(float));
+		}
+
+		entry_read_count += entries_to_read_count;
+
+		return entries_to_read_count;
+	}
 }
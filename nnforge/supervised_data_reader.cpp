@@ -58,6 +58,36 @@ namespace nnforge
 		return read(input_elems, 0);
 	}
 
+	unsigned int supervised_data_reader::read_batch(
+		unsigned int requested_entry_count,
+		void * input_elems,
+		float * output_elems)
+	{
+		size_t input_entry_size = get_input_neuron_elem_size() * get_input_configuration().get_neuron_count();
+		unsigned int output_neuron_count = get_output_configuration().get_neuron_count();
+		unsigned char * input_ptr = static_cast<unsigned char *>(input_elems);
+
+		unsigned int entries_read_count = 0;
+		while (entries_read_count < requested_entry_count)
+		{
+			bool entry_read = read(
+				(input_ptr != 0) ? input_ptr + (input_entry_size * entries_read_count) : 0,
+				(output_elems != 0) ? output_elems + (output_neuron_count * entries_read_count) : 0);
+			if (!entry_read)
+				break;
+			entries_read_count++;
+		}
+
+		return entries_read_count;
+	}
+
+	unsigned int supervised_data_reader::read_batch(
+		unsigned int requested_entry_count,
+		void * input_elems)
+	{
+		return read_batch(requested_entry_count, input_elems, 0);
+	}
+
 	std::vector<feature_map_data_stat> supervised_data_reader::get_feature_map_output_data_stat_list()
 	{
 		std::vector<feature_map_data_stat> res;
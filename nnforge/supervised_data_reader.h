@@ -61,6 +61,18 @@ namespace nnforge
 
 		virtual bool read(void * input_elems);
 
+		// The method reads up to requested_entry_count entries to consecutive locations and returns the number of entries read
+		// Less than requested_entry_count entries are read only if there is no more entries available
+		// If any parameter is null the method should just discard corresponding data
+		virtual unsigned int read_batch(
+			unsigned int requested_entry_count,
+			void * input_elems,
+			float * output_elems);
+
+		virtual unsigned int read_batch(
+			unsigned int requested_entry_count,
+			void * input_elems);
+
 		virtual layer_configuration_specific get_output_configuration() const = 0;
 
 		output_neuron_value_set_smart_ptr get_output_neuron_value_set(unsigned int sample_count);
@@ -20,6 +20,8 @@
 
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/format.hpp>
+#include <algorithm>
+#include <cstring>
 
 namespace nnforge
 {
@@ -82,6 +84,40 @@ namespace nnforge
 		return true;
 	}
 
+	unsigned int supervised_data_stream_reader::read_batch(
+		unsigned int requested_entry_count,
+		void * input_neurons,
+		float * output_neurons)
+	{
+		unsigned int entries_to_read_count = std::min(requested_entry_count, entry_count - entry_read_count);
+		size_t input_entry_size = get_input_neuron_elem_size() * input_neuron_count;
+		size_t output_entry_size = sizeof(float) * output_neuron_count;
+		size_t entry_size = input_entry_size + output_entry_size;
+
+		if ((input_neurons == 0) && (output_neurons == 0))
+			in_stream->seekg(entry_size * entries_to_read_count, std::ios_base::cur);
+		else if (entries_to_read_count > 0)
+		{
+			// Entries are stored interleaved, read them all at once and split
+			batch_buf.resize(entry_size * entries_to_read_count);
+			in_stream->read(reinterpret_cast<char*>(&(*batch_buf.begin())), entry_size * entries_to_read_count);
+
+			const unsigned char * src = &(*batch_buf.begin());
+			unsigned char * input_dst = static_cast<unsigned char *>(input_neurons);
+			for(unsigned int i = 0; i < entries_to_read_count; ++i, src += entry_size)
+			{
+				if (input_neurons)
+					memcpy(input_dst + (input_entry_size * i), src, input_entry_size);
+				if (output_neurons)
+					memcpy(output_neurons + (output_neuron_count * i), src + input_entry_size, output_entry_size);
+			}
+		}
+
+		entry_read_count += entries_to_read_count;
+
+		return entries_to_read_count;
+	}
+
 	bool supervised_data_stream_reader::raw_read(std::vector<unsigned char>& all_elems)
 	{
 		if (!entry_available())
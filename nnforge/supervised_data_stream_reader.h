@@ -42,6 +42,11 @@ namespace nnforge
 			void * input_neurons,
 			float * output_neurons);
 
+		virtual unsigned int read_batch(
+			unsigned int requested_entry_count,
+			void * input_neurons,
+			float * output_neurons);
+
 		virtual bool raw_read(std::vector<unsigned char>& all_elems);
 
 		virtual layer_configuration_specific get_input_configuration() const
@@ -81,6 +86,8 @@ namespace nnforge
 		unsigned int entry_read_count;
 		std::istream::pos_type reset_pos;
 
+		std::vector<unsigned char> batch_buf;
+
 	private:
 		supervised_data_stream_reader(const supervised_data_stream_reader&);
 		supervised_data_stream_reader& operator =(const supervised_data_stream_reader&);
@@ -37,10 +37,17 @@ namespace nnforge
 			void * input_elems,
 			float * output_elems);
 
+		virtual unsigned int read_batch(
+			unsigned int requested_entry_count,
+			void * input_elems,
+			float * output_elems);
+
 		virtual bool raw_read(std::vector<unsigned char>& all_elems);
 
 		virtual void rewind(unsigned int entry_id);
 
+		virtual bool is_rewind_supported() const;
+
 		virtual void reset();
 
 		virtual layer_configuration_specific get_input_configuration() const;
@@ -17,6 +17,7 @@
 #include "supervised_multiple_epoch_data_reader.h"
 
 #include <cstring>
+#include <algorithm>
 
 namespace nnforge
 {
@@ -56,6 +57,21 @@ namespace nnforge
 		return original_reader->read(input_elems, output_elems);
 	}
 
+	unsigned int supervised_multiple_epoch_data_reader::read_batch(
+		unsigned int requested_entry_count,
+		void * input_elems,
+		float * output_elems)
+	{
+		unsigned int entries_read_count = original_reader->read_batch(
+			std::min(requested_entry_count, local_entry_count - entry_read_count),
+			input_elems,
+			output_elems);
+
+		entry_read_count += entries_read_count;
+
+		return entries_read_count;
+	}
+
 	void supervised_multiple_epoch_data_reader::reset()
 	{
 		entry_read_count = 0;
@@ -93,9 +109,15 @@ namespace nnforge
 
 	void supervised_multiple_epoch_data_reader::rewind(unsigned int entry_id)
 	{
+		entry_read_count = entry_id;
 		original_reader->rewind(start_original_entry_id + entry_id);
 	}
 
+	bool supervised_multiple_epoch_data_reader::is_rewind_supported() const
+	{
+		return original_reader->is_rewind_supported();
+	}
+
 	bool supervised_multiple_epoch_data_reader::raw_read(std::vector<unsigned char>& all_elems)
 	{
 		if (!entry_available())
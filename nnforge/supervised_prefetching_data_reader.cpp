@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "supervised_prefetching_data_reader.h"
+
+#include "neural_network_exception.h"
+
+namespace nnforge
+{
+	supervised_prefetching_data_reader::supervised_prefetching_data_reader(
+		supervised_data_reader_smart_ptr original_reader,
+		unsigned int prefetch_entry_count)
+		: original_reader(original_reader)
+		, prefetch_helper(new data_reader_prefetch_helper(original_reader.get(), original_reader.get(), prefetch_entry_count))
+	{
+	}
+
+	supervised_prefetching_data_reader::supervised_prefetching_data_reader()
+	{
+	}
+
+	supervised_prefetching_data_reader::~supervised_prefetching_data_reader()
+	{
+	}
+
+	bool supervised_prefetching_data_reader::read(
+		void * input_elems,
+		float * output_elems)
+	{
+		return prefetch_helper->read(input_elems, output_elems);
+	}
+
+	unsigned int supervised_prefetching_data_reader::read_batch(
+		unsigned int requested_entry_count,
+		void * input_elems,
+		float * output_elems)
+	{
+		return prefetch_helper->read_batch(requested_entry_count, input_elems, output_elems);
+	}
+
+	bool supervised_prefetching_data_reader::raw_read(std::vector<unsigned char>& all_elems)
+	{
+		throw neural_network_exception("raw_read is not supported by supervised_prefetching_data_reader");
+	}
+
+	void supervised_prefetching_data_reader::rewind(unsigned int entry_id)
+	{
+		prefetch_helper->stop();
+		original_reader->rewind(entry_id);
+	}
+
+	bool supervised_prefetching_data_reader::is_rewind_supported() const
+	{
+		return original_reader->is_rewind_supported();
+	}
+
+	void supervised_prefetching_data_reader::reset()
+	{
+		prefetch_helper->stop();
+		original_reader->reset();
+	}
+
+	void supervised_prefetching_data_reader::next_epoch()
+	{
+		prefetch_helper->stop();
+		original_reader->next_epoch();
+	}
+
+	layer_configuration_specific supervised_prefetching_data_reader::get_input_configuration() const
+	{
+		return original_reader->get_input_configuration();
+	}
+
+	layer_configuration_specific supervised_prefetching_data_reader::get_output_configuration() const
+	{
+		return original_reader->get_output_configuration();
+	}
+
+	neuron_data_type::input_type supervised_prefetching_data_reader::get_input_type() const
+	{
+		return original_reader->get_input_type();
+	}
+
+	unsigned int supervised_prefetching_data_reader::get_entry_count() const
+	{
+		return original_reader->get_entry_count();
+	}
+}
@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include "supervised_data_reader.h"
+#include "data_reader_prefetch_helper.h"
+
+namespace nnforge
+{
+	// The reader reads entries from the original reader in batches on a background thread
+	// The original reader should not be used directly while being wrapped
+	class supervised_prefetching_data_reader : public supervised_data_reader
+	{
+	public:
+		supervised_prefetching_data_reader(
+			supervised_data_reader_smart_ptr original_reader,
+			unsigned int prefetch_entry_count);
+
+		virtual ~supervised_prefetching_data_reader();
+
+		// The method should return true in case entry is read and false if there is no more entries available (and no entry is read in this case)
+		// If any parameter is null the method should just discard corresponding data
+		virtual bool read(
+			void * input_elems,
+			float * output_elems);
+
+		virtual unsigned int read_batch(
+			unsigned int requested_entry_count,
+			void * input_elems,
+			float * output_elems);
+
+		// Raw reading is not supported as prefetched entries are stored in the decoded form
+		virtual bool raw_read(std::vector<unsigned char>& all_elems);
+
+		virtual void rewind(unsigned int entry_id);
+
+		virtual bool is_rewind_supported() const;
+
+		virtual void reset();
+
+		virtual void next_epoch();
+
+		virtual layer_configuration_specific get_input_configuration() const;
+
+		virtual layer_configuration_specific get_output_configuration() const;
+
+		virtual neuron_data_type::input_type get_input_type() const;
+
+		virtual unsigned int get_entry_count() const;
+
+	protected:
+		supervised_prefetching_data_reader();
+
+	protected:
+		supervised_data_reader_smart_ptr original_reader;
+		data_reader_prefetch_helper_smart_ptr prefetch_helper;
+	};
+}
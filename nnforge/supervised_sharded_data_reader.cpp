@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "supervised_sharded_data_reader.h"
+
+#include "neural_network_exception.h"
+
+#include <boost/format.hpp>
+
+namespace nnforge
+{
+	supervised_sharded_data_reader::supervised_sharded_data_reader(
+		supervised_data_reader& original_reader,
+		unsigned int shard_id,
+		unsigned int shard_count,
+		unsigned int first_entry_id,
+		unsigned int entry_count)
+		: original_reader(original_reader)
+		, shard_id(shard_id)
+		, shard_count(shard_count)
+		, first_entry_id(first_entry_id)
+		, entry_count(entry_count)
+		, entry_read_count(0)
+	{
+		if (shard_id >= shard_count)
+			throw neural_network_exception("Shard ID should be less than shard count");
+		unsigned int shard_entry_count = get_shard_entry_count(original_reader.get_entry_count(), shard_id, shard_count);
+		if (first_entry_id + entry_count > shard_entry_count)
+			throw neural_network_exception((boost::format("Entries %1% to %2% requested from shard %3% containing %4% entries") % first_entry_id % (first_entry_id + entry_count) % shard_id % shard_entry_count).str());
+
+		move_to(0);
+	}
+
+	supervised_sharded_data_reader::~supervised_sharded_data_reader()
+	{
+	}
+
+	unsigned int supervised_sharded_data_reader::get_shard_start_entry_id(
+		unsigned int entry_count,
+		unsigned int shard_id,
+		unsigned int shard_count)
+	{
+		return static_cast<unsigned int>(static_cast<unsigned long long>(entry_count) * shard_id / shard_count);
+	}
+
+	unsigned int supervised_sharded_data_reader::get_shard_entry_count(
+		unsigned int entry_count,
+		unsigned int shard_id,
+		unsigned int shard_count)
+	{
+		return get_shard_start_entry_id(entry_count, shard_id + 1, shard_count) - get_shard_start_entry_id(entry_count, shard_id, shard_count);
+	}
+
+	bool supervised_sharded_data_reader::read(
+		void * input_elems,
+		float * output_elems)
+	{
+		if (entry_read_count >= entry_count)
+			return false;
+
+		if (!original_reader.read(input_elems, output_elems))
+			return false;
+		++entry_read_count;
+
+		return true;
+	}
+
+	bool supervised_sharded_data_reader::raw_read(std::vector<unsigned char>& all_elems)
+	{
+		if (entry_read_count >= entry_count)
+			return false;
+
+		if (!original_reader.raw_read(all_elems))
+			return false;
+		++entry_read_count;
+
+		return true;
+	}
+
+	void supervised_sharded_data_reader::move_to(unsigned int entry_id)
+	{
+		unsigned int original_entry_id = get_shard_start_entry_id(original_reader.get_entry_count(), shard_id, shard_count) + first_entry_id + entry_id;
+		if (original_reader.is_rewind_supported())
+		{
+			original_reader.rewind(original_entry_id);
+		}
+		else
+		{
+			original_reader.reset();
+			for(unsigned int i = 0; i < original_entry_id; ++i)
+				if (!original_reader.read(0, 0))
+					break;
+		}
+
+		entry_read_count = entry_id;
+	}
+
+	void supervised_sharded_data_reader::rewind(unsigned int entry_id)
+	{
+		move_to(entry_id);
+	}
+
+	void supervised_sharded_data_reader::reset()
+	{
+		move_to(0);
+	}
+
+	layer_configuration_specific supervised_sharded_data_reader::get_input_configuration() const
+	{
+		return original_reader.get_input_configuration();
+	}
+
+	layer_configuration_specific supervised_sharded_data_reader::get_output_configuration() const
+	{
+		return original_reader.get_output_configuration();
+	}
+
+	neuron_data_type::input_type supervised_sharded_data_reader::get_input_type() const
+	{
+		return original_reader.get_input_type();
+	}
+
+	unsigned int supervised_sharded_data_reader::get_entry_count() const
+	{
+		return entry_count;
+	}
+}
@@ -0,0 +1,89 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include "supervised_data_reader.h"
+
+namespace nnforge
+{
+	// Shard shard_id is a contiguous range of entries of the original reader, shards of shard_count workers cover the reader entirely.
+	// The reader returns entry_count entries of the shard starting from entry first_entry_id of the shard.
+	// The original reader is positioned at the range with rewind, or with reset and skipping entries
+	// when it doesn't support rewind. Entry IDs are relative to the position reset moves the original reader to.
+	// The original reader should outlive this one
+	class supervised_sharded_data_reader : public supervised_data_reader
+	{
+	public:
+		supervised_sharded_data_reader(
+			supervised_data_reader& original_reader,
+			unsigned int shard_id,
+			unsigned int shard_count,
+			unsigned int first_entry_id,
+			unsigned int entry_count);
+
+		virtual ~supervised_sharded_data_reader();
+
+		// Returns the ID of the entry of the original reader the shard starts at
+		static unsigned int get_shard_start_entry_id(
+			unsigned int entry_count,
+			unsigned int shard_id,
+			unsigned int shard_count);
+
+		// Returns the number of entries of the shard, entry_count is the number of entries of the original reader
+		static unsigned int get_shard_entry_count(
+			unsigned int entry_count,
+			unsigned int shard_id,
+			unsigned int shard_count);
+
+		// The method should return true in case entry is read and false if there is no more entries available (and no entry is read in this case)
+		// If any parameter is null the method should just discard corresponding data
+		virtual bool read(
+			void * input_elems,
+			float * output_elems);
+
+		virtual bool raw_read(std::vector<unsigned char>& all_elems);
+
+		virtual void rewind(unsigned int entry_id);
+
+		// Moves the original reader back to the first entry of the range
+		virtual void reset();
+
+		virtual layer_configuration_specific get_input_configuration() const;
+
+		virtual layer_configuration_specific get_output_configuration() const;
+
+		virtual neuron_data_type::input_type get_input_type() const;
+
+		virtual unsigned int get_entry_count() const;
+
+	private:
+		void move_to(unsigned int entry_id);
+
+	protected:
+		supervised_data_reader& original_reader;
+		unsigned int shard_id;
+		unsigned int shard_count;
+		unsigned int first_entry_id;
+		unsigned int entry_count;
+
+		unsigned int entry_read_count;
+
+	private:
+		supervised_sharded_data_reader(const supervised_sharded_data_reader&);
+		supervised_sharded_data_reader& operator =(const supervised_sharded_data_reader&);
+	};
+}
@@ -18,6 +18,7 @@
 
 #include "supervised_data_reader.h"
 #include "data_transformer.h"
+#include "data_transformer_worker_pool.h"
 
 #include <memory>
 
@@ -28,7 +29,8 @@ namespace nnforge
 	public:
 		supervised_transformed_input_data_reader(
 			supervised_data_reader_smart_ptr original_reader,
-			data_transformer_smart_ptr transformer);
+			data_transformer_smart_ptr transformer,
+			unsigned int worker_count = 1);
 
 		virtual ~supervised_transformed_input_data_reader();
 
@@ -38,10 +40,17 @@ namespace nnforge
 			void * input_elems,
 			float * output_elems);
 
+		virtual unsigned int read_batch(
+			unsigned int requested_entry_count,
+			void * input_elems,
+			float * output_elems);
+
 		virtual bool raw_read(std::vector<unsigned char>& all_elems);
 
 		virtual void rewind(unsigned int entry_id);
 
+		virtual bool is_rewind_supported() const;
+
 		virtual void reset();
 
 		virtual void next_epoch();
@@ -63,10 +72,12 @@ namespace nnforge
 
 		std::vector<unsigned char> input_buf;
 		std::vector<float> output_buf;
+		std::vector<unsigned char> input_batch_buf;
 		void * local_input_ptr;
 		float * local_output_ptr;
 		size_t output_buf_size;
 		unsigned int current_sample_id;
 		unsigned int transformer_sample_count;
+		data_transformer_worker_pool_smart_ptr worker_pool;
 	};
 }
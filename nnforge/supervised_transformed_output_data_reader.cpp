@@ -17,6 +17,7 @@
 #include "supervised_transformed_output_data_reader.h"
 
 #include <cstring>
+#include <algorithm>
 
 namespace nnforge
 {
@@ -83,6 +84,44 @@ namespace nnforge
 		return true;
 	}
 
+	unsigned int supervised_transformed_output_data_reader::read_batch(
+		unsigned int requested_entry_count,
+		void * input_elems,
+		float * output_elems)
+	{
+		// Samples of the same original entry are generated one by one
+		if (transformer_sample_count > 1)
+			return supervised_data_reader::read_batch(requested_entry_count, input_elems, output_elems);
+
+		layer_configuration_specific original_output_configuration = original_reader->get_output_configuration();
+		unsigned int original_output_neuron_count = original_output_configuration.get_neuron_count();
+		unsigned int output_neuron_count = transformer->get_transformed_configuration(original_output_configuration).get_neuron_count();
+
+		float * original_output_elems = output_elems;
+		if ((local_output_ptr != 0) && (output_elems != 0))
+		{
+			output_batch_buf.resize(std::max(output_batch_buf.size(), static_cast<size_t>(original_output_neuron_count * requested_entry_count)));
+			original_output_elems = &(*output_batch_buf.begin());
+		}
+
+		unsigned int entries_read_count = original_reader->read_batch(requested_entry_count, input_elems, original_output_elems);
+
+		if (output_elems != 0)
+		{
+			for(unsigned int i = 0; i < entries_read_count; ++i)
+			{
+				transformer->transform(
+					(local_output_ptr != 0) ? original_output_elems + (original_output_neuron_count * i) : 0,
+					output_elems + (output_neuron_count * i),
+					neuron_data_type::type_float,
+					original_output_configuration,
+					0);
+			}
+		}
+
+		return entries_read_count;
+	}
+
 	void supervised_transformed_output_data_reader::reset()
 	{
 		current_sample_id = 0;
@@ -122,6 +161,11 @@ namespace nnforge
 		throw std::runtime_error("rewind not implemented for supervised_transformed_output_data_reader");
 	}
 
+	bool supervised_transformed_output_data_reader::is_rewind_supported() const
+	{
+		return false;
+	}
+
 	bool supervised_transformed_output_data_reader::raw_read(std::vector<unsigned char>& all_elems)
 	{
 		throw std::runtime_error("raw_read not implemented for supervised_transformed_output_data_reader");
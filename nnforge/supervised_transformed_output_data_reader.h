@@ -38,10 +38,17 @@ namespace nnforge
 			void * input_elems,
 			float * output_elems);
 
+		virtual unsigned int read_batch(
+			unsigned int requested_entry_count,
+			void * input_elems,
+			float * output_elems);
+
 		virtual bool raw_read(std::vector<unsigned char>& all_elems);
 
 		virtual void rewind(unsigned int entry_id);
 
+		virtual bool is_rewind_supported() const;
+
 		virtual void reset();
 
 		virtual void next_epoch();
@@ -63,6 +70,7 @@ namespace nnforge
 
 		std::vector<float> buf;
 		std::vector<unsigned char> input_buf;
+		std::vector<float> output_batch_buf;
 		float * local_output_ptr;
 		void * local_input_ptr;
 		size_t input_buf_size;
@@ -19,6 +19,7 @@
 namespace nnforge
 {
 	training_task_state::training_task_state()
+		: hessian_epoch(0)
 	{
 	}
 }
@@ -33,6 +33,10 @@ namespace nnforge
 		std::vector<testing_result_smart_ptr> history;
 		std::vector<std::string> comments;
 		unsigned int initial_epoch;
+		// Hessian cached by the trainer, empty if the trainer doesn't cache it
+		network_data_smart_ptr hessian;
+		// The epoch the cached hessian was last calculated at
+		unsigned int hessian_epoch;
 
 		unsigned int get_current_epoch() const
 		{
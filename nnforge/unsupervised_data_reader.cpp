@@ -32,6 +32,29 @@ namespace nnforge
 	{
 	}
 
+	unsigned int unsupervised_data_reader::read_batch(
+		unsigned int requested_entry_count,
+		void * input_elems)
+	{
+		size_t input_entry_size = get_input_neuron_elem_size() * get_input_configuration().get_neuron_count();
+		unsigned char * input_ptr = static_cast<unsigned char *>(input_elems);
+
+		unsigned int entries_read_count = 0;
+		while (entries_read_count < requested_entry_count)
+		{
+			if (!read((input_ptr != 0) ? input_ptr + (input_entry_size * entries_read_count) : 0))
+				break;
+			entries_read_count++;
+		}
+
+		return entries_read_count;
+	}
+
+	bool unsupervised_data_reader::is_rewind_supported() const
+	{
+		return true;
+	}
+
 	size_t unsupervised_data_reader::get_input_neuron_elem_size() const
 	{
 		return neuron_data_type::get_input_size(get_input_type());
@@ -35,6 +35,13 @@ namespace nnforge
 		// The method should return true in case entry is read and false if there is no more entries available (and no entry is read in this case)
 		virtual bool read(void * input_elems) = 0;
 
+		// The method reads up to requested_entry_count entries to consecutive locations and returns the number of entries read
+		// Less than requested_entry_count entries are read only if there is no more entries available
+		// If the parameter is null the method should just discard corresponding data
+		virtual unsigned int read_batch(
+			unsigned int requested_entry_count,
+			void * input_elems);
+
 		// The method should return true in case entry is read and false if there is no more entries available (and no entry is read in this case)
 		virtual bool raw_read(std::vector<unsigned char>& all_elems) = 0;
 
@@ -44,6 +51,9 @@ namespace nnforge
 
 		virtual void rewind(unsigned int entry_id) = 0;
 
+		// Returns false if rewind is not implemented and throws, reset is supported by all the readers
+		virtual bool is_rewind_supported() const;
+
 		virtual layer_configuration_specific get_input_configuration() const = 0;
 
 		virtual neuron_data_type::input_type get_input_type() const = 0;
@@ -20,6 +20,7 @@
 
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/format.hpp>
+#include <algorithm>
 
 namespace nnforge
 {
@@ -73,6 +74,23 @@ namespace nnforge
 		return true;
 	}
 
+	unsigned int unsupervised_data_stream_reader::read_batch(
+		unsigned int requested_entry_count,
+		void * input_neurons)
+	{
+		unsigned int entries_to_read_count = std::min(requested_entry_count, entry_count - entry_read_count);
+		size_t input_entry_size = get_input_neuron_elem_size() * input_neuron_count;
+
+		if (input_neurons)
+			in_stream->read(reinterpret_cast<char*>(input_neurons), input_entry_size * entries_to_read_count);
+		else
+			in_stream->seekg(input_entry_size * entries_to_read_count, std::ios_base::cur);
+
+		entry_read_count += entries_to_read_count;
+
+		return entries_to_read_count;
+	}
+
 	bool unsupervised_data_stream_reader::raw_read(std::vector<unsigned char>& all_elems)
 	{
 		if (!entry_available())
@@ -40,6 +40,10 @@ namespace nnforge
 
 		virtual bool read(void * input_neurons);
 
+		virtual unsigned int read_batch(
+			unsigned int requested_entry_count,
+			void * input_neurons);
+
 		virtual bool raw_read(std::vector<unsigned char>& all_elems);
 
 		virtual layer_configuration_specific get_input_configuration() const
@@ -16,11 +16,14 @@
 
 #include "unsupervised_transformed_input_data_reader.h"
 
+#include <algorithm>
+
 namespace nnforge
 {
 	unsupervised_transformed_input_data_reader::unsupervised_transformed_input_data_reader(
 		unsupervised_data_reader_smart_ptr original_reader,
-		data_transformer_smart_ptr transformer)
+		data_transformer_smart_ptr transformer,
+		unsigned int worker_count)
 		: original_reader(original_reader)
 		, transformer(transformer)
 		, local_input_ptr(0)
@@ -32,6 +35,11 @@ namespace nnforge
 			buf.resize(original_reader->get_input_neuron_elem_size() * original_reader->get_input_configuration().get_neuron_count());
 			local_input_ptr = &(*buf.begin());
 		}
+		if ((worker_count > 1) && (transformer_sample_count == 1) && transformer->is_parallel_transform_supported())
+		{
+			random_generator seed_generator = rnd::get_random_generator();
+			worker_pool = data_transformer_worker_pool_smart_ptr(new data_transformer_worker_pool(worker_count, seed_generator));
+		}
 	}
 
 	unsupervised_transformed_input_data_reader::unsupervised_transformed_input_data_reader()
@@ -66,6 +74,57 @@ namespace nnforge
 		return true;
 	}
 
+	unsigned int unsupervised_transformed_input_data_reader::read_batch(
+		unsigned int requested_entry_count,
+		void * input_elems)
+	{
+		// Samples of the same original entry are generated one by one
+		if (transformer_sample_count > 1)
+			return unsupervised_data_reader::read_batch(requested_entry_count, input_elems);
+
+		neuron_data_type::input_type type_code = original_reader->get_input_type();
+		layer_configuration_specific original_input_configuration = original_reader->get_input_configuration();
+		size_t input_neuron_elem_size = neuron_data_type::get_input_size(type_code);
+		size_t original_input_entry_size = input_neuron_elem_size * original_input_configuration.get_neuron_count();
+		size_t input_entry_size = input_neuron_elem_size * transformer->get_transformed_configuration(original_input_configuration).get_neuron_count();
+
+		unsigned char * original_input_elems = static_cast<unsigned char *>(input_elems);
+		if ((local_input_ptr != 0) && (input_elems != 0))
+		{
+			input_batch_buf.resize(std::max(input_batch_buf.size(), original_input_entry_size * requested_entry_count));
+			original_input_elems = &(*input_batch_buf.begin());
+		}
+
+		unsigned int entries_read_count = original_reader->read_batch(requested_entry_count, original_input_elems);
+
+		if ((input_elems != 0) && worker_pool)
+		{
+			worker_pool->transform(
+				*transformer,
+				entries_read_count,
+				(local_input_ptr != 0) ? original_input_elems : 0,
+				original_input_entry_size,
+				input_elems,
+				input_entry_size,
+				type_code,
+				original_input_configuration);
+		}
+		else if (input_elems != 0)
+		{
+			for(unsigned int i = 0; i < entries_read_count; ++i)
+			{
+				transformer->transform(
+					(local_input_ptr != 0) ? original_input_elems + (original_input_entry_size * i) : 0,
+					static_cast<unsigned char *>(input_elems) + (input_entry_size * i),
+					type_code,
+					original_input_configuration,
+					0);
+			}
+		}
+
+		return entries_read_count;
+	}
+
 	void unsupervised_transformed_input_data_reader::reset()
 	{
 		current_sample_id = 0;
@@ -100,6 +159,11 @@ namespace nnforge
 		throw std::runtime_error("rewind not implemented for unsupervised_transformed_input_data_reader");
 	}
 
+	bool unsupervised_transformed_input_data_reader::is_rewind_supported() const
+	{
+		return false;
+	}
+
 	bool unsupervised_transformed_input_data_reader::raw_read(std::vector<unsigned char>& all_elems)
 	{
 		throw std::runtime_error("raw_read not implemented for unsupervised_transformed_input_data_reader");
@@ -18,6 +18,7 @@
 
 #include "unsupervised_data_reader.h"
 #include "data_transformer.h"
+#include "data_transformer_worker_pool.h"
 
 #include <memory>
 
@@ -28,7 +29,8 @@ namespace nnforge
 	public:
 		unsupervised_transformed_input_data_reader(
 			unsupervised_data_reader_smart_ptr original_reader,
-			data_transformer_smart_ptr transformer);
+			data_transformer_smart_ptr transformer,
+			unsigned int worker_count = 1);
 
 		virtual ~unsupervised_transformed_input_data_reader();
 
@@ -36,10 +38,16 @@ namespace nnforge
 		// If any parameter is null the method should just discard corresponding data
 		virtual bool read(void * input_elems);
 
+		virtual unsigned int read_batch(
+			unsigned int requested_entry_count,
+			void * input_elems);
+
 		virtual bool raw_read(std::vector<unsigned char>& all_elems);
 
 		virtual void rewind(unsigned int entry_id);
 
+		virtual bool is_rewind_supported() const;
+
 		virtual void reset();
 
 		virtual void next_epoch();
@@ -58,8 +66,10 @@ namespace nnforge
 		data_transformer_smart_ptr transformer;
 
 		std::vector<unsigned char> buf;
+		std::vector<unsigned char> input_batch_buf;
 		void * local_input_ptr;
 		unsigned int current_sample_id;
 		unsigned int transformer_sample_count;
+		data_transformer_worker_pool_smart_ptr worker_pool;
 	};
 }
@@ -41,19 +41,30 @@ namespace nnforge
 
 	void validate_progress_network_data_pusher::push(const training_task_state& task_state)
 	{
-		tester->set_data(task_state.data);
+		validate(
+			task_state.data,
+			task_state.index_peeked,
+			task_state.get_current_epoch(),
+			std::cout);
+	}
+
+	void validate_progress_network_data_pusher::validate(
+		network_data_smart_ptr data,
+		unsigned int index_peeked,
+		unsigned int epoch,
+		std::ostream& out)
+	{
+		tester->set_data(data);
 
 		testing_complete_result_set testing_res(ef, actual_output_neuron_value_set);
 		tester->test(
 			*reader,
 			testing_res);
 
-		unsigned int last_index = static_cast<unsigned int>(task_state.history.size()) - 1;
-
-		std::cout << "# " << task_state.index_peeked
-			<< ", Epoch " << task_state.get_current_epoch()
+		out << "# " << index_peeked
+			<< ", Epoch " << epoch
 			<< ", Validating ";
-		visualizer->dump(std::cout, testing_res);
-		std::cout << std::endl;
+		visualizer->dump(out, testing_res);
+		out << std::endl;
 	}
 }
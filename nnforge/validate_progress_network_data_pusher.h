@@ -24,6 +24,8 @@
 #include "testing_complete_result_set_visualizer.h"
 #include "error_function.h"
 
+#include <ostream>
+
 namespace nnforge
 {
 	class validate_progress_network_data_pusher : public network_data_pusher
@@ -40,6 +42,14 @@ namespace nnforge
 
 		virtual void push(const training_task_state& task_state);
 
+	protected:
+		// Runs validation and dumps the result line to out
+		void validate(
+			network_data_smart_ptr data,
+			unsigned int index_peeked,
+			unsigned int epoch,
+			std::ostream& out);
+
 	protected:
 		network_tester_smart_ptr tester;
 		supervised_data_reader_smart_ptr reader;
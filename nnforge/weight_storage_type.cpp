@@ -0,0 +1,200 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include "weight_storage_type.h"
+
+#include "neural_network_exception.h"
+
+#include <string.h>
+#include <boost/format.hpp>
+
+namespace nnforge
+{
+	size_t weight_storage_type::get_elem_size(storage_type t)
+	{
+		switch(t)
+		{
+		case type_float:
+			return sizeof(float);
+		case type_fp16:
+		case type_bf16:
+			return sizeof(unsigned short);
+		}
+
+		throw neural_network_exception((boost::format("Unknown weight storage type %1%") % t).str());
+	}
+
+	weight_storage_type::storage_type weight_storage_type::parse(const std::string& name)
+	{
+		if (name == "float")
+			return type_float;
+		else if (name == "fp16")
+			return type_fp16;
+		else if (name == "bf16")
+			return type_bf16;
+
+		throw neural_network_exception((boost::format("Unknown weight storage type name: %1%") % name).str());
+	}
+
+	const char * weight_storage_type::get_name(storage_type t)
+	{
+		switch(t)
+		{
+		case type_float:
+			return "float";
+		case type_fp16:
+			return "fp16";
+		case type_bf16:
+			return "bf16";
+		}
+
+		throw neural_network_exception((boost::format("Unknown weight storage type %1%") % t).str());
+	}
+
+	unsigned short weight_storage_type::float_to_fp16(float val)
+	{
+		unsigned int f;
+		memcpy(&f, &val, sizeof(f));
+
+		unsigned int sign = (f >> 16) & 0x8000;
+		unsigned int abs_val = f & 0x7FFFFFFF;
+
+		// Inf and NaN
+		if (abs_val >= 0x7F800000)
+			return static_cast<unsigned short>(sign | 0x7C00 | ((abs_val > 0x7F800000) ? 0x200 : 0));
+
+		// Values rounding to beyond the max half (65504) become Inf
+		if (abs_val >= 0x477FF000)
+			return static_cast<unsigned short>(sign | 0x7C00);
+
+		// Subnormal half values
+		if (abs_val < 0x38800000)
+		{
+			if (abs_val < 0x33000000)
+				return static_cast<unsigned short>(sign);
+
+			unsigned int shift = 126 - (abs_val >> 23);
+			unsigned int mantissa = (abs_val & 0x7FFFFF) | 0x800000;
+			unsigned int res = mantissa >> shift;
+			unsigned int remainder = mantissa & ((1U << shift) - 1);
+			unsigned int half_unit = 1U << (shift - 1);
+			if ((remainder > half_unit) || ((remainder == half_unit) && ((res & 1) != 0)))
+				++res;
+			return static_cast<unsigned short>(sign | res);
+		}
+
+		// Exponent is rebiased from 127 to 15, rounding carry propagates into exponent correctly
+		unsigned int res = (abs_val - 0x38000000) >> 13;
+		unsigned int remainder = abs_val & 0x1FFF;
+		if ((remainder > 0x1000) || ((remainder == 0x1000) && ((res & 1) != 0)))
+			++res;
+		return static_cast<unsigned short>(sign | res);
+	}
+
+	float weight_storage_type::fp16_to_float(unsigned short val)
+	{
+		unsigned int sign = (static_cast<unsigned int>(val) & 0x8000) << 16;
+		unsigned int exponent = (val >> 10) & 0x1F;
+		unsigned int mantissa = val & 0x3FF;
+
+		unsigned int f;
+		if (exponent == 0x1F)
+			f = sign | 0x7F800000 | (mantissa << 13);
+		else if (exponent != 0)
+			f = sign | ((exponent + 112) << 23) | (mantissa << 13);
+		else if (mantissa == 0)
+			f = sign;
+		else
+		{
+			// Subnormal half is normal float
+			exponent = 113;
+			while ((mantissa & 0x400) == 0)
+			{
+				mantissa <<= 1;
+				--exponent;
+			}
+			f = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+		}
+
+		float res;
+		memcpy(&res, &f, sizeof(res));
+		return res;
+	}
+
+	unsigned short weight_storage_type::float_to_bf16(float val)
+	{
+		unsigned int f;
+		memcpy(&f, &val, sizeof(f));
+
+		// Keep NaN quiet, rounding might turn it into Inf otherwise
+		if ((f & 0x7FFFFFFF) > 0x7F800000)
+			return static_cast<unsigned short>((f >> 16) | 0x40);
+
+		return static_cast<unsigned short>((f + 0x7FFF + ((f >> 16) & 1)) >> 16);
+	}
+
+	float weight_storage_type::bf16_to_float(unsigned short val)
+	{
+		unsigned int f = static_cast<unsigned int>(val) << 16;
+
+		float res;
+		memcpy(&res, &f, sizeof(res));
+		return res;
+	}
+
+	void weight_storage_type::narrow(
+		storage_type t,
+		const float * src,
+		unsigned short * dst,
+		size_t elem_count)
+	{
+		switch(t)
+		{
+		case type_fp16:
+			for(size_t i = 0; i < elem_count; ++i)
+				dst[i] = float_to_fp16(src[i]);
+			break;
+		case type_bf16:
+			for(size_t i = 0; i < elem_count; ++i)
+				dst[i] = float_to_bf16(src[i]);
+			break;
+		default:
+			throw neural_network_exception((boost::format("Unable to narrow weights to storage type %1%") % t).str());
+		}
+	}
+
+	void weight_storage_type::widen(
+		storage_type t,
+		const unsigned short * src,
+		float * dst,
+		size_t elem_count)
+	{
+		switch(t)
+		{
+		case type_fp16:
+			for(size_t i = 0; i < elem_count; ++i)
+				dst[i] = fp16_to_float(src[i]);
+			break;
+		case type_bf16:
+			for(size_t i = 0; i < elem_count; ++i)
+				dst[i] = bf16_to_float(src[i]);
+			break;
+		default:
+			throw neural_network_exception((boost::format("Unable to widen weights from storage type %1%") % t).str());
+		}
+	}
+}
@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2011-2014 Maxim Milakov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <string>
+#include <memory>
+
+namespace nnforge
+{
+	// Precision weights are stored with, in files or in memory
+	// Weights are always widened to float before computations
+	class weight_storage_type
+	{
+	public:
+		enum storage_type
+		{
+			type_float = 0,
+			type_fp16 = 1,
+			type_bf16 = 2
+		};
+
+		static size_t get_elem_size(storage_type t);
+
+		// Accepts "float", "fp16" and "bf16"
+		static storage_type parse(const std::string& name);
+
+		static const char * get_name(storage_type t);
+
+		// Rounds to the nearest, ties to even
+		static unsigned short float_to_fp16(float val);
+
+		static float fp16_to_float(unsigned short val);
+
+		// Rounds to the nearest, ties to even
+		static unsigned short float_to_bf16(float val);
+
+		static float bf16_to_float(unsigned short val);
+
+		// t should be either type_fp16 or type_bf16
+		static void narrow(
+			storage_type t,
+			const float * src,
+			unsigned short * dst,
+			size_t elem_count);
+
+		// t should be either type_fp16 or type_bf16
+		static void widen(
+			storage_type t,
+			const unsigned short * src,
+			float * dst,
+			size_t elem_count);
+
+	private:
+		weight_storage_type();
+		weight_storage_type(const weight_storage_type&);
+		weight_storage_type& operator =(const weight_storage_type&);
+	};
+}